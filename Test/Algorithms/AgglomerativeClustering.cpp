@@ -0,0 +1,247 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Test case for agglomerative clustering.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#define BOOST_TEST_MODULE Algorithms_AgglomerativeClustering
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <algorithm>
+
+#include <shark/Algorithms/AgglomerativeClustering.h>
+#include <shark/Models/Clustering/HierarchicalClustering.h>
+#include <shark/Models/Clustering/HardClusteringModel.h>
+
+using namespace shark;
+
+std::vector<RealVector> randomPoints(std::size_t n, std::size_t dim){
+	std::vector<RealVector> points(n, RealVector(dim));
+	for(auto& point: points){
+		for(auto& x: point)
+			x = random::gauss(random::globalRng, 0, 1);
+	}
+	return points;
+}
+
+//naive O(n^3) agglomerative clustering, returns the merge distances and the clusters after
+//all but the last numClusters-1 merges
+std::vector<double> naiveClustering(
+	std::vector<RealVector> const& points, Linkage linkage,
+	std::size_t numClusters, std::vector<std::vector<std::size_t> >& cut
+){
+	std::vector<std::vector<std::size_t> > clusters(points.size());
+	for(std::size_t i = 0; i != points.size(); ++i)
+		clusters[i].push_back(i);
+	auto linkageDistance = [&](std::vector<std::size_t> const& a, std::vector<std::size_t> const& b){
+		if(linkage == WardLinkage){
+			RealVector ca(points[0].size(), 0.0);
+			RealVector cb(points[0].size(), 0.0);
+			for(std::size_t i: a) ca += points[i] / double(a.size());
+			for(std::size_t j: b) cb += points[j] / double(b.size());
+			return std::sqrt(2.0 * a.size() * b.size() / (a.size() + b.size())) * norm_2(ca - cb);
+		}
+		double result = linkage == SingleLinkage ? std::numeric_limits<double>::max() : 0.0;
+		for(std::size_t i: a){
+			for(std::size_t j: b){
+				double d = norm_2(points[i] - points[j]);
+				if(linkage == SingleLinkage)
+					result = std::min(result, d);
+				else
+					result += d / (a.size() * b.size());
+			}
+		}
+		return result;
+	};
+	std::vector<double> distances;
+	while(clusters.size() > 1){
+		if(clusters.size() == numClusters)
+			cut = clusters;
+		std::size_t bestI = 0, bestJ = 1;
+		double best = std::numeric_limits<double>::max();
+		for(std::size_t i = 0; i != clusters.size(); ++i){
+			for(std::size_t j = i + 1; j != clusters.size(); ++j){
+				double d = linkageDistance(clusters[i], clusters[j]);
+				if(d < best){
+					best = d;
+					bestI = i;
+					bestJ = j;
+				}
+			}
+		}
+		distances.push_back(best);
+		clusters[bestI].insert(clusters[bestI].end(), clusters[bestJ].begin(), clusters[bestJ].end());
+		clusters.erase(clusters.begin() + bestJ);
+	}
+	return distances;
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_AgglomerativeClustering)
+
+BOOST_AUTO_TEST_CASE(AgglomerativeClustering_Naive)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> points = randomPoints(60, 3);
+	Data<RealVector> data = createDataFromRange(points, 16);
+	for(Linkage linkage: {WardLinkage, AverageLinkage, SingleLinkage}){
+		std::vector<std::vector<std::size_t> > cut;
+		std::vector<double> distances = naiveClustering(points, linkage, 5, cut);
+		std::vector<ClusterMerge> merges = agglomerativeClustering(data, linkage);
+		BOOST_REQUIRE_EQUAL(merges.size(), 59);
+		for(std::size_t i = 0; i != merges.size(); ++i){
+			BOOST_CHECK_CLOSE(merges[i].distance, distances[i], 1.e-8);
+			BOOST_CHECK_LT(merges[i].left, merges[i].right);
+			BOOST_CHECK_LT(merges[i].right, 60 + i);
+			if(i > 0)
+				BOOST_CHECK_LE(merges[i - 1].distance, merges[i].distance);
+		}
+		BOOST_CHECK_EQUAL(merges.back().size, 60);
+
+		//the cut produces the same partition
+		std::vector<unsigned int> labels = cutDendrogram(merges, 5);
+		BOOST_REQUIRE_EQUAL(cut.size(), 5);
+		for(auto const& cluster: cut){
+			for(std::size_t i: cluster)
+				BOOST_CHECK_EQUAL(labels[i], labels[cluster[0]]);
+		}
+		for(std::size_t c = 1; c != cut.size(); ++c){
+			for(std::size_t c2 = 0; c2 != c; ++c2)
+				BOOST_CHECK_NE(labels[cut[c][0]], labels[cut[c2][0]]);
+		}
+	}
+}
+
+//Ward linkage over several tiles of centroids far away from the origin, where the expanded
+//distances suffer from cancellation
+BOOST_AUTO_TEST_CASE(AgglomerativeClustering_Ward_Tiles)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> points = randomPoints(300, 3);
+	for(RealVector& point: points)
+		point += RealVector(3, 1000.0);
+	std::vector<std::vector<std::size_t> > cut;
+	std::vector<double> distances = naiveClustering(points, WardLinkage, 5, cut);
+	std::vector<ClusterMerge> merges = agglomerativeClustering(createDataFromRange(points, 32), WardLinkage);
+	BOOST_REQUIRE_EQUAL(merges.size(), 299);
+	for(std::size_t i = 0; i != merges.size(); ++i)
+		BOOST_CHECK_CLOSE(merges[i].distance, distances[i], 1.e-6);
+}
+
+//single linkage over several tiles against Prim's algorithm
+BOOST_AUTO_TEST_CASE(AgglomerativeClustering_SingleLinkage_Large)
+{
+	random::globalRng.seed(42);
+	std::size_t n = 1500;
+	std::vector<RealVector> points = randomPoints(n, 4);
+	std::vector<double> primDistances;
+	std::vector<double> distance(n, std::numeric_limits<double>::max());
+	std::vector<bool> inTree(n, false);
+	distance[0] = 0;
+	for(std::size_t step = 0; step != n; ++step){
+		std::size_t next = n;
+		for(std::size_t i = 0; i != n; ++i){
+			if(!inTree[i] && (next == n || distance[i] < distance[next]))
+				next = i;
+		}
+		inTree[next] = true;
+		if(step > 0)
+			primDistances.push_back(distance[next]);
+		for(std::size_t i = 0; i != n; ++i)
+			distance[i] = std::min(distance[i], norm_2(points[i] - points[next]));
+	}
+	std::sort(primDistances.begin(), primDistances.end());
+
+	std::vector<ClusterMerge> merges = agglomerativeClustering(createDataFromRange(points), SingleLinkage);
+	BOOST_REQUIRE_EQUAL(merges.size(), n - 1);
+	for(std::size_t i = 0; i != n - 1; ++i)
+		BOOST_CHECK_CLOSE(merges[i].distance, primDistances[i], 1.e-8);
+}
+
+BOOST_AUTO_TEST_CASE(AgglomerativeClustering_HierarchicalClustering)
+{
+	random::globalRng.seed(42);
+	//three well separated blobs
+	std::vector<RealVector> points = randomPoints(300, 2);
+	for(std::size_t i = 0; i != points.size(); ++i)
+		points[i](i % 3 == 2? 1: 0) += 10.0 * (i % 3);
+	Data<RealVector> data = createDataFromRange(points, 32);
+	for(Linkage linkage: {WardLinkage, AverageLinkage, SingleLinkage}){
+		std::vector<ClusterMerge> merges = agglomerativeClustering(data, linkage);
+		std::vector<unsigned int> labels = cutDendrogram(merges, 3);
+		for(std::size_t i = 3; i != points.size(); ++i)
+			BOOST_CHECK_EQUAL(labels[i], labels[i % 3]);
+		BOOST_CHECK_NE(labels[0], labels[1]);
+		BOOST_CHECK_NE(labels[0], labels[2]);
+		BOOST_CHECK_NE(labels[1], labels[2]);
+
+		ClusterTree tree(data, merges, 3);
+		BOOST_CHECK_EQUAL(tree.nodes(), 5);
+		BOOST_CHECK_EQUAL(tree.size(), 300);
+		BOOST_CHECK_CLOSE(tree.height(), merges.back().distance, 1.e-12);
+		HierarchicalClustering<RealVector> clustering(&tree);
+		BOOST_CHECK_EQUAL(clustering.numberOfClusters(), 3);
+		HardClusteringModel<RealVector> model(&clustering);
+		Data<unsigned int> memberships = model(data);
+		for(std::size_t i = 0; i != points.size(); ++i)
+			BOOST_CHECK_EQUAL(memberships.element(i), labels[i]);
+	}
+}
+
+//the lower bound of every node must not exceed the distance to any of its members
+void checkLowerBound(BinaryTree<RealVector> const& node, std::vector<RealVector> const& points, RealVector const& reference){
+	double minDistance = std::numeric_limits<double>::max();
+	for(std::size_t i = 0; i != node.size(); ++i)
+		minDistance = std::min(minDistance, norm_sqr(points[node.index(i)] - reference));
+	BOOST_CHECK_LE(node.squaredDistanceLowerBound(reference), minDistance * (1 + 1.e-12));
+	if(node.hasChildren()){
+		checkLowerBound(*node.left(), points, reference);
+		checkLowerBound(*node.right(), points, reference);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(AgglomerativeClustering_ClusterTree_LowerBound)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> points = randomPoints(200, 3);
+	Data<RealVector> data = createDataFromRange(points, 32);
+	for(Linkage linkage: {WardLinkage, AverageLinkage, SingleLinkage}){
+		std::vector<ClusterMerge> merges = agglomerativeClustering(data, linkage);
+		ClusterTree tree(data, merges, 20);
+		for(std::size_t trial = 0; trial != 20; ++trial){
+			RealVector reference(3);
+			for(double& x: reference)
+				x = random::gauss(random::globalRng, 0, 2);
+			checkLowerBound(tree, points, reference);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
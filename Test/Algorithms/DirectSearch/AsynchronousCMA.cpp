@@ -0,0 +1,204 @@
+#define BOOST_TEST_MODULE DirectSearch_AsynchronousCMA
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/DirectSearch/AsynchronousCMA.h>
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Algorithms/DirectSearch/VDCMA.h>
+#include <shark/Algorithms/DirectSearch/LMCMA.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Sphere.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Ellipsoid.h>
+
+#include "../testFunction.h"
+
+#include <thread>
+#include <chrono>
+
+using namespace shark;
+
+//the benchmark functions do not use shared state and can be evaluated in parallel
+struct ThreadSafeSphere : public Sphere{
+	ThreadSafeSphere(std::size_t numberOfVariables):Sphere(numberOfVariables){
+		m_features |= IS_THREAD_SAFE;
+	}
+};
+struct ThreadSafeEllipsoid : public Ellipsoid{
+	ThreadSafeEllipsoid(std::size_t numberOfVariables):Ellipsoid(numberOfVariables){
+		m_features |= IS_THREAD_SAFE;
+	}
+};
+
+//sphere whose evaluation time depends on the point, so offspring finish out of order.
+//Some points take much longer and return several updates after they were sampled.
+struct DelayedSphere : public ThreadSafeSphere{
+	DelayedSphere(std::size_t numberOfVariables):ThreadSafeSphere(numberOfVariables){}
+	double eval(RealVector const& x)const{
+		double delay = 50 + 2000 * std::abs(std::sin(1.e4 * x(0)));
+		if(std::abs(std::sin(1.e4 * x(1))) < 0.1)
+			delay *= 20;
+		std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(delay)));
+		return ThreadSafeSphere::eval(x);
+	}
+};
+
+//sphere which fails after a fixed number of evaluations
+struct FailingSphere : public ThreadSafeSphere{
+	FailingSphere(std::size_t numberOfVariables, std::size_t failAfter)
+	:ThreadSafeSphere(numberOfVariables), m_failAfter(failAfter){}
+	double eval(RealVector const& x)const{
+		if(evaluationCounter() > m_failAfter)
+			throw SHARKEXCEPTION("evaluation failed");
+		return ThreadSafeSphere::eval(x);
+	}
+	std::size_t m_failAfter;
+};
+
+//counts the offspring of an update which are not samples of the current search distribution
+struct ConsistencyCheckingCMA : public CMA{
+	ConsistencyCheckingCMA(random::rng_type& rng = random::globalRng):CMA(rng), inconsistentOffspring(0){}
+
+	void updatePopulation( std::vector<IndividualType> const& offspring ){
+		RealMatrix A = eigenVectors() % to_diagonal(sqrt(eigenValues()));
+		for(IndividualType const& individual: offspring){
+			RealVector step = sigma() * (A % individual.chromosome());
+			if(norm_2(step - (individual.searchPoint() - mean())) > 1.e-6 * norm_2(step))
+				++inconsistentOffspring;
+		}
+		CMA::updatePopulation(offspring);
+	}
+	std::size_t inconsistentOffspring;
+};
+
+//averages the normalized step size sigma sqrt(tr(C)/n) n/||m|| and the length of the step size path
+//over the updates, after the initial adaptation
+template<class Optimizer>
+void averageStepSizeAndPath(Optimizer& optimizer, DelayedSphere const& function, double& stepSize, double& pathLength){
+	std::size_t n = function.numberOfVariables();
+	std::size_t burnIn = 50;
+	std::size_t updates = 150;
+	stepSize = 0;
+	pathLength = 0;
+	for(std::size_t i = 0; i != burnIn + updates; ++i){
+		optimizer.step(function);
+		if(i < burnIn) continue;
+		double scale = std::sqrt(sum(optimizer.eigenValues()) / n);
+		stepSize += std::log(optimizer.sigma() * scale * n / norm_2(optimizer.mean()));
+		pathLength += norm_2(optimizer.evolutionPathSigma()) / std::sqrt(double(n));
+	}
+	stepSize = std::exp(stepSize / updates);
+	pathLength /= updates;
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_AsynchronousCMA)
+
+BOOST_AUTO_TEST_CASE( AsynchronousCMA_Sphere )
+{
+	ThreadSafeSphere function(10);
+	AsynchronousCMA<CMA> optimizer;
+	optimizer.setNumberOfWorkers(4);
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << std::endl;
+	testFunction( optimizer, function, 5, 1000, 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( AsynchronousCMA_Ellipsoid )
+{
+	ThreadSafeEllipsoid function(10);
+	AsynchronousCMA<CMA> optimizer;
+	optimizer.setNumberOfWorkers(4);
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << std::endl;
+	testFunction( optimizer, function, 5, 3000, 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( AsynchronousVDCMA_Sphere )
+{
+	ThreadSafeSphere function(20);
+	AsynchronousCMA<VDCMA> optimizer;
+	optimizer.setNumberOfWorkers(4);
+	optimizer.setInitialSigma(2);
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << std::endl;
+	testFunction( optimizer, function, 5, 3000, 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( AsynchronousLMCMA_Sphere )
+{
+	ThreadSafeSphere function(20);
+	AsynchronousCMA<LMCMA> optimizer;
+	optimizer.setNumberOfWorkers(4);
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << std::endl;
+	testFunction( optimizer, function, 5, 3000, 1E-10 );
+}
+
+//offspring sampled from earlier distributions must not disturb the step size adaptation
+BOOST_AUTO_TEST_CASE( AsynchronousCMA_Delays_StepSize )
+{
+	DelayedSphere function(10);
+	function.init();
+	RealVector start(10, 1.0);
+
+	CMA synchronous;
+	synchronous.init(function, start);
+	double syncStepSize = 0;
+	double syncPathLength = 0;
+	averageStepSizeAndPath(synchronous, function, syncStepSize, syncPathLength);
+
+	AsynchronousCMA<ConsistencyCheckingCMA> asynchronous;
+	asynchronous.setNumberOfWorkers(8);
+	asynchronous.init(function, start);
+	double asyncStepSize = 0;
+	double asyncPathLength = 0;
+	averageStepSizeAndPath(asynchronous, function, asyncStepSize, asyncPathLength);
+	asynchronous.stopWorkers();
+
+	BOOST_CHECK_EQUAL(asynchronous.inconsistentOffspring, 0);
+	BOOST_CHECK_CLOSE(asyncStepSize, syncStepSize, 50);
+	BOOST_CHECK_CLOSE(asyncPathLength, syncPathLength, 25);
+}
+
+BOOST_AUTO_TEST_CASE( AsynchronousCMA_Restart )
+{
+	ThreadSafeSphere function(10);
+	function.init();
+	AsynchronousCMA<CMA> optimizer;
+	optimizer.setNumberOfWorkers(3);
+	optimizer.init(function);
+	for(std::size_t i = 0; i != 10; ++i)
+		optimizer.step(function);
+	BOOST_CHECK_GE(optimizer.numberOfEvaluatedOffspring(), 10 * optimizer.lambda());
+
+	//reinitialisation stops the workers and resets the state
+	optimizer.init(function, function.proposeStartingPoint(), 20, 5, 1.0);
+	BOOST_CHECK_EQUAL(optimizer.numberOfEvaluatedOffspring(), 0);
+	BOOST_CHECK_EQUAL(optimizer.lambda(), 20);
+	for(std::size_t i = 0; i != 10; ++i)
+		optimizer.step(function);
+	BOOST_CHECK_GE(optimizer.numberOfEvaluatedOffspring(), 10 * optimizer.lambda());
+}
+
+//an exception of a worker stops all workers and is rethrown by step()
+BOOST_AUTO_TEST_CASE( AsynchronousCMA_Exception )
+{
+	FailingSphere function(10, 50);
+	function.init();
+	AsynchronousCMA<CMA> optimizer;
+	optimizer.setNumberOfWorkers(4);
+	optimizer.init(function);
+	BOOST_CHECK_THROW(
+		for(std::size_t i = 0; i != 100; ++i) optimizer.step(function),
+		Exception
+	);
+	BOOST_CHECK_EQUAL(optimizer.numberOfEvaluatedOffspring(), 0);
+
+	//the optimizer can be used again afterwards
+	ThreadSafeSphere sphere(10);
+	sphere.init();
+	optimizer.init(sphere);
+	for(std::size_t i = 0; i != 10; ++i)
+		optimizer.step(sphere);
+	BOOST_CHECK_GE(optimizer.numberOfEvaluatedOffspring(), 10 * optimizer.lambda());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -114,6 +114,25 @@ BOOST_AUTO_TEST_CASE( CMA_Ellipsoid_Niko )
 	BOOST_CHECK(cma.condition() > 1E5);
 }
 
+//in 30 dimensions the decomposition is only recomputed every few generations
+BOOST_AUTO_TEST_CASE( CMA_Ellipsoid_Background_Decomposition )
+{
+	random::globalRng.seed(42);
+	const unsigned N = 30;
+	RealVector x0(N, 0.1);
+	Ellipsoid elli(N, 1E6);
+	elli.init();
+	CMA cma(random::globalRng);
+	BOOST_REQUIRE(!cma.lazyDecomposition());
+	cma.setLazyDecomposition(true);
+	cma.setBackgroundDecomposition(true);
+	cma.init(elli, x0);
+
+	for(unsigned i=0; i<10000 && cma.solution().value > 1E-10; i++) 	cma.step( elli );
+	BOOST_CHECK(cma.solution().value < 1E-10);
+	BOOST_CHECK(cma.condition() > 1E5);
+}
+
 BOOST_AUTO_TEST_CASE( CMA_Sphere_Niko )
 {
 	random::globalRng.seed(42);
@@ -4,6 +4,8 @@
 
 #include <shark/Algorithms/DirectSearch/Operators/Domination/FastNonDominatedSort.h>
 #include <shark/Algorithms/DirectSearch/Operators/Domination/DCNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/MatrixNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/NonDominatedSort.h>
 #include <shark/Core/Random.h>
 #include <shark/Core/Timer.h>
 
@@ -63,4 +65,49 @@ BOOST_AUTO_TEST_CASE( NonDominatedSort_Test )
 		}
 	}
 }
+// Checks that the matrix based algorithm coincides with the fast non-dominated sort
+// for all combinations of brute force and parallel recursion.
+BOOST_AUTO_TEST_CASE( NonDominatedSort_Matrix )
+{
+	std::size_t numPoints = 500;
+	std::size_t numTrials = 3;
+	std::size_t bruteForceThresholds[] = {0, 16, 1000000};
+	std::size_t parallelThresholds[] = {0, 1000000};
+	for (std::size_t numDims=2; numDims <= 5; numDims++)
+	{
+		for (std::size_t t = 0; t != numTrials; ++t) {
+			RealMatrix points(numPoints, numDims);
+			std::vector<RealVector> pointVector(numPoints);
+			for (std::size_t i = 0; i != numPoints; ++i) {
+				for (std::size_t j = 0; j != numDims; ++j) {
+					points(i,j) = random::uni(random::globalRng,-1,2);
+					if (random::coinToss(random::globalRng)) points(i,j) = std::round(points(i,j));
+				}
+				pointVector[i] = row(points,i);
+			}
+			std::vector<unsigned int> ranks1(numPoints);
+			fastNonDominatedSort(pointVector, ranks1);
+
+			for(std::size_t bruteForce: bruteForceThresholds){
+				for(std::size_t parallel: parallelThresholds){
+					std::vector<unsigned int> ranks2(numPoints);
+					BaseMatrixNonDominatedSort sorter(bruteForce, parallel);
+					sorter(points, ranks2);
+					for (std::size_t i=0; i<numPoints; i++)
+					{
+						BOOST_CHECK_EQUAL(ranks1[i], ranks2[i]);
+					}
+				}
+			}
+			
+			std::vector<unsigned int> ranks3(numPoints);
+			nonDominatedSort(points, ranks3);
+			for (std::size_t i=0; i<numPoints; i++)
+			{
+				BOOST_CHECK_EQUAL(ranks1[i], ranks3[i]);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -53,6 +53,30 @@ private:
 	BoxConstraintHandler<SearchPointType> m_handler;
 };
 
+//noisy function which records the order in which points are evaluated
+struct RecordingTestFunction : public SingleObjectiveFunction
+{
+	RecordingTestFunction(std::size_t numVariables) : m_numVariables(numVariables){
+		m_features |= IS_NOISY;
+	}
+
+	std::string name() const
+	{ return "RecordingTestFunction"; }
+
+	std::size_t numberOfVariables()const{
+		return m_numVariables;
+	}
+
+	ResultType eval( const SearchPointType & x ) const {
+		m_evaluated.push_back(x(0));
+		return x(0) + m_evaluated.size();
+	}
+
+	mutable std::vector<double> m_evaluated;
+private:
+	std::size_t m_numVariables;
+};
+
 //check that feasible points are not penalized
 BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_Operators_PenalizingEvaluator)
 
@@ -156,4 +180,27 @@ BOOST_AUTO_TEST_CASE( PenalizingEvaluator_MultiObjective_Infeasible ) {
 		++trials;
 	}
 }
+
+//functions which are not thread safe are evaluated in the same order as by the single individual version
+BOOST_AUTO_TEST_CASE( PenalizingEvaluator_Range_SequentialOrder ) {
+	PenalizingEvaluator evaluator;
+	evaluator.m_numEvaluations = 3;
+	RecordingTestFunction objective(2);
+	BOOST_REQUIRE(!objective.isThreadSafe());
+	std::vector<TestIndividualSOO> individuals(5);
+	for(std::size_t i = 0; i != individuals.size(); ++i){
+		individuals[i].m_point = RealVector(2, double(i));
+	}
+	evaluator(objective, individuals.begin(), individuals.end());
+	
+	BOOST_REQUIRE_EQUAL(objective.m_evaluated.size(), 15);
+	for(std::size_t i = 0; i != individuals.size(); ++i){
+		for(std::size_t k = 0; k != 3; ++k){
+			BOOST_CHECK_EQUAL(objective.m_evaluated[3 * i + k], double(i));
+		}
+		//mean of i + (3i+1), i + (3i+2) and i + (3i+3)
+		BOOST_CHECK_CLOSE(individuals[i].m_unpenalizedFitness, 4.0 * i + 2, 1.e-10);
+		BOOST_CHECK_EQUAL(individuals[i].m_penalizedFitness, individuals[i].m_unpenalizedFitness);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -110,8 +110,145 @@ BOOST_AUTO_TEST_CASE( MergeBudgetMaintenanceStrategy_MergingProblemFunction)
 
 
 
+// the vectorized search for gaussian kernels must find the merge with the smallest degradation
 BOOST_AUTO_TEST_CASE( MergeBudgetMaintenanceStrategy_reduceBudget)
 {
+    random::globalRng.seed(42);
+    std::size_t budgetSize = 20;
+    std::size_t dim = 3;
+    std::vector<RealVector> points(budgetSize, RealVector(dim));
+    for(std::size_t i = 0; i != budgetSize; ++i)
+        for(std::size_t j = 0; j != dim; ++j)
+            points[i](j) = random::uni(random::globalRng, 0.0, 1.0);
+    // several batches to test the batchwise kernel row
+    Data<RealVector> basis = createDataFromRange(points, 8);
+
+    GaussianRbfKernel<> kernel(0.5);
+    KernelExpansion<RealVector> model(&kernel, basis, false, 2);
+    for(std::size_t i = 0; i != budgetSize - 1; ++i)
+    {
+        model.alpha()(i, 0) = random::uni(random::globalRng, 0.1, 1.0);
+        model.alpha()(i, 1) = -model.alpha()(i, 0);
+    }
+    RealMatrix alpha = model.alpha();
+
+    // brute force search for the best merge partner of the first vector
+    std::size_t firstIndex = 0;
+    double minDegradation = std::numeric_limits<double>::infinity();
+    std::size_t secondIndex = 0;
+    RealVector mergedVector;
+    for(std::size_t j = 1; j != budgetSize; ++j)
+    {
+        double k = kernel(points[firstIndex], points[j]);
+        double a = 0.0;
+        double b = 0.0;
+        for(std::size_t c = 0; c != 2; ++c)
+        {
+            double d = std::min(0.00001, alpha(j, c) + alpha(firstIndex, c));
+            a += alpha(firstIndex, c) / d;
+            b += alpha(j, c) / d;
+        }
+        double bestH = 0;
+        double bestValue = -std::numeric_limits<double>::infinity();
+        for(std::size_t step = 0; step <= 10000; ++step)
+        {
+            double h = step / 10000.0;
+            double value = a * std::pow(k, (1 - h) * (1 - h)) + b * std::pow(k, h * h);
+            if(value > bestValue)
+            {
+                bestValue = value;
+                bestH = h;
+            }
+        }
+        double degradation = 0;
+        for(std::size_t c = 0; c != 2; ++c)
+        {
+            double zAlpha = std::pow(k, (1 - bestH) * (1 - bestH)) * alpha(firstIndex, c) + std::pow(k, bestH * bestH) * alpha(j, c);
+            degradation += sqr(alpha(firstIndex, c)) + sqr(alpha(j, c)) + 2 * k * alpha(firstIndex, c) * alpha(j, c) - zAlpha * zAlpha;
+        }
+        if(degradation < minDegradation)
+        {
+            minDegradation = degradation;
+            secondIndex = j;
+            mergedVector = bestH * points[firstIndex] + (1 - bestH) * points[j];
+        }
+    }
+
+    MergeBudgetMaintenanceStrategy<RealVector> ms;
+    ms.init(model);
+    ms.reduceBudget(model, firstIndex);
+
+    // the last vector is the buffer which is moved to the position of the first
+    std::size_t mergedIndex = secondIndex == budgetSize - 1 ? firstIndex : secondIndex;
+    BOOST_CHECK_SMALL(norm_inf(RealVector(model.basis().element(mergedIndex)) - mergedVector), 1.e-3);
+    BOOST_CHECK_SMALL(norm_inf(row(model.alpha(), budgetSize - 1)), 1.e-15);
+    if(secondIndex != budgetSize - 1)
+        BOOST_CHECK_SMALL(norm_inf(RealVector(model.basis().element(firstIndex)) - points[budgetSize - 1]), 1.e-15);
+}
+
+
+// all merge partners have alphas of opposite sign, thus the best merge lies outside of the segment between both vectors
+BOOST_AUTO_TEST_CASE( MergeBudgetMaintenanceStrategy_reduceBudget_MixedSigns)
+{
+    random::globalRng.seed(42);
+    std::size_t budgetSize = 20;
+    std::size_t dim = 3;
+    std::vector<RealVector> points(budgetSize, RealVector(dim));
+    for(std::size_t i = 0; i != budgetSize; ++i)
+        for(std::size_t j = 0; j != dim; ++j)
+            points[i](j) = random::uni(random::globalRng, 0.0, 1.0);
+    Data<RealVector> basis = createDataFromRange(points, 8);
+
+    GaussianRbfKernel<> kernel(5.0);
+    KernelExpansion<RealVector> model(&kernel, basis, false, 1);
+    // the buffer vector gets a weight as well, otherwise it would be the trivial best merge
+    for(std::size_t i = 0; i != budgetSize; ++i)
+    {
+        model.alpha()(i, 0) = random::uni(random::globalRng, 0.1, 1.0);
+        if(i != 0)
+            model.alpha()(i, 0) *= -1;
+    }
+    RealVector alpha = column(model.alpha(), 0);
+
+    // brute force search on a grid which covers the optima outside of [0,1]
+    std::size_t firstIndex = 0;
+    double minDegradation = std::numeric_limits<double>::infinity();
+    std::size_t secondIndex = 0;
+    RealVector mergedVector;
+    for(std::size_t j = 1; j != budgetSize; ++j)
+    {
+        double k = kernel(points[firstIndex], points[j]);
+        double d = std::min(0.00001, alpha(j) + alpha(firstIndex));
+        double a = alpha(firstIndex) / d;
+        double b = alpha(j) / d;
+        double bestH = 0;
+        double bestValue = -std::numeric_limits<double>::infinity();
+        for(std::size_t step = 0; step <= 400000; ++step)
+        {
+            double h = -20.0 + step / 10000.0;
+            double value = a * std::pow(k, (1 - h) * (1 - h)) + b * std::pow(k, h * h);
+            if(value > bestValue)
+            {
+                bestValue = value;
+                bestH = h;
+            }
+        }
+        double zAlpha = std::pow(k, (1 - bestH) * (1 - bestH)) * alpha(firstIndex) + std::pow(k, bestH * bestH) * alpha(j);
+        double degradation = sqr(alpha(firstIndex)) + sqr(alpha(j)) + 2 * k * alpha(firstIndex) * alpha(j) - zAlpha * zAlpha;
+        if(degradation < minDegradation)
+        {
+            minDegradation = degradation;
+            secondIndex = j;
+            mergedVector = bestH * points[firstIndex] + (1 - bestH) * points[j];
+        }
+    }
+
+    MergeBudgetMaintenanceStrategy<RealVector> ms;
+    ms.init(model);
+    ms.reduceBudget(model, firstIndex);
+
+    std::size_t mergedIndex = secondIndex == budgetSize - 1 ? firstIndex : secondIndex;
+    BOOST_CHECK_SMALL(norm_inf(RealVector(model.basis().element(mergedIndex)) - mergedVector), 1.e-3);
 }
 
 
@@ -37,6 +37,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/Algorithms/Trainers/CSvmTrainer.h>
+#include <shark/Algorithms/QP/SvmProblems.h>
 #include <shark/Models/Kernels/LinearKernel.h>
 #include <shark/Models/Kernels/GaussianRbfKernel.h>
 #include <shark/Data/DataDistribution.h>
@@ -333,4 +334,88 @@ BOOST_AUTO_TEST_CASE( CSVM_WEIGHTED_TEST )
 }
 
 
+//the violating pair found during the gradient update must be the one of a full search,
+//also after shrinking and for problems large enough to be split between threads
+BOOST_AUTO_TEST_CASE( CSVM_MAXIMAL_VIOLATING_PAIR )
+{
+	typedef KernelMatrix<RealVector, float> KernelMatrixType;
+	typedef CachedMatrix<KernelMatrixType> MatrixType;
+	typedef GeneralQuadraticProblem<MatrixType> SvmProblemType;
+	typedef SvmShrinkingProblem<SvmProblemType> ProblemType;
+
+	std::size_t sizes[] = {500, 70000};
+	for(std::size_t n: sizes){
+		Chessboard chessboard;
+		ClassificationDataset dataset = chessboard.generateDataset(n);
+		GaussianRbfKernel<> kernel(1.0);
+		KernelMatrixType km(kernel, dataset.inputs());
+		MatrixType matrix(&km);
+		Data<double> weights(n, 1.0);
+		SvmProblemType svmProblem(matrix, dataset.labels(), weights, RealVector(1, 1.0));
+		ProblemType problem(svmProblem, true);
+
+		LibSVMSelectionCriterion selection;
+		for(std::size_t iter = 0; iter != 100; ++iter){
+			std::size_t i = 0, j = 0;
+			selection(problem, i, j);
+			problem.updateSMO(i, j);
+			if(iter % 25 == 24)
+				problem.shrink(1.e-3);
+
+			double largestUp = -1e100;
+			double smallestDown = 1e100;
+			std::size_t up = 0, down = 0;
+			for(std::size_t a = 0; a != problem.active(); ++a){
+				if(!problem.isUpperBound(a) && problem.gradient(a) > largestUp){
+					largestUp = problem.gradient(a);
+					up = a;
+				}
+				if(!problem.isLowerBound(a) && problem.gradient(a) < smallestDown){
+					smallestDown = problem.gradient(a);
+					down = a;
+				}
+			}
+			detail::ViolatingPair const& pair = problem.maximalViolatingPair();
+			BOOST_REQUIRE_EQUAL(pair.up, up);
+			BOOST_REQUIRE_EQUAL(pair.down, down);
+			BOOST_REQUIRE_EQUAL(pair.largestUp, largestUp);
+			BOOST_REQUIRE_EQUAL(pair.smallestDown, smallestDown);
+		}
+	}
+}
+
+//every point of the warm started path must have the same objective value as training from scratch
+BOOST_AUTO_TEST_CASE( CSVM_REGULARIZATION_PATH )
+{
+	Chessboard chessboard;
+	ClassificationDataset dataset = chessboard.generateDataset(200);
+	GaussianRbfKernel<> kernel(1.0);
+	std::vector<double> C = {0.1, 1.0, 1.0, 10.0, 100.0};
+	std::vector<RealVector> kernelParameters = {RealVector(1, 0.5), RealVector(1, 1.0)};
+
+	for(bool offset: {true, false}){
+		CSvmTrainer<RealVector, double> trainer(&kernel, 1.0, offset);
+		trainer.stoppingCondition().minAccuracy = 1e-8;
+		auto path = trainer.trainPath(dataset, C, kernelParameters);
+		BOOST_REQUIRE_EQUAL(path.size(), C.size() * kernelParameters.size());
+		BOOST_CHECK_EQUAL(trainer.C(), 1.0);
+		BOOST_CHECK_EQUAL(kernel.gamma(), 1.0);
+
+		for(std::size_t p = 0; p != path.size(); ++p){
+			BOOST_CHECK_EQUAL(path[p].C, C[p % C.size()]);
+			kernel.setParameterVector(kernelParameters[p / C.size()]);
+			CSvmTrainer<RealVector, double> coldTrainer(&kernel, path[p].C, offset);
+			coldTrainer.stoppingCondition().minAccuracy = 1e-8;
+			KernelClassifier<RealVector> svm;
+			coldTrainer.train(svm, dataset);
+			double value = coldTrainer.solutionProperties().value;
+			BOOST_CHECK_CLOSE(path[p].properties.value, value, 1.e-4);
+			if(offset)
+				BOOST_CHECK_SMALL(path[p].offset - svm.decisionFunction().offset(0), 1.e-4);
+		}
+		kernel.setGamma(1.0);
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
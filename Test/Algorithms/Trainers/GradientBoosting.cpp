@@ -0,0 +1,193 @@
+#define BOOST_TEST_MODULE TRAINERS_GRADIENTBOOSTING
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/GradientBoostingTrainer.h>
+#include <shark/Algorithms/StoppingCriteria/MaxIterations.h>
+#include <shark/Algorithms/StoppingCriteria/GeneralizationLoss.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
+#include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Core/Random.h>
+
+#include <sstream>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_GradientBoosting)
+
+// the label depends non-linearly on the first two of five inputs
+class RegressionProblem : public LabeledDataDistribution<RealVector, RealVector>
+{
+public:
+	RegressionProblem(double noise):m_noise(noise){}
+	void draw(RealVector& input, RealVector& label) const
+	{
+		input.resize(5);
+		label.resize(1);
+		for (std::size_t i = 0; i != 5; i++) input(i) = random::uni(random::globalRng, -2, 2);
+		label(0) = std::sin(input(0)) + 0.5 * input(1) * input(1) + random::gauss(random::globalRng, 0, m_noise);
+	}
+private:
+	double m_noise;
+};
+
+// three classes, separated by the sign of the first input and the second input
+class ClassificationProblem : public LabeledDataDistribution<RealVector, unsigned int>
+{
+public:
+	void draw(RealVector& input, unsigned int& label) const
+	{
+		input.resize(4);
+		for (std::size_t i = 0; i != 4; i++) input(i) = random::uni(random::globalRng, -1, 1);
+		label = input(0) < 0? 0: (input(1) < 0? 1: 2);
+	}
+};
+
+// cross entropy without second derivative, the trainer estimates the Hessian by differences
+class FirstOrderCrossEntropy : public AbstractLoss<unsigned int, RealVector>
+{
+public:
+	FirstOrderCrossEntropy(){
+		m_features |= HAS_FIRST_DERIVATIVE;
+	}
+	std::string name() const
+	{ return "FirstOrderCrossEntropy"; }
+
+	using AbstractLoss<unsigned int, RealVector>::eval;
+	double eval(UIntVector const& labels, RealMatrix const& predictions) const{
+		return m_loss.eval(labels, predictions);
+	}
+	double evalDerivative(UIntVector const& labels, RealMatrix const& predictions, RealMatrix& gradient) const{
+		return m_loss.evalDerivative(labels, predictions, gradient);
+	}
+private:
+	CrossEntropy m_loss;
+};
+
+BOOST_AUTO_TEST_CASE(GradientBoosting_Regression)
+{
+	random::globalRng.seed(42);
+	RegressionProblem problem(0.0);
+	LabeledData<RealVector, RealVector> train = problem.generateDataset(1000);
+	LabeledData<RealVector, RealVector> test = problem.generateDataset(500);
+
+	SquaredLoss<> loss;
+	GradientBoostingTrainer<RealVector> trainer(&loss);
+	trainer.setNumberOfRounds(200);
+	trainer.setMaxDepth(4);
+	GradientBoostedTrees model;
+	trainer.train(model, train);
+	BOOST_CHECK_EQUAL(model.numberOfTrees(), 200);
+	BOOST_CHECK_EQUAL(model.inputShape().numElements(), 5);
+	BOOST_CHECK_EQUAL(model.outputShape().numElements(), 1);
+
+	//the offset is the mean of the labels and the trees improve on it by far
+	RealVector mean(1, 0.0);
+	for(auto const& label: train.labels().elements())
+		mean += label / 1000.0;
+	BOOST_CHECK_SMALL(model.offset()(0) - mean(0), 1.e-6);
+	double error = loss(test.labels(), model(test.inputs()));
+	GradientBoostedTrees constant(5, model.offset());
+	double constantError = loss(test.labels(), constant(test.inputs()));
+	BOOST_CHECK_LT(error, 0.02 * constantError);
+
+	//the batched prediction is the sum of the single trees
+	RealMatrix inputs = test.inputs().batch(0);
+	RealMatrix predictions = model(inputs);
+	for(std::size_t i = 0; i != inputs.size1(); ++i){
+		double prediction = model.offset()(0);
+		for(std::size_t t = 0; t != model.numberOfTrees(); ++t)
+			prediction += model.tree(t)(RealVector(row(inputs, i)))(0);
+		BOOST_CHECK_CLOSE(predictions(i, 0), prediction, 1.e-10);
+	}
+
+	//serialization
+	std::ostringstream outputStream;
+	{
+		TextOutArchive oa(outputStream);
+		oa << model;
+	}
+	GradientBoostedTrees modelDeserialized;
+	std::istringstream inputStream(outputStream.str());
+	TextInArchive ia(inputStream);
+	ia >> modelDeserialized;
+	BOOST_REQUIRE_EQUAL(modelDeserialized.numberOfTrees(), model.numberOfTrees());
+	RealMatrix predictionsDeserialized = modelDeserialized(inputs);
+	for(std::size_t i = 0; i != inputs.size1(); ++i)
+		BOOST_CHECK_EQUAL(predictions(i, 0), predictionsDeserialized(i, 0));
+}
+
+BOOST_AUTO_TEST_CASE(GradientBoosting_Classification)
+{
+	random::globalRng.seed(42);
+	ClassificationProblem problem;
+	LabeledData<RealVector, unsigned int> train = problem.generateDataset(1000);
+	LabeledData<RealVector, unsigned int> test = problem.generateDataset(500);
+
+	CrossEntropy loss;
+	ZeroOneLoss<> zeroOne;
+	GradientBoostingTrainer<unsigned int> trainer(&loss);
+	trainer.setNumberOfRounds(50);
+	trainer.setSubsample(0.5);
+	trainer.setFeatureFraction(0.5);
+	Classifier<GradientBoostedTrees> model;
+	trainer.train(model, train);
+	BOOST_CHECK_EQUAL(model.decisionFunction().outputShape().numElements(), 3);
+	BOOST_CHECK_LT(zeroOne(test.labels(), model(test.inputs())), 0.03);
+
+	//two classes use a single output
+	for(auto& label: train.labels().elements())
+		label = label > 0;
+	for(auto& label: test.labels().elements())
+		label = label > 0;
+	trainer.train(model, train);
+	BOOST_CHECK_EQUAL(model.decisionFunction().outputShape().numElements(), 1);
+	BOOST_CHECK_LT(zeroOne(test.labels(), model(test.inputs())), 0.03);
+
+	//without second derivative of the loss the Hessian is estimated
+	FirstOrderCrossEntropy firstOrderLoss;
+	BOOST_REQUIRE(!firstOrderLoss.hasSecondDerivative());
+	GradientBoostingTrainer<unsigned int> firstOrderTrainer(&firstOrderLoss);
+	firstOrderTrainer.setNumberOfRounds(50);
+	Classifier<GradientBoostedTrees> firstOrderModel;
+	firstOrderTrainer.train(firstOrderModel, train);
+	BOOST_CHECK_LT(zeroOne(test.labels(), firstOrderModel(test.inputs())), 0.03);
+}
+
+BOOST_AUTO_TEST_CASE(GradientBoosting_EarlyStopping)
+{
+	random::globalRng.seed(42);
+	RegressionProblem problem(1.0);
+	LabeledData<RealVector, RealVector> train = problem.generateDataset(300);
+	LabeledData<RealVector, RealVector> validation = problem.generateDataset(300);
+
+	SquaredLoss<> loss;
+	GradientBoostingTrainer<RealVector> trainer(&loss);
+	trainer.setNumberOfRounds(500);
+	trainer.setLearningRate(0.3);
+	GradientBoostedTrees model;
+
+	//stopping on the training loss
+	MaxIterations<> maxIterations(20);
+	trainer.setStoppingCriterion(&maxIterations);
+	trainer.train(model, train);
+	BOOST_CHECK_EQUAL(model.numberOfTrees(), 20);
+
+	//stopping on the validation loss keeps the best model
+	trainer.setStoppingCriterion(nullptr);
+	GeneralizationLoss<> generalizationLoss(1.0);
+	trainer.setValidationStoppingCriterion(validation, &generalizationLoss);
+	trainer.train(model, train);
+	std::size_t trees = model.numberOfTrees();
+	BOOST_CHECK_GT(trees, 0);
+	BOOST_CHECK_LT(trees, 500);
+	double best = loss(validation.labels(), model(validation.inputs()));
+	//fewer trees are worse on the validation set
+	GradientBoostedTrees truncated = model;
+	truncated.truncate(trees - 1);
+	BOOST_CHECK_GT(loss(validation.labels(), truncated(validation.inputs())), best);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
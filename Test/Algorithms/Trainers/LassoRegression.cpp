@@ -58,4 +58,86 @@ BOOST_AUTO_TEST_CASE(LassoRegression_TEST)
 	}
 }
 
+// sparse regression problem with many irrelevant and some correlated features
+LabeledData<RealVector, RealVector> createSparseProblem(std::size_t n, std::size_t dim){
+	std::vector<RealVector> inputs(n, RealVector(dim, 0.0));
+	std::vector<RealVector> labels(n, RealVector(1));
+	for (std::size_t i=0; i<n; i++){
+		for (std::size_t j=0; j<dim; j++){
+			if (random::coinToss(random::globalRng, 0.3))
+				inputs[i](j) = random::gauss(random::globalRng);
+		}
+		inputs[i](1) += 0.5 * inputs[i](0);
+		labels[i](0) = 2 * inputs[i](0) - inputs[i](1) + 0.5 * inputs[i](7) + 0.1 * random::gauss(random::globalRng);
+	}
+	return createLabeledDataFromRange(inputs, labels);
+}
+
+RealVector weights(LassoRegression<RealVector>& trainer, LabeledData<RealVector, RealVector> const& data){
+	LinearModel<RealVector> model;
+	trainer.train(model, data);
+	return row(model.matrix(), 0);
+}
+
+// screening, paths and parallel updates must not change the solution
+BOOST_AUTO_TEST_CASE(LassoRegression_Screening_Path)
+{
+	random::globalRng.seed(42);
+	LabeledData<RealVector, RealVector> data = createSparseProblem(300, 50);
+	double accuracy = 1e-8;
+	LassoRegression<RealVector> trainer(1.0, accuracy);
+	double lambdaMax = trainer.maxLambda(data);
+	std::vector<double> lambdas;
+	for (double lambda = lambdaMax; lambda > 0.01 * lambdaMax; lambda *= 0.7)
+		lambdas.push_back(lambda);
+
+	BOOST_CHECK(!trainer.screening());
+	trainer.setScreening(true);
+	std::vector<LassoRegression<RealVector>::PathPoint> path = trainer.trainPath(data, lambdas);
+	BOOST_REQUIRE_EQUAL(path.size(), lambdas.size());
+	BOOST_CHECK_SMALL(norm_inf(path[0].w), 1e-12);
+	BOOST_CHECK(path.back().activeFeatures < 50);
+
+	for (std::size_t k=0; k<lambdas.size(); k++)
+	{
+		trainer.setLambda(lambdas[k]);
+		trainer.setScreening(false);
+		trainer.setParallelUpdates(1);
+		RealVector reference = weights(trainer, data);
+		trainer.setScreening(true);
+		RealVector screened = weights(trainer, data);
+		trainer.setParallelUpdates(4);
+		RealVector parallel = weights(trainer, data);
+
+		BOOST_CHECK_SMALL(norm_inf(reference - screened), 1e-6);
+		BOOST_CHECK_SMALL(norm_inf(reference - parallel), 1e-6);
+		BOOST_CHECK_SMALL(norm_inf(reference - path[k].w), 1e-6);
+	}
+}
+
+// sparse inputs are handled through the compressed column-wise copy
+BOOST_AUTO_TEST_CASE(LassoRegression_Sparse)
+{
+	random::globalRng.seed(42);
+	LabeledData<RealVector, RealVector> data = createSparseProblem(200, 30);
+	std::vector<CompressedRealVector> sparseInputs;
+	for (RealVector const& x: data.inputs().elements()){
+		CompressedRealVector v(x.size());
+		for (std::size_t j=0; j<x.size(); j++){
+			if (x(j) != 0.0) v.set_element(v.end(), j, x(j));
+		}
+		sparseInputs.push_back(v);
+	}
+	std::vector<RealVector> labels(data.labels().elements().begin(), data.labels().elements().end());
+	LabeledData<CompressedRealVector, RealVector> sparseData = createLabeledDataFromRange(sparseInputs, labels);
+
+	LassoRegression<RealVector> denseTrainer(2.0, 1e-8);
+	LassoRegression<CompressedRealVector> sparseTrainer(2.0, 1e-8);
+	LinearModel<CompressedRealVector> sparseModel;
+	sparseTrainer.train(sparseModel, sparseData);
+	RealVector dense = weights(denseTrainer, data);
+	RealVector sparse = row(sparseModel.matrix(), 0);
+	BOOST_CHECK_SMALL(norm_inf(dense - sparse), 1e-6);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
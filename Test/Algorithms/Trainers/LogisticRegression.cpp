@@ -200,4 +200,66 @@ BOOST_AUTO_TEST_CASE( LogReg_Binary_Lone_Weighted){
 }
 
 
+BOOST_AUTO_TEST_CASE( LogReg_Binary_TrustRegionNewton){
+	random::globalRng.seed(42);
+	PamiToy problem;
+	ClassificationDataset const& dataset = problem.generateDataset(50);
+	
+	LogisticRegression<> trainer(0,0.1);
+	BOOST_CHECK_EQUAL(trainer.solver(), LogisticRegression<>::LBFGSSolver);
+	LogisticRegression<>::ModelType lbfgsModel;
+	trainer.train(lbfgsModel,dataset);
+	
+	trainer.setSolver(LogisticRegression<>::TrustRegionNewtonSolver);
+	BOOST_CHECK_EQUAL(trainer.solver(), LogisticRegression<>::TrustRegionNewtonSolver);
+	LogisticRegression<>::ModelType model;
+	trainer.train(model,dataset);
+	
+	BOOST_CHECK_EQUAL(model.numberOfParameters(),11);
+	BOOST_CHECK_SMALL(norm_inf(model.parameterVector() - lbfgsModel.parameterVector()),1.e-6);
+	
+	//check gradient
+	{
+		CrossEntropy loss;
+		ErrorFunction error(dataset, &model.decisionFunction(),&loss);
+		RealVector derivative;
+		error.evalDerivative(model.parameterVector(),derivative);
+		RealVector penalty = 0.1 * model.parameterVector();
+		penalty(10) = 0;
+		BOOST_CHECK_SMALL(norm_inf(derivative+penalty),1.e-8);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( LogReg_MultiClass_NoLone){
+	random::globalRng.seed(42);
+	//three gaussian clusters in 5 dimensions
+	std::vector<RealVector> inputs(150, RealVector(5));
+	std::vector<unsigned int> labels(150);
+	for(std::size_t i = 0; i != 150; ++i){
+		labels[i] = i % 3;
+		for(std::size_t j = 0; j != 5; ++j)
+			inputs[i](j) = random::gauss(random::globalRng, 0, 1) + (j == labels[i]? 1.0 : 0.0);
+	}
+	ClassificationDataset dataset = createLabeledDataFromRange(inputs, labels, 32);
+	
+	for(auto solver: {LogisticRegression<>::LBFGSSolver, LogisticRegression<>::TrustRegionNewtonSolver}){
+		LogisticRegression<> trainer(0,0.1);
+		trainer.setSolver(solver);
+		LogisticRegression<>::ModelType model;
+		trainer.train(model,dataset);
+		
+		BOOST_CHECK_EQUAL(model.numberOfParameters(),18);
+		
+		//check gradient
+		CrossEntropy loss;
+		ErrorFunction error(dataset, &model.decisionFunction(),&loss);
+		RealVector derivative;
+		error.evalDerivative(model.parameterVector(),derivative);
+		RealVector penalty = 0.1 * model.parameterVector();
+		subrange(penalty,15,18).clear();
+		BOOST_CHECK_SMALL(norm_inf(derivative+penalty),1.e-8);
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,187 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       test case for the MinibatchTrainer
+ * 
+ * 
+ * 
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define BOOST_TEST_MODULE ALGORITHMS_TRAINERS_MINIBATCHTRAINER
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/MinibatchTrainer.h>
+#include <shark/Algorithms/Trainers/LinearRegression.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Models/LinearModel.h>
+
+using namespace shark;
+
+//linear regression problem with noise, the optimal weights are computed by LinearRegression
+RegressionDataset createProblem(std::size_t numPoints){
+	std::size_t inputDim = 5;
+	std::size_t outputDim = 2;
+	RealMatrix A(outputDim, inputDim);
+	RealVector b(outputDim);
+	for(std::size_t i = 0; i != outputDim; ++i){
+		b(i) = random::gauss(random::globalRng, 0, 1);
+		for(std::size_t j = 0; j != inputDim; ++j)
+			A(i,j) = random::gauss(random::globalRng, 0, 1);
+	}
+	std::vector<RealVector> inputs(numPoints, RealVector(inputDim));
+	std::vector<RealVector> labels(numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		for(std::size_t j = 0; j != inputDim; ++j)
+			inputs[i](j) = random::gauss(random::globalRng, 0, 1);
+		labels[i] = prod(A,inputs[i]) + b;
+		for(std::size_t j = 0; j != outputDim; ++j)
+			labels[i](j) += random::gauss(random::globalRng, 0, 0.01);
+	}
+	return createLabeledDataFromRange(inputs, labels, 100);
+}
+
+void testTrainer(MinibatchUpdate update, double learningRate, std::size_t batchSize, bool prefetch){
+	random::globalRng.seed(42);
+	RegressionDataset data = createProblem(1000);
+	LinearModel<> optimalModel;
+	LinearRegression regression;
+	regression.train(optimalModel, data);
+
+	SquaredLoss<> loss;
+	LinearModel<> model(inputDimension(data), labelDimension(data), true);
+	MinibatchTrainer<LinearModel<> > trainer(&loss, update);
+	trainer.setLearningRate(learningRate);
+	trainer.setEpochs(100);
+	trainer.setBatchSize(batchSize);
+	trainer.setPrefetch(prefetch);
+	BOOST_CHECK(trainer.update() == update);
+	BOOST_CHECK_EQUAL(trainer.batchSize(), batchSize);
+	trainer.train(model, data);
+
+	//the remaining stochastic noise of the steps is small compared to the weights
+	double distance = norm_inf(model.parameterVector() - optimalModel.parameterVector());
+	BOOST_CHECK_SMALL(distance, 0.05);
+	double optimalError = loss(data.labels(), optimalModel(data.inputs()));
+	BOOST_CHECK_LT(trainer.trainingError(), 1.2 * optimalError);
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_MinibatchTrainer)
+
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_SGD ){
+	testTrainer(MinibatchUpdate::SGD, 0.01, 0, true);
+	testTrainer(MinibatchUpdate::SGD, 0.01, 32, true);
+}
+
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_Adam ){
+	testTrainer(MinibatchUpdate::Adam, 0.01, 0, true);
+	testTrainer(MinibatchUpdate::Adam, 0.01, 32, true);
+	testTrainer(MinibatchUpdate::Adam, 0.01, 32, false);
+}
+
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_AdamW ){
+	testTrainer(MinibatchUpdate::AdamW, 0.01, 32, true);
+}
+
+//with weight decay, AdamW converges to parameters shrunk towards zero while SGD
+//with decoupled weight decay converges to the minimum of the penalized loss
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_WeightDecay ){
+	random::globalRng.seed(42);
+	RegressionDataset data = createProblem(1000);
+	LinearModel<> optimalModel;
+	LinearRegression regression;
+	regression.train(optimalModel, data);
+
+	SquaredLoss<> loss;
+	MinibatchUpdate updates[] = {MinibatchUpdate::SGD, MinibatchUpdate::Adam, MinibatchUpdate::AdamW};
+	for(MinibatchUpdate update: updates){
+		LinearModel<> model(inputDimension(data), labelDimension(data), true);
+		MinibatchTrainer<LinearModel<> > trainer(&loss, update);
+		trainer.setLearningRate(0.01);
+		trainer.setWeightDecay(0.1);
+		trainer.setEpochs(20);
+		trainer.setBatchSize(32);
+		trainer.train(model, data);
+		BOOST_CHECK_LT(norm_2(model.parameterVector()), norm_2(optimalModel.parameterVector()));
+	}
+}
+
+//prefetching only moves the assembly of the minibatches to another thread, the result is the same
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_Prefetch ){
+	random::globalRng.seed(42);
+	RegressionDataset data = createProblem(1000);
+	SquaredLoss<> loss;
+	RealVector parameters[2];
+	for(std::size_t i = 0; i != 2; ++i){
+		LinearModel<> model(inputDimension(data), labelDimension(data), true);
+		MinibatchTrainer<LinearModel<> > trainer(&loss, MinibatchUpdate::Adam);
+		trainer.setEpochs(5);
+		trainer.setBatchSize(33);
+		trainer.setPrefetch(i == 0);
+		random::globalRng.seed(17);
+		trainer.train(model, data);
+		parameters[i] = model.parameterVector();
+	}
+	BOOST_CHECK_EQUAL(norm_inf(parameters[0] - parameters[1]), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( MinibatchTrainer_Serialization ){
+	SquaredLoss<> loss;
+	MinibatchTrainer<LinearModel<> > trainer(&loss, MinibatchUpdate::SGD);
+	trainer.setLearningRate(0.05);
+	trainer.setMomentum(0.5);
+	trainer.setBeta1(0.8);
+	trainer.setBeta2(0.99);
+	trainer.setEpsilon(1.e-6);
+	trainer.setWeightDecay(0.01);
+	trainer.setEpochs(7);
+	trainer.setBatchSize(64);
+	trainer.setPrefetch(false);
+
+	std::ostringstream outputStream;
+	{
+		TextOutArchive oa(outputStream);
+		oa << const_cast<MinibatchTrainer<LinearModel<> > const&>(trainer);
+	}
+	MinibatchTrainer<LinearModel<> > deserialized(&loss);
+	std::istringstream inputStream(outputStream.str());
+	TextInArchive ia(inputStream);
+	ia >> deserialized;
+	BOOST_CHECK(deserialized.update() == MinibatchUpdate::SGD);
+	BOOST_CHECK_EQUAL(deserialized.learningRate(), 0.05);
+	BOOST_CHECK_EQUAL(deserialized.momentum(), 0.5);
+	BOOST_CHECK_EQUAL(deserialized.beta1(), 0.8);
+	BOOST_CHECK_EQUAL(deserialized.beta2(), 0.99);
+	BOOST_CHECK_EQUAL(deserialized.epsilon(), 1.e-6);
+	BOOST_CHECK_EQUAL(deserialized.weightDecay(), 0.01);
+	BOOST_CHECK_EQUAL(deserialized.epochs(), 7);
+	BOOST_CHECK_EQUAL(deserialized.batchSize(), 64);
+	BOOST_CHECK(!deserialized.prefetch());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
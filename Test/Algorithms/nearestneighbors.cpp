@@ -42,7 +42,9 @@
 #include <shark/Models/Trees/KDTree.h>
 #include <shark/Models/Trees/LCTree.h>
 #include <shark/Models/Trees/KHCTree.h>
+#include <shark/Models/Trees/CompactTree.h>
 #include <shark/Algorithms/NearestNeighbors/TreeNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/CompactTreeNearestNeighbors.h>
 #include <shark/Core/Random.h>
 #include <shark/Core/Timer.h>
 
@@ -201,4 +203,120 @@ BOOST_AUTO_TEST_CASE(IterativeNearestNeighborQueries)
 	}
 }
 
+//compare the neighbors of the compact tree against the iterative query on the reference tree
+template<class Tree>
+void testCompactTree(
+	CompactTree const& compactTree, Tree const& tree, std::vector<RealVector> const& data,
+	RealVector const& test, std::size_t k
+){
+	std::vector<CompactTree::DistancePair> neighbors = compactTree.nearestNeighbors(test, k);
+	BOOST_REQUIRE_EQUAL(neighbors.size(), k);
+	IterativeNNQuery<std::vector<RealVector> > query(&tree, data, test);
+	for(std::size_t i = 0; i != k; ++i){
+		std::pair<double,std::size_t> ret = query.next();
+		BOOST_CHECK_SMALL(neighbors[i].key - ret.first, 1.e-12);
+		BOOST_CHECK_SMALL(distance(data[neighbors[i].value], test) - neighbors[i].key, 1.e-12);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CompactTree_Structure)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> data(1000, RealVector(3));
+	for(auto& point: data){
+		for(auto& x: point)
+			x = random::gauss(random::globalRng);
+	}
+	UnlabeledData<RealVector> dataset = createDataFromRange(data, 100);
+
+	for(auto rule: {CompactTree::KDSplit, CompactTree::LinearCutSplit}){
+		CompactTree tree(dataset, rule, TreeConstruction(0, 10));
+		BOOST_CHECK_EQUAL(tree.size(), 1000);
+		BOOST_CHECK_EQUAL(tree.depth(), 7);
+		BOOST_CHECK_EQUAL(tree.nodes(), 255);
+		//the points are a permutation of the data
+		std::vector<std::size_t> indices(1000);
+		for(std::size_t i = 0; i != 1000; ++i){
+			indices[i] = tree.index(i);
+			BOOST_CHECK_SMALL(norm_inf(row(tree.points(), i) - data[tree.index(i)]), 1.e-15);
+		}
+		std::sort(indices.begin(), indices.end());
+		for(std::size_t i = 0; i != 1000; ++i)
+			BOOST_CHECK_EQUAL(indices[i], i);
+		//the children partition the points of the node along the split
+		for(std::size_t node = 0; node != tree.nodes(); ++node){
+			if(tree.isLeaf(node)){
+				BOOST_CHECK_LE(tree.end(node) - tree.begin(node), 10);
+				continue;
+			}
+			BOOST_CHECK_EQUAL(tree.parent(tree.left(node)), node);
+			BOOST_CHECK_EQUAL(tree.parent(tree.right(node)), node);
+			BOOST_CHECK_EQUAL(tree.begin(tree.left(node)), tree.begin(node));
+			BOOST_CHECK_EQUAL(tree.end(tree.left(node)), tree.begin(tree.right(node)));
+			BOOST_CHECK_EQUAL(tree.end(tree.right(node)), tree.end(node));
+			for(std::size_t i = tree.begin(tree.left(node)); i != tree.end(tree.left(node)); ++i)
+				BOOST_CHECK_LE(tree.distanceFromPlane(node, row(tree.points(), i)), 0.0);
+			for(std::size_t i = tree.begin(tree.right(node)); i != tree.end(tree.right(node)); ++i)
+				BOOST_CHECK_GE(tree.distanceFromPlane(node, row(tree.points(), i)), 0.0);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CompactTree_Queries)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> data(20000, RealVector(3));
+	for(std::size_t i = 0; i != data.size(); ++i){
+		for(auto& x: data[i])
+			x = i < 5 ? 0.0: random::gauss(random::globalRng);//multiple instances of the same point
+	}
+	std::vector<RealVector> test(10, RealVector(3));
+	for(auto& point: test){
+		for(auto& x: point)
+			x = random::gauss(random::globalRng);
+	}
+	test[0].clear();//(0,0,0)
+	UnlabeledData<RealVector> dataset = createDataFromRange(data);
+
+	//the LCTree can not split duplicate points, the neighbors of the KDTree are the reference for both rules
+	KDTree<RealVector> kdtree(dataset);
+	for(std::size_t bucketSize: {1, 16}){
+		CompactTree compactKD(dataset, CompactTree::KDSplit, TreeConstruction(0, bucketSize));
+		CompactTree compactLC(dataset, CompactTree::LinearCutSplit, TreeConstruction(0, bucketSize));
+		for(std::size_t k = 0; k != test.size(); ++k){
+			testCompactTree(compactKD, kdtree, data, test[k], 100);
+			testCompactTree(compactLC, kdtree, data, test[k], 100);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(CompactTree_NearestNeighbors)
+{
+	random::globalRng.seed(42);
+	std::vector<RealVector> inputs(5000, RealVector(2));
+	std::vector<unsigned int> labels(5000);
+	for(std::size_t i = 0; i != inputs.size(); ++i){
+		inputs[i](0) = random::uni(random::globalRng, -1, 1);
+		inputs[i](1) = random::uni(random::globalRng, -1, 1);
+		labels[i] = inputs[i](0) * inputs[i](1) > 0;
+	}
+	ClassificationDataset dataset = createLabeledDataFromRange(inputs, labels);
+	KDTree<RealVector> kdtree(dataset.inputs());
+	TreeNearestNeighbors<RealVector, unsigned int> reference(dataset, &kdtree);
+	CompactTreeNearestNeighbors<unsigned int> algorithm(dataset);
+
+	RealMatrix queries(100, 2);
+	for(std::size_t i = 0; i != 100; ++i){
+		queries(i,0) = random::uni(random::globalRng, -1, 1);
+		queries(i,1) = random::uni(random::globalRng, -1, 1);
+	}
+	auto neighbors = algorithm.getNeighbors(queries, 10);
+	auto referenceNeighbors = reference.getNeighbors(queries, 10);
+	BOOST_REQUIRE_EQUAL(neighbors.size(), referenceNeighbors.size());
+	for(std::size_t i = 0; i != neighbors.size(); ++i){
+		BOOST_CHECK_SMALL(neighbors[i].key - referenceNeighbors[i].key, 1.e-12);
+		BOOST_CHECK_EQUAL(neighbors[i].value, referenceNeighbors[i].value);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
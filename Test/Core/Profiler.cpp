@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE Core_Profiler
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Core/Profiler.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/LinAlg/Base.h>
+
+#include <sstream>
+
+using namespace shark;
+using namespace shark::profiling;
+
+BOOST_AUTO_TEST_SUITE (Core_Profiler)
+
+BOOST_AUTO_TEST_CASE( Profiler_Hierarchy )
+{
+	Profiler::instance().reset();
+	for(std::size_t i = 0; i != 3; ++i){
+		ScopedRegion outer("outer");
+		addCounter("evaluations", 2);
+		for(std::size_t j = 0; j != 4; ++j){
+			ScopedRegion inner("inner");
+			addCounter("bytes", 10);
+		}
+	}
+	ProfileNode root = Profiler::instance().summary();
+	ProfileNode const* outer = root.findChild("outer");
+	BOOST_REQUIRE(outer != nullptr);
+	BOOST_CHECK(root.findChild("inner") == nullptr);
+	BOOST_CHECK_EQUAL(outer->calls, 3u);
+	BOOST_CHECK_EQUAL(outer->counter("evaluations"), 6.0);
+	BOOST_CHECK_EQUAL(outer->counter("bytes"), 0.0);
+	ProfileNode const* inner = outer->findChild("inner");
+	BOOST_REQUIRE(inner != nullptr);
+	BOOST_CHECK_EQUAL(inner->calls, 12u);
+	BOOST_CHECK_EQUAL(inner->counter("bytes"), 120.0);
+	BOOST_CHECK(inner->seconds >= 0.0);
+	BOOST_CHECK(outer->seconds >= inner->seconds);
+
+	std::ostringstream json;
+	Profiler::instance().writeJSON(json);
+	BOOST_CHECK(json.str().find("\"name\":\"inner\",\"calls\":12") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_Threads )
+{
+	Profiler::instance().reset();
+	SHARK_PARALLEL_FOR(int i = 0; i < 100; ++i){
+		ScopedRegion region("parallel");
+		addCounter("items", 1);
+	}
+	ProfileNode root = Profiler::instance().summary();
+	ProfileNode const* region = root.findChild("parallel");
+	BOOST_REQUIRE(region != nullptr);
+	BOOST_CHECK_EQUAL(region->calls, 100u);
+	BOOST_CHECK_EQUAL(region->counter("items"), 100.0);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_ChromeTrace )
+{
+	Profiler::instance().reset();
+	Profiler::instance().setRecordTrace(true);
+	{
+		ScopedRegion region("traced");
+	}
+	Profiler::instance().setRecordTrace(false);
+	{
+		ScopedRegion region("untraced");
+	}
+	std::ostringstream trace;
+	Profiler::instance().writeChromeTrace(trace);
+	BOOST_CHECK(trace.str().find("\"name\":\"traced\",\"ph\":\"X\"") != std::string::npos);
+	BOOST_CHECK(trace.str().find("untraced") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_EscapeNames )
+{
+	Profiler::instance().reset();
+	Profiler::instance().setRecordTrace(true);
+	{
+		ScopedRegion region("say \"hi\"\\\n");
+		addCounter("tab\t", 1);
+	}
+	Profiler::instance().setRecordTrace(false);
+	std::ostringstream json;
+	Profiler::instance().writeJSON(json);
+	BOOST_CHECK(json.str().find("\"name\":\"say \\\"hi\\\"\\\\\\u000a\"") != std::string::npos);
+	BOOST_CHECK(json.str().find("\"tab\\u0009\":1") != std::string::npos);
+	std::ostringstream trace;
+	Profiler::instance().writeChromeTrace(trace);
+	BOOST_CHECK(trace.str().find("\"name\":\"say \\\"hi\\\"\\\\\\u000a\"") != std::string::npos);
+}
+
+#ifdef SHARK_USE_PROFILING
+BOOST_AUTO_TEST_CASE( Profiler_GemmFlops )
+{
+	Profiler::instance().reset();
+	RealMatrix A(3,4,1.0);
+	RealMatrix B(4,5,1.0);
+	RealMatrix C(3,5);
+	{
+		ScopedRegion region("product");
+		noalias(C) = prod(A,B);
+	}
+	ProfileNode root = Profiler::instance().summary();
+	ProfileNode const* region = root.findChild("product");
+	BOOST_REQUIRE(region != nullptr);
+	BOOST_CHECK_EQUAL(region->counter("GEMM flops"), 2.0 * 3 * 4 * 5);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
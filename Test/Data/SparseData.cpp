@@ -236,4 +236,42 @@ BOOST_AUTO_TEST_CASE (Set_SparseData)
 	TestExportImport_regression(test_ds_sreg);
 }
 
+//single precision inputs and labels read the same values, rounded to float
+BOOST_AUTO_TEST_CASE (Set_SparseData_Float)
+{
+	std::stringstream ssbc(test_binary_classification);
+	std::stringstream ssreg(test_regression);
+
+	LabeledData<FloatVector, unsigned int> test_ds_bc;
+	LabeledData<FloatVector, FloatVector>  test_ds_reg;
+	importSparseData(test_ds_bc, ssbc);
+	importSparseData(test_ds_reg, ssreg);
+
+	BOOST_REQUIRE_EQUAL(test_ds_bc.numberOfElements(), NumLines);
+	BOOST_REQUIRE_EQUAL(test_ds_reg.numberOfElements(), NumLines);
+	BOOST_CHECK_EQUAL(test_ds_bc.inputShape(), Shape({VectorSize}));
+	BOOST_CHECK_EQUAL(test_ds_reg.inputShape(), Shape({VectorSize}));
+	BOOST_CHECK_EQUAL(test_ds_reg.labelShape(), Shape({1}));
+
+	unsigned int bc_labels[NumLines] = {0, 1, 1, 0, 1};
+	float reg_labels[NumLines] = {7.1f, 9.99f, -5.0f, 1.0f, 500.0f};
+	for (std::size_t i=0; i<NumLines; i++)
+	{
+		BOOST_CHECK_EQUAL(test_ds_bc.element(i).label, bc_labels[i]);
+		BOOST_REQUIRE_EQUAL(test_ds_reg.element(i).label.size(), 1);
+		BOOST_CHECK_EQUAL(test_ds_reg.element(i).label(0), reg_labels[i]);
+
+		BOOST_REQUIRE_EQUAL(test_ds_bc.element(i).input.size(), VectorSize);
+		BOOST_REQUIRE_EQUAL(test_ds_reg.element(i).input.size(), VectorSize);
+		for (std::size_t j=0; j<VectorSize; j++)
+		{
+			BOOST_CHECK_EQUAL(test_ds_bc.element(i).input(j), float(input_values[i][j]));
+			BOOST_CHECK_EQUAL(test_ds_reg.element(i).input(j), float(input_values[i][j]));
+		}
+	}
+
+	// test export + import round trip
+	TestExportImport_classification(test_ds_bc);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
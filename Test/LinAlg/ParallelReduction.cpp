@@ -0,0 +1,43 @@
+#define BOOST_TEST_MODULE LINALG_PARALLELREDUCTION
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/LinAlg/ParallelReduction.h>
+#include <shark/Core/Random.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (LinAlg_ParallelReduction)
+
+BOOST_AUTO_TEST_CASE( LinAlg_ParallelReduction_Sum ){
+	//the small block size forces several blocks, the sizes include a partial last block
+	ParallelVectorReduction<> reduction(16);
+	std::size_t sizes[] = {1, 16, 100, 1000};
+	for(std::size_t size: sizes){
+		for(std::size_t numBuffers = 1; numBuffers != 6; ++numBuffers){
+			reduction.init(numBuffers, size);
+			BOOST_REQUIRE_EQUAL(reduction.numberOfBuffers(), numBuffers);
+			BOOST_REQUIRE_EQUAL(reduction.size(), size);
+			RealVector expected(size, 0.0);
+			double expectedValue = 0;
+			for(std::size_t t = 0; t != numBuffers; ++t){
+				BOOST_REQUIRE_EQUAL(norm_inf(reduction.buffer(t)), 0.0);
+				BOOST_REQUIRE_EQUAL(reduction.value(t), 0.0);
+				for(std::size_t i = 0; i != size; ++i){
+					double x = random::gauss(random::globalRng, 0, 1);
+					reduction.buffer(t)(i) += x;
+					expected(i) += x;
+				}
+				reduction.value(t) = t + 1.0;
+				expectedValue += t + 1.0;
+			}
+			RealVector result;
+			reduction.sum(result);
+			BOOST_REQUIRE_EQUAL(result.size(), size);
+			BOOST_CHECK_SMALL(norm_inf(result - expected), 1.e-12);
+			BOOST_CHECK_CLOSE(reduction.sumOfValues(), expectedValue, 1.e-12);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -71,5 +71,37 @@ BOOST_AUTO_TEST_CASE( Models_Conv2D_Valid)
 	testWeightedDerivativesSame(model,10);
 }
 
+//the batched convolution must agree with convolving each image on its own,
+//the batch is large enough to be processed in several chunks
+BOOST_AUTO_TEST_CASE( Models_Conv2D_Batch)
+{
+	Shape imageShape = {11,9,6};
+	Shape filterShape = {2,3,5};
+	for(Convolution type: {Convolution::Valid, Convolution::ZeroPad}){
+		Conv2DModel<RealVector> model(imageShape, filterShape, type);
+		RealVector params(model.numberOfParameters());
+		for(auto& p: params)
+			p = random::gauss(random::globalRng, 0, 1);
+		model.setParameterVector(params);
+		
+		std::size_t numImages = 1100;
+		RealMatrix inputs(numImages, imageShape.numElements());
+		for(std::size_t i = 0; i != numImages; ++i)
+			for(std::size_t j = 0; j != inputs.size2(); ++j)
+				inputs(i,j) = random::uni(random::globalRng, -1, 1);
+		RealMatrix outputs = model(inputs);
+		
+		std::size_t padding = (type == Convolution::Valid)? 0: 1;
+		std::size_t outputsForFilter = model.outputShape().numElements() / 2;
+		RealVector filters = subrange(params, 0, params.size() - 2);
+		for(std::size_t i = 0; i != numImages; ++i){
+			RealVector output(model.outputShape().numElements());
+			blas::kernels::conv2d(row(inputs,i), filters, output, 6, 2, 11, 9, 3, 5, padding * 2, padding * 4);
+			for(std::size_t j = 0; j != output.size(); ++j)
+				output(j) += params(params.size() - 2 + j / outputsForFilter);
+			BOOST_CHECK_SMALL(norm_inf(row(outputs,i) - output), 1.e-12);
+		}
+	}
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -37,6 +37,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/LinearKernel.h>
 #include <shark/Models/Kernels/KernelExpansion.h>
 #include <shark/Core/Random.h>
 
@@ -178,4 +179,66 @@ BOOST_AUTO_TEST_CASE( KERNEL_EXPANSION_SERIALIZATION )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( KERNEL_EXPANSION_COMPACT_BASIS )
+{
+	std::vector<RealVector> data(1000,RealVector(5));
+	for(auto& point: data){
+		for(auto& x: point)
+			x = random::uni(random::globalRng,-1,1);
+	}
+	Data<RealVector> basis = createDataFromRange(data,100);
+	RealMatrix inputBatch(300,5);
+	for(std::size_t i = 0; i != 300; ++i){
+		for(std::size_t j = 0; j != 5; ++j)
+			inputBatch(i,j) = random::uni(random::globalRng,-1,1);
+	}
+
+	DenseRbfKernel gaussian(0.5);
+	LinearKernel<> linear;
+	AbstractKernelFunction<RealVector>* kernels[] = {&gaussian, &linear};
+	for(auto kernel: kernels){
+		KernelExpansion<RealVector> expansion(kernel, basis, true, 3);
+		RealVector parameters(expansion.numberOfParameters());
+		for(std::size_t i = 0; i != parameters.size(); ++i){
+			parameters(i) = random::uni(random::globalRng,-1,1);
+		}
+		expansion.setParameterVector(parameters);
+		//every second basis vector is not a support vector
+		for(std::size_t i = 0; i < 1000; i += 2)
+			row(expansion.alpha(),i).clear();
+		RealMatrix expected = expansion(inputBatch);
+
+		expansion.compactBasis(false, 64);
+		BOOST_REQUIRE(expansion.hasCompactBasis());
+		RealMatrix output = expansion(inputBatch);
+		BOOST_CHECK_SMALL(max(abs(output - expected)), 1.e-10);
+
+		expansion.compactBasis(true, 64);
+		RealMatrix outputFloat = expansion(inputBatch);
+		BOOST_CHECK_SMALL(max(abs(outputFloat - expected)), 1.e-2);
+
+		//the offset is read directly, changing it keeps the compact basis
+		expansion.compactBasis(false, 64);
+		expansion.offset(1) += 1.0;
+		BOOST_REQUIRE(expansion.hasCompactBasis());
+		RealMatrix outputOffset = expansion(inputBatch);
+		BOOST_CHECK_SMALL(max(abs(column(outputOffset,1) - column(expected,1) - 1.0)), 1.e-10);
+		expansion.offset(1) -= 1.0;
+
+		//changing the coefficients or basis removes the compact basis
+		expansion.alpha(1,0) += 1.0;
+		BOOST_CHECK(!expansion.hasCompactBasis());
+		RealMatrix changedAlpha = expansion(inputBatch);
+		expansion.compactBasis(false, 64);
+		BOOST_CHECK_SMALL(max(abs(expansion(inputBatch) - changedAlpha)), 1.e-10);
+		expansion.basis();
+		BOOST_CHECK(!expansion.hasCompactBasis());
+
+		//changing the parameters removes the compact basis
+		expansion.compactBasis(false, 64);
+		expansion.setParameterVector(parameters);
+		BOOST_CHECK(!expansion.hasCompactBasis());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
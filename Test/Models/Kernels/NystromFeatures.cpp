@@ -0,0 +1,58 @@
+#define BOOST_TEST_MODULE Models_NystromFeatures
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Models/Kernels/NystromFeatures.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Core/Random.h>
+
+using namespace shark;
+
+namespace{
+Data<RealVector> randomPoints(std::size_t n, std::size_t dim){
+	std::vector<RealVector> points(n, RealVector(dim));
+	for(auto& point: points){
+		for(auto& x: point)
+			x = random::uni(random::globalRng, -1, 1);
+	}
+	return createDataFromRange(points, 7);
+}
+}
+
+BOOST_AUTO_TEST_SUITE (Models_Kernels_NystromFeatures)
+
+//on the landmarks the approximation is exact
+BOOST_AUTO_TEST_CASE( NystromFeatures_Landmarks ){
+	random::globalRng.seed(42);
+	GaussianRbfKernel<> kernel(0.5);
+	Data<RealVector> landmarks = randomPoints(30, 3);
+	NystromFeatures<RealVector> features(&kernel, landmarks);
+	BOOST_CHECK_EQUAL(features.inputShape().numElements(), 3);
+	BOOST_CHECK(features.outputShape().numElements() <= 30);
+
+	Data<RealVector> points = randomPoints(20, 3);
+	RealMatrix K = calculateMixedKernelMatrix(kernel, landmarks, points);
+	RealMatrix featuresLandmarks = createBatch(features(landmarks).elements());
+	RealMatrix featuresPoints = createBatch(features(points).elements());
+	RealMatrix approximation = prod(featuresLandmarks, trans(featuresPoints));
+	BOOST_CHECK_SMALL(max(abs(K - approximation)), 1.e-6);
+}
+
+//the span of enough landmarks contains the whole input space of the linear kernel
+BOOST_AUTO_TEST_CASE( NystromFeatures_Linear ){
+	random::globalRng.seed(42);
+	LinearKernel<> kernel;
+	Data<RealVector> landmarks = randomPoints(20, 5);
+	NystromFeatures<RealVector> features(&kernel, landmarks);
+	BOOST_CHECK_EQUAL(features.outputShape().numElements(), 5);
+
+	Data<RealVector> points = randomPoints(20, 5);
+	RealMatrix X = createBatch(points.elements());
+	RealMatrix featuresPoints = features(X);
+	RealMatrix approximation = prod(featuresPoints, trans(featuresPoints));
+	RealMatrix K = prod(X, trans(X));
+	BOOST_CHECK_SMALL(max(abs(K - approximation)), 1.e-8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
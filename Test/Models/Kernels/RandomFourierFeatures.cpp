@@ -0,0 +1,80 @@
+#define BOOST_TEST_MODULE Models_RandomFourierFeatures
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Models/Kernels/RandomFourierFeatures.h>
+#include <shark/Algorithms/Trainers/CSvmTrainer.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
+#include <shark/Core/Random.h>
+
+using namespace shark;
+
+namespace{
+RealMatrix randomPoints(std::size_t n, std::size_t dim){
+	RealMatrix points(n, dim);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != dim; ++j)
+			points(i,j) = random::uni(random::globalRng, -1, 1);
+	}
+	return points;
+}
+
+//the inner products of the features must approximate the kernel
+template<class Kernel>
+void testApproximation(Kernel const& kernel, RandomFourierFeatures const& features, std::size_t dim){
+	RealMatrix X = randomPoints(20, dim);
+	RealMatrix Y = randomPoints(30, dim);
+	RealMatrix K = kernel(X, Y);
+	RealMatrix featuresX = features(X);
+	RealMatrix featuresY = features(Y);
+	BOOST_REQUIRE_EQUAL(featuresX.size2(), features.outputShape().numElements());
+	RealMatrix approximation = prod(featuresX, trans(featuresY));
+	BOOST_CHECK_SMALL(max(abs(K - approximation)), 0.05);
+}
+}
+
+BOOST_AUTO_TEST_SUITE (Models_Kernels_RandomFourierFeatures)
+
+BOOST_AUTO_TEST_CASE( RandomFourierFeatures_Gaussian ){
+	random::globalRng.seed(42);
+	std::size_t dim = 5;
+	GaussianRbfKernel<> kernel(0.7);
+	RandomFourierFeatures features(kernel, dim, 20000, random::globalRng);
+	BOOST_CHECK_EQUAL(features.inputShape().numElements(), dim);
+	BOOST_CHECK_EQUAL(features.outputShape().numElements(), 20000);
+	BOOST_CHECK_EQUAL(features.numberOfParameters(), 0);
+	testApproximation(kernel, features, dim);
+}
+
+BOOST_AUTO_TEST_CASE( RandomFourierFeatures_ARD ){
+	random::globalRng.seed(42);
+	std::size_t dim = 4;
+	ARDKernelUnconstrained<> kernel(dim);
+	RealVector gammas(dim);
+	gammas(0) = 0.1; gammas(1) = 2.0; gammas(2) = 0.5; gammas(3) = 1.0;
+	kernel.setGammaVector(gammas);
+	RandomFourierFeatures features(kernel, 20000, random::globalRng);
+	testApproximation(kernel, features, dim);
+}
+
+//a linear svm on the features must solve a problem which is not linearly separable
+BOOST_AUTO_TEST_CASE( RandomFourierFeatures_LinearSvm ){
+	random::globalRng.seed(42);
+	Chessboard problem(2, 0);
+	ClassificationDataset train = problem.generateDataset(1000);
+	ClassificationDataset test = problem.generateDataset(1000);
+
+	GaussianRbfKernel<> kernel(1.0);
+	RandomFourierFeatures features(kernel, 2, 500, random::globalRng);
+	ClassificationDataset trainFeatures = transformInputs(train, features);
+	LinearClassifier<> classifier;
+	LinearCSvmTrainer<RealVector> trainer(10.0, true);
+	trainer.train(classifier, trainFeatures);
+
+	ZeroOneLoss<unsigned int> loss;
+	Data<unsigned int> predictions = classifier(features(test.inputs()));
+	BOOST_CHECK_SMALL(loss(test.labels(), predictions), 0.1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
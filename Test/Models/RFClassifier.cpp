@@ -40,6 +40,7 @@
 
 #include <shark/Algorithms/Trainers/RFTrainer.h>
 #include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
 #include <shark/Data/DataDistribution.h>
 
 #include <sstream>
@@ -93,4 +94,106 @@ BOOST_AUTO_TEST_CASE( RF_Classifier ) {
 	BOOST_REQUIRE_CLOSE(error_test_serialized, error_test, 1.e-13);
 }
 
+BOOST_AUTO_TEST_CASE( RF_Regression ) {
+	random::globalRng.seed(42);
+	//the label depends only on the first two of four inputs
+	auto generate = [](std::size_t n){
+		std::vector<RealVector> inputs(n, RealVector(4));
+		std::vector<RealVector> labels(n, RealVector(1));
+		for(std::size_t i = 0; i != n; ++i){
+			for(auto& x: inputs[i])
+				x = random::uni(random::globalRng, -1, 1);
+			labels[i](0) = inputs[i](0) + 2 * inputs[i](1) + random::gauss(random::globalRng, 0, 0.01);
+		}
+		return createLabeledDataFromRange(inputs, labels, 50);
+	};
+	auto train = generate(200);
+	auto test = generate(200);
+	RFTrainer<RealVector> trainer(true,true);
+	trainer.setNTrees(50);
+	RFClassifier<RealVector> model;
+	trainer.train(model, train);
+	
+	//the batched evaluation of the trees agrees with the evaluation of single patterns
+	for(std::size_t m = 0; m != model.numberOfModels(); ++m){
+		RealMatrix predictions = model.getModel(m)(test.inputs().batch(0));
+		for(std::size_t i = 0; i != predictions.size1(); ++i){
+			RealVector prediction = model.getModel(m)(RealVector(row(test.inputs().batch(0),i)));
+			BOOST_CHECK_EQUAL(predictions(i,0), prediction(0));
+		}
+	}
+	
+	SquaredLoss<> loss;
+	double error_test = loss.eval(test.labels(), model(test.inputs()));
+	BOOST_CHECK_SMALL(std::abs(error_test - model.OOBerror()), 0.05);
+	BOOST_REQUIRE_EQUAL(model.featureImportances().size(), 4);
+	BOOST_CHECK(model.featureImportances()(1) > model.featureImportances()(0));
+	BOOST_CHECK(model.featureImportances()(0) > 10 * std::abs(model.featureImportances()(2)));
+	BOOST_CHECK(model.featureImportances()(0) > 10 * std::abs(model.featureImportances()(3)));
+	
+	//the importances only depend on the seed
+	std::vector<std::vector<std::size_t> > oobIndices(model.numberOfModels());
+	for(std::size_t m = 0; m != oobIndices.size(); ++m){
+		for(std::size_t i = 0; i != 20; ++i)
+			oobIndices[m].push_back((7 * m + 13 * i) % test.numberOfElements());
+	}
+	random::rng_type rng1(3);
+	random::rng_type rng2(3);
+	model.computeFeatureImportances(oobIndices, test, rng1);
+	RealVector importances = model.featureImportances();
+	model.computeFeatureImportances(oobIndices, test, rng2);
+	for(std::size_t i = 0; i != 4; ++i)
+		BOOST_CHECK_EQUAL(importances(i), model.featureImportances()(i));
+}
+
+BOOST_AUTO_TEST_CASE( RF_Presorted ) {
+	PamiToy generator(5,5,0,0.4);
+	auto train = generator.generateDataset(300);
+	auto test = generator.generateDataset(200);
+	blas::matrix<double, blas::column_major> inputs = createBatch<RealVector>(train.inputs().elements().begin(),train.inputs().elements().end());
+	RealVector weights(train.numberOfElements(), 1.0 / train.numberOfElements());
+	
+	//when all features are checked, both builders find the same splits.
+	//Leaves contain several points with real valued labels, thus no two splits have the same improvement
+	RealMatrix targets(inputs.size1(), 1);
+	for(std::size_t i = 0; i != inputs.size1(); ++i)
+		targets(i,0) = inputs(i,0) - inputs(i,1) + inputs(i,2) * inputs(i,3);
+	CART::TreeBuilder<RealVector,CART::MSECriterion> builder;
+	builder.m_min_samples_leaf = 5;
+	builder.m_min_split = 10;
+	builder.m_max_depth = 10000;
+	builder.m_min_impurity_split = 1e-10;
+	builder.m_epsilon = 1e-10;
+	builder.m_max_features = inputs.size2();
+	std::vector<CARTree<RealVector> > trees;
+	for(bool presort: {false, true}){
+		random::rng_type rng(17);
+		CART::TreeBuilder<RealVector,CART::MSECriterion>::Bootstrap bootstrap(rng, inputs, targets, weights);
+		builder.m_presort = presort;
+		trees.push_back(builder.buildTree(rng, bootstrap));
+	}
+	BOOST_CHECK_EQUAL(trees[0].numberOfNodes(), trees[1].numberOfNodes());
+	RealMatrix predictions = trees[0](test.inputs().batch(0));
+	RealMatrix predictionsPresorted = trees[1](test.inputs().batch(0));
+	for(std::size_t i = 0; i != predictions.size1(); ++i)
+		BOOST_CHECK_CLOSE(predictions(i,0), predictionsPresorted(i,0), 1.e-10);
+	
+	//a forest with fewer trees than threads and one with many trees
+	ZeroOneLoss<> loss;
+	for(std::size_t numTrees: {2, 100}){
+		RFTrainer<unsigned int> trainer(false,true);
+		trainer.setNTrees(numTrees);
+		trainer.setPresort(true);
+		RFClassifier<unsigned int> model;
+		trainer.train(model, train);
+		BOOST_REQUIRE_EQUAL(model.numberOfModels(), numTrees);
+		double error_train = loss.eval(train.labels(), model(train.inputs()));
+		BOOST_CHECK(error_train < 0.1);
+		if(numTrees == 100){
+			double error_test = loss.eval(test.labels(), model(test.inputs()));
+			BOOST_CHECK_SMALL(std::abs(error_test - model.OOBerror()), 0.03);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,7 @@
 #include <boost/serialization/vector.hpp>
 
 #include <shark/ObjectiveFunctions/Benchmarks/Benchmarks.h>
+#include <shark/ObjectiveFunctions/EvaluationArchive.h>
 
 #include <shark/Statistics/Statistics.h>
 
@@ -66,4 +67,50 @@ BOOST_AUTO_TEST_CASE( Ellipsoid_Derivative )
 	}
 }
 
+//Sphere which announces that it can be evaluated in parallel
+class ThreadSafeSphere : public shark::Sphere{
+public:
+	ThreadSafeSphere(std::size_t dimensions):shark::Sphere(dimensions){
+		m_features |= IS_THREAD_SAFE;
+	}
+};
+
+BOOST_AUTO_TEST_CASE( EvalBatch )
+{
+	const std::size_t dimensions = 5;
+	const std::size_t numPoints = 100;
+	
+	shark::Sphere sphere(dimensions);
+	ThreadSafeSphere parallelSphere(dimensions);
+	shark::EvaluationArchive<shark::RealVector, double> archive(&parallelSphere);
+	sphere.init();
+	parallelSphere.init();
+	archive.init();
+	
+	shark::RealMatrix points(numPoints,dimensions);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		noalias(row(points,i)) = sphere.proposeStartingPoint();
+	}
+	shark::RealVector values;
+	shark::RealVector parallelValues;
+	shark::RealVector archiveValues;
+	sphere.evalBatch(points,values);
+	parallelSphere.evalBatch(points,parallelValues);
+	archive.evalBatch(points,archiveValues);
+	
+	BOOST_REQUIRE_EQUAL(values.size(), numPoints);
+	BOOST_REQUIRE_EQUAL(parallelValues.size(), numPoints);
+	BOOST_REQUIRE_EQUAL(archiveValues.size(), numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		double value = sphere.eval(row(points,i));
+		BOOST_CHECK_EQUAL(values(i), value);
+		BOOST_CHECK_EQUAL(parallelValues(i), value);
+		BOOST_CHECK_EQUAL(archiveValues(i), value);
+	}
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 2 * numPoints);
+	BOOST_CHECK_EQUAL(parallelSphere.evaluationCounter(), 2 * numPoints);
+	BOOST_CHECK_EQUAL(archive.evaluationCounter(), numPoints);
+	BOOST_CHECK_EQUAL(archive.size(), numPoints);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
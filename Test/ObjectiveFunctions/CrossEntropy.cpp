@@ -126,4 +126,37 @@ BOOST_AUTO_TEST_CASE( CROSSENTROPY_DERIVATIVES_MULTI_CLASS ){
 	}
 }
 
+BOOST_AUTO_TEST_CASE( CROSSENTROPY_HESSIAN_DIAGONAL ){
+	CrossEntropy loss;
+	BOOST_REQUIRE(loss.hasSecondDerivative());
+	for(std::size_t outputs: {1, 5}){
+		RealMatrix predictions(100, outputs);
+		UIntVector labels(100);
+		for(std::size_t i = 0; i != 100; ++i){
+			labels(i) = outputs == 1? random::coinToss(random::globalRng) : random::discrete(random::globalRng, 0, 4);
+			for(std::size_t k = 0; k != outputs; ++k)
+				predictions(i,k) = random::uni(random::globalRng, -10.0,10.0);
+		}
+		RealMatrix derivative;
+		RealMatrix firstDerivative;
+		RealMatrix hessianDiagonal;
+		double value = loss.evalDerivative(labels, predictions, derivative, hessianDiagonal);
+		BOOST_CHECK_SMALL(value - loss.evalDerivative(labels, predictions, firstDerivative), 1.e-12);
+		BOOST_CHECK_SMALL(max(abs(derivative - firstDerivative)), 1.e-15);
+		for(std::size_t i = 0; i != 100; ++i){
+			UIntVector label(1, labels(i));
+			RealMatrix point = rows(predictions, i, i + 1);
+			RealMatrix estimatedHessian = estimateSecondDerivative(loss, point, label, 1.e-4);
+			BOOST_CHECK_SMALL(norm_inf(row(hessianDiagonal,i) - diag(estimatedHessian)), 1.e-5);
+
+			//the single point version agrees
+			RealVector gradient;
+			RealMatrix hessian;
+			double pointValue = loss.evalDerivative(labels(i), row(predictions,i), gradient, hessian);
+			BOOST_CHECK_SMALL(pointValue - loss.eval(labels(i), row(predictions,i)), 1.e-12);
+			BOOST_CHECK_SMALL(norm_inf(row(hessianDiagonal,i) - diag(hessian)), 1.e-12);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,9 @@
 #include <shark/Algorithms/Trainers/LinearRegression.h>
 #include <shark/Algorithms/GradientDescent/Rprop.h>
 #include <shark/Algorithms/GradientDescent/SteepestDescent.h>
+#include <shark/Algorithms/GradientDescent/Adam.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Models/ConcatenatedModel.h>
 #include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
 #include <shark/Data/DataDistribution.h>
 
@@ -185,7 +188,7 @@ BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_LinearRegression ){
 	}
 	
 	{
-		detail::ErrorFunctionImpl<RealVector,RealVector,RealVector> mse(trainset,&model,&loss,false);
+		detail::ErrorFunctionImpl<RealVector,RealVector,RealVector,RealVector> mse(trainset,&model,&loss,false);
 		double val = mse.eval(optimum);
 		BOOST_CHECK_CLOSE(optimalMSE,val,1.e-10);
 		
@@ -254,6 +257,136 @@ BOOST_AUTO_TEST_CASE( ObjFunct_WeightedErrorFunction_LinearRegression )
 	BOOST_CHECK_SMALL(norm_sqr(unWDerivative - WDerivative),1.e-8);
 }
 
+//trains the same linear regression problem in single and double precision
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_SinglePrecision ){
+	const std::size_t trainExamples = 1000;
+	RealMatrix matrix(2, 2);
+	matrix(0,0) = 3;
+	matrix(1,1) = -5;
+	matrix(0,1) = -2;
+	matrix(1,0) = 7;
+	RealVector offset(2);
+	offset(0) = 3;
+	offset(1) = -6;
+	LinearModel<> model(matrix, offset);
+
+	std::vector<RealVector> input(trainExamples,RealVector(2));
+	std::vector<RealVector> target(trainExamples);
+	std::vector<FloatVector> inputFloat(trainExamples);
+	std::vector<FloatVector> targetFloat(trainExamples);
+	for (std::size_t i=0;i!=trainExamples;++i) {
+		input[i](0) = random::uni(random::globalRng, -3.0,3.0);
+		input[i](1) = random::uni(random::globalRng, -3.0,3.0);
+		target[i] = model(input[i]);
+		target[i](0) += random::gauss(random::globalRng, 0, 0.01);
+		target[i](1) += random::gauss(random::globalRng, 0, 0.01);
+		inputFloat[i] = input[i];
+		targetFloat[i] = target[i];
+	}
+	RegressionDataset trainset = createLabeledDataFromRange(input, target);
+	LabeledData<FloatVector,FloatVector> trainsetFloat = createLabeledDataFromRange(inputFloat, targetFloat);
+
+	//the optimum in double precision
+	LinearRegression trainer;
+	trainer.setRegularization(0);
+	trainer.train(model, trainset);
+	RealVector optimum = model.parameterVector();
+
+	LinearModel<FloatVector> modelFloat(2, 2, true);
+	SquaredLoss<FloatVector> lossFloat;
+	ErrorFunctionT<FloatVector> mse(trainsetFloat, &modelFloat, &lossFloat);
+	SquaredLoss<> loss;
+	ErrorFunction mseDouble(trainset, &model, &loss);
+
+	//value and gradient agree with the double precision error function
+	FloatVector optimumFloat = optimum;
+	ErrorFunctionT<FloatVector>::FirstOrderDerivative d;
+	ErrorFunction::FirstOrderDerivative dDouble;
+	RealVector point = optimum + 0.1;
+	FloatVector pointFloat = point;
+	BOOST_CHECK_CLOSE(mse.evalDerivative(pointFloat, d), mseDouble.evalDerivative(point, dDouble), 1.e-3);
+	BOOST_REQUIRE_EQUAL(d.size(), dDouble.size());
+	for(std::size_t i = 0; i != d.size(); ++i){
+		BOOST_CHECK_SMALL(d(i) - dDouble(i), 1.e-3);
+	}
+
+	{
+		IRpropPlusT<FloatVector> rprop;
+		rprop.init(mse, FloatVector(optimum.size(), 0.0f));
+		for(std::size_t i = 0; i != 200; ++i){
+			rprop.step(mse);
+		}
+		FloatVector diff = rprop.solution().point - optimumFloat;
+		BOOST_CHECK_SMALL(norm_inf(diff), 1.e-3f);
+	}
+	{
+		AdamT<FloatVector> adam;
+		adam.setEta(0.1);
+		adam.init(mse, FloatVector(optimum.size(), 0.0f));
+		for(std::size_t i = 0; i != 2000; ++i){
+			adam.step(mse);
+		}
+		FloatVector diff = adam.solution().point - optimumFloat;
+		BOOST_CHECK_SMALL(norm_inf(diff), 1.e-2f);
+	}
+}
+
+//a two layer network with single precision parameters, checked against a numerical derivative
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_SinglePrecision_Network ){
+	random::globalRng.seed(42);
+	std::vector<FloatVector> input(200,FloatVector(2));
+	std::vector<FloatVector> target(200,FloatVector(1));
+	for (std::size_t i=0;i!=input.size();++i) {
+		input[i](0) = random::uni(random::globalRng, -2.0,2.0);
+		input[i](1) = random::uni(random::globalRng, -2.0,2.0);
+		target[i](0) = std::sin(input[i](0)) * input[i](1);
+	}
+	LabeledData<FloatVector,FloatVector> trainset = createLabeledDataFromRange(input, target, 50);
+
+	LinearModel<FloatVector, TanhNeuron> hidden(2, 8, true);
+	LinearModel<FloatVector> output(8, 1, true);
+	ConcatenatedModel<FloatVector> net = hidden >> output;
+	ConcatenatedModel<FloatVector> netAdd;
+	netAdd.add(&hidden, true);
+	netAdd.add(&output, true);
+	BOOST_REQUIRE(net.hasFirstParameterDerivative());
+	BOOST_REQUIRE_EQUAL(net.numberOfParameters(), netAdd.numberOfParameters());
+	initRandomUniform(net, -1, 1);
+
+	SquaredLoss<FloatVector> loss;
+	ErrorFunctionT<FloatVector> error(trainset, &net, &loss);
+	FloatVector point = net.parameterVector();
+	ErrorFunctionT<FloatVector>::FirstOrderDerivative derivative;
+	double value = error.evalDerivative(point, derivative);
+	BOOST_CHECK_CLOSE(value, error.eval(point), 1.e-4);
+	BOOST_REQUIRE_EQUAL(derivative.size(), point.size());
+	//central differences, the step is large because of the single precision
+	float const epsilon = 1.e-2f;
+	for(std::size_t i = 0; i != point.size(); ++i){
+		FloatVector testPoint = point;
+		testPoint(i) += epsilon;
+		double valuePlus = error.eval(testPoint);
+		testPoint(i) -= 2 * epsilon;
+		double valueMinus = error.eval(testPoint);
+		double estimate = (valuePlus - valueMinus) / (2 * epsilon);
+		BOOST_CHECK_SMALL(derivative(i) - estimate, 1.e-3 * (1 + std::abs(estimate)));
+	}
+
+	//the network built with add computes the same derivative
+	ErrorFunctionT<FloatVector> errorAdd(trainset, &netAdd, &loss);
+	ErrorFunctionT<FloatVector>::FirstOrderDerivative derivativeAdd;
+	BOOST_CHECK_CLOSE(errorAdd.evalDerivative(point, derivativeAdd), value, 1.e-4);
+	BOOST_CHECK_SMALL(norm_inf(derivativeAdd - derivative), 1.e-5f);
+
+	AdamT<FloatVector> adam;
+	adam.setEta(0.01);
+	adam.init(error, point);
+	for(std::size_t i = 0; i != 1000; ++i){
+		adam.step(error);
+	}
+	BOOST_CHECK_LT(adam.solution().value, 0.1 * value);
+}
+
 BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_Noisy )
 {
 	//create regression data from the testfunction
@@ -0,0 +1,214 @@
+#define BOOST_TEST_MODULE ObjFunct_LogisticRegressionError
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/ObjectiveFunctions/LogisticRegressionError.h>
+#include <shark/ObjectiveFunctions/ErrorFunction.h>
+#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
+#include <shark/ObjectiveFunctions/Regularizer.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Data/DataDistribution.h>
+
+#include "TestObjectiveFunction.h"
+
+using namespace shark;
+
+//three gaussian clusters in 5 dimensions
+ClassificationDataset createMultiClassData(std::size_t numPoints){
+	std::vector<RealVector> inputs(numPoints, RealVector(5));
+	std::vector<unsigned int> labels(numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		labels[i] = i % 3;
+		for(std::size_t j = 0; j != 5; ++j)
+			inputs[i](j) = random::gauss(random::globalRng, 0, 1) + (j == labels[i]? 1.5 : 0.0);
+	}
+	return createLabeledDataFromRange(inputs, labels, 16);
+}
+
+//compares value and derivative with the ErrorFunction using the CrossEntropy and TwoNormRegularizer
+template<class Dataset>
+void testAgainstErrorFunction(Dataset const& dataset, bool bias, double lambda2){
+	std::size_t numOutputs = numberOfClasses(dataset) == 2? 1: numberOfClasses(dataset);
+	LinearModel<> model(inputDimension(dataset), numOutputs, bias);
+	std::size_t dim = model.numberOfParameters();
+	CrossEntropy loss;
+	ErrorFunction reference(dataset, &model, &loss);
+	TwoNormRegularizer regularizer;
+	if(bias){
+		RealVector mask(dim,1.0);
+		subrange(mask,dim - numOutputs, dim).clear();
+		regularizer.setMask(mask);
+	}
+	reference.setRegularizer(lambda2, &regularizer);
+
+	LogisticRegressionError<> error(dataset, bias, lambda2);
+	BOOST_REQUIRE_EQUAL(error.numberOfVariables(), dim);
+	BOOST_CHECK(error.hasFirstDerivative());
+	BOOST_CHECK(error.hasHessianVectorProduct());
+	for(std::size_t trial = 0; trial != 10; ++trial){
+		RealVector point(dim);
+		for(auto& p: point)
+			p = random::gauss(random::globalRng, 0, 1);
+		RealVector derivative;
+		RealVector referenceDerivative;
+		BOOST_CHECK_CLOSE(error.eval(point), reference.eval(point), 1.e-10);
+		BOOST_CHECK_CLOSE(error.evalDerivative(point, derivative), reference.evalDerivative(point, referenceDerivative), 1.e-10);
+		BOOST_CHECK_SMALL(norm_inf(derivative - referenceDerivative), 1.e-10);
+	}
+}
+
+//the hessian vector product must match the finite difference of the gradients
+void testHessianVectorProduct(LogisticRegressionError<>& error){
+	std::size_t dim = error.numberOfVariables();
+	for(std::size_t trial = 0; trial != 10; ++trial){
+		RealVector point(dim);
+		RealVector v(dim);
+		for(std::size_t i = 0; i != dim; ++i){
+			point(i) = random::gauss(random::globalRng, 0, 1);
+			v(i) = random::gauss(random::globalRng, 0, 1);
+		}
+		RealMatrix hessian = estimateSecondDerivative(error, point, 1.e-5);
+		RealVector derivative;
+		error.evalDerivative(point, derivative);
+		RealVector Hv;
+		error.hessianVectorProduct(point, v, Hv);
+		BOOST_REQUIRE_EQUAL(Hv.size(), dim);
+		RealVector estimate = prod(hessian, v);
+		BOOST_CHECK_SMALL(norm_inf(Hv - estimate) / norm_inf(estimate), 1.e-6);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (ObjectiveFunctions_LogisticRegressionError)
+
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_Binary ){
+	random::globalRng.seed(42);
+	PamiToy problem;
+	ClassificationDataset dataset = problem.generateDataset(100, 16);
+	testAgainstErrorFunction(dataset, true, 0.0);
+	testAgainstErrorFunction(dataset, true, 0.1);
+	testAgainstErrorFunction(dataset, false, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_MultiClass ){
+	random::globalRng.seed(42);
+	ClassificationDataset dataset = createMultiClassData(100);
+	testAgainstErrorFunction(dataset, true, 0.0);
+	testAgainstErrorFunction(dataset, true, 0.1);
+	testAgainstErrorFunction(dataset, false, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_Weighted ){
+	random::globalRng.seed(42);
+	WeightedLabeledData<RealVector, unsigned int> binary(PamiToy().generateDataset(100, 16), 1.0);
+	for(double& weight: binary.weights().elements())
+		weight = random::uni(random::globalRng, 0.1, 2);
+	testAgainstErrorFunction(binary, true, 0.1);
+
+	WeightedLabeledData<RealVector, unsigned int> multiClass(createMultiClassData(100), 1.0);
+	for(double& weight: multiClass.weights().elements())
+		weight = random::uni(random::globalRng, 0.1, 2);
+	testAgainstErrorFunction(multiClass, true, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_HessianVectorProduct ){
+	random::globalRng.seed(42);
+	LogisticRegressionError<> binary(PamiToy().generateDataset(100, 16), true, 0.1);
+	testHessianVectorProduct(binary);
+
+	WeightedLabeledData<RealVector, unsigned int> multiClass(createMultiClassData(100), 1.0);
+	for(double& weight: multiClass.weights().elements())
+		weight = random::uni(random::globalRng, 0.1, 2);
+	LogisticRegressionError<> multiClassError(multiClass, true, 0.1);
+	testHessianVectorProduct(multiClassError);
+}
+
+//points along a line are evaluated using the cached margins. Check that this gives the same
+//results as a fresh function over many steps
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_MarginCache ){
+	random::globalRng.seed(42);
+	ClassificationDataset dataset = createMultiClassData(200);
+	LogisticRegressionError<> error(dataset, true, 0.1);
+	std::size_t dim = error.numberOfVariables();
+	RealVector point(dim, 0.0);
+	for(std::size_t step = 0; step != 120; ++step){
+		RealVector direction(dim);
+		for(auto& d: direction)
+			d = random::gauss(random::globalRng, 0, 0.1);
+		//line search like trials
+		for(double t: {1.0, 0.5, 0.25}){
+			RealVector trial = point + t * direction;
+			LogisticRegressionError<> fresh(dataset, true, 0.1);
+			BOOST_CHECK_CLOSE(error.eval(trial), fresh.eval(trial), 1.e-10);
+		}
+		point += 0.25 * direction;
+		RealVector derivative;
+		RealVector freshDerivative;
+		LogisticRegressionError<> fresh(dataset, true, 0.1);
+		BOOST_CHECK_CLOSE(error.evalDerivative(point, derivative), fresh.evalDerivative(point, freshDerivative), 1.e-10);
+		BOOST_CHECK_SMALL(norm_inf(derivative - freshDerivative), 1.e-10);
+	}
+}
+
+//sparse inputs use the sparse products with the data and must give the same results as dense inputs
+void testSparseAgainstDense(
+	LogisticRegressionError<CompressedRealVector> const& sparseError,
+	LogisticRegressionError<> const& denseError
+){
+	std::size_t dim = denseError.numberOfVariables();
+	BOOST_REQUIRE_EQUAL(sparseError.numberOfVariables(), dim);
+	for(std::size_t trial = 0; trial != 10; ++trial){
+		RealVector point(dim);
+		RealVector v(dim);
+		for(std::size_t i = 0; i != dim; ++i){
+			point(i) = random::gauss(random::globalRng, 0, 1);
+			v(i) = random::gauss(random::globalRng, 0, 1);
+		}
+		RealVector sparseDerivative;
+		RealVector denseDerivative;
+		BOOST_CHECK_CLOSE(sparseError.eval(point), denseError.eval(point), 1.e-10);
+		BOOST_CHECK_CLOSE(sparseError.evalDerivative(point, sparseDerivative), denseError.evalDerivative(point, denseDerivative), 1.e-10);
+		BOOST_CHECK_SMALL(norm_inf(sparseDerivative - denseDerivative), 1.e-10);
+		RealVector sparseHv;
+		RealVector denseHv;
+		sparseError.hessianVectorProduct(point, v, sparseHv);
+		denseError.hessianVectorProduct(point, v, denseHv);
+		BOOST_CHECK_SMALL(norm_inf(sparseHv - denseHv), 1.e-10);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( LogisticRegressionError_Sparse ){
+	random::globalRng.seed(42);
+	std::size_t numPoints = 150;
+	std::size_t dim = 40;
+	std::vector<RealVector> denseInputs(numPoints, RealVector(dim, 0.0));
+	std::vector<CompressedRealVector> sparseInputs(numPoints, CompressedRealVector(dim));
+	std::vector<unsigned int> labels(numPoints);
+	std::vector<unsigned int> binaryLabels(numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		labels[i] = i % 3;
+		binaryLabels[i] = i % 2;
+		//about 10% of the entries are non-zero
+		for(std::size_t j = 0; j != dim; ++j){
+			if(!random::coinToss(random::globalRng, 0.1)) continue;
+			double value = random::gauss(random::globalRng, 0, 1) + (j % 3 == labels[i]? 1.0 : 0.0);
+			denseInputs[i](j) = value;
+			sparseInputs[i](j) = value;
+		}
+	}
+
+	LabeledData<CompressedRealVector, unsigned int> sparse = createLabeledDataFromRange(sparseInputs, labels, 16);
+	ClassificationDataset dense = createLabeledDataFromRange(denseInputs, labels, 16);
+	testSparseAgainstDense(
+		LogisticRegressionError<CompressedRealVector>(sparse, true, 0.1),
+		LogisticRegressionError<>(dense, true, 0.1)
+	);
+
+	LabeledData<CompressedRealVector, unsigned int> sparseBinary = createLabeledDataFromRange(sparseInputs, binaryLabels, 16);
+	ClassificationDataset denseBinary = createLabeledDataFromRange(denseInputs, binaryLabels, 16);
+	testSparseAgainstDense(
+		LogisticRegressionError<CompressedRealVector>(sparseBinary, false, 0.1),
+		LogisticRegressionError<>(denseBinary, false, 0.1)
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -197,4 +197,35 @@ BOOST_AUTO_TEST_CASE( ObjectiveFunctions_LooErrorCSvm_Chessboard_NoBias )
 	BOOST_CHECK_SMALL(value - standardLoo, 1e-10);
 }
 
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_LooErrorCSvm_Threads )
+{
+	std::cout<<"testing that the result does not depend on the number of threads"<<std::endl;
+	Chessboard problem;
+	ClassificationDataset dataset = problem.generateDataset(200);
+	GaussianRbfKernel<> kernel;
+	CSvmTrainer<RealVector> trainer(&kernel, 10.0,true);
+	RealVector parameters = trainer.parameterVector();
+
+	for(bool withOffset: {true, false}){
+		LooErrorCSvm<RealVector> loosvm(dataset, &kernel, withOffset);
+#ifdef SHARK_USE_OPENMP
+		int threads = omp_get_max_threads();
+		omp_set_num_threads(1);
+		double serial = loosvm.eval(parameters);
+		omp_set_num_threads(4);
+		double parallel = loosvm.eval(parameters);
+		omp_set_num_threads(threads);
+		BOOST_CHECK_EQUAL(serial, parallel);
+#else
+		double parallel = loosvm.eval(parameters);
+#endif
+		// brute force computation
+		CSvmTrainer<RealVector> bruteTrainer(&kernel, 10.0, withOffset);
+		ZeroOneLoss<unsigned int> loss;
+		KernelClassifier<RealVector> ke;
+		LooError<KernelClassifier<RealVector>,unsigned int> loo(dataset, &ke, &bruteTrainer, &loss);
+		BOOST_CHECK_SMALL(parallel - loo.eval(), 1e-10);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,126 @@
+//===========================================================================
+/*!
+ * 
+ *
+ * \brief       Test case for the evidence of a Gaussian Process with inducing points.
+ * 
+ * 
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <shark/Core/Random.h>
+#include <shark/Data/Dataset.h>
+#include <shark/Data/DataDistribution.h>
+
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Algorithms/GradientDescent/Rprop.h>
+#include <shark/ObjectiveFunctions/NegativeGaussianProcessEvidence.h>
+#include <shark/ObjectiveFunctions/NegativeSparseGaussianProcessEvidence.h>
+
+#define BOOST_TEST_MODULE OBJECTIVEFUNCTIONS_SPARSE_EVIDENCE
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include "TestObjectiveFunction.h"
+
+
+using namespace shark;
+using namespace std;
+
+
+BOOST_AUTO_TEST_SUITE (ObjectiveFunctions_NegativeSparseGaussianProcessEvidence)
+
+//with all training points as inducing points, both approximations are exact
+BOOST_AUTO_TEST_CASE( SPARSE_GAUSSIAN_PROCESS_EVIDENCE_EXACT )
+{
+	random::globalRng.seed( 0 );
+	GaussianRbfKernel<> kernel(1.0, true);
+	Wave prob;
+	RegressionDataset trainingData = prob.generateDataset(50,10);
+
+	NegativeGaussianProcessEvidence<> evidence(trainingData, &kernel, true);
+	NegativeSparseGaussianProcessEvidence<> fitc(trainingData, trainingData.inputs(), &kernel, true, true);
+	NegativeSparseGaussianProcessEvidence<> dtc(trainingData, trainingData.inputs(), &kernel, true, false);
+	BOOST_REQUIRE_EQUAL(fitc.numberOfVariables(), evidence.numberOfVariables());
+
+	for(std::size_t test = 0; test != 10; ++test){
+		RealVector parameters(evidence.numberOfVariables());
+		parameters(0) = random::uni(random::globalRng, -2,0);
+		parameters(1) = random::uni(random::globalRng, -3,-1);
+		double exact = evidence.eval(parameters);
+		BOOST_CHECK_SMALL(fitc.eval(parameters) - exact, 1.e-4 * std::abs(exact));
+		BOOST_CHECK_SMALL(dtc.eval(parameters) - exact, 1.e-4 * std::abs(exact));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( SPARSE_GAUSSIAN_PROCESS_EVIDENCE_DERIVATIVE )
+{
+	random::globalRng.seed( 42 );
+	GaussianRbfKernel<> kernel(1.0, true);
+	Wave prob;
+	RegressionDataset trainingData = prob.generateDataset(100,16);
+	Data<RealVector> inducingPoints = prob.generateDataset(10).inputs();
+
+	for(bool useFitc: {true, false}){
+		NegativeSparseGaussianProcessEvidence<> evidence(trainingData, inducingPoints, &kernel, true, useFitc);
+		RealVector parameters(evidence.numberOfVariables());
+		SingleObjectiveFunction::FirstOrderDerivative derivative;
+		double value = evidence.evalDerivative(parameters, derivative);
+		BOOST_CHECK_SMALL(value - evidence.eval(parameters), 1.e-10);
+		for(std::size_t test = 0; test != 100; ++test){
+			for(std::size_t i = 0; i != parameters.size(); ++i){
+				parameters(i) = random::uni(random::globalRng, -2,2);
+			}
+			testDerivative(evidence,parameters,1.e-7);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( SPARSE_GAUSSIAN_PROCESS_EVIDENCE_OPTIMIZATION )
+{
+	random::globalRng.seed( 1 );
+	GaussianRbfKernel<> kernel(100.0, true);
+	Wave prob;
+	RegressionDataset trainingData = prob.generateDataset(500);
+	Data<RealVector> inducingPoints = prob.generateDataset(20).inputs();
+
+	NegativeSparseGaussianProcessEvidence<> evidence(trainingData, inducingPoints, &kernel, true);
+	RealVector params(evidence.numberOfVariables());
+	params(0) = std::log(100.0);
+	params(1) = std::log(1.e-3);
+
+	IRpropPlus rprop;
+	rprop.init(evidence, params);
+	double prevEvidence = rprop.solution().value;
+	for (unsigned int iter = 0; iter < 4; iter++) {
+		for (unsigned int step = 0; step < 10; step++) 
+			rprop.step(evidence);
+		double e = rprop.solution().value;
+		BOOST_CHECK(e < prevEvidence);
+		prevEvidence = e;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -104,4 +104,44 @@ BOOST_AUTO_TEST_CASE( MULTIVARIATENORMAL_Cholesky) {
 	
 }
 
+//batch sampling applies the same transformation to every row of z
+BOOST_AUTO_TEST_CASE( MULTIVARIATENORMAL_Batch) {
+	std::size_t Dimensions = 5;
+	std::size_t Samples = 10000;
+	
+	RealMatrix base(Dimensions,2*Dimensions);
+	for(std::size_t i = 0; i != Dimensions; ++i){
+		for(std::size_t j = 0; j != 2*Dimensions; ++j){
+			base(i,j) = random::gauss(random::globalRng, 0,1);
+		}
+	}
+	RealMatrix covariance=prod(base,trans(base));
+	covariance /= 2.0*Dimensions;
+	
+	MultiVariateNormalDistribution dist(covariance);
+	MultiVariateNormalDistributionCholesky distCholesky(covariance);
+	RealMatrix samples, z, samplesCholesky, zCholesky;
+	dist.generate(random::globalRng, samples, z, Samples);
+	distCholesky.generate(random::globalRng, samplesCholesky, zCholesky, Samples);
+	BOOST_REQUIRE_EQUAL(samples.size1(), Samples);
+	BOOST_REQUIRE_EQUAL(samples.size2(), Dimensions);
+	BOOST_REQUIRE_EQUAL(samplesCholesky.size1(), Samples);
+	BOOST_REQUIRE_EQUAL(samplesCholesky.size2(), Dimensions);
+	
+	RealMatrix A = dist.eigenVectors() % to_diagonal(sqrt(dist.eigenValues()));
+	for(std::size_t i = 0; i != 100; ++i){
+		RealVector y = A % row(z,i);
+		RealVector zi = row(zCholesky,i);
+		RealVector yCholesky = blas::triangular_prod<blas::lower>(distCholesky.lowerCholeskyFactor(),zi);
+		BOOST_CHECK_SMALL(norm_inf(y - row(samples,i)), 1.e-12);
+		BOOST_CHECK_SMALL(norm_inf(yCholesky - row(samplesCholesky,i)), 1.e-12);
+	}
+	
+	//check that covariances are correct
+	RealMatrix covarianceSampled = prod(trans(samples),samples) / double(Samples);
+	RealMatrix covarianceSampledCholesky = prod(trans(samplesCholesky),samplesCholesky) / double(Samples);
+	BOOST_CHECK_SMALL(norm_frobenius(covarianceSampled-covariance)/sqr(Dimensions),1.e-2);
+	BOOST_CHECK_SMALL(norm_frobenius(covarianceSampledCholesky-covariance)/sqr(Dimensions),1.e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,94 +1,78 @@
 #define SHARK_USE_SIMD
-#include <shark/LinAlg/BLAS/blas.h>
+#include <shark/LinAlg/BLAS/remora.hpp>
 #include <shark/LinAlg/BLAS/kernels/conv2d.hpp>
+#include <shark/Models/ConvolutionalModel.h>
 #include <shark/Core/Timer.h>
 #include <iostream>
 using namespace shark;
 using namespace std;
 
-template<class E1, class E2>
+//compares convolving each image of a batch on its own with the batched convolution of Conv2DModel
+template<class T>
 void benchmark(
-	blas::matrix_expression<E1, blas::cpu_tag> const& image,
-	blas::matrix_expression<E2, blas::cpu_tag> const& filter,
+	std::size_t image_size,
+	std::size_t filter_size,
 	std::size_t num_channels,
-	std::size_t num_filters
+	std::size_t num_filters,
+	std::size_t batch_size
 ){
-	std::size_t filter_size = filter().size2();
-	std::size_t image_size1 = image().size1()/num_channels;
-	std::size_t image_size2 = image().size2();
-	std::size_t output_size1 = image_size1 - filter_size +1;
-	std::size_t output_size2 = image_size2 - filter_size +1;
-	typedef typename E1::value_type value_type;
-	
-	blas::matrix<value_type> out(output_size1 * num_filters, output_size2 ,0.0);
-	double minOptTime = std::numeric_limits<double>::max();
-	for(std::size_t i = 0; i != 20; ++i){
-		Timer time;
-		blas::kernels::conv2d(image,filter,out, num_channels, num_filters);
-		minOptTime = min(minOptTime,time.stop());
-	}
-	
-	double mults = output_size1 * output_size2 * filter_size * filter_size * num_filters * num_channels;
-	double flops = mults /1024/1024/minOptTime;
-	
-	std::cout<<output_size1<<"\t"<<filter_size<<"\t"<<num_channels<<"\t"<< num_filters<<"\t";
-	std::cout<<"\t"<<flops<< std::endl;
-}
+	typedef blas::vector<T> VectorType;
+	std::size_t output_size = image_size - filter_size + 1;
+	std::size_t filter_elements = num_filters * num_channels * filter_size * filter_size;
 
+	blas::matrix<T> images(batch_size, num_channels * image_size * image_size);
+	for(std::size_t i = 0; i != images.size1(); ++i){
+		for(std::size_t j = 0; j != images.size2(); ++j){
+			images(i,j)  = 1.0/images.size2()*j + 0.1 - (0.1/batch_size)*i;
+		}
+	}
+	VectorType filters(filter_elements + num_filters, 0.0);
+	for(std::size_t i = 0; i != filter_elements; ++i){
+		filters(i)  = 1.0/filter_elements * i - 0.1;
+	}
+	Conv2DModel<VectorType> model({image_size, image_size, num_channels}, {num_filters, filter_size, filter_size}, Convolution::Valid);
+	model.setParameterVector(filters);
+	auto filter_weights = subrange(filters, 0, filter_elements);
 
-int main(int argc, char **argv) {
-	std::cout<<"Flops"<<std::endl;
-	std::size_t num_channels = 8;
-	std::size_t num_outputs = 16;
-	std::cout<<"performance float"<<std::endl;
-	for(std::size_t filterSize = 4; filterSize != 32; filterSize *= 2){
-		for(std::size_t iter = 0; iter != 6; ++iter){
-			std::size_t sizeOut1 = (3+16 * 2<<iter);
-			std::size_t sizeOut2 = (3+16 * 2<<iter);
-			std::size_t sizeIm1 = sizeOut1 + filterSize-1;
-			std::size_t sizeIm2 = sizeOut2 + filterSize-1;
-
-			blas::matrix<float> image(num_channels * sizeIm1 , sizeIm2);
-			blas::matrix<float> filter(num_channels * num_outputs *  filterSize, filterSize);
-			
-			for(std::size_t i = 0; i != num_channels * sizeIm1; ++i){
-				for(std::size_t j = 0; j != sizeIm2; ++j){
-					image(i,j)  = 1.0/(num_channels * sizeOut1)*i + 0.1 - (0.1/sizeOut2)*j;
-				}
-			}
-			for(std::size_t i = 0; i != num_channels * num_outputs * filterSize; ++i){
-				for(std::size_t j = 0; j != filterSize; ++j){
-					filter(i,j)  = 1.0/(num_channels * filterSize)*i + 0.1 - (0.1/filterSize)*j;
-				}
-			}
-			
-			benchmark(image,filter,num_channels,num_outputs);			
+	blas::matrix<T> out(batch_size, output_size * output_size * num_filters, 0.0);
+	double minSingleTime = std::numeric_limits<double>::max();
+	double minBatchTime = std::numeric_limits<double>::max();
+	for(std::size_t i = 0; i != 10; ++i){
+		Timer time;
+		for(std::size_t b = 0; b != batch_size; ++b){
+			auto out_row = row(out,b);
+			blas::kernels::conv2d(row(images,b), filter_weights, out_row,
+				num_channels, num_filters, image_size, image_size, filter_size, filter_size
+			);
 		}
+		minSingleTime = min(minSingleTime,time.stop());
+	}
+	for(std::size_t i = 0; i != 10; ++i){
+		Timer time;
+		model.eval(images,out);
+		minBatchTime = min(minBatchTime,time.stop());
 	}
-	num_outputs = 8;
-	std::cout<<"performance double"<<std::endl;
-	for(std::size_t filterSize = 4; filterSize != 32; filterSize *= 2){
-		for(std::size_t iter = 0; iter != 6; ++iter){
-			std::size_t sizeOut1 = (3+16 * 2<<iter);
-			std::size_t sizeOut2 = (3+16 * 2<<iter);
-			std::size_t sizeIm1 = sizeOut1 + filterSize-1;
-			std::size_t sizeIm2 = sizeOut2 + filterSize-1;
 
-			blas::matrix<double> image(num_channels * sizeIm1 , sizeIm2);
-			blas::matrix<double> filter(num_channels * num_outputs *  filterSize, filterSize);
-			
-			for(std::size_t i = 0; i != num_channels * sizeIm1; ++i){
-				for(std::size_t j = 0; j != sizeIm2; ++j){
-					image(i,j)  = 1.0/(num_channels * sizeOut1)*i + 0.1 - (0.1/sizeOut2)*j;
-				}
-			}
-			for(std::size_t i = 0; i != num_channels * num_outputs * filterSize; ++i){
-				for(std::size_t j = 0; j != filterSize; ++j){
-					filter(i,j)  = 1.0/(num_channels * filterSize)*i + 0.1 - (0.1/filterSize)*j;
-				}
+	double mults = double(batch_size) * output_size * output_size * filter_size * filter_size * num_filters * num_channels;
+	std::cout<<image_size<<"\t"<<filter_size<<"\t"<<num_channels<<"\t"<< num_filters<<"\t"<<batch_size<<"\t";
+	std::cout<<"\t"<<mults /1024/1024/minSingleTime<<"\t"<<mults /1024/1024/minBatchTime<< std::endl;
+}
+
+template<class T>
+void benchmark(std::size_t num_channels, std::size_t num_filters){
+	std::cout<<"image\tfilter\tchannels\tfilters\tbatch\tMFlops single\tMFlops batched"<<std::endl;
+	for(std::size_t filter_size = 3; filter_size <= 7; filter_size += 2){
+		for(std::size_t image_size = 16; image_size <= 64; image_size *= 2){
+			for(std::size_t batch_size = 1; batch_size <= 256; batch_size *= 4){
+				benchmark<T>(image_size, filter_size, num_channels, num_filters, batch_size);
 			}
-			
-			benchmark(image,filter,num_channels,num_outputs);			
 		}
 	}
 }
+
+int main(int argc, char **argv) {
+	std::cout<<"performance float"<<std::endl;
+	benchmark<float>(8, 16);
+	std::cout<<"performance double"<<std::endl;
+	benchmark<double>(8, 8);
+}
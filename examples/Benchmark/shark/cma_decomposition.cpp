@@ -0,0 +1,50 @@
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Ellipsoid.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Rosenbrock.h>
+
+#include <shark/Core/Timer.h>
+#include <shark/Core/Random.h>
+#include <iostream>
+using namespace shark;
+
+//runs a fixed number of generations and reports the time per generation and the reached function value
+void benchmark(SingleObjectiveFunction& function, bool lazy, bool background, std::size_t generations){
+	random::globalRng.seed(42);
+	function.init();
+	CMA cma;
+	cma.setLazyDecomposition(lazy);
+	cma.setBackgroundDecomposition(background);
+	cma.init(function, function.proposeStartingPoint());
+
+	Timer time;
+	for(std::size_t i = 0; i != generations; ++i){
+		cma.step(function);
+	}
+	double timeTaken = time.stop();
+	std::cout<<"\t"<<timeTaken / generations<<"\t"<<cma.solution().value;
+}
+
+void benchmark(SingleObjectiveFunction& function, std::size_t generations){
+	std::cout<<function.numberOfVariables();
+	benchmark(function, false, false, generations);
+	benchmark(function, true, false, generations);
+	benchmark(function, true, true, generations);
+	std::cout<<std::endl;
+}
+
+int main(int argc, char **argv) {
+	std::size_t dimensions[] = {100, 250, 500, 1000};
+	std::size_t generations = 100;
+	std::cout<<"time per generation and function value after "<<generations<<" generations"<<std::endl;
+	std::cout<<"n\teager\t\tlazy\t\tlazy+background"<<std::endl;
+	std::cout<<"Ellipsoid"<<std::endl;
+	for(std::size_t n: dimensions){
+		Ellipsoid function(n);
+		benchmark(function, generations);
+	}
+	std::cout<<"Rosenbrock"<<std::endl;
+	for(std::size_t n: dimensions){
+		Rosenbrock function(n);
+		benchmark(function, generations);
+	}
+}
@@ -1,4 +1,4 @@
-#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMD.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMDHOY.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculatorMDWFG.h>
 
 #include <shark/Core/Timer.h>
@@ -13,7 +13,7 @@ std::vector<RealVector> createRandomFront(std::size_t numPoints, std::size_t num
 		double norm = 0;
 		double sum = 0;
 		for(std::size_t j = 0; j != numObj; ++j){
-			points[i](j) = 1- random::uni(0.0, 1.0-sum);
+			points[i](j) = 1- random::uni(random::globalRng, 0.0, 1.0-sum);
 			sum += 1-points[i](j);
 			norm += std::pow(points[i](j),p);
 		}
@@ -26,14 +26,14 @@ std::vector<RealVector> createRandomFront(std::size_t numPoints, std::size_t num
 int main(int argc, char **argv) {
 	
 	
-	random::seed(42);
+	random::globalRng.seed(42);
 	for(std::size_t dim = 4; dim != 9; ++dim){
 		std::cout<<"dimensions = " <<dim<<std::endl;
 		RealVector reference(dim,1.0);
 		for(unsigned int numPoints = 10; numPoints != 110; numPoints +=10){
 			auto set = createRandomFront(numPoints,dim,2);
 			
-			HypervolumeCalculatorMD algorithm1;
+			HypervolumeCalculatorMDHOY algorithm1;
 			HypervolumeCalculatorMDWFG algorithm2;
 			
 			double val1= 0;
@@ -1,9 +1,9 @@
 #include <shark/Data/SparseData.h>
 #include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
-#include <shark/ObjectiveFunctions/Regularizer.h>
+#include <shark/ObjectiveFunctions/LogisticRegressionError.h>
 
 #include <shark/Algorithms/GradientDescent/LBFGS.h>
-#include <shark/ObjectiveFunctions/ErrorFunction.h>
+#include <shark/Algorithms/GradientDescent/TrustRegionNewton.h>
 #include <shark/Models/LinearModel.h>
 
 #include <shark/Core/Timer.h>
@@ -20,9 +20,7 @@ int main(int argc, char **argv) {
 	
 	//Setting up the problem
 	model.decisionFunction().setStructure(inputDimension(data),numberOfClasses(data),true);
-	TwoNormRegularizer regularizer;
-	ErrorFunction error(data,&model.decisionFunction(),&loss);
-	error.setRegularizer(alpha,&regularizer);
+	LogisticRegressionError<> error(data,true,alpha);
 	
 	//solving
 	Timer time;
@@ -36,4 +34,18 @@ int main(int argc, char **argv) {
 	
 	cout << "Cross-Entropy: " << loss(data.labels(),model.decisionFunction()(data.inputs()))<<std::endl;
 	cout << "Time:\n" << time_taken << endl;
-}
\ No newline at end of file
+	
+	//the same problem with the Hessian-free trust region Newton method
+	LogisticRegressionError<> tronError(data,true,alpha);
+	Timer tronTime;
+	TrustRegionNewton tron;
+	tron.init(tronError);
+	for(std::size_t i = 0; i != 20 && !tron.converged(); ++i){
+		tron.step(tronError);
+	}
+	model.setParameterVector(tron.solution().point);
+	double tron_time_taken = tronTime.stop();
+	
+	cout << "Cross-Entropy (TRON): " << loss(data.labels(),model.decisionFunction()(data.inputs()))<<std::endl;
+	cout << "Time (TRON):\n" << tron_time_taken << endl;
+}
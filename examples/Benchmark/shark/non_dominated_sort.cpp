@@ -0,0 +1,64 @@
+#include <shark/Algorithms/DirectSearch/Operators/Domination/FastNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/DCNonDominatedSort.h>
+#include <shark/Algorithms/DirectSearch/Operators/Domination/MatrixNonDominatedSort.h>
+
+#include <shark/Core/Timer.h>
+#include <shark/Core/Random.h>
+#include <iostream>
+using namespace shark;
+
+//points are drawn uniformly such that there are many fronts, as is typical for NSGA-II/III offspring populations
+RealMatrix createRandomPoints(std::size_t numPoints, std::size_t numObj){
+	RealMatrix points(numPoints,numObj);
+	for (std::size_t i = 0; i != numPoints; ++i) {
+		for(std::size_t j = 0; j != numObj; ++j){
+			points(i,j) = random::uni(random::globalRng, 0.0, 1.0);
+		}
+	}
+	return points;
+}
+
+template<class Algorithm, class Points>
+double benchmark(Algorithm algorithm, Points const& points, std::size_t numPoints){
+	std::vector<unsigned int> ranks(numPoints);
+	double minTime = std::numeric_limits<double>::max();
+	for(std::size_t i = 0; i != 3; ++i){
+		Timer time;
+		algorithm(points, ranks);
+		minTime = std::min(minTime,time.stop());
+	}
+	return minTime;
+}
+
+int main(int argc, char **argv) {
+	random::globalRng.seed(42);
+	std::size_t bruteForceThresholds[] = {0, 64, 256, 1024};
+	for(std::size_t dim = 2; dim != 8; ++dim){
+		std::cout<<"objectives = " <<dim<<std::endl;
+		std::cout<<"points\tfast\tdc";
+		for(std::size_t bruteForce: bruteForceThresholds)
+			std::cout<<"\tmatrix("<<bruteForce<<")";
+		std::cout<<"\tmatrix-serial"<<std::endl;
+		for(std::size_t numPoints = 50; numPoints <= 51200; numPoints *= 2){
+			RealMatrix points = createRandomPoints(numPoints,dim);
+			std::vector<RealVector> pointVector(numPoints);
+			for(std::size_t i = 0; i != numPoints; ++i)
+				pointVector[i] = row(points,i);
+
+			std::cout<<numPoints;
+			//the quadratic algorithm is skipped for large point sets
+			if(numPoints <= 6400)
+				std::cout<<"\t"<<benchmark([](std::vector<RealVector> const& p, std::vector<unsigned int>& r){fastNonDominatedSort(p,r);}, pointVector, numPoints);
+			else
+				std::cout<<"\t-";
+			std::cout<<"\t"<<benchmark([](std::vector<RealVector> const& p, std::vector<unsigned int>& r){dcNonDominatedSort(p,r);}, pointVector, numPoints);
+			for(std::size_t bruteForce: bruteForceThresholds){
+				BaseMatrixNonDominatedSort sorter(bruteForce);
+				std::cout<<"\t"<<benchmark(sorter, points, numPoints);
+			}
+			BaseMatrixNonDominatedSort serialSorter(256, std::numeric_limits<std::size_t>::max());
+			std::cout<<"\t"<<benchmark(serialSorter, points, numPoints)<<std::endl;
+		}
+		std::cout<<std::endl;
+	}
+}
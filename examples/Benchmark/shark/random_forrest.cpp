@@ -2,7 +2,9 @@
 #include <shark/Data/SparseData.h>
 #include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
 #include <shark/Algorithms/Trainers/RFTrainer.h>
+#include <shark/Algorithms/Trainers/GradientBoostingTrainer.h>
 #include <shark/Models/Kernels/GaussianRbfKernel.h>
 
 #include <shark/Core/Timer.h>
@@ -25,4 +27,16 @@ int main(int argc, char **argv) {
 		
 	ZeroOneLoss<> loss;
 	cout <<  time_taken <<" "<< 1.0 - loss(data.labels(),model(data.inputs()))<< " "<< 1.0 - loss(test.labels(),model(test.inputs()))<<std::endl;
+	
+	//gradient boosted trees on the same split
+	CrossEntropy crossEntropy;
+	Classifier<GradientBoostedTrees> boosted;
+	GradientBoostingTrainer<unsigned int> boostingTrainer(&crossEntropy);
+	boostingTrainer.setNumberOfRounds(200);
+	boostingTrainer.setMaxDepth(8);
+	
+	Timer boostingTime;
+	boostingTrainer.train(boosted, data);
+	time_taken = boostingTime.stop();
+	cout <<  time_taken <<" "<< 1.0 - loss(data.labels(),boosted(data.inputs()))<< " "<< 1.0 - loss(test.labels(),boosted(test.inputs()))<<std::endl;
 }
\ No newline at end of file
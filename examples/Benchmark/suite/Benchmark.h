@@ -0,0 +1,144 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Minimal benchmark runner with robust statistics
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_BENCHMARK_BENCHMARK_H
+#define SHARK_BENCHMARK_BENCHMARK_H
+
+#include <shark/Core/Random.h>
+#include <shark/Core/Timer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace benchmark{
+
+/// \brief Prepares the benchmark for a given problem size and returns the function to be timed.
+///
+/// The setup is not timed. Everything it creates should be captured by value in the returned function.
+typedef std::function<std::function<void()>(std::size_t size)> Setup;
+
+struct Case{
+	std::string name;
+	std::vector<std::size_t> sizes;
+	Setup setup;
+};
+
+/// \brief Timing statistics of a single case and size.
+///
+/// Median and interquartile range are used as they are robust against outliers
+/// which are common in timings, for example due to scheduling.
+struct Result{
+	std::string name;
+	std::size_t size;
+	std::size_t repetitions;
+	double median;
+	double q1;
+	double q3;
+
+	double iqr()const{
+		return q3 - q1;
+	}
+};
+
+inline std::vector<Case>& registry(){
+	static std::vector<Case> cases;
+	return cases;
+}
+
+/// \brief Registers a benchmark at static initialization time.
+struct Registration{
+	Registration(std::string const& name, std::vector<std::size_t> const& sizes, Setup const& setup){
+		registry().push_back(Case{name, sizes, setup});
+	}
+};
+
+/// \brief Linear interpolated quantile of sorted values.
+inline double quantile(std::vector<double> const& sorted, double p){
+	double pos = p * (sorted.size() - 1);
+	std::size_t i = static_cast<std::size_t>(pos);
+	if(i + 1 >= sorted.size())
+		return sorted.back();
+	double t = pos - i;
+	return (1 - t) * sorted[i] + t * sorted[i + 1];
+}
+
+/// \brief Runs the case for the given size.
+///
+/// The global random number generator is seeded before the setup, thus the synthetic
+/// datasets are identical between runs. After one untimed warm-up run, the function is
+/// timed repetitions times.
+inline Result run(Case const& benchmarkCase, std::size_t size, std::size_t repetitions){
+	shark::random::globalRng.seed(42);
+	std::function<void()> f = benchmarkCase.setup(size);
+	f();
+	std::vector<double> times(repetitions);
+	for(double& t: times){
+		shark::Timer timer;
+		f();
+		t = timer.stop();
+	}
+	std::sort(times.begin(),times.end());
+	return Result{benchmarkCase.name, size, repetitions, quantile(times, 0.5), quantile(times, 0.25), quantile(times, 0.75)};
+}
+
+/// \brief Writes results as whitespace separated table. Lines starting with # are comments.
+inline void write(std::ostream& stream, std::vector<Result> const& results){
+	stream<<"# name size repetitions median q1 q3\n";
+	stream.precision(9);
+	for(auto const& r: results){
+		stream<<r.name<<" "<<r.size<<" "<<r.repetitions<<" "<<r.median<<" "<<r.q1<<" "<<r.q3<<"\n";
+	}
+}
+
+/// \brief Reads results written by write().
+inline std::vector<Result> read(std::istream& stream){
+	std::vector<Result> results;
+	std::string line;
+	while(std::getline(stream,line)){
+		if(line.empty() || line[0] == '#') continue;
+		std::istringstream lineStream(line);
+		Result r;
+		if(lineStream>>r.name>>r.size>>r.repetitions>>r.median>>r.q1>>r.q3)
+			results.push_back(r);
+	}
+	return results;
+}
+
+}
+
+#endif
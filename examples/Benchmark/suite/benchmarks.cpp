@@ -0,0 +1,275 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Benchmark suite covering the performance critical parts of Shark
+ *
+ * Usage: SharkBenchmarks [--filter substring] [--repetitions n] [--quick] [--output file]
+ *
+ * Every case runs on fixed-seed synthetic data for a list of problem sizes. The
+ * results can be compared against an earlier run using CompareBenchmarks.
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/KernelMatrix.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Data/Csv.h>
+#include <shark/Data/SparseData.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Models/NearestNeighborModel.h>
+#include <shark/Models/Trees/KDTree.h>
+#include <shark/Algorithms/NearestNeighbors/CompactTreeNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/SimpleNearestNeighbors.h>
+#include <shark/Algorithms/NearestNeighbors/TreeNearestNeighbors.h>
+#include <shark/Algorithms/Trainers/CSvmTrainer.h>
+#include <shark/Algorithms/Trainers/RFTrainer.h>
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Ellipsoid.h>
+#include <shark/Unsupervised/RBM/BinaryRBM.h>
+#include <shark/Unsupervised/RBM/Sampling/GibbsOperator.h>
+
+#include <memory>
+
+using namespace shark;
+
+namespace{
+
+RealMatrix randomMatrix(std::size_t rows, std::size_t columns){
+	RealMatrix A(rows, columns);
+	for(std::size_t i = 0; i != rows; ++i){
+		for(std::size_t j = 0; j != columns; ++j){
+			A(i,j) = random::gauss(random::globalRng, 0, 1);
+		}
+	}
+	return A;
+}
+
+//blas kernels
+benchmark::Registration gemm("blas/gemm", {128, 256, 512, 1024}, [](std::size_t n){
+	RealMatrix A = randomMatrix(n,n);
+	RealMatrix B = randomMatrix(n,n);
+	auto C = std::make_shared<RealMatrix>(n,n);
+	return [=]{ noalias(*C) = prod(A,B); };
+});
+
+benchmark::Registration potrf("blas/potrf", {128, 256, 512, 1024}, [](std::size_t n){
+	RealMatrix X = randomMatrix(n,n);
+	RealMatrix A = prod(X,trans(X)) + 0.1 * blas::identity_matrix<double>(n);
+	auto L = std::make_shared<RealMatrix>(n,n);
+	return [=]{
+		noalias(*L) = A;
+		blas::kernels::potrf<blas::lower>(*L);
+	};
+});
+
+//computing kernel matrix rows as done inside the SVM solvers
+benchmark::Registration kernelRows("kernel/rows", {1000, 10000, 50000}, [](std::size_t n){
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(0.5);
+	Data<RealVector> data = NormalDistributedPoints(20).generateDataset(n);
+	auto matrix = std::make_shared<KernelMatrix<RealVector, float> >(*kernel, data);
+	auto row = std::make_shared<std::vector<float> >(n);
+	return [kernel, matrix, row, n]{
+		for(std::size_t i = 0; i != 100; ++i)
+			matrix->row(i * (n / 100), 0, n, row->data());
+	};
+});
+
+//QP solvers
+benchmark::Registration csvm("qp/csvm", {500, 1000, 2000, 4000}, [](std::size_t n){
+	auto kernel = std::make_shared<GaussianRbfKernel<> >(1.0);
+	ClassificationDataset data = Chessboard().generateDataset(n);
+	return [=]{
+		KernelClassifier<RealVector> model;
+		CSvmTrainer<RealVector> trainer(kernel.get(), 10.0, true);
+		trainer.train(model, data);
+	};
+});
+
+//trees
+benchmark::Registration randomForest("trees/rf", {1000, 5000, 20000}, [](std::size_t n){
+	ClassificationDataset data = Chessboard().generateDataset(n);
+	return [=]{
+		RFClassifier<unsigned int> model;
+		RFTrainer<unsigned int> trainer;
+		trainer.setNTrees(32);
+		trainer.train(model, data);
+	};
+});
+
+//nearest neighbours, n queries against n points
+benchmark::Registration knnBruteForce("knn/brute-force", {1000, 5000, 20000}, [](std::size_t n){
+	auto kernel = std::make_shared<LinearKernel<RealVector> >();
+	ClassificationDataset data = Chessboard().generateDataset(n);
+	auto algorithm = std::make_shared<SimpleNearestNeighbors<RealVector,unsigned int> >(data, kernel.get());
+	//the algorithm only stores a pointer to the kernel, thus it must be kept alive explicitly
+	return [kernel, algorithm, data]{
+		NearestNeighborModel<RealVector, unsigned int> model(algorithm.get(), 10);
+		Data<unsigned int> predictions = model(data.inputs());
+	};
+});
+
+benchmark::Registration knnKDTree("knn/kdtree", {1000, 5000, 20000}, [](std::size_t n){
+	//the tree and the algorithm keep references to the data
+	auto data = std::make_shared<ClassificationDataset>(Chessboard().generateDataset(n));
+	auto tree = std::make_shared<KDTree<RealVector> >(data->inputs());
+	auto algorithm = std::make_shared<TreeNearestNeighbors<RealVector,unsigned int> >(*data, tree.get());
+	return [tree, algorithm, data]{
+		NearestNeighborModel<RealVector, unsigned int> model(algorithm.get(), 10);
+		Data<unsigned int> predictions = model(data->inputs());
+	};
+});
+
+benchmark::Registration knnCompactTree("knn/compact-tree", {1000, 5000, 20000}, [](std::size_t n){
+	ClassificationDataset data = Chessboard().generateDataset(n);
+	auto algorithm = std::make_shared<CompactTreeNearestNeighbors<unsigned int> >(data);
+	return [algorithm, data]{
+		NearestNeighborModel<RealVector, unsigned int> model(algorithm.get(), 10);
+		Data<unsigned int> predictions = model(data.inputs());
+	};
+});
+
+//direct search, 10 generations on the ellipsoid in dimension n
+benchmark::Registration cma("directsearch/cma", {10, 100, 500}, [](std::size_t n){
+	auto function = std::make_shared<Ellipsoid>(n);
+	return [=]{
+		CMA optimizer;
+		optimizer.init(*function, RealVector(n, 1.0));
+		for(std::size_t i = 0; i != 10; ++i)
+			optimizer.step(*function);
+	};
+});
+
+//hypervolume of n points on the sphere in 5 dimensions
+benchmark::Registration hypervolume("hypervolume/5d", {20, 50, 100}, [](std::size_t n){
+	std::vector<RealVector> points(n, RealVector(5));
+	for(auto& point: points){
+		for(auto& x: point)
+			x = std::abs(random::gauss(random::globalRng, 0, 1));
+		point /= norm_2(point);
+	}
+	RealVector reference(5, 1.1);
+	return [=]{
+		HypervolumeCalculator calculator;
+		volatile double volume = calculator(points, reference);
+		(void)volume;
+	};
+});
+
+//importers, n rows with 20 features
+benchmark::Registration importCsv("import/csv", {1000, 10000, 100000}, [](std::size_t n){
+	std::ostringstream stream;
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != 20; ++j)
+			stream<<random::gauss(random::globalRng, 0, 1)<<(j == 19? '\n' : ',');
+	}
+	std::string contents = stream.str();
+	return [=]{
+		Data<RealVector> data;
+		csvStringToData(data, contents, ',');
+	};
+});
+
+benchmark::Registration importLibsvm("import/libsvm", {1000, 10000, 100000}, [](std::size_t n){
+	std::ostringstream stream;
+	for(std::size_t i = 0; i != n; ++i){
+		stream<<(i % 2);
+		for(std::size_t j = 1; j <= 20; j += 1 + i % 3)
+			stream<<" "<<j<<":"<<random::gauss(random::globalRng, 0, 1);
+		stream<<'\n';
+	}
+	std::string contents = stream.str();
+	return [=]{
+		std::istringstream input(contents);
+		ClassificationDataset data;
+		importSparseData(data, input);
+	};
+});
+
+//rbm, 10 steps of block gibbs sampling of a batch of 100 chains with n hidden and n visible units
+benchmark::Registration rbmSampling("rbm/gibbs", {50, 200, 500}, [](std::size_t n){
+	auto rbm = std::make_shared<BinaryRBM>(random::globalRng);
+	rbm->setStructure(n,n);
+	initRandomNormal(*rbm,0.1);
+	RealMatrix states(100,n);
+	for(std::size_t i = 0; i != 100; ++i){
+		for(std::size_t j = 0; j != n; ++j)
+			states(i,j) = random::coinToss(random::globalRng, 0.5);
+	}
+	return [=]{
+		BinaryGibbsOperator gibbs(rbm.get());
+		BinaryGibbsOperator::HiddenSampleBatch hiddenBatch(100,n);
+		BinaryGibbsOperator::VisibleSampleBatch visibleBatch(100,n);
+		gibbs.createSample(hiddenBatch,visibleBatch,states);
+		gibbs.stepVH(hiddenBatch,visibleBatch,10,blas::repeat(1.0,100));
+	};
+});
+
+}
+
+int main(int argc, char** argv){
+	std::string filter;
+	std::string output;
+	std::size_t repetitions = 10;
+	bool quick = false;
+	for(int i = 1; i < argc; ++i){
+		std::string arg = argv[i];
+		if(arg == "--filter" && i + 1 < argc)
+			filter = argv[++i];
+		else if(arg == "--repetitions" && i + 1 < argc)
+			repetitions = std::stoul(argv[++i]);
+		else if(arg == "--output" && i + 1 < argc)
+			output = argv[++i];
+		else if(arg == "--quick")
+			quick = true;
+		else{
+			std::cerr<<"usage: "<<argv[0]<<" [--filter substring] [--repetitions n] [--quick] [--output file]"<<std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<benchmark::Result> results;
+	for(auto const& benchmarkCase: benchmark::registry()){
+		if(benchmarkCase.name.find(filter) == std::string::npos) continue;
+		for(std::size_t size: benchmarkCase.sizes){
+			results.push_back(benchmark::run(benchmarkCase, size, repetitions));
+			benchmark::Result const& r = results.back();
+			std::cerr<<r.name<<"\t"<<r.size<<"\t"<<r.median<<"s\t(IQR "<<r.iqr()<<"s)"<<std::endl;
+			if(quick) break;
+		}
+	}
+
+	if(output.empty()){
+		benchmark::write(std::cout, results);
+	}else{
+		std::ofstream file(output);
+		benchmark::write(file, results);
+	}
+}
@@ -0,0 +1,85 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Compares two result files of SharkBenchmarks and flags regressions
+ *
+ * Usage: CompareBenchmarks baseline current [tolerance]
+ *
+ * A case is flagged as regression, if the median of the current run is slower than the
+ * baseline by more than the relative tolerance (default 0.1) and the difference exceeds
+ * the larger of both interquartile ranges, i.e. it is not explained by timing noise.
+ * Improvements are reported the same way. The exit code is 1 if any regression was found.
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+
+int main(int argc, char** argv){
+	if(argc < 3 || argc > 4){
+		std::cerr<<"usage: "<<argv[0]<<" baseline current [tolerance]"<<std::endl;
+		return 2;
+	}
+	std::ifstream baselineFile(argv[1]);
+	std::ifstream currentFile(argv[2]);
+	if(!baselineFile || !currentFile){
+		std::cerr<<"could not open result files"<<std::endl;
+		return 2;
+	}
+	double tolerance = argc == 4? std::stod(argv[3]) : 0.1;
+	std::vector<benchmark::Result> baseline = benchmark::read(baselineFile);
+	std::vector<benchmark::Result> current = benchmark::read(currentFile);
+
+	std::size_t regressions = 0;
+	std::printf("%-24s %8s %12s %12s %8s\n", "name", "size", "baseline", "current", "change");
+	for(auto const& c: current){
+		auto b = std::find_if(baseline.begin(), baseline.end(), [&](benchmark::Result const& r){
+			return r.name == c.name && r.size == c.size;
+		});
+		if(b == baseline.end()){
+			std::printf("%-24s %8zu %12s %12.6g %8s\n", c.name.c_str(), c.size, "-", c.median, "new");
+			continue;
+		}
+		double change = c.median / b->median - 1.0;
+		bool significant = std::abs(c.median - b->median) > std::max(b->iqr(), c.iqr());
+		char const* flag = "";
+		if(significant && change > tolerance){
+			flag = "REGRESSION";
+			++regressions;
+		}else if(significant && change < -tolerance){
+			flag = "improved";
+		}
+		std::printf("%-24s %8zu %12.6g %12.6g %+7.1f%% %s\n", c.name.c_str(), c.size, b->median, c.median, 100 * change, flag);
+	}
+	if(regressions != 0){
+		std::printf("%zu regressions found\n", regressions);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,91 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Agglomerative hierarchical clustering
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_AGGLOMERATIVECLUSTERING_H
+#define SHARK_ALGORITHMS_AGGLOMERATIVECLUSTERING_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Data/Dataset.h>
+#include <shark/Models/Trees/ClusterTree.h>
+
+namespace shark{
+
+/// \brief Linkage criteria of the agglomerative clustering.
+enum Linkage{
+	WardLinkage,    ///< increase of the within-cluster sum of squares
+	AverageLinkage, ///< mean Euclidean distance between the points of both clusters
+	SingleLinkage   ///< smallest Euclidean distance between the points of both clusters
+};
+
+///
+/// \brief Bottom-up hierarchical clustering of vector-valued data.
+///
+/// \par
+/// Starting with every point as its own cluster, the two closest clusters w.r.t.
+/// the linkage criterion are merged until a single cluster remains.
+/// The result is the list of n-1 merges sorted by distance, see ClusterMerge.
+/// It can be turned into a ClusterTree for use with HierarchicalClustering or
+/// into flat cluster labels using cutDendrogram.
+///
+/// \par
+/// Ward and average linkage are computed with the nearest-neighbor-chain algorithm,
+/// which needs O(n^2) time. Ward linkage stores only the cluster centroids, the
+/// reported distance is \f$ \sqrt{2 \frac{|A||B|}{|A|+|B|}} \|c_A - c_B\| \f$ which
+/// is the Euclidean distance for two single points. Average linkage keeps the full
+/// distance matrix, which is computed block-wise by matrix products, and thus needs O(n^2) memory.
+///
+/// \par
+/// Single linkage is computed from the minimum spanning tree of the points, found by
+/// Boruvka's algorithm. In every round, the closest point of another component is searched
+/// for every point using tiles of the distance matrix, which are computed in parallel.
+/// Only O(n) memory is needed.
+///
+/// \param data     vector-valued data to be clustered
+/// \param linkage  linkage criterion
+/// \return         the n-1 merges of the hierarchy
+SHARK_EXPORT_SYMBOL std::vector<ClusterMerge> agglomerativeClustering(Data<RealVector> const& data, Linkage linkage = WardLinkage);
+
+///
+/// \brief Assigns the points of a cluster hierarchy to numClusters clusters.
+///
+/// The hierarchy is cut by undoing the last numClusters-1 merges. The clusters
+/// are numbered in the same order as the leaves of the ClusterTree.
+///
+/// \param merges       merges of the hierarchy as returned by agglomerativeClustering
+/// \param numClusters  number of clusters
+/// \return             cluster label of every point
+SHARK_EXPORT_SYMBOL std::vector<unsigned int> cutDendrogram(std::vector<ClusterMerge> const& merges, std::size_t numClusters);
+
+} // namespace shark
+#endif
@@ -0,0 +1,264 @@
+/*!
+ * \brief       Asynchronous steady-state driver for the CMA-ES variants
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SHARK_ALGORITHMS_DIRECT_SEARCH_ASYNCHRONOUS_CMA_H
+#define SHARK_ALGORITHMS_DIRECT_SEARCH_ASYNCHRONOUS_CMA_H
+
+#include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
+#include <shark/Core/Exception.h>
+#include <shark/Core/Random.h>
+#include <shark/Core/Profiler.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+namespace shark {
+
+/// \brief Asynchronous steady-state driver for the CMA-ES variants CMA, VDCMA and LMCMA.
+///
+/// In the generational algorithms sampling, evaluating the lambda offspring and updating the
+/// search distribution form one barrier. If evaluation times differ, most workers are idle
+/// while waiting for the slowest evaluation of a generation.
+///
+/// This driver instead keeps a pool of worker threads busy. Every worker pulls an offspring from a
+/// queue filled by the search distribution, evaluates it and returns the result. A call to step()
+/// waits until lambda new evaluations have arrived and updates the search distribution with them.
+/// Every evaluated offspring enters exactly one update. Offspring sampled before an update are not
+/// discarded, but enter the next update, similar to injected solutions: their chromosomes are
+/// recomputed from their search points with respect to the current distribution and the
+/// steps are shortened to a bounded Mahalanobis length before the update.
+/// The queue of not yet evaluated offspring is refilled from the updated distribution.
+///
+/// An update is triggered by lambda and not already by mu new evaluations. updatePopulation() ranks a
+/// complete population of lambda offspring, and filling it up with offspring that already entered an
+/// earlier update counts them twice, which lets the step size collapse as the number of workers grows.
+///
+/// The objective function must be thread safe, i.e. announce IS_THREAD_SAFE.
+/// The workers are started by the first call to step() and are stopped by init(), stopWorkers() or
+/// on destruction. Between two calls to step() the workers only start new evaluations as long as
+/// less than lambda results are waiting. If an evaluation throws, the workers are stopped and the
+/// exception is rethrown by step(). Noise handling of the CMA is not supported in this mode.
+///
+/// \tparam CMAType The algorithm to drive. Must provide generateOffspring(), updatePopulation() and rebaseOffspring().
+template<class CMAType>
+class AsynchronousCMA : public CMAType{
+private:
+	typedef typename CMAType::IndividualType IndividualType;
+public:
+	typedef typename CMAType::ObjectiveFunctionType ObjectiveFunctionType;
+	typedef typename CMAType::SearchPointType SearchPointType;
+
+	/// \brief Default c'tor. Uses as many workers as there are hardware threads.
+	AsynchronousCMA(random::rng_type& rng = random::globalRng)
+	: CMAType(rng)
+	, m_numberOfWorkers(std::max(1u,std::thread::hardware_concurrency()))
+	, mep_function(nullptr)
+	, m_stop(false)
+	, m_error(nullptr)
+	, m_numberOfEvaluations(0)
+	, m_generation(0){}
+
+	~AsynchronousCMA(){
+		stopWorkers();
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "Asynchronous" + CMAType::name(); }
+
+	/// \brief Returns the number of worker threads evaluating offspring.
+	std::size_t numberOfWorkers()const{
+		return m_numberOfWorkers;
+	}
+
+	/// \brief Sets the number of worker threads. Takes effect with the next call to init().
+	void setNumberOfWorkers(std::size_t numberOfWorkers){
+		SHARK_RUNTIME_CHECK(numberOfWorkers > 0, "At least one worker is needed");
+		m_numberOfWorkers = numberOfWorkers;
+	}
+
+	/// \brief Returns the number of offspring evaluated by the workers since init().
+	std::size_t numberOfEvaluatedOffspring()const{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_numberOfEvaluations;
+	}
+
+	using CMAType::init;
+	/// \brief Stops the workers and initializes the algorithm for the supplied objective function.
+	void init(ObjectiveFunctionType const& function, SearchPointType const& p){
+		stopWorkers();
+		CMAType::init(function, p);
+	}
+
+	/// \brief Stops the workers and forwards the arguments to the init() of the driven algorithm.
+	template<class Arg, class... Args>
+	void init(ObjectiveFunctionType const& function, SearchPointType const& p, Arg&& arg, Args&&... args){
+		stopWorkers();
+		CMAType::init(function, p, std::forward<Arg>(arg), std::forward<Args>(args)...);
+	}
+
+	/// \brief Waits for lambda new evaluations and updates the search distribution.
+	///
+	/// If the evaluation of an offspring threw an exception, the workers are stopped and the exception is rethrown.
+	void step(ObjectiveFunctionType const& function){
+		SHARK_PROFILE_REGION("AsynchronousCMA::step");
+		if(mep_function != &function){
+			SHARK_RUNTIME_CHECK(function.isThreadSafe(), "Asynchronous evaluation requires a thread safe objective function");
+			stopWorkers();
+			startWorkers(function);
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_resultArrived.wait(lock,[this]{return m_error || m_evaluated.size() >= this->lambda();});
+		if(m_error){
+			std::exception_ptr error = m_error;
+			lock.unlock();
+			stopWorkers();
+			std::rethrow_exception(error);
+		}
+
+		//the lambda first results form the population, evaluations finished later enter the next update.
+		//Offspring sampled from an earlier distribution are expressed in terms of the current one
+		std::vector<Sample> population(m_evaluated.begin(), m_evaluated.begin() + this->lambda());
+		m_evaluated.erase(m_evaluated.begin(), m_evaluated.begin() + this->lambda());
+		std::vector<IndividualType> offspring;
+		offspring.reserve(population.size());
+		for(Sample const& sample: population){
+			offspring.push_back(sample.individual);
+			if(sample.generation != m_generation)
+				this->rebaseOffspring(offspring.back());
+		}
+		//update and replace the pending offspring by samples of the new distribution
+		this->updatePopulation(offspring);
+		++m_generation;
+		m_pending.clear();
+
+		//rebasing might have shortened the step of the best individual, report the evaluated point
+		auto best = std::min_element(population.begin(), population.end(),[](Sample const& a, Sample const& b){
+			return a.individual.penalizedFitness() < b.individual.penalizedFitness();
+		});
+		this->m_best.point = best->individual.searchPoint();
+		this->m_best.value = best->individual.unpenalizedFitness();
+		m_resultsConsumed.notify_all();
+	}
+
+	/// \brief Stops all workers. Evaluations in progress are finished and discarded.
+	void stopWorkers(){
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_resultsConsumed.notify_all();
+		for(auto& worker: m_workers)
+			worker.join();
+		m_workers.clear();
+		m_pending.clear();
+		m_evaluated.clear();
+		mep_function = nullptr;
+		m_stop = false;
+		m_error = nullptr;
+		m_numberOfEvaluations = 0;
+		m_generation = 0;
+	}
+
+private:
+	/// \brief An offspring together with the number of updates before it was sampled.
+	struct Sample{
+		IndividualType individual;
+		std::size_t generation;
+	};
+
+	void startWorkers(ObjectiveFunctionType const& function){
+		mep_function = &function;
+		for(std::size_t i = 0; i != m_numberOfWorkers; ++i){
+			m_workers.emplace_back([this]{work();});
+		}
+	}
+
+	void work(){
+		PenalizingEvaluator evaluator;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while(!m_stop){
+			//lambda waiting results suffice for the next update, so wait for it
+			m_resultsConsumed.wait(lock,[this]{return m_stop || m_evaluated.size() < this->lambda();});
+			if(m_stop) break;
+			//sampling uses the state and the random number generator of the algorithm
+			if(m_pending.empty()){
+				for(IndividualType& individual: this->generateOffspring())
+					m_pending.push_back(Sample{std::move(individual), m_generation});
+			}
+			Sample sample = std::move(m_pending.front());
+			m_pending.pop_front();
+
+			//the evaluation counter of the function is atomic, so workers can evaluate concurrently
+			lock.unlock();
+			std::exception_ptr error;
+			try{
+				evaluator(*mep_function, sample.individual);
+			}catch(...){
+				error = std::current_exception();
+			}
+			lock.lock();
+
+			//an exception must not leave the thread. Keep the first one for step() and stop all workers
+			if(error){
+				if(!m_error)
+					m_error = error;
+				m_stop = true;
+				m_resultArrived.notify_all();
+				m_resultsConsumed.notify_all();
+			}
+			if(m_stop) break;
+			m_evaluated.push_back(std::move(sample));
+			++m_numberOfEvaluations;
+			m_resultArrived.notify_one();
+		}
+	}
+
+	std::size_t m_numberOfWorkers;
+	ObjectiveFunctionType const* mep_function;///< function evaluated by the running workers
+	std::vector<std::thread> m_workers;
+
+	mutable std::mutex m_mutex;///< guards the state of the algorithm and the queues
+	std::condition_variable m_resultArrived;
+	std::condition_variable m_resultsConsumed;
+	bool m_stop;
+	std::exception_ptr m_error;///< first exception thrown by an evaluation, rethrown by step()
+
+	std::deque<Sample> m_pending;///< sampled offspring waiting for evaluation
+	std::vector<Sample> m_evaluated;///< evaluated offspring not yet used for an update
+	std::size_t m_numberOfEvaluations;
+	std::size_t m_generation;///< number of updates of the search distribution since the workers started
+};
+
+}
+#endif
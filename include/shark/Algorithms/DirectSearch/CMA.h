@@ -42,6 +42,8 @@
 #include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
 #include <shark/Algorithms/DirectSearch/Individual.h>
 
+#include <future>
+
 
 namespace shark {
 /// \brief Implements the CMA-ES.
@@ -62,6 +64,12 @@ namespace shark {
 /// the rank of the average function value is used for updating the strategy parameters
 /// which ensures asymptotic unbiasedness. We further do not have an upper bound on
 /// the number of reevaluations for the same reason.
+///
+/// Computing the eigendecomposition of the covariance matrix costs O(n^3) while the rest of
+/// the update is O(mu n^2). As in the reference implementation, the decomposition is by default
+/// only recomputed every 1/(10 n (c_1+c_mu)) generations, i.e. roughly every n/(10 lambda) generations,
+/// and offspring are sampled using the last decomposition in between. Optionally, the decomposition
+/// can be computed in a background thread while the next generation is evaluated.
 class CMA : public AbstractSingleObjectiveOptimizer<RealVector >
 {
 public:
@@ -203,6 +211,36 @@ public:
 	std::size_t numberOfEvaluations()const{
 		return m_numEvaluations;
 	}
+	
+	/// \brief Returns whether the eigendecomposition is only recomputed every few generations.
+	bool lazyDecomposition()const{
+		return m_lazyDecomposition;
+	}
+	
+	/// \brief Sets whether the eigendecomposition is only recomputed every few generations.
+	///
+	/// This is disabled by default, then the decomposition is computed after every update
+	/// of the covariance matrix. If enabled, it is recomputed every 1/(10 n (c1+cMu)) generations
+	/// as in the reference implementation, which reduces the cost per generation from cubic
+	/// to quadratic in n. The eigenvalues and eigenvectors returned by the algorithm
+	/// always belong to the decomposition used for sampling.
+	void setLazyDecomposition(bool lazyDecomposition){
+		m_lazyDecomposition = lazyDecomposition;
+	}
+	
+	/// \brief Returns whether the eigendecomposition is computed in a background thread.
+	bool backgroundDecomposition()const{
+		return m_backgroundDecomposition;
+	}
+	
+	/// \brief Sets whether the eigendecomposition is computed in a background thread.
+	///
+	/// The decomposition is started at the end of an update and is used for sampling starting
+	/// with the generation after the next one. Thus, evaluating the next generation
+	/// and decomposing the covariance matrix overlap. Disabled by default.
+	void setBackgroundDecomposition(bool backgroundDecomposition){
+		m_backgroundDecomposition = backgroundDecomposition;
+	}
 
 
 protected:
@@ -215,6 +253,13 @@ protected:
 	/// \brief Updates the strategy parameters based on the supplied offspring population.
 	SHARK_EXPORT_SYMBOL void updatePopulation( std::vector<IndividualType > const& offspring ) ;
 
+	/// \brief Expresses an offspring sampled from an earlier search distribution in terms of the current one.
+	///
+	/// The chromosome is recomputed from the search point using the current mean, step size and
+	/// eigendecomposition. As for injected solutions, the step is shortened to a Mahalanobis length
+	/// of at most \f$ \sqrt{n} + 2n/(n+2) \f$, which moves the search point towards the mean.
+	SHARK_EXPORT_SYMBOL void rebaseOffspring( IndividualType& offspring ) const;
+
 	SHARK_EXPORT_SYMBOL  void doInit(
 		std::vector<SearchPointType> const& points,
 		std::vector<ResultType> const& functionValues,
@@ -223,6 +268,8 @@ protected:
 		double initialSigma
 	);
 private:
+	/// \brief Recomputes or schedules the eigendecomposition of the covariance matrix if it is due.
+	SHARK_EXPORT_SYMBOL void updateDecomposition();
 
 	std::size_t m_numberOfVariables; ///< Stores the dimensionality of the search space.
 	std::size_t m_mu; ///< The size of the parent population.
@@ -259,6 +306,12 @@ private:
 	double m_rankChangeQuantile;
 
 	MultiVariateNormalDistribution m_mutationDistribution;
+	
+	bool m_lazyDecomposition; ///< only recompute the decomposition every few generations
+	bool m_backgroundDecomposition; ///< compute the decomposition in a background thread
+	std::size_t m_lastDecomposition; ///< generation in which the current decomposition was started
+	/// \brief Decomposition computed in the background, used starting with the next update.
+	std::shared_future<MultiVariateNormalDistribution::DecompositionType> m_pendingDecomposition;
 	random::rng_type* mpe_rng;
 };
 }
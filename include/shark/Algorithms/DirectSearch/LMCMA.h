@@ -34,6 +34,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/PopulationBasedStepSizeAdaptation.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
+#include <shark/Core/Profiler.h>
 
 
 
@@ -276,26 +277,11 @@ public:
 
 	/// \brief Executes one iteration of the algorithm.
 	void step(ObjectiveFunctionType const& function){
-		typedef Individual<RealVector, double, RealVector> IndividualType;
-		std::vector< IndividualType > offspring( m_lambda );
-
+		SHARK_PROFILE_REGION("LMCMA::step");
+		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
-		for( unsigned int i = 0; i < offspring.size(); i++ ) {
-			createSample(offspring[i].searchPoint(),offspring[i].chromosome());
-		}
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
-
-		// Selection and parameter update
-		// opposed to normal CMA selection, we don't remove any indidivudals but only order
-		// them by rank to allow the use of the population based strategy.
-		std::vector< IndividualType > parents( lambda() );
-		ElitistSelection< IndividualType::FitnessOrdering > selection;
-		selection(offspring.begin(),offspring.end(),parents.begin(), parents.end());
-		updateStrategyParameters( parents );
-
-		//update the best solution found so far.
-		m_best.point= parents[ 0 ].searchPoint();
-		m_best.value= parents[ 0 ].unpenalizedFitness();
+		updatePopulation(offspring);
 	}
 
 	/// \brief Accesses the current step size.
@@ -338,6 +324,47 @@ public:
 		return m_lambda;
 	}
 
+protected:
+	/// \brief The type of individual used for the LMCMA
+	typedef Individual<RealVector, double, RealVector> IndividualType;
+
+	/// \brief Samples lambda individuals from the search distribution
+	std::vector<IndividualType> generateOffspring( ) const{
+		std::vector< IndividualType > offspring( m_lambda );
+		for( unsigned int i = 0; i < offspring.size(); i++ ) {
+			createSample(offspring[i].searchPoint(),offspring[i].chromosome());
+		}
+		return offspring;
+	}
+
+	/// \brief Updates the strategy parameters based on the supplied evaluated offspring population.
+	void updatePopulation( std::vector<IndividualType> const& offspring ) {
+		// Selection and parameter update
+		// opposed to normal CMA selection, we don't remove any indidivudals but only order
+		// them by rank to allow the use of the population based strategy.
+		std::vector< IndividualType > parents( offspring.size() );
+		ElitistSelection< IndividualType::FitnessOrdering > selection;
+		selection(offspring.begin(),offspring.end(),parents.begin(), parents.end());
+		updateStrategyParameters( parents );
+
+		//update the best solution found so far.
+		m_best.point= parents[ 0 ].searchPoint();
+		m_best.value= parents[ 0 ].unpenalizedFitness();
+	}
+
+	/// \brief Expresses an offspring sampled from an earlier search distribution in terms of the current one.
+	///
+	/// The chromosome is recomputed from the search point as for CMA::rebaseOffspring and
+	/// shortened to a Mahalanobis length of at most \f$ \sqrt{n} + 2n/(n+2) \f$.
+	void rebaseOffspring( IndividualType& offspring ) const{
+		RealVector y = (offspring.searchPoint() - m_mean) / sigma();
+		RealVector z;
+		m_A.inv(z,y);
+		double n = static_cast<double>(m_numberOfVariables);
+		double alpha = std::min(1.0, (std::sqrt(n) + 2 * n / (n + 2)) / norm_2(z));
+		offspring.chromosome() = alpha * z;
+		offspring.searchPoint() = m_mean + (alpha * sigma()) * y;
+	}
 private:
 	/// \brief Updates the strategy parameters based on the supplied offspring population.
 	void updateStrategyParameters( std::vector<Individual<RealVector, double, RealVector> > const& offspring ) {
@@ -367,7 +394,7 @@ private:
 		x.resize(m_numberOfVariables);
 		z.resize(m_numberOfVariables);
 		for(std::size_t i = 0; i != m_numberOfVariables; ++i){
-			z(i) = gauss(*mpe_rng,0,1);
+			z(i) = random::gauss(*mpe_rng,0,1);
 		}
 		m_A.prod(x,z);
 		noalias(x) = sigma()*x +m_mean;
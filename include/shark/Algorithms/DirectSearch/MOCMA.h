@@ -41,6 +41,7 @@
 
 
 #include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/Core/Profiler.h>
 
 namespace shark {
 
@@ -147,6 +148,7 @@ public:
 	 * \param [in] function The function to iterate upon.
 	 */
 	void step( ObjectiveFunctionType const& function ) {
+		SHARK_PROFILE_REGION("MOCMA::step");
 		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
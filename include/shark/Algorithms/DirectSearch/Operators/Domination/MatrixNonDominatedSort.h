@@ -0,0 +1,427 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Divide-and-conquer non-dominated sorting on a contiguous objective matrix.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_DIRECTSEARCH_OPERATORS_DOMINATION_MATRIXNONDOMINATEDSORT_H
+#define SHARK_ALGORITHMS_DIRECTSEARCH_OPERATORS_DOMINATION_MATRIXNONDOMINATEDSORT_H
+
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+
+namespace shark {
+
+/// \brief Divide-and-conquer non-dominated sorting of the rows of an objective matrix.
+///
+/// This implements the same algorithm as BaseDCNonDominatedSort
+/// (Fortin, Grenier and Parizeau, GECCO 2013) with complexity
+/// \f$ \mathcal{O}(n \log(n)^{m-2}c) \f$, but is tailored to large populations:
+///
+/// - The unique objective vectors are copied in lexicographic order into a single
+///   row-major matrix, so that all subsets of the recursion refer to contiguous rows
+///   which are traversed front to back.
+/// - Subproblems with fewer than bruteForceThreshold() point pairs are solved by
+///   direct pairwise comparison. The comparison loops are branch-free and operate
+///   on contiguous rows and are therefore vectorized by the compiler.
+/// - The independent branches of the recursion are executed as OpenMP tasks
+///   as long as the subproblems contain more than parallelThreshold() points.
+///
+/// The default thresholds were obtained with examples/Benchmark/shark/non_dominated_sort.cpp.
+class BaseMatrixNonDominatedSort
+{
+private:
+	typedef std::vector<std::size_t> ContainerType;
+	typedef std::map<unsigned int, double> MapType;
+public:
+	BaseMatrixNonDominatedSort(
+		std::size_t bruteForceThreshold = 1024,
+		std::size_t parallelThreshold = 4096
+	):m_bruteForceThreshold(bruteForceThreshold), m_parallelThreshold(parallelThreshold){}
+
+	/// \brief Maximum number of point pairs for which a subproblem is solved by direct comparison.
+	std::size_t bruteForceThreshold()const{
+		return m_bruteForceThreshold;
+	}
+	/// \brief Minimum number of points in a subproblem for which the recursion is split into tasks.
+	std::size_t parallelThreshold()const{
+		return m_parallelThreshold;
+	}
+
+	/// \brief Executes the non-dominated sorting algorithm.
+	///
+	/// Every row of points is an objective vector. Afterwards ranks(i) is the
+	/// front index of the i-th row. The front of dominating points has the value 1.
+	template<class Matrix, class RankRange>
+	void operator () (blas::matrix_expression<Matrix, blas::cpu_tag> const& points, RankRange& ranks)
+	{
+		std::size_t n = points().size1();
+		SIZE_CHECK(n == ranks.size());
+		if(n == 0) return;
+		m_dim = points().size2();
+
+		//lexicographic order of the rows
+		RealMatrix input = points;
+		std::vector<std::size_t> order(n);
+		std::iota(order.begin(),order.end(),0);
+		std::sort(order.begin(),order.end(),[&](std::size_t i, std::size_t j){
+			return lexicographicLess(row(input,i), row(input,j));
+		});
+
+		//store the unique points in lexicographic order
+		//and remember for every input row its position in the unique set
+		std::vector<std::size_t> uniqueIndex(n);
+		m_points.resize(n,m_dim);
+		std::size_t numUnique = 0;
+		for(std::size_t i = 0; i != n; ++i){
+			if(i == 0 || !equal(row(input,order[i]), row(m_points,numUnique - 1))){
+				noalias(row(m_points,numUnique)) = row(input,order[i]);
+				++numUnique;
+			}
+			uniqueIndex[order[i]] = numUnique - 1;
+		}
+		m_front.assign(numUnique,1);
+
+		ContainerType S(numUnique);
+		std::iota(S.begin(),S.end(),0);
+
+		// call recursive algorithm
+		if(numUnique > m_parallelThreshold){
+			SHARK_PARALLEL_REGION
+			{
+				SHARK_SINGLE_REGION
+				ndHelperA(S,m_dim);
+			}
+		}else{
+			ndHelperA(S,m_dim);
+		}
+
+		// assign ranks to individuals
+		for (std::size_t i = 0; i != n; ++i){
+			ranks[i] = m_front[uniqueIndex[i]];
+		}
+	}
+
+private:
+	template<class Row1, class Row2>
+	static bool lexicographicLess(Row1 const& lhs, Row2 const& rhs){
+		for (std::size_t i=0; i != lhs.size(); i++){
+			if (lhs(i) < rhs(i)) return true;
+			if (lhs(i) > rhs(i)) return false;
+		}
+		return false;
+	}
+	template<class Row1, class Row2>
+	static bool equal(Row1 const& lhs, Row2 const& rhs){
+		for (std::size_t i=0; i != lhs.size(); i++){
+			if (lhs(i) != rhs(i)) return false;
+		}
+		return true;
+	}
+
+	double const* obj(std::size_t i)const{
+		return m_points.raw_storage().values + i * m_points.raw_storage().leading_dimension;
+	}
+
+	// true if lhs is better or equal than rhs in all of the first k objectives.
+	// The loop has no early exit so that it can be vectorized.
+	bool weaklyDominates(std::size_t lhs, std::size_t rhs, std::size_t k)const{
+		double const* l = obj(lhs);
+		double const* r = obj(rhs);
+		std::size_t worse = 0;
+		for (std::size_t i=0; i != k; i++){
+			worse += l[i] > r[i];
+		}
+		return worse == 0;
+	}
+	// true if lhs strictly dominates rhs with respect to the first k objectives.
+	bool dominates(std::size_t lhs, std::size_t rhs, std::size_t k)const{
+		double const* l = obj(lhs);
+		double const* r = obj(rhs);
+		std::size_t worse = 0;
+		std::size_t better = 0;
+		for (std::size_t i=0; i != k; i++){
+			worse += l[i] > r[i];
+			better += l[i] < r[i];
+		}
+		return worse == 0 && better > 0;
+	}
+
+	// Non-dominated sorting of S according to the first k objectives,
+	// see ndHelperA in BaseDCNonDominatedSort.
+	void ndHelperA(ContainerType& S, std::size_t k)
+	{
+		if (S.size() < 2) return;
+		if (S.size() * S.size() <= 2 * m_bruteForceThreshold){
+			bruteForceA(S,k);
+			return;
+		}
+		if (k == 2){
+			sweepA(S);
+			return;
+		}
+
+		// check condition |\{s_k | s \in S\}| = 1
+		bool k_equal = true;
+		for (std::size_t i=1; i<S.size(); i++){
+			if (obj(S[0])[k-1] != obj(S[i])[k-1]){
+				k_equal = false;
+				break;
+			}
+		}
+
+		if (k_equal){
+			ndHelperA(S, k-1);
+		}else{
+			ContainerType L, H;
+			splitA(S, k, L, H);
+			ndHelperA(L, k);
+			ndHelperB(L, H, k-1);
+			ndHelperA(H, k);
+		}
+	}
+
+	// S is lexicographically sorted, therefore a point can only be dominated
+	// by points preceding it. Processing the points in order makes sure that
+	// the front index of every dominating point is final when it is used.
+	void bruteForceA(ContainerType const& S, std::size_t k)
+	{
+		for (std::size_t j=1; j < S.size(); j++){
+			unsigned int frt = m_front[S[j]];
+			for (std::size_t i=0; i != j; i++){
+				if(dominates(S[i], S[j], k))
+					frt = std::max(frt, m_front[S[i]] + 1);
+			}
+			m_front[S[j]] = frt;
+		}
+	}
+
+	// Two objective sweep, see sweepA in BaseDCNonDominatedSort.
+	void sweepA(ContainerType const& S)
+	{
+		MapType T;
+		T[m_front[S[0]]] = obj(S[0])[1];
+		for (std::size_t i=1; i<S.size(); i++){
+			double v = obj(S[i])[1];
+			unsigned int r = 0;
+			for (auto p : T){
+				if (p.second <= v) r = std::max(r, p.first);
+			}
+			if (r > 0) m_front[S[i]] = std::max(m_front[S[i]], r + 1);
+			T[m_front[S[i]]] = v;
+		}
+	}
+
+	// median of the k-th objective over S
+	double median(ContainerType const& S, std::size_t k)const
+	{
+		std::vector<double> value(S.size());
+		for (std::size_t i=0; i<S.size(); i++) value[i] = obj(S[i])[k];
+		std::nth_element(value.begin(), value.begin() + value.size() / 2, value.end());
+		double ret = value[value.size() / 2];
+		if (S.size() & 1) return ret;
+		ret += *std::max_element(value.begin(), value.begin() + value.size() / 2);
+		return ret / 2.0;
+	}
+
+	// Splits S at the value pivot of objective k (zero based) into
+	// the lexicographically sorted sets A1, A2 (ties in A1) and B1, B2 (ties in B2).
+	void partition(
+		ContainerType const& S, std::size_t k, double pivot,
+		ContainerType& A1, ContainerType& A2, ContainerType& B1, ContainerType& B2
+	)const{
+		for (std::size_t i=0; i<S.size(); i++){
+			double v = obj(S[i])[k];
+			if (v < pivot){
+				A1.push_back(S[i]);
+				B1.push_back(S[i]);
+			}else if (v > pivot){
+				A2.push_back(S[i]);
+				B2.push_back(S[i]);
+			}else{
+				A1.push_back(S[i]);
+				B2.push_back(S[i]);
+			}
+		}
+	}
+
+	// Split the set S according to the median in objective k (one based),
+	// see splitA in BaseDCNonDominatedSort.
+	void splitA(ContainerType const& S, std::size_t k, ContainerType& L, ContainerType& H)
+	{
+		ContainerType La, Lb, Ha, Hb;
+		partition(S, k - 1, median(S, k - 1), La, Ha, Lb, Hb);
+		if (Lb.size() < Ha.size()){
+			L.swap(La);
+			H.swap(Ha);
+		}else{
+			L.swap(Lb);
+			H.swap(Hb);
+		}
+	}
+
+	// Assigns the front indices of L to H, see ndHelperB in BaseDCNonDominatedSort.
+	//
+	// The calls ndHelperB(L1, H1, k) and ndHelperB(L1, H2, k-1), ndHelperB(L2, H2, k)
+	// only read the final front indices of L and write to the disjoint sets H1 and H2.
+	// Therefore they are executed in parallel.
+	void ndHelperB(ContainerType const& L, ContainerType& H, std::size_t k)
+	{
+		if (L.empty() || H.empty()) return;
+		if (L.size() == 1 || H.size() == 1 || L.size() * H.size() <= m_bruteForceThreshold){
+			bruteForceB(L, H, k);
+			return;
+		}
+		if (k == 2){
+			sweepB(L, H);
+			return;
+		}
+		double minLk = obj(L[0])[k-1];
+		double maxLk = minLk;
+		for (std::size_t i=1; i<L.size(); i++){
+			double v = obj(L[i])[k-1];
+			minLk = std::min(minLk, v);
+			maxLk = std::max(maxLk, v);
+		}
+		double minHk = obj(H[0])[k-1];
+		double maxHk = minHk;
+		for (std::size_t i=1; i<H.size(); i++){
+			double v = obj(H[i])[k-1];
+			minHk = std::min(minHk, v);
+			maxHk = std::max(maxHk, v);
+		}
+		if (maxLk <= minHk){
+			ndHelperB(L, H, k-1);
+			return;
+		}
+		if (minLk <= maxHk){
+			ContainerType L1, L2, H1, H2;
+			splitB(L, H, k, L1, L2, H1, H2);
+			if(L.size() + H.size() > m_parallelThreshold){
+				auto lower = [&]{ndHelperB(L1, H1, k);};
+				auto upper = [&]{
+					ndHelperB(L1, H2, k - 1);
+					ndHelperB(L2, H2, k);
+				};
+				SHARK_TASK
+				lower();
+				upper();
+				SHARK_TASKWAIT
+			}else{
+				ndHelperB(L1, H1, k);
+				ndHelperB(L1, H2, k - 1);
+				ndHelperB(L2, H2, k);
+			}
+		}
+	}
+
+	void bruteForceB(ContainerType const& L, ContainerType& H, std::size_t k)
+	{
+		for (std::size_t j=0; j<H.size(); j++){
+			unsigned int frt = m_front[H[j]];
+			for (std::size_t i=0; i<L.size(); i++){
+				if (weaklyDominates(L[i], H[j], k))
+					frt = std::max(frt, m_front[L[i]] + 1);
+			}
+			m_front[H[j]] = frt;
+		}
+	}
+
+	// Two objective sweep, see sweepB in BaseDCNonDominatedSort.
+	void sweepB(ContainerType const& L, ContainerType& H)
+	{
+		MapType T;
+		std::size_t i = 0;
+		for (std::size_t j=0; j<H.size(); j++){
+			double const* h = obj(H[j]);
+			while (i < L.size()){
+				double const* l = obj(L[i]);
+				if (l[0] > h[0]) break;
+				if (l[0] == h[0] && l[1] > h[1]) break;
+				auto it = T.find(m_front[L[i]]);
+				if (it == T.end() || l[1] < it->second){
+					T[m_front[L[i]]] = l[1];
+				}
+				i++;
+			}
+			unsigned int r = 0;
+			for (auto p : T){
+				if (p.second <= h[1]) r = std::max(r, p.first);
+			}
+			if (r > 0){
+				m_front[H[j]] = std::max(m_front[H[j]], r + 1);
+			}
+		}
+	}
+
+	// Splits L and H using a common pivot of objective k (one based),
+	// see splitB in BaseDCNonDominatedSort.
+	void splitB(ContainerType const& L, ContainerType const& H, std::size_t k,
+			ContainerType& L1, ContainerType& L2, ContainerType& H1, ContainerType& H2)
+	{
+		double pivot = median((L.size() > H.size()) ? L : H, k - 1);
+		ContainerType L1a, L1b, L2a, L2b;
+		partition(L, k - 1, pivot, L1a, L2a, L1b, L2b);
+		ContainerType H1a, H1b, H2a, H2b;
+		partition(H, k - 1, pivot, H1a, H2a, H1b, H2b);
+
+		if (L1b.size() + H1b.size() <= L2a.size() + H2a.size()){
+			L1.swap(L1a);
+			L2.swap(L2a);
+			H1.swap(H1a);
+			H2.swap(H2a);
+		}else{
+			L1.swap(L1b);
+			L2.swap(L2b);
+			H1.swap(H1b);
+			H2.swap(H2b);
+		}
+	}
+
+	std::size_t m_bruteForceThreshold;
+	std::size_t m_parallelThreshold;
+	std::size_t m_dim;
+	RealMatrix m_points; ///< unique points in lexicographic order
+	std::vector<unsigned int> m_front; ///< front index (1-based) of the unique points
+};
+
+/// \brief Non-dominated sorting of the rows of the objective matrix points.
+template<class Matrix, class RankRange>
+void matrixNonDominatedSort(blas::matrix_expression<Matrix, blas::cpu_tag> const& points, RankRange& ranks) {
+	BaseMatrixNonDominatedSort sorter;
+	sorter(points,ranks);
+}
+
+}  // namespace shark
+#endif
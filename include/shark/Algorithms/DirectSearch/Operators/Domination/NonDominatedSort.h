@@ -30,6 +30,7 @@
 
 #include "FastNonDominatedSort.h"
 #include "DCNonDominatedSort.h"
+#include "MatrixNonDominatedSort.h"
 
 
 namespace shark {
@@ -70,6 +71,25 @@ void nonDominatedSort(PointRange const& points, RankRange const& ranks) {
 	nonDominatedSort(points,ranksCopy);
 }
 
+/// \brief Frontend for non-dominated sorting of the rows of an objective matrix.
+///
+/// Every row of points is an objective vector and afterwards ranks[i]
+/// stores the front index of the i-th row. The front of non-dominated points has the value 1.
+///
+/// The divide-and-conquer algorithm working on contiguous storage is used for all problem sizes.
+/// Its brute force base case makes it faster than fastNonDominatedSort already for
+/// 50 points, see examples/Benchmark/shark/non_dominated_sort.cpp.
+template<class RankRange>
+void nonDominatedSort(RealMatrix const& points, RankRange& ranks) {
+	matrixNonDominatedSort(points,ranks);
+}
+
+template<class RankRange>
+void nonDominatedSort(RealMatrix const& points, RankRange const& ranks) {
+	RankRange ranksCopy=ranks;
+	nonDominatedSort(points,ranksCopy);
+}
+
 
 } // namespace shark
 #endif
@@ -37,6 +37,8 @@
 #define SHARK_ALGORITHMS_DIRECT_SEARCH_OPERATORS_EVALUATION_PENALIZING_EVALUATOR_H
 
 #include <shark/LinAlg/Base.h>
+#include <shark/Data/BatchInterface.h>
+#include <vector>
 
 namespace shark {
 /**
@@ -85,14 +87,54 @@ struct PenalizingEvaluator {
 	/**
 	* \brief Evaluates The function on individuals in the range [first,last]
 	*
+	* If the function is thread safe, the repaired search points are evaluated as one batch
+	* using f.evalBatch, which evaluates the points in parallel. In this case the order of the
+	* evaluations, and thus of the random numbers drawn by noisy functions, is not defined.
+	* Otherwise the individuals are evaluated one after another, exactly as by the single
+	* individual version.
+	*
 	* \param [in] f The function to be evaluated.
 	* \param [in] begin first indivdual in the range to be evaluated
 	* \param [in] end iterator pointing directly beehind the last individual to be evaluated
 	*/
 	template<typename Function, typename Iterator>
 	void operator()( Function const& f, Iterator begin, Iterator end ) const {
-		for(Iterator pos = begin; pos != end; ++pos){
-			(*this)(f,*pos);
+		typedef typename Function::SearchPointType SearchPointType;
+		typedef typename Function::ResultBatch ResultBatch;
+		if(!f.isThreadSafe()){
+			for(Iterator it = begin; it != end; ++it){
+				(*this)(f, *it);
+			}
+			return;
+		}
+		
+		std::size_t n = end - begin;
+		if(n == 0) return;
+		
+		std::vector<SearchPointType> points(n);
+		for(std::size_t i = 0; i != n; ++i){
+			points[i] = begin[i].searchPoint();
+			if( !f.isFeasible( points[i] ) ) {
+				f.closestFeasible( points[i] );
+			}
+		}
+		auto batch = Batch<SearchPointType>::createBatchFromRange(points.begin(),points.end());
+		
+		ResultBatch values;
+		f.evalBatch(batch, values);
+		if(m_numEvaluations > 1){
+			ResultBatch reevaluation;
+			for(std::size_t k = 1; k < m_numEvaluations; ++k){
+				f.evalBatch(batch, reevaluation);
+				values += reevaluation;
+			}
+			values /= double(m_numEvaluations);
+		}
+		
+		for(std::size_t i = 0; i != n; ++i){
+			begin[i].unpenalizedFitness() = getBatchElement(values,i);
+			begin[i].penalizedFitness() = begin[i].unpenalizedFitness();
+			penalize(begin[i].searchPoint(),points[i],begin[i].penalizedFitness() );
 		}
 	}
 	
@@ -56,7 +56,7 @@ struct ElitistSelection {
 	){
 		std::size_t outputSize = std::distance( out, outE );
 		std::vector<InIterator> results = order(it, itE);
-		SHARK_RUNTIME_CHECK(results.size() > outputSize, "Input range must be bigger than output range");
+		SHARK_RUNTIME_CHECK(results.size() >= outputSize, "Input range must not be smaller than output range");
 		
 		for(std::size_t i = 0; i != outputSize; ++i, ++out){
 			*out = *results[i];
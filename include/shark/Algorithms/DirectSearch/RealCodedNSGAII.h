@@ -46,6 +46,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Recombination/SimulatedBinaryCrossover.h>
 #include <shark/Algorithms/DirectSearch/Operators/Mutation/PolynomialMutation.h>
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
+#include <shark/Core/Profiler.h>
 
 
 namespace shark {
@@ -182,6 +183,7 @@ public:
 	///
 	///\param [in] function The function to iterate upon.
 	void step( ObjectiveFunctionType const& function ) {
+		SHARK_PROFILE_REGION("RealCodedNSGAII::step");
 		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
@@ -46,6 +46,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 
 #include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/Core/Profiler.h>
 
 namespace shark {
 
@@ -166,6 +167,7 @@ public:
 	 * \param [in] function The function to iterate upon.
 	 */
 	void step( ObjectiveFunctionType const& function ) {
+		SHARK_PROFILE_REGION("SMSEMOA::step");
 		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
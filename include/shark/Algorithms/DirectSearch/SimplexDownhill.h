@@ -37,6 +37,7 @@
 
 
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Core/Profiler.h>
 #include <boost/serialization/vector.hpp>
 #include <vector>
 
@@ -108,6 +109,7 @@ public:
 	/// \brief Step of the simplex algorithm.
 	void step(ObjectiveFunctionType const& objectiveFunction)
 	{
+		SHARK_PROFILE_REGION("SimplexDownhill::step");
 		size_t dim = m_simplex.size() - 1;
 
 		// step of the simplex algorithm
@@ -38,6 +38,7 @@
 #include <shark/Algorithms/DirectSearch/CMA/CMAIndividual.h>
 
 #include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/Core/Profiler.h>
 
 namespace shark {
 
@@ -151,6 +152,7 @@ public:
 	 * \param [in] function The function to iterate upon.
 	 */
 	void step( ObjectiveFunctionType const& function ) {
+		SHARK_PROFILE_REGION("SteadyStateMOCMA::step");
 		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
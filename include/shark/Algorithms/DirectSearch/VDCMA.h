@@ -34,6 +34,7 @@
 
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
+#include <shark/Core/Profiler.h>
 
 
 /// \brief Implements the VD-CMA-ES Algorithm
@@ -147,25 +148,11 @@ public:
 
 	/// \brief Executes one iteration of the algorithm.
 	void step(ObjectiveFunctionType const& function){
-		typedef Individual<RealVector, double, RealVector> IndividualType;
-		std::vector< IndividualType > offspring( m_lambda );
-
+		SHARK_PROFILE_REGION("VDCMA::step");
+		std::vector<IndividualType> offspring = generateOffspring();
 		PenalizingEvaluator penalizingEvaluator;
-		for( std::size_t i = 0; i < offspring.size(); i++ ) {
-			createSample(offspring[i].searchPoint(),offspring[i].chromosome());
-		}
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
-
-		// Selection
-		std::vector< IndividualType > parents( m_mu );
-		ElitistSelection<IndividualType::FitnessOrdering> selection;
-		selection(offspring.begin(),offspring.end(),parents.begin(), parents.end());
-		// Strategy parameter update
-		m_counter++; // increase generation counter
-		updateStrategyParameters( parents );
-
-		m_best.point= parents[ 0 ].searchPoint();
-		m_best.value= parents[ 0 ].unpenalizedFitness();
+		updatePopulation(offspring);
 	}
 
 	/// \brief Accesses the current step size.
@@ -229,7 +216,47 @@ public:
 	std::size_t & lambda(){
 		return m_lambda;
 	}
+protected:
+	/// \brief The type of individual used for the VDCMA
+	typedef Individual<RealVector, double, RealVector> IndividualType;
+
+	/// \brief Samples lambda individuals from the search distribution
+	std::vector<IndividualType> generateOffspring( ) const{
+		std::vector< IndividualType > offspring( m_lambda );
+		for( std::size_t i = 0; i < offspring.size(); i++ ) {
+			createSample(offspring[i].searchPoint(),offspring[i].chromosome());
+		}
+		return offspring;
+	}
+
+	/// \brief Updates the strategy parameters based on the supplied evaluated offspring population.
+	void updatePopulation( std::vector<IndividualType> const& offspring ) {
+		// Selection
+		std::vector< IndividualType > parents( m_mu );
+		ElitistSelection<IndividualType::FitnessOrdering> selection;
+		selection(offspring.begin(),offspring.end(),parents.begin(), parents.end());
+		// Strategy parameter update
+		m_counter++; // increase generation counter
+		updateStrategyParameters( parents );
+
+		m_best.point= parents[ 0 ].searchPoint();
+		m_best.value= parents[ 0 ].unpenalizedFitness();
+	}
 
+	/// \brief Expresses an offspring sampled from an earlier search distribution in terms of the current one.
+	///
+	/// The chromosome is recomputed from the search point as for CMA::rebaseOffspring and
+	/// shortened to a Mahalanobis length of at most \f$ \sqrt{n} + 2n/(n+2) \f$.
+	void rebaseOffspring( IndividualType& offspring ) const{
+		RealVector y = (offspring.searchPoint() - m_mean) / (m_sigma * m_D);
+		//z= (1+(1/sqrt(1+||v||^2)-1)v_n v_n^T)y
+		double b = 1/std::sqrt(1+sqr(m_normv))-1;
+		RealVector z = y + b * inner_prod(y,m_vn) * m_vn;
+		double n = static_cast<double>(m_numberOfVariables);
+		double alpha = std::min(1.0, (std::sqrt(n) + 2 * n / (n + 2)) / norm_2(z));
+		offspring.chromosome() = alpha * y;
+		offspring.searchPoint() = m_mean + (alpha * m_sigma) * m_D * y;
+	}
 private:
 	/// \brief Updates the strategy parameters based on the supplied offspring population.
 	///
@@ -37,16 +37,62 @@
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
 
 namespace shark{
+namespace detail{
+/// \brief Single pass update of the Adam moment estimates and the point.
+///
+/// Computes for every coordinate with the scaled gradient \f$ g = s \nabla \f$
+/// \f[ m = \beta_1 m + (1-\beta_1) g, \quad v = \beta_2 v + (1-\beta_2) g^2 \f]
+/// \f[ x = x - \eta_1 m /(\epsilon + \sqrt{v/b_2}) - \lambda x \f]
+/// in one loop instead of one loop per vector expression. The last term is the decoupled
+/// weight decay of AdamW and vanishes for decay = 0.
+template<class T>
+void adamUpdate(
+	blas::vector<T>& point, blas::vector<T>& firstMoment, blas::vector<T>& secondMoment,
+	blas::vector<T> const& gradient, double gradientScale,
+	double beta1, double beta2, double epsilon,
+	double stepSize, double bias2, double decay
+){
+	SIZE_CHECK(firstMoment.size() == point.size());
+	SIZE_CHECK(secondMoment.size() == point.size());
+	SIZE_CHECK(gradient.size() == point.size());
+	T* x = point.raw_storage().values;
+	T* m = firstMoment.raw_storage().values;
+	T* v = secondMoment.raw_storage().values;
+	T const* g = gradient.raw_storage().values;
+	T const b1 = T(beta1);
+	T const b2 = T(beta2);
+	T const c1 = T((1 - beta1) * gradientScale);
+	T const c2 = T((1 - beta2) * gradientScale * gradientScale);
+	T const eps = T(epsilon);
+	T const eta = T(stepSize);
+	T const lambda = T(decay);
+	T const invBias2 = T(1 / bias2);
+	std::size_t n = point.size();
+	for(std::size_t i = 0; i != n; ++i){
+		T gi = g[i];
+		T mi = b1 * m[i] + c1 * gi;
+		T vi = b2 * v[i] + c2 * gi * gi;
+		m[i] = mi;
+		v[i] = vi;
+		x[i] -= eta * mi / (eps + std::sqrt(vi * invBias2)) + lambda * x[i];
+	}
+}
+}
 
 ///@brief Adaptive Moment Estimation Algorithm (ADAM)
 ///
 /// Performs SGD by using a long term average of the gradient as well as its second moment to adapt
 /// a step size for each coordinate.
-class Adam : public AbstractSingleObjectiveOptimizer<RealVector >
+/// The template parameter is the type of the search point, Adam is the version for RealVector.
+template<class SearchPointType>
+class AdamT : public AbstractSingleObjectiveOptimizer<SearchPointType >
 {
+private:
+	typedef AbstractSingleObjectiveOptimizer<SearchPointType > base_type;
 public:
-	Adam() {
-		m_features |= REQUIRES_FIRST_DERIVATIVE;
+	typedef typename base_type::ObjectiveFunctionType ObjectiveFunctionType;
+	AdamT() {
+		this->m_features |= base_type::REQUIRES_FIRST_DERIVATIVE;
 
 		m_beta1 = 0.9;
 		m_beta2 = 0.999;
@@ -59,19 +105,19 @@ public:
 	{ return "Adam"; }
 
 	void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
-		checkFeatures(objectiveFunction);
+		this->checkFeatures(objectiveFunction);
 		SHARK_RUNTIME_CHECK(startingPoint.size() == objectiveFunction.numberOfVariables(), "Initial starting point and dimensionality of function do not agree");
 		
 		//initialize long term averages
-		m_avgGrad = blas::repeat(0.0,startingPoint.size());
-		m_secondMoment = blas::repeat(0.0,startingPoint.size());
+		m_avgGrad = SearchPointType(startingPoint.size(),0.0);
+		m_secondMoment = SearchPointType(startingPoint.size(),0.0);
 		m_counter = 0;
 		
 		//set point to the current starting point
-		m_best.point = startingPoint;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		this->m_best.point = startingPoint;
+		this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,m_derivative);
 	}
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using base_type::init;
 
 	/// \brief get learning rate eta
 	double eta() const {
@@ -127,17 +173,15 @@ public:
 	/// where a slight step correction is used to remove the bias in the first few iterations where the means are close to 0.
 	void step(ObjectiveFunctionType const& objectiveFunction) {
 		//update long term averages of the gradient and its variance
-		noalias(m_avgGrad) = m_beta1 * m_avgGrad + (1-m_beta1) * m_derivative;
-		noalias(m_secondMoment) = m_beta2 * m_secondMoment + (1-m_beta2)* sqr(m_derivative);
 		//for the first few iterations, we need bias correction
 		++m_counter;
 		double bias1 = 1-std::pow(m_beta1,m_counter);
 		double bias2 = 1-std::pow(m_beta2,m_counter);
-		//~ std::cout<<"m "<<m_avgGrad<<std::endl;
-		//~ std::cout<<"v "<<m_secondMoment<<std::endl;
-		
-		noalias(m_best.point) -= (m_eta/bias1) * m_avgGrad/(m_epsilon + sqrt(m_secondMoment/bias2));
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		detail::adamUpdate(
+			this->m_best.point, m_avgGrad, m_secondMoment, m_derivative, 1.0,
+			m_beta1, m_beta2, m_epsilon, m_eta/bias1, bias2, 0.0
+		);
+		this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,m_derivative);
 	}
 	virtual void read( InArchive & archive )
 	{
@@ -145,7 +189,7 @@ public:
 		archive>>m_secondMoment;
 		archive>>m_counter;
 		archive>>m_derivative;
-		archive>>m_best;
+		archive>>this->m_best;
 		
 		archive>>m_beta1;
 		archive>>m_beta2;
@@ -159,7 +203,7 @@ public:
 		archive<<m_secondMoment;
 		archive<<m_counter;
 		archive<<m_derivative;
-		archive<<m_best;
+		archive<<this->m_best;
 		
 		archive<<m_beta1;
 		archive<<m_beta2;
@@ -168,10 +212,10 @@ public:
 	}
 
 private:
-	RealVector m_avgGrad;
-	RealVector m_secondMoment;
+	SearchPointType m_avgGrad;
+	SearchPointType m_secondMoment;
 	unsigned int m_counter;
-	ObjectiveFunctionType::FirstOrderDerivative m_derivative;
+	SearchPointType m_derivative;
 	
 	double m_beta1;
 	double m_beta2;
@@ -179,6 +223,8 @@ private:
 	double m_eta;
 };
 
+typedef AdamT<RealVector> Adam;
+
 }
 #endif
 
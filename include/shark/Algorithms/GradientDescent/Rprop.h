@@ -105,10 +105,12 @@ namespace shark{
  *      stable
  *
  */
-class RpropMinus : public AbstractSingleObjectiveOptimizer<RealVector >
+template<class SearchPointType>
+class RpropMinusT : public AbstractSingleObjectiveOptimizer<SearchPointType >
 {
 public:
-	SHARK_EXPORT_SYMBOL RpropMinus();
+	typedef typename AbstractSingleObjectiveOptimizer<SearchPointType >::ObjectiveFunctionType ObjectiveFunctionType;
+	SHARK_EXPORT_SYMBOL RpropMinusT();
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -116,7 +118,7 @@ public:
 
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint);
 	SHARK_EXPORT_SYMBOL virtual void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta);
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using AbstractSingleObjectiveOptimizer<SearchPointType >::init;
 
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
@@ -154,11 +156,11 @@ public:
 	}
 	
 	/// \brief Returns the derivative at the current point. Can be used for stopping criteria.
-	RealVector const& derivative()const{
+	SearchPointType const& derivative()const{
 		return m_derivative;
 	}
 protected:
-	ObjectiveFunctionType::FirstOrderDerivative m_derivative;
+	SearchPointType m_derivative;
 
 	//! The increase factor \f$ \eta^+ \f$, set to 1.2 by default.
 	double m_increaseFactor;
@@ -175,10 +177,10 @@ protected:
 	size_t m_parameterSize;
 
 	//! The last error gradient.
-	RealVector m_oldDerivative;
+	SearchPointType m_oldDerivative;
 
 	//! The absolute update values (increment) for all weights.
-	RealVector m_delta;
+	SearchPointType m_delta;
 };
 
 //===========================================================================
@@ -258,10 +260,12 @@ protected:
  *      stable
  *
  */
-class RpropPlus : public RpropMinus
+template<class SearchPointType>
+class RpropPlusT : public RpropMinusT<SearchPointType>
 {
 public:
-	SHARK_EXPORT_SYMBOL RpropPlus();
+	typedef typename RpropMinusT<SearchPointType>::ObjectiveFunctionType ObjectiveFunctionType;
+	SHARK_EXPORT_SYMBOL RpropPlusT();
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -269,7 +273,7 @@ public:
 
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint);
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta);
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using AbstractSingleObjectiveOptimizer<SearchPointType >::init;
 
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 	SHARK_EXPORT_SYMBOL void read( InArchive & archive );
@@ -277,7 +281,7 @@ public:
 
 protected:
 	//! The final update values for all weights.
-	RealVector m_deltaw;
+	SearchPointType m_deltaw;
 };
 
 
@@ -384,10 +388,12 @@ protected:
  *      stable
  *
  */
-class IRpropPlus : public RpropPlus
+template<class SearchPointType>
+class IRpropPlusT : public RpropPlusT<SearchPointType>
 {
 public:
-	SHARK_EXPORT_SYMBOL IRpropPlus();
+	typedef typename RpropPlusT<SearchPointType>::ObjectiveFunctionType ObjectiveFunctionType;
+	SHARK_EXPORT_SYMBOL IRpropPlusT();
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -395,7 +401,7 @@ public:
 
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint);
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta);
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using AbstractSingleObjectiveOptimizer<SearchPointType >::init;
 
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
@@ -413,10 +419,12 @@ protected:
 };
 
 
-class IRpropPlusFull : public RpropPlus
+template<class SearchPointType>
+class IRpropPlusFullT : public RpropPlusT<SearchPointType>
 {
 public:
-	SHARK_EXPORT_SYMBOL IRpropPlusFull();
+	typedef typename RpropPlusT<SearchPointType>::ObjectiveFunctionType ObjectiveFunctionType;
+	SHARK_EXPORT_SYMBOL IRpropPlusFullT();
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -424,7 +432,7 @@ public:
 
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint);
 	SHARK_EXPORT_SYMBOL void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta);
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using AbstractSingleObjectiveOptimizer<SearchPointType >::init;
 
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
@@ -515,9 +523,11 @@ protected:
  *      stable
  *
  */
-class IRpropMinus : public RpropMinus {
+template<class SearchPointType>
+class IRpropMinusT : public RpropMinusT<SearchPointType> {
 public:
-	SHARK_EXPORT_SYMBOL IRpropMinus();
+	typedef typename RpropMinusT<SearchPointType>::ObjectiveFunctionType ObjectiveFunctionType;
+	SHARK_EXPORT_SYMBOL IRpropMinusT();
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -526,6 +536,14 @@ public:
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 };
 
+//! The Rprop variants for RealVector search points. The templates are
+//! instantiated for RealVector and FloatVector.
+typedef RpropMinusT<RealVector> RpropMinus;
+typedef RpropPlusT<RealVector> RpropPlus;
+typedef IRpropPlusT<RealVector> IRpropPlus;
+typedef IRpropPlusFullT<RealVector> IRpropPlusFull;
+typedef IRpropMinusT<RealVector> IRpropMinus;
+
 //! Used to connect the class names with the year of
 //! publication of the paper in which the algorithm was introduced.
 typedef IRpropPlus Rprop99;
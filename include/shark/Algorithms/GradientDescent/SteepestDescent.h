@@ -38,12 +38,45 @@
 
 namespace shark{
 
+namespace detail{
+/// \brief Single pass momentum step \f$ p = \mu p - \eta s \nabla, \quad x = x + p - \lambda x \f$.
+///
+/// The last term is a decoupled weight decay and vanishes for decay = 0.
+template<class T>
+void momentumUpdate(
+	blas::vector<T>& point, blas::vector<T>& path,
+	blas::vector<T> const& gradient, double gradientScale,
+	double learningRate, double momentum, double decay
+){
+	SIZE_CHECK(path.size() == point.size());
+	SIZE_CHECK(gradient.size() == point.size());
+	T* x = point.raw_storage().values;
+	T* p = path.raw_storage().values;
+	T const* g = gradient.raw_storage().values;
+	T const mu = T(momentum);
+	T const eta = T(learningRate * gradientScale);
+	T const lambda = T(decay);
+	std::size_t n = point.size();
+	for(std::size_t i = 0; i != n; ++i){
+		T pi = mu * p[i] - eta * g[i];
+		p[i] = pi;
+		x[i] += pi - lambda * x[i];
+	}
+}
+}
+
 ///@brief Standard steepest descent.
-class SteepestDescent : public AbstractSingleObjectiveOptimizer<RealVector >
+///
+/// The template parameter is the type of the search point, SteepestDescent is the version for RealVector.
+template<class SearchPointType>
+class SteepestDescentT : public AbstractSingleObjectiveOptimizer<SearchPointType >
 {
+private:
+	typedef AbstractSingleObjectiveOptimizer<SearchPointType > base_type;
 public:
-	SteepestDescent() {
-		m_features |= REQUIRES_FIRST_DERIVATIVE;
+	typedef typename base_type::ObjectiveFunctionType ObjectiveFunctionType;
+	SteepestDescentT() {
+		this->m_features |= base_type::REQUIRES_FIRST_DERIVATIVE;
 
 		m_learningRate = 0.1;
 		m_momentum = 0.0;
@@ -54,15 +87,15 @@ public:
 	{ return "SteepestDescent"; }
 
 	void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
-		checkFeatures(objectiveFunction);
+		this->checkFeatures(objectiveFunction);
 		SHARK_RUNTIME_CHECK(startingPoint.size() == objectiveFunction.numberOfVariables(), "Initial starting point and dimensionality of function do not agree");
 		
 		m_path.resize(startingPoint.size());
 		m_path.clear();
-		m_best.point = startingPoint;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		this->m_best.point = startingPoint;
+		this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,m_derivative);
 	}
-	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+	using base_type::init;
 
 	/*!
 	 *  \brief get learning rate
@@ -95,9 +128,8 @@ public:
 	 *  \brief updates searchdirection and then does simple gradient descent
 	 */
 	void step(ObjectiveFunctionType const& objectiveFunction) {
-		m_path = -m_learningRate * m_derivative + m_momentum * m_path;
-		m_best.point+=m_path;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		detail::momentumUpdate(this->m_best.point, m_path, m_derivative, 1.0, m_learningRate, m_momentum, 0.0);
+		this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,m_derivative);
 	}
 	virtual void read( InArchive & archive )
 	{
@@ -114,12 +146,14 @@ public:
 	}
 
 private:
-	RealVector m_path;
-	ObjectiveFunctionType::FirstOrderDerivative m_derivative;
+	SearchPointType m_path;
+	SearchPointType m_derivative;
 	double m_learningRate;
 	double m_momentum;
 };
 
+typedef SteepestDescentT<RealVector> SteepestDescent;
+
 }
 #endif
 
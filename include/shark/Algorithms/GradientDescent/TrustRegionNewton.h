@@ -62,6 +62,10 @@ namespace shark {
 /// is set by a forcing-schedule so that accuracy increases in the vicinity of the
 /// optimum, enabling solutions with arbitrary precision.
 ///
+/// If the objective function provides hessianVectorProduct, the Hessian is never formed and
+/// CG only uses products of the Hessian with vectors. This makes the method applicable
+/// to problems with many variables, for example linear models on high dimensional data.
+///
 /// The algorithm is based on 
 /// Jorge Nocedal, Stephen J. Wright
 /// Numerical Optimization, 2nd Edition
@@ -75,7 +79,7 @@ public:
 	/// \brief Initialize the iterative optimizer with a problem (objective function) and a starting point.
 	///
 	/// The initial trust region radius is set to 0.1
-	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint){
+	void init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint){
 		init(objectiveFunction,startingPoint,0.1);
 	}
 	/// \brief Initialize the iterative optimizer with a problem (objective function), a starting point and an initial value for the trust-region
@@ -99,7 +103,26 @@ public:
 	/// \brief Perform one trust region Newton step, update point and trust region radius.
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
+	/// \brief Returns the derivative of the objective function at the current point.
+	RealVector const& derivative()const{
+		return m_derivatives.gradient;
+	}
+
+	/// \brief Returns true if the last step could not improve the point any further.
+	///
+	/// This is the case when the decrease of the function value predicted by the model
+	/// is below the rounding error of the current function value. Further steps only
+	/// shrink the trust region.
+	bool converged()const{
+		return m_converged;
+	}
+
 protected:
+	/// \brief Evaluates value and derivatives at the current point, the Hessian only if it is needed.
+	SHARK_EXPORT_SYMBOL double evalDerivative(ObjectiveFunctionType const& objectiveFunction);
+
+	bool m_hessianFree;                                           ///< Whether products with the Hessian are computed by the objective function.
+	bool m_converged;                                             ///< Whether the last step predicted no measurable improvement.
 	double m_delta;                                               ///< Current trust region size
 	double m_minImprovementRatio;                                 ///< Minimal improvement ratio (see the algorithm details in the class description).
 	ObjectiveFunctionType::SecondOrderDerivative m_derivatives;   ///< First and second derivative of the objective function in the current point.
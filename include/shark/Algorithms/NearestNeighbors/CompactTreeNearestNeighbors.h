@@ -0,0 +1,99 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Nearest neighbor queries using a pointer-free tree.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_NEARESTNEIGHBORS_COMPACTTREENEARESTNEIGHBORS_H
+#define SHARK_ALGORITHMS_NEARESTNEIGHBORS_COMPACTTREENEARESTNEIGHBORS_H
+
+#include <shark/Algorithms/NearestNeighbors/AbstractNearestNeighbors.h>
+#include <shark/Models/Trees/CompactTree.h>
+#include <shark/Data/DataView.h>
+
+namespace shark {
+
+///\brief Nearest Neighbors implementation using a CompactTree
+///
+/// Builds the tree from the inputs of the dataset and returns the labels and Euclidean
+/// distances of the k nearest neighbors of a point, like TreeNearestNeighbors with a
+/// KDTree or LCTree. The points of a batch are queried in parallel.
+template<class LabelType>
+class CompactTreeNearestNeighbors:public AbstractNearestNeighbors<RealVector,LabelType>
+{
+private:
+	typedef AbstractNearestNeighbors<RealVector,LabelType> base_type;
+
+public:
+	typedef LabeledData<RealVector, LabelType> Dataset;
+	typedef typename base_type::DistancePair DistancePair;
+	typedef typename Batch<RealVector>::type BatchInputType;
+
+	CompactTreeNearestNeighbors(
+		Dataset const& dataset,
+		CompactTree::SplitRule rule = CompactTree::KDSplit,
+		TreeConstruction tc = TreeConstruction(0, 16)
+	)
+	: m_dataset(dataset)
+	, m_labels(dataset.labels())
+	, m_tree(dataset.inputs(), rule, tc)
+	{
+		this->m_inputShape = dataset.inputShape();
+	}
+
+	///\brief returns the k nearest neighbors of the point
+	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
+		std::vector<CompactTree::DistancePair> neighbors = m_tree.nearestNeighbors(patterns, k);
+		std::vector<DistancePair> results(neighbors.size());
+		for(std::size_t i = 0; i != neighbors.size(); ++i){
+			results[i].key = neighbors[i].key;
+			results[i].value = m_labels[neighbors[i].value];
+		}
+		return results;
+	}
+
+	LabeledData<RealVector,LabelType>const& dataset()const {
+		return m_dataset;
+	}
+
+	CompactTree const& tree()const{
+		return m_tree;
+	}
+
+private:
+	Dataset m_dataset;
+	DataView<Data<LabelType> const> m_labels;
+	CompactTree m_tree;
+};
+
+
+}
+#endif
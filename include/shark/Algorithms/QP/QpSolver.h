@@ -37,6 +37,7 @@
 #define SHARK_ALGORITHMS_QP_QPSOLVER_H
 
 #include <shark/Core/Timer.h>
+#include <shark/Core/Profiler.h>
 #include <shark/Algorithms/QP/QuadraticProgram.h>
 #include <shark/Data/Dataset.h>
 
@@ -416,6 +417,7 @@ public:
 		QpStoppingCondition& stop,
 		QpSolutionProperties* prop = NULL
 	){
+		SHARK_PROFILE_REGION("QpSolver::solve");
 		double start_time = Timer::now();
 		unsigned long long iter = 0;
 		unsigned long long shrinkCounter = 0;
@@ -464,6 +466,7 @@ public:
 			iter++;
 			shrinkCounter--;
 		}
+		SHARK_PROFILE_COUNTER("iterations", iter);
 
 		if (prop != NULL)
 		{
@@ -31,8 +31,35 @@
 #define SHARK_ALGORITHMS_QP_SVMPROBLEMS_H
 
 #include <shark/Algorithms/QP/BoxConstrainedProblems.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark{
+
+namespace detail{
+/// \brief The variable with largest gradient which can be increased and the one with smallest gradient which can be decreased.
+///
+/// If no variable can be increased (decreased), largestUp (smallestDown) is -1e100 (1e100).
+struct ViolatingPair{
+	double largestUp;
+	double smallestDown;
+	std::size_t up;
+	std::size_t down;
+
+	ViolatingPair():largestUp(-1e100), smallestDown(1e100), up(0), down(0){}
+
+	/// \brief Merges the pair of a range of variables with higher indices. On ties the lower index is kept.
+	void merge(ViolatingPair const& other){
+		if(other.largestUp > largestUp){
+			largestUp = other.largestUp;
+			up = other.up;
+		}
+		if(other.smallestDown < smallestDown){
+			smallestDown = other.smallestDown;
+			down = other.down;
+		}
+	}
+};
+}
  
 // Working-Set-Selection-Criteria are applied as follows:
 // Criterium crit;
@@ -54,32 +81,12 @@ struct MVPSelectionCriterion{
 	template<class Problem>
 	double operator()(Problem& problem, std::size_t& i, std::size_t& j)
 	{
-		double largestUp = -1e100;
-		double smallestDown = 1e100;
-
-		for (std::size_t a=0; a < problem.active(); a++)
-		{
-			double ga = problem.gradient(a);
-			if (!problem.isUpperBound(a))
-			{
-				if (ga > largestUp)
-				{
-					largestUp = ga;
-					i = a;
-				}
-			}
-			if (!problem.isLowerBound(a))
-			{
-				if (ga < smallestDown)
-				{
-					smallestDown = ga;
-					j = a;
-				}
-			}
-		}
+		detail::ViolatingPair const& pair = problem.maximalViolatingPair();
+		if (pair.largestUp != -1e100) i = pair.up;
+		if (pair.smallestDown != 1e100) j = pair.down;
 
 		// MVP stopping condition
-		return largestUp - smallestDown;
+		return pair.largestUp - pair.smallestDown;
 	}
 	
 	void reset(){}
@@ -105,44 +112,40 @@ struct LibSVMSelectionCriterion{
 		i = 0;
 		j = 1;
 
-		double smallestDown = 1e100;
-		double largestUp = -1e100;
-
-		for (std::size_t a=0; a < problem.active(); a++)
-		{
-			double ga = problem.gradient(a);
-			//if (aa < problem.boxMax(a))
-			if (!problem.isUpperBound(a))
-			{
-				if (ga > largestUp)
-				{
-					largestUp = ga;
-					i = a;
-				}
-			}
-		}
+		//the first index is found by the problem during the last gradient update
+		detail::ViolatingPair const& pair = problem.maximalViolatingPair();
+		double largestUp = pair.largestUp;
+		double smallestDown = pair.smallestDown;
 		if (largestUp == -1e100) return 0.0;
+		i = pair.up;
 
 		// find the second index using second order information
+		// The largest gain of a block is found using independent accumulators, the index is only
+		// searched for in blocks which contain a new best gain.
 		typename Problem::QpFloatType* q = problem.quadratic().row(i, 0, problem.active());
+		double di = problem.diagonal(i);
+		auto gain = [&](std::size_t a){
+			return problem.isLowerBound(a)? 0.0: detail::maximumGainQuadratic2DOnLine(
+				di, problem.diagonal(a), q[a], largestUp, problem.gradient(a)
+			);
+		};
 		double best = 0.0;
-		for (std::size_t a = 0; a < problem.active(); a++){
-			double ga = problem.gradient(a);
-			if (!problem.isLowerBound(a))
-			{
-				smallestDown=std::min(smallestDown,ga);
-				
-				double gain = detail::maximumGainQuadratic2DOnLine(
-					problem.diagonal(i),
-					problem.diagonal(a),
-					q[a],
-					largestUp,ga
-				);
-				if (gain> best)
-				{
-					best = gain;
-					j = a;
-				}
+		std::size_t const blockSize = 256;
+		for (std::size_t start = 0; start < problem.active(); start += blockSize){
+			std::size_t end = std::min(start + blockSize, problem.active());
+			double blockBest[4] = {0.0, 0.0, 0.0, 0.0};
+			std::size_t a = start;
+			for (; a + 4 <= end; a += 4){
+				for (std::size_t l = 0; l != 4; ++l)
+					blockBest[l] = std::max(blockBest[l], gain(a + l));
+			}
+			for (; a < end; ++a)
+				blockBest[0] = std::max(blockBest[0], gain(a));
+			double maxGain = std::max(std::max(blockBest[0], blockBest[1]), std::max(blockBest[2], blockBest[3]));
+			if (maxGain > best){
+				for (a = start; gain(a) != maxGain; ++a);
+				best = maxGain;
+				j = a;
 			}
 		}
 
@@ -233,9 +236,6 @@ private:
 		std::size_t bestIndex = 0;//index of variable
 		double bestGain = 0;
 		
-		double largestUp = -1e100;
-		double smallestDown = 1e100;
-
 		// try combinations with b = old_i
 		typename Problem::QpFloatType* q = problem.quadratic().row(i, 0, problem.active());
 		double ab = problem.alpha(i);
@@ -246,12 +246,6 @@ private:
 		for (std::size_t a = 0; a < problem.active(); a++)
 		{
 			double ga = problem.gradient(a);
-			
-			if (!problem.isUpperBound(a))
-				largestUp = std::max(largestUp,ga);
-			if (!problem.isLowerBound(a))
-				smallestDown = std::min(smallestDown,ga);
-			
 			if (a == i) continue;
 			//get maximum unconstrained step length
 			double denominator = (problem.diagonal(a) + db - 2.0 * q[a]);
@@ -281,7 +275,9 @@ private:
 			}
 		}
 		MGStep step;
-		step.violation= largestUp-smallestDown;
+		//the KKT violation is known from the last gradient update
+		detail::ViolatingPair const& pair = problem.maximalViolatingPair();
+		step.violation= pair.largestUp-pair.smallestDown;
 		step.index = bestIndex;
 		step.gain=bestGain;
 		return step;
@@ -307,7 +303,8 @@ public:
 	: m_problem(problem)
 	, m_gradient(problem.linear)
 	, m_active(problem.dimensions())
-	, m_alphaStatus(problem.dimensions(),AlphaFree){
+	, m_alphaStatus(problem.dimensions(),AlphaFree)
+	, m_pairValid(false){
 		//compute the gradient if alpha != 0
 		for (std::size_t i=0; i != dimensions(); i++){
 			double v = alpha(i);
@@ -422,14 +419,24 @@ public:
 		
 		if(ai == aiOld && aj == ajOld)return;
 		
-		//Update internal data structures (gradient and alpha status)
-		QpFloatType* qj = quadratic().row(j, 0, active());
-		for (std::size_t a = 0; a < active(); a++) 
-			m_gradient(a) -= step * qi[a] - step * qj[a];
-		
-		//update boundary status
+		//Update internal data structures (alpha status and gradient)
 		updateAlphaStatus(i);
 		updateAlphaStatus(j);
+		QpFloatType* qj = quadratic().row(j, 0, active());
+		updateGradient(qi, qj, step);
+	}
+
+	/// \brief Returns the maximal violating pair of the active variables.
+	///
+	/// The pair is found during the gradient update of updateSMO and is only recomputed
+	/// if the problem was changed otherwise in between.
+	detail::ViolatingPair const& maximalViolatingPair()const{
+		if(!m_pairValid || m_pairActive != active()){
+			m_pair = findViolatingPair(0, active());
+			m_pairActive = active();
+			m_pairValid = true;
+		}
+		return m_pair;
 	}
 
 	///\brief Returns the current function value of the problem.
@@ -459,6 +466,7 @@ public:
 			m_gradient(i) = gradient(j);
 			updateAlphaStatus(i);
 		}
+		m_pairValid = false;
 	}
 
 	/// \brief Define the initial solution for the iterative solver.
@@ -498,12 +506,14 @@ public:
 			if(alpha(i) == 0.0) break;
 		}
 		m_alphaStatus[i] = AlphaDeactivated;
+		m_pairValid = false;
 	}
 	///\brief Reactivate an previously deactivated variable.
 	void activateVariable(std::size_t i){
 		SIZE_CHECK(i < dimensions());
 		m_alphaStatus[i] = AlphaFree;
 		updateAlphaStatus(i);
+		m_pairValid = false;
 	}
 	
 	/// exchange two variables via the permutation
@@ -516,6 +526,7 @@ public:
 		m_problem.flipCoordinates(i, j);
 		std::swap( m_gradient[i], m_gradient[j]);
 		std::swap( m_alphaStatus[i], m_alphaStatus[j]);
+		m_pairValid = false;
 	}
 	
 	/// \brief Scales all box constraints by a constant factor and adapts the solution using a separate scaling
@@ -529,6 +540,7 @@ public:
 			m_gradient(i) += linear(i);
 			updateAlphaStatus(i);
 		}
+		m_pairValid = false;
 	}
 	
 	/// \brief adapts the linear part of the problem and updates the internal data structures accordingly.
@@ -536,18 +548,12 @@ public:
 		m_gradient(i) -= linear(i);
 		m_gradient(i) += newValue;
 		m_problem.linear(i) = newValue;
+		m_pairValid = false;
 	}
 	
 	double checkKKT()const{
-		double largestUp = -1e100;
-		double smallestDown = 1e100;
-		for (std::size_t a = 0; a < active(); a++){
-			if (!isLowerBound(a))
-				smallestDown = std::min(smallestDown,gradient(a));
-			if (!isUpperBound(a))
-				largestUp = std::max(largestUp,gradient(a));
-		}
-		return largestUp - smallestDown;
+		detail::ViolatingPair const& pair = maximalViolatingPair();
+		return pair.largestUp - pair.smallestDown;
 	}
 
 protected:
@@ -561,6 +567,100 @@ protected:
 	/// \brief Stores the status, whther alpha is on the lower or upper bound, or whether it is free.
 	std::vector<char> m_alphaStatus;
 
+	/// \brief Maximal violating pair of the first m_pairActive variables, if m_pairValid is set.
+	mutable detail::ViolatingPair m_pair;
+	mutable std::size_t m_pairActive;
+	mutable bool m_pairValid;
+
+	/// \brief Number of active variables from which on the gradient update is split between threads.
+	static const std::size_t MinParallelSize = std::size_t(1) << 16;
+	/// \brief Number of variables which are updated before they are searched for the violating pair.
+	///
+	/// Blocks stay in the L1 cache between the update and the search, so the gradient is read from memory only once.
+	static const std::size_t BlockSize = 256;
+
+	/// \brief Finds the maximal violating pair of the variables start,...,end-1.
+	detail::ViolatingPair findViolatingPair(std::size_t start, std::size_t end)const{
+		detail::ViolatingPair pair;
+		for(std::size_t blockStart = start; blockStart < end; blockStart += BlockSize)
+			updateViolatingPair(blockStart, std::min(blockStart + BlockSize, end), pair);
+		return pair;
+	}
+
+	/// \brief Updates pair with the variables start,...,end-1, which must have larger indices than the ones already seen.
+	///
+	/// The extreme values are found first using independent accumulators, which avoids the long dependency
+	/// chain of tracking the index. The index is only searched for when the block contains a new extreme value.
+	void updateViolatingPair(std::size_t start, std::size_t end, detail::ViolatingPair& pair)const{
+		double const* g = m_gradient.raw_storage().values;
+		char const* status = m_alphaStatus.data();
+		double up[4] = {-1e100, -1e100, -1e100, -1e100};
+		double down[4] = {1e100, 1e100, 1e100, 1e100};
+		std::size_t a = start;
+		for(; a + 4 <= end; a += 4){
+			for(std::size_t l = 0; l != 4; ++l){
+				up[l] = std::max(up[l], (status[a + l] & AlphaUpperBound)? -1e100: g[a + l]);
+				down[l] = std::min(down[l], (status[a + l] & AlphaLowerBound)? 1e100: g[a + l]);
+			}
+		}
+		for(; a < end; ++a){
+			up[0] = std::max(up[0], (status[a] & AlphaUpperBound)? -1e100: g[a]);
+			down[0] = std::min(down[0], (status[a] & AlphaLowerBound)? 1e100: g[a]);
+		}
+		double largestUp = std::max(std::max(up[0], up[1]), std::max(up[2], up[3]));
+		double smallestDown = std::min(std::min(down[0], down[1]), std::min(down[2], down[3]));
+		if(largestUp > pair.largestUp){
+			for(a = start; (status[a] & AlphaUpperBound) || g[a] != largestUp; ++a);
+			pair.largestUp = largestUp;
+			pair.up = a;
+		}
+		if(smallestDown < pair.smallestDown){
+			for(a = start; (status[a] & AlphaLowerBound) || g[a] != smallestDown; ++a);
+			pair.smallestDown = smallestDown;
+			pair.down = a;
+		}
+	}
+
+	///\brief Computes g -= step*qi - step*qj for the active variables and the new maximal violating pair.
+	///
+	/// This is a single pass over the gradient and the kernel rows. The alpha status must already be up to date.
+	/// Large problems are split into one range per thread. The ranges are merged in order, thus the
+	/// result is the same as in a sequential pass.
+	void updateGradient(QpFloatType const* qi, QpFloatType const* qj, double step){
+		std::size_t n = active();
+		std::size_t numRanges = 1;
+		if(n >= MinParallelSize)
+			numRanges = std::min<std::size_t>(SHARK_NUM_THREADS, n / (MinParallelSize / 2));
+		if(numRanges <= 1){
+			m_pair = updateGradientRange(qi, qj, step, 0, n);
+		}else{
+			std::vector<detail::ViolatingPair> pairs(numRanges);
+			SHARK_PARALLEL_FOR(int t = 0; t < (int)numRanges; ++t){
+				pairs[t] = updateGradientRange(qi, qj, step, n * t / numRanges, n * (t + 1) / numRanges);
+			}
+			m_pair = pairs[0];
+			for(std::size_t t = 1; t != numRanges; ++t)
+				m_pair.merge(pairs[t]);
+		}
+		m_pairActive = n;
+		m_pairValid = true;
+	}
+
+	detail::ViolatingPair updateGradientRange(
+		QpFloatType const* qi, QpFloatType const* qj, double step,
+		std::size_t start, std::size_t end
+	){
+		double* g = m_gradient.raw_storage().values;
+		detail::ViolatingPair pair;
+		for(std::size_t blockStart = start; blockStart < end; blockStart += BlockSize){
+			std::size_t blockEnd = std::min(blockStart + BlockSize, end);
+			for(std::size_t a = blockStart; a < blockEnd; ++a)
+				g[a] -= step * qi[a] - step * qj[a];
+			updateViolatingPair(blockStart, blockEnd, pair);
+		}
+		return pair;
+	}
+
 	///\brief Update the problem by a proposed step i taking the box constraints into account.
 	///
 	/// A step length 0<=lambda<=1 is found so that 
@@ -608,15 +708,12 @@ protected:
 	        
 	        if(ai == aiOld && aj == ajOld)return;
 	        
-	        //Update internal data structures (gradient and alpha status)
-	        QpFloatType* qi = quadratic().row(i, 0, active());
-	        QpFloatType* qj = quadratic().row(j, 0, active());
-	        for (std::size_t a = 0; a < active(); a++) 
-	                m_gradient(a) -= step * qi[a] - step * qj[a];
-	        
-	        //update boundary status
+	        //Update internal data structures (alpha status and gradient)
 	        updateAlphaStatus(i);
 	        updateAlphaStatus(j);
+	        QpFloatType* qi = quadratic().row(i, 0, active());
+	        QpFloatType* qj = quadratic().row(j, 0, active());
+	        updateGradient(qi, qj, step);
 	}
 
 	
@@ -81,6 +81,16 @@ public:
 	virtual void addToModel(ModelType& model, InputType const& alpha, ElementType const& supportVector)  = 0;
 
 
+	/// this is called by the trainer after the budget has been initialized and before
+	/// the first call to addToModel. Strategies caching information about the budget
+	/// vectors have to reset it here. The default does nothing.
+	///
+	/// @param[in]  model   the model the strategy will work with
+	///
+	virtual void init(ModelType const& model)
+	{ }
+
+
 
 	/// this will find the vector with the smallest alpha, measured in 2-norm
 	/// in the given model. now there is a special case: if there is somewhere a zero
@@ -257,7 +257,9 @@ public:
 
 		// create a preinitialized budget.
 		// this is used to initialize the kernelexpansion, we will work with.
-		LabeledData<InputType, unsigned int> preinitializedBudgetVectors(m_budgetSize, dataset.element(0));
+		// the budget is stored as a single batch, so that kernel rows
+		// can be computed with a single matrix-vector product.
+		LabeledData<InputType, unsigned int> preinitializedBudgetVectors(m_budgetSize, dataset.element(0), m_budgetSize);
 
 		// preinit the vectors first
 		// we still preinit even for no preinit, as we need the vectors in the
@@ -331,6 +333,8 @@ public:
 		// or it is the extra budget vector we need for technical reasons
 		row(budgetAlpha, m_budgetSize - 1) *= 0;
 
+		m_budgetMaintenanceStrategy->init(budgetModel);
+
 
 		// preinitialize everything to prevent costly memory allocations in the loop
 		RealVector predictions(classes, 0.0);
@@ -54,6 +54,7 @@
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
 
 #include <shark/Algorithms/Trainers/Budgeted/AbstractBudgetMaintenanceStrategy.h>
 
@@ -182,6 +183,7 @@ public:
 	/// this routine will do the real merging. Given a index it will search for a second
 	/// index, so that merging is 'optimal'. It then will perform the merging. After that
 	/// the last budget vector will be freed again (by setting its alpha-coefficients to zero).
+	/// For Gaussian kernels the search is vectorized, see findGaussianMerge.
 	/// \param[in]  model   Model to work on
 	/// \param[in]  firstIndex  The index of the first element of the pair to merge.
 	///
@@ -189,109 +191,22 @@ public:
 	{
 		size_t maxIndex = model.basis().numberOfElements();
 
-		// compute the kernel row of the given, first element and all the others
-		// should take O(B) time, as it is a row of size B
-		blas::vector<float> kernelRow(maxIndex, 0.0);
-		for(size_t j = 0; j < maxIndex; j++)
-			kernelRow(j) = static_cast<float>( model.kernel()->eval(model.basis().element(firstIndex), model.basis().element(j)));
-
-		// initialize the search
-		double fret(0.);
-		RealVector h(1);     // initial search starting point
-		RealVector xi(1);    // direction of search
-		RealVector d(1);    // derivative ater line-search (not needed)
-
-		// save the parameter at the minimum
-		double minDegradation = std::numeric_limits<double>::infinity();
-		double minH = 0.0;
-		double minAlphaMergedFirst = 0.0;
-		double minAlphaMergedSecond = 0.0;
-		size_t secondIndex = 0;
-
-
-		// we need to check every other vector
-		RealMatrix &alpha = model.alpha();
-		for(size_t currentIndex = 0; currentIndex < maxIndex; currentIndex++)
-		{
-			// we do not want the vector already chosen
-			if(firstIndex == currentIndex)
-				continue;
-
-			// compute the alphas for the model, this is the formula
-			// between (6.7) and (6.8) in wang, crammer, vucetic
-			double a = 0.0;
-			double b = 0.0;
-			for(size_t c = 0; c < alpha.size2(); c++)
-			{
-				double d = std::min(0.00001, alpha(currentIndex, c) + alpha(firstIndex, c));
-				a += alpha(firstIndex, c) / d;
-				b += alpha(currentIndex, c) / d;
-			}
-
-			// Initialize search starting point and direction:
-			h(0) = 0.0;
-			xi(0) = 0.5;
-			double k = kernelRow(currentIndex);
-			MergingProblemFunction mergingProblemFunction(a, b, k);
-			fret = mergingProblemFunction.evalDerivative(h,d);
-			//perform a line-search
-			LineSearch lineSearch;
-			lineSearch.lineSearchType() = LineSearch::Dlinmin;
-			lineSearch.init(mergingProblemFunction);
-			lineSearch(h,fret,xi,d,1.0);
-
-			// the optimal point is now given by h.
-			// the vector that corresponds to this is
-			// $z = h x_m + (1-h) x_n$  by formula (6.7)
-			RealVector firstVector = model.basis().element(firstIndex);
-			RealVector currentVector = model.basis().element(currentIndex);
-			RealVector mergedVector = h(0) * firstVector + (1.0 - h(0)) * currentVector;
-
-			// this is another minimization problem, which has as optimal
-			// solution $\alpha_z^{(i)} = \alpha_m^{(i)} k(x_m, z) + \alpha_n^{(i)} k(x_n, z).$
-
-			// the coefficient of this z is computed by approximating
-			// both vectors by the merged one. maybe KernelBasisDistance can be used
-			// but i am not sure, if at all and if, if its faster.
-
-			long double alphaMergedFirst = pow(k, (1.0 - h(0)) * (1.0 - h(0)));
-			long double alphaMergedCurrent = pow(k, h(0) * h(0));
-
-			// degradation is computed for each class
-			// this is computed by using formula (6.8), applying it to each class and summing up
-			// here a kernel with $k(x,x) = 1$ is assumed
-			double currentDegradation = 0.0f;
-			for(size_t c = 0; c < alpha.size2(); c++)
-			{
-				double zAlpha = alphaMergedFirst * alpha(firstIndex, c) + alphaMergedCurrent * alpha(currentIndex, c);
-				// TODO: unclear to me why this is the thing we want to compute
-				currentDegradation += pow(alpha(firstIndex, c), 2) + pow(alpha(currentIndex, c), 2) +
-									  2.0 * k * alpha(firstIndex, c) * alpha(currentIndex, c) - zAlpha * zAlpha;
-			}
-
-			// TODO: this is shamelessly copied, as the rest, but maybe i want to refactor it and make it nicer.
-			if(currentDegradation < minDegradation)
-			{
-				minDegradation = currentDegradation;
-				minH = h(0);
-				minAlphaMergedFirst = alphaMergedFirst;
-				minAlphaMergedSecond = alphaMergedCurrent;
-				secondIndex = currentIndex;
-			}
-		}
+		GaussianRbfKernel<RealVector> const* gaussian = dynamic_cast<GaussianRbfKernel<RealVector> const*>(model.kernel());
+		MergeCandidate merge = gaussian? findGaussianMerge(model, firstIndex, gaussian->gamma()) : findMerge(model, firstIndex);
 
 		// compute merged vector
 		RealVector firstVector = model.basis().element(firstIndex);
-		RealVector secondVector = model.basis().element(secondIndex);
-		RealVector mergedVector = minH * firstVector + (1.0 - minH) * secondVector;
+		RealVector secondVector = model.basis().element(merge.secondIndex);
+		RealVector mergedVector = merge.h * firstVector + (1.0 - merge.h) * secondVector;
 
 		// replace the second vector by the merged one
-		model.basis().element(secondIndex) = mergedVector;
+		model.basis().element(merge.secondIndex) = mergedVector;
 
 		// and update the alphas
+		RealMatrix &alpha = model.alpha();
 		for(size_t c = 0; c < alpha.size2(); c++)
 		{
-			alpha(secondIndex, c) = minAlphaMergedFirst * alpha(firstIndex, c) + minAlphaMergedSecond * alpha(secondIndex, c);
+			alpha(merge.secondIndex, c) = merge.alphaMergedFirst * alpha(firstIndex, c) + merge.alphaMergedSecond * alpha(merge.secondIndex, c);
 		}
 
 		// the first index is now obsolete, so we copy the
@@ -302,6 +217,27 @@ public:
 		// clear the  buffer by cleaning the alphas
 		// finally the vectors we merged.
 		row(model.alpha(), maxIndex - 1).clear();
+
+		updateSquaredNorm(model, merge.secondIndex);
+		updateSquaredNorm(model, firstIndex);
+	}
+
+
+	/// Prepares the strategy for a new budget.
+	/// Computes the squared norms of the budget vectors, which are cached for Gaussian kernels.
+	/// \param[in]  model   the model the strategy will work with
+	///
+	virtual void init(ModelType const& model)
+	{
+		m_squaredNorms.resize(model.basis().numberOfElements());
+		std::size_t start = 0;
+		for(auto const& batch: model.basis().batches())
+		{
+			std::size_t size = batch.size1();
+			for(std::size_t i = 0; i != size; ++i)
+				m_squaredNorms(start + i) = norm_sqr(row(batch, i));
+			start += size;
+		}
 	}
 
 
@@ -331,6 +267,7 @@ public:
 		size_t maxIndex = model.basis().numberOfElements();
 		model.basis().element(maxIndex - 1) = supportVector.input;
 		row(model.alpha(), maxIndex - 1) = alpha;
+		updateSquaredNorm(model, maxIndex - 1);
 
 
 		// the first vector to merge is the one with the smallest alpha coefficient
@@ -348,6 +285,7 @@ public:
 			// vector to that place and undo our putting-the-vector-to-back-position
 			model.basis().element(firstIndex) = supportVector.input;
 			row(model.alpha(), firstIndex) = alpha;
+			updateSquaredNorm(model, firstIndex);
 
 			// enough to zero out the alpha
 			row(model.alpha(), maxIndex - 1).clear();
@@ -370,6 +308,298 @@ public:
 
 
 protected:
+	/// The result of the search for the second vector to merge.
+	struct MergeCandidate
+	{
+		size_t secondIndex;          ///< index of the second vector
+		double h;                    ///< the merged vector is h * x_first + (1-h) * x_second
+		double alphaMergedFirst;     ///< weight of the alphas of the first vector in the merged alphas
+		double alphaMergedSecond;    ///< weight of the alphas of the second vector in the merged alphas
+	};
+
+
+	/// Searches the vector to merge with the vector at firstIndex for arbitrary kernels.
+	/// For each candidate, the merging problem is solved by a line search.
+	/// \param[in]  model   Model to work on
+	/// \param[in]  firstIndex  The index of the first element of the pair to merge.
+	///
+	MergeCandidate findMerge(ModelType const& model, size_t firstIndex)
+	{
+		size_t maxIndex = model.basis().numberOfElements();
+
+		// compute the kernel row of the given, first element and all the others
+		// should take O(B) time, as it is a row of size B
+		blas::vector<float> kernelRow(maxIndex, 0.0);
+		for(size_t j = 0; j < maxIndex; j++)
+			kernelRow(j) = static_cast<float>( model.kernel()->eval(model.basis().element(firstIndex), model.basis().element(j)));
+
+		RealVector h(1);     // optimal mixing of both vectors
+
+		// save the parameter at the minimum
+		double minDegradation = std::numeric_limits<double>::infinity();
+		MergeCandidate merge = {0, 0.0, 0.0, 0.0};
+
+
+		// we need to check every other vector
+		RealMatrix const& alpha = model.alpha();
+		for(size_t currentIndex = 0; currentIndex < maxIndex; currentIndex++)
+		{
+			// we do not want the vector already chosen
+			if(firstIndex == currentIndex)
+				continue;
+
+			// compute the alphas for the model, this is the formula
+			// between (6.7) and (6.8) in wang, crammer, vucetic
+			double a = 0.0;
+			double b = 0.0;
+			for(size_t c = 0; c < alpha.size2(); c++)
+			{
+				double d = std::min(0.00001, alpha(currentIndex, c) + alpha(firstIndex, c));
+				a += alpha(firstIndex, c) / d;
+				b += alpha(currentIndex, c) / d;
+			}
+
+			double k = kernelRow(currentIndex);
+			h(0) = solveMergingProblem(a, b, k);
+
+			// the optimal point is now given by h.
+			// the vector that corresponds to this is
+			// $z = h x_m + (1-h) x_n$  by formula (6.7)
+
+			// this is another minimization problem, which has as optimal
+			// solution $\alpha_z^{(i)} = \alpha_m^{(i)} k(x_m, z) + \alpha_n^{(i)} k(x_n, z).$
+
+			// the coefficient of this z is computed by approximating
+			// both vectors by the merged one. maybe KernelBasisDistance can be used
+			// but i am not sure, if at all and if, if its faster.
+
+			long double alphaMergedFirst = pow(k, (1.0 - h(0)) * (1.0 - h(0)));
+			long double alphaMergedCurrent = pow(k, h(0) * h(0));
+
+			// degradation is computed for each class
+			// this is computed by using formula (6.8), applying it to each class and summing up
+			// here a kernel with $k(x,x) = 1$ is assumed
+			double currentDegradation = 0.0f;
+			for(size_t c = 0; c < alpha.size2(); c++)
+			{
+				double zAlpha = alphaMergedFirst * alpha(firstIndex, c) + alphaMergedCurrent * alpha(currentIndex, c);
+				// TODO: unclear to me why this is the thing we want to compute
+				currentDegradation += pow(alpha(firstIndex, c), 2) + pow(alpha(currentIndex, c), 2) +
+									  2.0 * k * alpha(firstIndex, c) * alpha(currentIndex, c) - zAlpha * zAlpha;
+			}
+
+			// TODO: this is shamelessly copied, as the rest, but maybe i want to refactor it and make it nicer.
+			if(currentDegradation < minDegradation)
+			{
+				minDegradation = currentDegradation;
+				merge.h = h(0);
+				merge.alphaMergedFirst = alphaMergedFirst;
+				merge.alphaMergedSecond = alphaMergedCurrent;
+				merge.secondIndex = currentIndex;
+			}
+		}
+		return merge;
+	}
+
+
+	/// Solves the merging problem \f$ \max_h a \cdot k^{(1-h)^2} + b \cdot k^{h^2} \f$ by a line search starting in h=0.
+	static double solveMergingProblem(double a, double b, double k)
+	{
+		// Initialize search starting point and direction:
+		RealVector h(1, 0.0);
+		RealVector xi(1, 0.5);
+		RealVector d(1);    // derivative ater line-search (not needed)
+		MergingProblemFunction mergingProblemFunction(a, b, k);
+		double fret = mergingProblemFunction.evalDerivative(h,d);
+		//perform a line-search
+		LineSearch lineSearch;
+		lineSearch.lineSearchType() = LineSearch::Dlinmin;
+		lineSearch.init(mergingProblemFunction);
+		lineSearch(h,fret,xi,d,1.0);
+		return h(0);
+	}
+
+
+	/// Searches the vector to merge with the vector at firstIndex for Gaussian kernels.
+	/// The kernel row is computed from the cached squared norms of the budget vectors
+	/// and one matrix-vector product per batch of the budget. The merging problems
+	/// \f[ \max_h a \cdot k^{(1-h)^2} + b \cdot k^{h^2} \f]
+	/// of all candidates are then solved at once by a golden section search on [0,1].
+	/// For \f$ a, b \geq 0 \f$, which holds if in every class the alphas of both vectors have the same sign,
+	/// both terms are smaller for h < 0 than for h = 0 and for h > 1 than for h = 1, thus the
+	/// maximum lies in [0,1]. The remaining candidates are solved by the unbounded line search of findMerge.
+	/// All steps are written as loops over contiguous arrays of candidates, which the
+	/// compiler can vectorize.
+	/// \param[in]  model   Model to work on
+	/// \param[in]  firstIndex  The index of the first element of the pair to merge.
+	/// \param[in]  gamma   bandwidth of the Gaussian kernel
+	///
+	MergeCandidate findGaussianMerge(ModelType const& model, size_t firstIndex, double gamma)
+	{
+		size_t maxIndex = model.basis().numberOfElements();
+		RealMatrix const& alpha = model.alpha();
+		if(m_squaredNorms.size() != maxIndex)
+			init(model);
+
+		m_logKernelRow.resize(maxIndex);
+		m_kernelRow.resize(maxIndex);
+		m_a.resize(maxIndex);
+		m_b.resize(maxIndex);
+		m_lower.resize(maxIndex);
+		m_upper.resize(maxIndex);
+		m_innerLower.resize(maxIndex);
+		m_innerUpper.resize(maxIndex);
+		m_valueLower.resize(maxIndex);
+		m_valueUpper.resize(maxIndex);
+		m_alphaMergedFirst.resize(maxIndex);
+		m_alphaMergedCurrent.resize(maxIndex);
+		m_degradation.resize(maxIndex);
+
+		// the kernel row: log k(x_m,x_n) = -gamma(|x_m|^2+|x_n|^2-2<x_m,x_n>)
+		RealVector firstVector = model.basis().element(firstIndex);
+		std::size_t start = 0;
+		for(auto const& batch: model.basis().batches())
+		{
+			std::size_t size = batch.size1();
+			noalias(subrange(m_logKernelRow, start, start + size)) = prod(batch, firstVector);
+			start += size;
+		}
+		double const* norms = m_squaredNorms.raw_storage().values;
+		double* logK = m_logKernelRow.raw_storage().values;
+		double* k = m_kernelRow.raw_storage().values;
+		double firstNorm = m_squaredNorms(firstIndex);
+		for(size_t j = 0; j < maxIndex; j++)
+		{
+			// cancellation can make the distance slightly negative
+			logK[j] = -gamma * std::max(firstNorm + norms[j] - 2 * logK[j], 0.0);
+			k[j] = std::exp(logK[j]);
+		}
+
+		// the coefficients of the merging problems, see findMerge
+		double* a = m_a.raw_storage().values;
+		double* b = m_b.raw_storage().values;
+		m_a.clear();
+		m_b.clear();
+		for(size_t c = 0; c < alpha.size2(); c++)
+		{
+			double alphaFirst = alpha(firstIndex, c);
+			for(size_t j = 0; j < maxIndex; j++)
+			{
+				double d = std::min(0.00001, alpha(j, c) + alphaFirst);
+				a[j] += alphaFirst / d;
+				b[j] += alpha(j, c) / d;
+			}
+		}
+
+		// golden section search for the maximum of all merging problems.
+		// Every iteration reuses one of the two inner points and thus needs a single new evaluation.
+		// 20 iterations give a precision of about 1e-4
+		std::size_t const iterations = 20;
+		double const ratio = 0.5 * (std::sqrt(5.0) - 1.0);
+		double* lower = m_lower.raw_storage().values;
+		double* upper = m_upper.raw_storage().values;
+		double* innerLower = m_innerLower.raw_storage().values;
+		double* innerUpper = m_innerUpper.raw_storage().values;
+		double* valueLower = m_valueLower.raw_storage().values;
+		double* valueUpper = m_valueUpper.raw_storage().values;
+		for(size_t j = 0; j < maxIndex; j++)
+		{
+			lower[j] = 0.0;
+			upper[j] = 1.0;
+			innerLower[j] = 1.0 - ratio;
+			innerUpper[j] = ratio;
+			valueLower[j] = a[j] * std::exp(logK[j] * ratio * ratio) + b[j] * std::exp(logK[j] * (1.0 - ratio) * (1.0 - ratio));
+			valueUpper[j] = a[j] * std::exp(logK[j] * (1.0 - ratio) * (1.0 - ratio)) + b[j] * std::exp(logK[j] * ratio * ratio);
+		}
+		for(size_t iteration = 0; iteration != iterations; iteration++)
+		{
+			for(size_t j = 0; j < maxIndex; j++)
+			{
+				// if the lower inner point is better, the maximum lies in [lower, innerUpper]
+				bool left = valueLower[j] >= valueUpper[j];
+				upper[j] = left ? innerUpper[j] : upper[j];
+				lower[j] = left ? lower[j] : innerLower[j];
+				double width = upper[j] - lower[j];
+				double h = left ? upper[j] - ratio * width : lower[j] + ratio * width;
+				double value = a[j] * std::exp(logK[j] * (1.0 - h) * (1.0 - h)) + b[j] * std::exp(logK[j] * h * h);
+				double oldInnerLower = innerLower[j];
+				double oldValueLower = valueLower[j];
+				innerLower[j] = left ? h : innerUpper[j];
+				valueLower[j] = left ? value : valueUpper[j];
+				innerUpper[j] = left ? oldInnerLower : h;
+				valueUpper[j] = left ? oldValueLower : value;
+			}
+		}
+
+		// the optimal h, stored in place of the lower bracket, and the alpha weights of the merged vectors
+		double* h = lower;
+		double* alphaMergedFirst = m_alphaMergedFirst.raw_storage().values;
+		double* alphaMergedCurrent = m_alphaMergedCurrent.raw_storage().values;
+		for(size_t j = 0; j < maxIndex; j++)
+		{
+			h[j] = 0.5 * (lower[j] + upper[j]);
+		}
+		for(size_t j = 0; j < maxIndex; j++)
+		{
+			if((a[j] < 0 || b[j] < 0) && j != firstIndex)
+				h[j] = solveMergingProblem(a[j], b[j], k[j]);
+		}
+		for(size_t j = 0; j < maxIndex; j++)
+		{
+			alphaMergedFirst[j] = std::exp(logK[j] * (1.0 - h[j]) * (1.0 - h[j]));
+			alphaMergedCurrent[j] = std::exp(logK[j] * h[j] * h[j]);
+		}
+
+		// weight degradation of all merges, see findMerge
+		double* degradation = m_degradation.raw_storage().values;
+		m_degradation.clear();
+		for(size_t c = 0; c < alpha.size2(); c++)
+		{
+			double alphaFirst = alpha(firstIndex, c);
+			for(size_t j = 0; j < maxIndex; j++)
+			{
+				double alphaCurrent = alpha(j, c);
+				double zAlpha = alphaMergedFirst[j] * alphaFirst + alphaMergedCurrent[j] * alphaCurrent;
+				degradation[j] += alphaFirst * alphaFirst + alphaCurrent * alphaCurrent
+					+ 2.0 * k[j] * alphaFirst * alphaCurrent - zAlpha * zAlpha;
+			}
+		}
+		degradation[firstIndex] = std::numeric_limits<double>::infinity();
+
+		MergeCandidate merge;
+		merge.secondIndex = std::min_element(degradation, degradation + maxIndex) - degradation;
+		merge.h = h[merge.secondIndex];
+		merge.alphaMergedFirst = alphaMergedFirst[merge.secondIndex];
+		merge.alphaMergedSecond = alphaMergedCurrent[merge.secondIndex];
+		return merge;
+	}
+
+
+	/// Updates the cached squared norm of a budget vector after it was changed.
+	void updateSquaredNorm(ModelType const& model, size_t index)
+	{
+		if(m_squaredNorms.size() != model.basis().numberOfElements())
+			init(model);
+		else
+			m_squaredNorms(index) = norm_sqr(model.basis().element(index));
+	}
+
+	RealVector m_squaredNorms; ///< cached squared norms of the budget vectors
+
+	// workspace of findGaussianMerge, kept to prevent allocations in the training loop
+	RealVector m_logKernelRow;
+	RealVector m_kernelRow;
+	RealVector m_a;
+	RealVector m_b;
+	RealVector m_lower;
+	RealVector m_upper;
+	RealVector m_innerLower;
+	RealVector m_innerUpper;
+	RealVector m_valueLower;
+	RealVector m_valueUpper;
+	RealVector m_alphaMergedFirst;
+	RealVector m_alphaMergedCurrent;
+	RealVector m_degradation;
 };
 
 }
@@ -280,7 +280,112 @@ public:
 		return m_db_dParams;
 	}
 
+	/// \brief Solution of the binary C-SVM for one point of a regularization path.
+	struct PathPoint{
+		double C;                        ///< regularization parameter of the solution
+		RealVector kernelParameters;     ///< parameter vector of the kernel of the solution
+		RealVector alpha;                ///< coefficients of the kernel expansion
+		double offset;                   ///< offset of the decision function, zero if no offset is trained
+		QpSolutionProperties properties; ///< solver statistics, seconds is the time spent for this point
+	};
+
+	/// \brief Train the binary C-SVM for an increasing sequence of values of C.
+	///
+	/// Each solution is the starting point for the next value of C. The solution stays
+	/// feasible when C grows and the gradient does not depend on C, so the solver continues
+	/// where it stopped. All points share one kernel cache.
+	/// The kernel and the regularization parameter of the trainer are not changed.
+	std::vector<PathPoint> trainPath(LabeledData<InputType, unsigned int> const& dataset, std::vector<double> const& C){
+		return trainPath(dataset, C, std::vector<RealVector>(1, base_type::m_kernel->parameterVector()));
+	}
+
+	/// \brief Train the binary C-SVM on a grid of kernel parameters and an increasing sequence of values of C.
+	///
+	/// The path over C is computed for each kernel parameter vector in turn. The first point of
+	/// a path starts from the first point of the previous path, which only requires to recompute the gradient.
+	/// The points are ordered by kernel parameters first.
+	std::vector<PathPoint> trainPath(
+		LabeledData<InputType, unsigned int> const& dataset,
+		std::vector<double> const& C,
+		std::vector<RealVector> const& kernelParameters
+	){
+		SHARK_RUNTIME_CHECK(numberOfClasses(dataset) == 2, "The regularization path is only implemented for binary problems");
+		SHARK_RUNTIME_CHECK(base_type::m_regularizers.size() == 1, "The regularization path is only implemented for SVMs with one C");
+		SHARK_RUNTIME_CHECK(!C.empty() && C[0] > 0, "The values of C must be positive");
+		for(std::size_t k = 1; k < C.size(); ++k)
+			SHARK_RUNTIME_CHECK(C[k] >= C[k-1], "The values of C must be sorted in increasing order");
+
+		typedef KernelMatrix<InputType, QpFloatType> KernelMatrixType;
+		double oldC = this->C();
+		RealVector oldParameters = base_type::m_kernel->parameterVector();
+		std::vector<PathPoint> path;
+		RealVector alpha(dataset.numberOfElements(), 0.0);
+		std::size_t accessCount = 0;
+		for(RealVector const& parameters: kernelParameters){
+			base_type::m_kernel->setParameterVector(parameters);
+			KernelMatrixType km(*base_type::m_kernel, dataset.inputs());
+			if (base_type::precomputeKernel()){
+				PrecomputedMatrix<KernelMatrixType> matrix(&km);
+				computePath(matrix, dataset, C, alpha, path);
+			}else{
+				CachedMatrix<KernelMatrixType> matrix(&km, base_type::m_cacheSize);
+				computePath(matrix, dataset, C, alpha, path);
+			}
+			accessCount += km.getAccessCount();
+		}
+		base_type::m_kernel->setParameterVector(oldParameters);
+		this->setC(oldC);
+		base_type::m_accessCount = accessCount;
+		return path;
+	}
+
 private:
+	//computes the path over C for one kernel matrix. alpha is the starting point and is
+	//replaced by the solution for the first C.
+	template<class Matrix>
+	void computePath(
+		Matrix& matrix, LabeledData<InputType, unsigned int> const& dataset,
+		std::vector<double> const& C, RealVector& alpha, std::vector<PathPoint>& path
+	){
+		CSVMProblem<Matrix> svmProblem(matrix, dataset.labels(), C[0]);
+		if (this->m_trainOffset){
+			SvmShrinkingProblem<CSVMProblem<Matrix> > problem(svmProblem, base_type::m_shrinking);
+			solvePath(problem, dataset, C, alpha, path);
+		}else{
+			BoxConstrainedShrinkingProblem<CSVMProblem<Matrix> > problem(svmProblem, base_type::m_shrinking);
+			solvePath(problem, dataset, C, alpha, path);
+		}
+	}
+
+	template<class Problem>
+	void solvePath(
+		Problem& problem, LabeledData<InputType, unsigned int> const& dataset,
+		std::vector<double> const& C, RealVector& alpha, std::vector<PathPoint>& path
+	){
+		problem.setInitialSolution(alpha);
+		for(std::size_t k = 0; k != C.size(); ++k){
+			double start_time = Timer::now();
+			if(k != 0){
+				// keep alpha, thus the gradient stays valid. As the box grows,
+				// the shrunk variables might not be at the bounds anymore.
+				problem.unshrink();
+				problem.scaleBoxConstraints(C[k] / C[k-1], 1.0);
+			}
+			this->setC(C[k]);
+			PathPoint point;
+			point.C = C[k];
+			point.kernelParameters = base_type::m_kernel->parameterVector();
+			QpSolver<Problem> solver(problem);
+			solver.solve(base_type::stoppingCondition(), &point.properties);
+			point.alpha = problem.getUnpermutedAlpha();
+			point.offset = this->m_trainOffset ? computeBias(problem, dataset) : 0.0;
+			point.properties.seconds = Timer::now() - start_time;
+			if(k == 0)
+				alpha = point.alpha;
+			path.push_back(point);
+		}
+	}
+
 	
 	void solveMcSimplex(
 		bool sumToZero, QpSparseArray<QpFloatType> const& nu,QpSparseArray<QpFloatType> const& M, RealMatrix const& linear,
@@ -0,0 +1,327 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Gradient boosting of regression trees
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_TRAINERS_GRADIENTBOOSTINGTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_GRADIENTBOOSTINGTRAINER_H
+
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Algorithms/Trainers/Impl/GradientBoosting.h>
+#include <shark/Algorithms/StoppingCriteria/AbstractStoppingCriterion.h>
+#include <shark/Core/ResultSets.h>
+#include <shark/Core/Random.h>
+#include <shark/Models/Classifier.h>
+#include <shark/Models/Trees/GradientBoostedTrees.h>
+#include <shark/ObjectiveFunctions/Loss/AbstractLoss.h>
+
+#include <vector>
+#include <limits>
+
+namespace shark {
+
+///
+/// \brief Gradient boosting of regression trees.
+///
+/// \par
+/// Gradient boosting builds an additive model \f$ f(x) = c + \sum_t T_t(x) \f$ by fitting one
+/// regression tree per round to the gradients of the loss at the current predictions, as
+/// described in<br/>
+/// Greedy Function Approximation: A Gradient Boosting Machine. Jerome H. Friedman. Annals of Statistics 29(5), 2001.<br/>
+/// The trees are grown on a second order approximation of the loss using the gradients and the
+/// diagonal of the Hessian w.r.t. the predictions, as in<br/>
+/// XGBoost: A Scalable Tree Boosting System. Tianqi Chen, Carlos Guestrin. KDD 2016.<br/>
+/// All outputs share the splits of a tree, which has vector valued leaves. If the loss has a second
+/// derivative (hasSecondDerivative()), its exact Hessian diagonal is used. Otherwise the diagonal is computed
+/// by finite differences of the gradient, thus every AbstractLoss with a first derivative can be used.
+/// The offset c is the constant minimizing the loss.
+///
+/// \par
+/// The inputs are discretized into at most 256 bins per feature once before training, and the splits are
+/// searched on histograms of the bins, see GBT::TreeBuilder. Histograms and splits are computed in parallel.
+/// Every round can be restricted to a random subset of the points and features, and the leaf values are
+/// shrunk by the learning rate.
+///
+/// \par
+/// Training runs for the given number of rounds. It stops earlier if the stopping criterion on the training
+/// loss is met, or if the stopping criterion on the validation loss is met. In the latter case the model is
+/// truncated to the round with the smallest validation loss.
+///
+/// \par
+/// For classification with CrossEntropy, the model needs one output for two classes and one output per
+/// class otherwise; wrap it in a Classifier to obtain class labels.
+///
+template<class LabelType>
+class GradientBoostingTrainer : public AbstractTrainer<GradientBoostedTrees, LabelType>
+{
+private:
+	typedef AbstractTrainer<GradientBoostedTrees, LabelType> base_type;
+public:
+	typedef typename base_type::DatasetType DatasetType;
+	typedef AbstractLoss<LabelType, RealVector> LossType;
+	typedef AbstractStoppingCriterion<SingleObjectiveResultSet<RealVector> > StoppingCriterionType;
+	typedef AbstractStoppingCriterion<ValidatedSingleObjectiveResultSet<RealVector> > ValidatedStoppingCriterionType;
+
+	GradientBoostingTrainer(LossType* loss)
+	: mep_loss(loss)
+	, mep_stoppingCriterion(nullptr)
+	, mep_validationStoppingCriterion(nullptr)
+	, m_numberOfRounds(100)
+	, m_learningRate(0.1)
+	, m_maxDepth(6)
+	, m_maxBins(256)
+	, m_minSamplesLeaf(1)
+	, m_minChildWeight(1.e-3)
+	, m_lambda(1.0)
+	, m_subsample(1.0)
+	, m_featureFraction(1.0){
+		SHARK_RUNTIME_CHECK(loss != nullptr, "Loss function must not be NULL");
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "GradientBoostingTrainer"; }
+
+	/// Set the maximum number of trees. (default 100)
+	void setNumberOfRounds(std::size_t rounds){ m_numberOfRounds = rounds; }
+
+	/// Set the shrinkage applied to the leaf values. (default 0.1)
+	void setLearningRate(double rate){ m_learningRate = rate; }
+
+	/// Set the maximum depth of the trees. (default 6)
+	void setMaxDepth(std::size_t depth){ m_maxDepth = depth; }
+
+	/// Set the maximum number of bins per feature, at most 256. (default 256)
+	void setMaxBins(std::size_t bins){ m_maxBins = bins; }
+
+	/// Set the minimum number of points in a leaf. (default 1)
+	void setMinSamplesLeaf(std::size_t samples){ m_minSamplesLeaf = samples; }
+
+	/// Set the minimum sum of the Hessian diagonal in a leaf. (default 1.e-3)
+	void setMinChildWeight(double weight){ m_minChildWeight = weight; }
+
+	/// Set the L2 regularization of the leaf values. (default 1)
+	void setRegularization(double lambda){ m_lambda = lambda; }
+
+	/// Set the fraction of points used to grow each tree. (default 1)
+	void setSubsample(double fraction){ m_subsample = fraction; }
+
+	/// Set the fraction of features used to grow each tree. (default 1)
+	void setFeatureFraction(double fraction){ m_featureFraction = fraction; }
+
+	/// \brief Stops training when the criterion on the training loss is met.
+	void setStoppingCriterion(StoppingCriterionType* stoppingCriterion){
+		mep_stoppingCriterion = stoppingCriterion;
+	}
+
+	/// \brief Stops training when the criterion on the loss on the validation set is met.
+	///
+	/// The trained model keeps the trees up to the round with the smallest validation loss.
+	void setValidationStoppingCriterion(DatasetType const& validationSet, ValidatedStoppingCriterionType* stoppingCriterion){
+		m_validationSet = validationSet;
+		mep_validationStoppingCriterion = stoppingCriterion;
+	}
+
+	/// \brief Trains the scores of a classifier.
+	void train(Classifier<GradientBoostedTrees>& model, DatasetType const& dataset){
+		train(model.decisionFunction(), dataset);
+	}
+
+	void train(GradientBoostedTrees& model, DatasetType const& dataset){
+		std::size_t n = dataset.numberOfElements();
+		std::size_t dim = inputDimension(dataset);
+		std::size_t outputs = outputDimension(dataset);
+
+		//copy data into single batch for easier lookup
+		blas::matrix<double, blas::column_major> inputs = createBatch<RealVector>(dataset.inputs().elements().begin(),dataset.inputs().elements().end());
+		auto labels = createBatch<LabelType>(dataset.labels().elements().begin(),dataset.labels().elements().end());
+		GBT::BinnedData data(inputs, m_maxBins);
+
+		GBT::TreeBuilder builder;
+		builder.m_max_depth = m_maxDepth;
+		builder.m_min_samples_leaf = m_minSamplesLeaf;
+		builder.m_min_child_weight = m_minChildWeight;
+		builder.m_lambda = m_lambda;
+		builder.m_learning_rate = m_learningRate;
+
+		RealMatrix predictions(n, outputs);
+		RealMatrix gradients(n, outputs);
+		RealMatrix hessians(n, outputs);
+		model = GradientBoostedTrees(dim, initialOffset(labels, predictions, gradients, hessians));
+
+		RealMatrix validationInputs;
+		RealMatrix validationPredictions;
+		typename Batch<LabelType>::type validationLabels;
+		if(mep_validationStoppingCriterion){
+			validationInputs = createBatch<RealVector>(m_validationSet.inputs().elements().begin(),m_validationSet.inputs().elements().end());
+			validationLabels = createBatch<LabelType>(m_validationSet.labels().elements().begin(),m_validationSet.labels().elements().end());
+			validationPredictions = model(validationInputs);
+			mep_validationStoppingCriterion->reset();
+		}
+		if(mep_stoppingCriterion)
+			mep_stoppingCriterion->reset();
+
+		std::size_t sampleSize = std::max<std::size_t>(1, std::size_t(m_subsample * n + 0.5));
+		std::size_t numFeatures = std::max<std::size_t>(1, std::size_t(m_featureFraction * dim + 0.5));
+		std::vector<unsigned int> points(n);
+		std::iota(points.begin(), points.end(), 0);
+		std::vector<unsigned int> features(dim);
+		std::iota(features.begin(), features.end(), 0);
+		std::vector<unsigned int> splitBins;
+		double bestValidationLoss = std::numeric_limits<double>::max();
+		std::size_t bestRounds = 0;
+		for(std::size_t t = 0; t != m_numberOfRounds; ++t){
+			computeDerivatives(labels, predictions, gradients, hessians);
+
+			//choose the points and features of this round
+			std::vector<unsigned int> rows;
+			if(sampleSize < n){
+				random::rng_type& rng = random::globalRng;
+				for(std::size_t i = 0; i != sampleSize; ++i)
+					std::swap(points[i], points[random::discrete(rng, i, n - 1)]);
+				rows.assign(points.begin(), points.begin() + sampleSize);
+				std::sort(rows.begin(), rows.end());
+			}else{
+				rows = points;
+			}
+			std::vector<char> useFeature(dim, numFeatures == dim);
+			if(numFeatures < dim){
+				std::shuffle(features.begin(), features.end(), random::globalRng);
+				for(std::size_t j = 0; j != numFeatures; ++j)
+					useFeature[features[j]] = true;
+			}
+
+			CARTree<RealVector> tree = builder.buildTree(data, gradients, hessians, rows, useFeature, splitBins);
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)n; ++i){
+				std::size_t leaf = GBT::TreeBuilder::findLeaf(tree, splitBins, data, i);
+				noalias(row(predictions, i)) += tree.getLabel(leaf);
+			}
+			model.addTree(tree);
+
+			SingleObjectiveResultSet<RealVector> result(mep_loss->eval(labels, predictions) / n, RealVector());
+			bool stop = mep_stoppingCriterion && mep_stoppingCriterion->stop(result);
+			if(mep_validationStoppingCriterion){
+				noalias(validationPredictions) += tree(validationInputs);
+				double validationLoss = mep_loss->eval(validationLabels, validationPredictions) / validationInputs.size1();
+				if(validationLoss < bestValidationLoss){
+					bestValidationLoss = validationLoss;
+					bestRounds = t + 1;
+				}
+				ValidatedSingleObjectiveResultSet<RealVector> validatedResult(result, validationLoss);
+				stop |= mep_validationStoppingCriterion->stop(validatedResult);
+			}
+			if(stop)
+				break;
+		}
+		if(mep_validationStoppingCriterion)
+			model.truncate(bestRounds);
+	}
+
+private:
+	std::size_t outputDimension(LabeledData<RealVector, RealVector> const& dataset)const{
+		return labelDimension(dataset);
+	}
+	std::size_t outputDimension(LabeledData<RealVector, unsigned int> const& dataset)const{
+		std::size_t classes = numberOfClasses(dataset);
+		return classes == 2? 1: classes;
+	}
+
+	/// gradient of the loss and diagonal of its Hessian w.r.t. the predictions
+	///
+	/// Losses with second derivative provide the exact diagonal. Otherwise it is estimated by forward
+	/// differences of the gradient with a step relative to the magnitude of the prediction.
+	void computeDerivatives(
+		typename Batch<LabelType>::type const& labels, RealMatrix const& predictions,
+		RealMatrix& gradients, RealMatrix& hessians
+	)const{
+		if(mep_loss->hasSecondDerivative()){
+			mep_loss->evalDerivative(labels, predictions, gradients, hessians);
+			return;
+		}
+		mep_loss->evalDerivative(labels, predictions, gradients);
+		RealMatrix shifted = predictions;
+		RealMatrix shiftedGradients;
+		for(std::size_t k = 0; k != predictions.size2(); ++k){
+			RealVector epsilon = 1.e-5 * (1 + abs(column(predictions, k)));
+			noalias(column(shifted, k)) += epsilon;
+			mep_loss->evalDerivative(labels, shifted, shiftedGradients);
+			noalias(column(shifted, k)) = column(predictions, k);
+			for(std::size_t i = 0; i != predictions.size1(); ++i)
+				hessians(i, k) = std::max(0.0, (shiftedGradients(i, k) - gradients(i, k)) / epsilon(i));
+		}
+	}
+
+	/// Newton steps on a constant prediction for all points, predictions is set to the result
+	RealVector initialOffset(
+		typename Batch<LabelType>::type const& labels, RealMatrix& predictions,
+		RealMatrix& gradients, RealMatrix& hessians
+	)const{
+		std::size_t n = predictions.size1();
+		RealVector offset(predictions.size2(), 0.0);
+		predictions.clear();
+		for(std::size_t iter = 0; iter != 20; ++iter){
+			computeDerivatives(labels, predictions, gradients, hessians);
+			RealVector gradient = sum_rows(gradients) / n;
+			RealVector hessian = sum_rows(hessians) / n;
+			double change = 0;
+			for(std::size_t k = 0; k != offset.size(); ++k){
+				if(hessian(k) <= 1.e-12) continue;
+				double step = gradient(k) / hessian(k);
+				offset(k) -= step;
+				change = std::max(change, std::abs(step));
+			}
+			for(std::size_t i = 0; i != n; ++i)
+				noalias(row(predictions, i)) = offset;
+			if(change < 1.e-8)
+				break;
+		}
+		return offset;
+	}
+
+	LossType* mep_loss;
+	StoppingCriterionType* mep_stoppingCriterion;
+	ValidatedStoppingCriterionType* mep_validationStoppingCriterion;
+	DatasetType m_validationSet;
+
+	std::size_t m_numberOfRounds; ///< maximum number of trees
+	double m_learningRate; ///< shrinkage of the leaf values
+	std::size_t m_maxDepth; ///< maximum depth of the trees
+	std::size_t m_maxBins; ///< maximum number of bins per feature
+	std::size_t m_minSamplesLeaf; ///< minimum number of points in a leaf
+	double m_minChildWeight; ///< minimum sum of the Hessian diagonal in a leaf
+	double m_lambda; ///< L2 regularization of the leaf values
+	double m_subsample; ///< fraction of points used per tree
+	double m_featureFraction; ///< fraction of features used per tree
+};
+
+}
+#endif
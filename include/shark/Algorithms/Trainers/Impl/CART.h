@@ -37,6 +37,8 @@
 #define SHARK_ALGORITHMS_TRAINERS_IMPL_CART_H
 
 #include <shark/Core/Random.h>
+#include <shark/Core/Profiler.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/utility/KeyValuePair.h>
 #include <shark/LinAlg/Base.h>
 #include <shark/Statistics/Distributions/MultiNomialDistribution.h>
@@ -52,6 +54,21 @@ struct Bootstrap{
 	std::size_t labelDim; ///< dimensionality of a vector to hold the labels in expanded form 
 	std::vector<unsigned int> weights; /// number of times the ith point got picked.
 	
+	/// \brief Per feature the sampled points of every node ordered by their value of the feature.
+	///
+	/// Empty unless presort() was called. The points of a node occupying the range [start,end)
+	/// are stored in sorted[f][start],...,sorted[f][end-1] for every feature f. In this case
+	/// indices, weights and labels keep their order and are indexed by the stored ids.
+	std::vector<std::vector<unsigned int> > sorted;
+	
+	/// \brief Range [start,end) of a node which is split at threshold of the feature.
+	struct SplitRange{
+		std::size_t start;
+		std::size_t end;
+		double threshold;
+		unsigned int feature;
+	};
+	
 	///\brief Creates a random bootstrap from the provided dataset.
 	Bootstrap(random::rng_type& rng, DataSet const& data, LabelSet const& labels, RealVector const& sample_weights):data(data){
 		// sample bootstrap indices (with replacement)
@@ -74,6 +91,32 @@ struct Bootstrap{
 		setLabels(labels);
 	}
 	
+	/// \brief Sorts the sampled points by every feature.
+	///
+	/// The order is kept through all later partitions, thus the values of a node
+	/// do not need to be sorted again when searching for a split.
+	void presort(){
+		std::size_t n = indices.size();
+		std::size_t dim = data.size2();
+		sorted.assign(dim, std::vector<unsigned int>(n));
+		m_goesLeft.resize(n);
+		SHARK_PARALLEL_FOR(int f = 0; f < (int)dim; ++f){
+			std::vector<unsigned int>& order = sorted[f];
+			std::iota(order.begin(), order.end(), 0);
+			auto column = blas::column(data, f);
+			std::sort(order.begin(), order.end(), [&](unsigned int i, unsigned int j){
+				double xi = column(indices[i]);
+				double xj = column(indices[j]);
+				return xi < xj || (xi == xj && i < j);
+			});
+		}
+	}
+	
+	/// \brief Returns the id under which the point at position pos is stored in indices, weights and labels.
+	std::size_t element(std::size_t pos)const{
+		return sorted.empty()? pos : sorted[0][pos];
+	}
+	
 	// Partition the bootstrap (indices,weights,labels) in the range start,end
 	// so that all points with the value of the feature smaller than the theshold
 	// are on the left side and all values larger are on the right side
@@ -81,6 +124,10 @@ struct Bootstrap{
 		std::size_t start, std::size_t end,
 		double threshold, unsigned feature
 	) {
+		if(!sorted.empty()){
+			partition(std::vector<SplitRange>(1, SplitRange{start, end, threshold, feature}));
+			return;
+		}
 		std::size_t pos = start;
 		while (pos < end) {
 			double xf = data(indices[pos], feature);
@@ -95,7 +142,48 @@ struct Bootstrap{
 			}
 		}
 	}
+	
+	/// \brief Partitions several disjoint ranges at once.
+	///
+	/// When presorted, every feature order is partitioned stably, such that the points of
+	/// both children stay sorted. The features are processed in parallel.
+	void partition(std::vector<SplitRange> const& splits){
+		if(sorted.empty()){
+			SHARK_PARALLEL_FOR(int s = 0; s < (int)splits.size(); ++s){
+				partition(splits[s].start, splits[s].end, splits[s].threshold, splits[s].feature);
+			}
+			return;
+		}
+		//mark the points that go to the left child
+		SHARK_PARALLEL_FOR(int s = 0; s < (int)splits.size(); ++s){
+			SplitRange const& split = splits[s];
+			for(std::size_t pos = split.start; pos != split.end; ++pos){
+				unsigned int id = sorted[split.feature][pos];
+				m_goesLeft[id] = data(indices[id], split.feature) <= split.threshold;
+			}
+		}
+		//stable partition of every feature order using one buffer per thread
+		std::vector<std::vector<unsigned int> > buffers(SHARK_NUM_THREADS);
+		SHARK_PARALLEL_FOR(int f = 0; f < (int)sorted.size(); ++f){
+			std::vector<unsigned int>& buffer = buffers[SHARK_THREAD_NUM];
+			for(auto const& split: splits){
+				buffer.clear();
+				std::size_t left = split.start;
+				for(std::size_t pos = split.start; pos != split.end; ++pos){
+					unsigned int id = sorted[f][pos];
+					if(m_goesLeft[id]){
+						sorted[f][left] = id;
+						++left;
+					}else{
+						buffer.push_back(id);
+					}
+				}
+				std::copy(buffer.begin(), buffer.end(), sorted[f].begin() + left);
+			}
+		}
+	}
 private:
+	std::vector<char> m_goesLeft; ///< workspace of partition: whether a point goes to the left child
 	void setLabels(RealMatrix const& labels){
 		labelDim = labels.size2();
 		this->labels.resize(indices.size(), labelDim);
@@ -379,6 +467,12 @@ private:
 		double priority;
 		CriterionRecord criterion;
 
+		TraversalRecord(
+			std::size_t nodeId, std::size_t start, std::size_t end, unsigned depth,
+			std::vector<bool> const& constFeatures, double priority
+		):nodeId(nodeId), start(start), end(end), depth(depth)
+		, constFeatures(constFeatures), priority(priority), criterion(){}
+
 		bool operator<(TraversalRecord const& other)const{
 			return priority < other.priority;
 		}
@@ -397,6 +491,12 @@ private:
 			return improvement < other.improvement;
 		}
 	};
+	
+	/// buffers reused by the split search of all nodes processed by one thread
+	struct Workspace{
+		std::vector<unsigned> features;
+		std::vector<KeyValuePair<double,unsigned int> > XF;
+	};
 public:
 	std::size_t m_max_features;///< number of attributes to randomly test at each inner node
 	std::size_t m_min_samples_leaf; ///< minimum number of samples in a leaf node
@@ -404,11 +504,18 @@ public:
 	std::size_t m_max_depth;///< maximum depth of the tree
 	double m_epsilon;///< Minimum difference between two values to be considered different
 	double m_min_impurity_split;///< stops splitting when the impority is below a threshold
+	bool m_presort = false;///< presort the features and grow all nodes of a level in parallel
 	
+	/// \brief Grows a tree on the bootstrap sample.
+	///
+	/// If m_presort is set, the tree is grown level by level by buildTreePresorted.
 	CARTree<LabelType> buildTree(
 		random::rng_type& rng,
 		Bootstrap& bootstrap
 	){
+		if(m_presort)
+			return buildTreePresorted(rng, bootstrap);
+		SHARK_PROFILE_REGION("CART::buildTree");
 		//create root of the tree
 		CARTree<LabelType> tree(bootstrap.data.size2());
 		tree.createRoot();
@@ -421,6 +528,7 @@ public:
 				tree.transformLeafNode(record.nodeId, Criterion::leafLabel(record.criterion));
 			}
 		};
+		Workspace workspace;
 		
 		//push root entry into the priority queue
 		std::priority_queue<TraversalRecord> queue;
@@ -436,12 +544,13 @@ public:
 			// find the best split
 			// if there is no valid split, this is a leaf node, which we create
 			SplitRecord split;
-			if(!findSplit(rng, record, split, bootstrap)){
+			if(!findSplit(rng, record, split, bootstrap, workspace)){
 				makeLeaf(record);
 				continue;
 			}
 			//create split node
 			auto const& node = tree.transformInternalNode(record.nodeId, split.feature, split.threshold);
+			SHARK_PROFILE_COUNTER("internal nodes", 1);
 			
 			//swap
 			std::size_t start = record.start;
@@ -463,18 +572,142 @@ public:
 		}
 		return tree;
 	}
+	
+	/// \brief Grows a tree on the presorted bootstrap sample, one level at a time.
+	///
+	/// The sampled points are sorted once by every feature and kept in order through
+	/// all partitions, thus the split search only scans the values of a node.
+	/// All nodes of the current level are split together: the first m_max_features
+	/// candidate features of all nodes are searched in parallel using one workspace
+	/// per thread, afterwards all feature orders are partitioned in parallel.
+	/// The candidate features of every node are drawn from rng in a fixed order,
+	/// thus the result does not depend on the number of threads.
+	CARTree<LabelType> buildTreePresorted(
+		random::rng_type& rng,
+		Bootstrap& bootstrap
+	){
+		SHARK_PROFILE_REGION("CART::buildTreePresorted");
+		std::size_t dim = bootstrap.data.size2();
+		CARTree<LabelType> tree(dim);
+		tree.createRoot();
+		bootstrap.presort();
+		
+		auto makeLeaf=[&](TraversalRecord const& record){
+			if(record.end - record.start == 1){
+				tree.transformLeafNode(record.nodeId, getBatchElement(bootstrap.labels,bootstrap.element(record.start)));
+			}else{
+				tree.transformLeafNode(record.nodeId, Criterion::leafLabel(record.criterion));
+			}
+		};
+		
+		std::vector<TraversalRecord> level;
+		TraversalRecord root = {0, 0,bootstrap.indices.size(), 0, std::vector<bool>(dim,false),0};
+		root.criterion = Criterion::initCriterion(bootstrap.labels, bootstrap.weights, bootstrap.labelDim);
+		if(isLeaf(root))
+			makeLeaf(root);
+		else
+			level.push_back(std::move(root));
+		
+		std::vector<Workspace> workspaces(SHARK_NUM_THREADS);
+		std::size_t candidates = std::max<std::size_t>(1, std::min(m_max_features, dim));
+		while(!level.empty()){
+			//draw the order in which the features of every node are checked
+			std::vector<std::vector<unsigned> > features(level.size(), std::vector<unsigned>(dim));
+			for(auto& order: features){
+				std::iota(order.begin(),order.end(),0);
+				std::shuffle(order.begin(), order.end(),rng);
+			}
+			
+			//search the first candidate features of all nodes in parallel
+			std::vector<SplitRecord> candidateSplits(level.size() * candidates);
+			std::vector<char> constant(level.size() * candidates, false);
+			SHARK_PARALLEL_FOR(int task = 0; task < (int)candidateSplits.size(); ++task){
+				TraversalRecord const& record = level[task / candidates];
+				unsigned feature = features[task / candidates][task % candidates];
+				SplitRecord& split = candidateSplits[task];
+				split.improvement = 0.0;
+				split.feature = feature;
+				if(!record.constFeatures[feature])
+					constant[task] = !evaluateFeature(record, feature, split, bootstrap, workspaces[SHARK_THREAD_NUM]);
+			}
+			
+			//pick the best split of every node, if none was found keep on searching the remaining features
+			std::vector<SplitRecord> splits(level.size());
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)level.size(); ++i){
+				TraversalRecord& record = level[i];
+				SplitRecord& split = splits[i];
+				split.improvement = 0.0;
+				for(std::size_t j = 0; j != candidates; ++j){
+					std::size_t task = i * candidates + j;
+					if(constant[task])
+						record.constFeatures[candidateSplits[task].feature] = true;
+					split = std::max(split, candidateSplits[task]);
+				}
+				for(std::size_t j = candidates; j < dim && split.improvement <= 0.0; ++j){
+					unsigned feature = features[i][j];
+					if(record.constFeatures[feature])
+						continue;
+					SplitRecord newSplit;
+					newSplit.improvement = 0.0;
+					newSplit.feature = feature;
+					if(!evaluateFeature(record, feature, newSplit, bootstrap, workspaces[SHARK_THREAD_NUM]))
+						record.constFeatures[feature] = true;
+					split = std::max(split, newSplit);
+				}
+			}
+			
+			//create the nodes of the next level
+			std::vector<TraversalRecord> nextLevel;
+			std::vector<TraversalRecord> leaves;
+			std::vector<typename Bootstrap::SplitRange> ranges;
+			for(std::size_t i = 0; i != level.size(); ++i){
+				TraversalRecord& record = level[i];
+				SplitRecord& split = splits[i];
+				if(split.improvement <= 0.0){
+					makeLeaf(record);
+					continue;
+				}
+				auto const& node = tree.transformInternalNode(record.nodeId, split.feature, split.threshold);
+				SHARK_PROFILE_COUNTER("internal nodes", 1);
+				std::size_t pos = record.start + split.pos;
+				ranges.push_back({record.start, record.end, split.threshold, split.feature});
+				
+				unsigned leafDepth = record.depth + 1;
+				TraversalRecord left = {node.leftId, record.start, pos, leafDepth, record.constFeatures, double(leafDepth)};
+				TraversalRecord right = {node.rightIdOrIndex, pos, record.end, leafDepth, record.constFeatures, double(leafDepth)};
+				Criterion::split(std::move(split.criterion),left.criterion,right.criterion);
+				for(TraversalRecord* child: {&left, &right}){
+					if(isLeaf(*child))
+						leaves.push_back(std::move(*child));
+					else
+						nextLevel.push_back(std::move(*child));
+				}
+			}
+			bootstrap.partition(ranges);
+			//the new leaves can only be created after their points are moved into place
+			for(auto const& record: leaves)
+				makeLeaf(record);
+			level = std::move(nextLevel);
+		}
+		return tree;
+	}
 private:
 
-	bool enqueueRecord(std::priority_queue<TraversalRecord>& queue, TraversalRecord const& record){
+	bool isLeaf(TraversalRecord const& record)const{
 		bool isLeaf = false;
 		std::size_t numSamples = record.end - record.start;
 		isLeaf |= record.depth == m_max_depth;
 		isLeaf |= numSamples < 2 * m_min_samples_leaf;
 		isLeaf |= numSamples < m_min_split;
 		isLeaf |= record.criterion.impurity <= m_min_impurity_split;
-		if(!isLeaf)
-			queue.push(record);
-		return !isLeaf;
+		return isLeaf;
+	}
+
+	bool enqueueRecord(std::priority_queue<TraversalRecord>& queue, TraversalRecord const& record){
+		if(isLeaf(record))
+			return false;
+		queue.push(record);
+		return true;
 	}
 	
 	// Compute the best split based on the impurity measure
@@ -484,19 +717,15 @@ private:
 		random::rng_type& rng,
 		TraversalRecord& record,
 		SplitRecord& split,
-		Bootstrap const& bootstrap
+		Bootstrap const& bootstrap,
+		Workspace& workspace
 	){
-		std::vector<unsigned> randomFeatures(bootstrap.data.size2());
+		std::vector<unsigned>& randomFeatures = workspace.features;
+		randomFeatures.resize(bootstrap.data.size2());
 		std::iota(randomFeatures.begin(),randomFeatures.end(),0);
 		std::shuffle(randomFeatures.begin(), randomFeatures.end(),rng);
 		
-		std::size_t start = record.start;
-		std::size_t end = record.end;
-		
-		//vector for storing split feature values. This gives faster memory access later
-		std::vector<KeyValuePair<double,unsigned int> > XF(end - start);
 		split.improvement = 0.0;
-		CriterionRecord bestCriterion;
 		for (std::size_t j = 0; j < randomFeatures.size(); j++) {
 			// Break as soon as at least max_features and a non-trivial split can be found
 			if (j >= m_max_features && split.improvement > 0.0) {
@@ -507,26 +736,11 @@ private:
 			if(record.constFeatures[feature]){
 				continue;
 			}
-			// Copy data in XF for faster lookup and
-			// compute minimum and maximum to check if it is constant
-			double minf = std::numeric_limits<double>::max();
-			double maxf = -std::numeric_limits<double>::max();
-			for (std::size_t i = start; i < end; i++) {
-				double f = bootstrap.data(bootstrap.indices[i],feature);
-				XF[i - start].key = f;
-				XF[i - start].value =  i;
-				minf = std::min(minf, f);
-				maxf = std::max(maxf, f);
-			}
-			//compute split
 			SplitRecord newSplit;
-			if (maxf <= minf + m_epsilon){//no reason to check with a constant split
-				newSplit.improvement = 0.0;
-				record.constFeatures[feature]  = true;
-			}else{
-				newSplit = computeOptimalThreshold(XF, bootstrap, record.criterion);
-			}
+			newSplit.improvement = 0.0;
 			newSplit.feature = feature;
+			if(!evaluateFeature(record, feature, newSplit, bootstrap, workspace))
+				record.constFeatures[feature]  = true;
 			split=std::max(split,newSplit);
 		}
 		
@@ -534,14 +748,52 @@ private:
 		return (split.improvement > 0.0);
 	}
 	
+	// Computes the best split of the node using the feature. Returns false if the feature is constant on the node.
+	bool evaluateFeature(
+		TraversalRecord const& record,
+		unsigned feature,
+		SplitRecord& split,
+		Bootstrap const& bootstrap,
+		Workspace& workspace
+	)const{
+		std::size_t start = record.start;
+		std::size_t end = record.end;
+		
+		//vector for storing split feature values. This gives faster memory access later
+		std::vector<KeyValuePair<double,unsigned int> >& XF = workspace.XF;
+		XF.resize(end - start);
+		// Copy data in XF for faster lookup and
+		// compute minimum and maximum to check if it is constant
+		double minf = std::numeric_limits<double>::max();
+		double maxf = -std::numeric_limits<double>::max();
+		bool presorted = !bootstrap.sorted.empty();
+		for (std::size_t i = start; i < end; i++) {
+			std::size_t id = presorted? bootstrap.sorted[feature][i]: i;
+			double f = bootstrap.data(bootstrap.indices[id],feature);
+			XF[i - start].key = f;
+			XF[i - start].value =  id;
+			minf = std::min(minf, f);
+			maxf = std::max(maxf, f);
+		}
+		//no reason to check with a constant split
+		if (maxf <= minf + m_epsilon)
+			return false;
+		split = computeOptimalThreshold(XF, bootstrap, record.criterion, presorted);
+		split.feature = feature;
+		SHARK_PROFILE_COUNTER("sorted feature values", XF.size());
+		return true;
+	}
+	
 	SplitRecord computeOptimalThreshold(
 		std::vector<KeyValuePair<double,unsigned int> >& XF,
 		Bootstrap const& bootstrap,
-		CriterionRecord criterion//copied because it is changed
-	){
+		CriterionRecord criterion,//copied because it is changed
+		bool sorted
+	)const{
 		
 		// Important: We are checking a non-constant feature here.
-		std::sort(XF.begin(),XF.end());
+		if(!sorted)
+			std::sort(XF.begin(),XF.end());
 
 		// init split
 		SplitRecord bestSplit;
@@ -0,0 +1,371 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Histogram based tree growing for gradient boosting
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_ALGORITHMS_TRAINERS_IMPL_GRADIENTBOOSTING_H
+#define SHARK_ALGORITHMS_TRAINERS_IMPL_GRADIENTBOOSTING_H
+
+#include <shark/Core/OpenMP.h>
+#include <shark/Core/Profiler.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/Models/Trees/CARTree.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace shark {namespace GBT{
+
+/// \brief Inputs discretized into at most 256 bins per feature.
+///
+/// The bins of a feature are separated by cut points placed between distinct values
+/// at the quantiles of the feature. A value x falls into bin b if cuts[b-1] < x <= cuts[b],
+/// thus splitting between the bins b and b+1 is the same as the split x <= cuts[b].
+struct BinnedData{
+	std::size_t size; ///< number of points
+	std::size_t dim; ///< number of features
+	std::vector<std::vector<double> > cuts; ///< cut points of every feature
+	std::vector<std::size_t> offsets; ///< position of the first bin of every feature in a histogram, the last entry is the total number of bins
+	std::vector<unsigned char> bins; ///< bin of the ith point in feature f, stored at f*size+i
+
+	BinnedData(blas::matrix<double, blas::column_major> const& data, std::size_t maxBins)
+	: size(data.size1()), dim(data.size2()), cuts(data.size2()), offsets(data.size2() + 1, 0), bins(data.size1() * data.size2()){
+		SHARK_RUNTIME_CHECK(maxBins >= 2 && maxBins <= 256, "[GBT::BinnedData] number of bins must be between 2 and 256");
+		SHARK_PARALLEL_FOR(int f = 0; f < (int)dim; ++f){
+			auto values = column(data, f);
+			std::vector<double> sorted(values.begin(), values.end());
+			std::sort(sorted.begin(), sorted.end());
+			std::vector<double>& featureCuts = cuts[f];
+			auto addCut = [&](double lower, double upper){
+				double cut = (lower + upper) / 2;
+				//check for numerical stability of the cut
+				if(cut == upper)
+					cut = lower;
+				if(featureCuts.empty() || cut > featureCuts.back())
+					featureCuts.push_back(cut);
+			};
+			std::size_t distinct = std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+			if(distinct <= maxBins){
+				for(std::size_t i = 1; i < distinct; ++i)
+					addCut(sorted[i - 1], sorted[i]);
+			}else{
+				//place the cuts at the quantiles of the values
+				sorted.assign(values.begin(), values.end());
+				std::sort(sorted.begin(), sorted.end());
+				for(std::size_t b = 1; b != maxBins; ++b){
+					std::size_t pos = std::upper_bound(sorted.begin(), sorted.end(), sorted[b * size / maxBins - 1]) - sorted.begin();
+					if(pos < size)
+						addCut(sorted[pos - 1], sorted[pos]);
+				}
+			}
+			for(std::size_t i = 0; i != size; ++i)
+				bins[f * size + i] = std::lower_bound(featureCuts.begin(), featureCuts.end(), values(i)) - featureCuts.begin();
+		}
+		for(std::size_t f = 0; f != dim; ++f)
+			offsets[f + 1] = offsets[f] + cuts[f].size() + 1;
+	}
+
+	unsigned int bin(std::size_t i, std::size_t f) const{
+		return bins[f * size + i];
+	}
+};
+
+/// \brief Grows regression trees on the gradients and Hessians of a loss using histograms.
+///
+/// \par
+/// For every node and feature the sums of gradients, Hessians and points per bin are collected
+/// into a histogram. The best split maximizes the reduction of the second order approximation of the loss
+/// \f[ \frac 1 2 \sum_k \frac{G_{L,k}^2}{H_{L,k}+\lambda} + \frac{G_{R,k}^2}{H_{R,k}+\lambda} - \frac{G_k^2}{H_k+\lambda} \f]
+/// where G and H are the sums of the gradients and Hessian diagonals of the points in a node and k
+/// runs over the outputs. A leaf predicts \f$ -\eta G_k/(H_k+\lambda) \f$ for the learning rate \f$ \eta \f$.
+///
+/// \par
+/// The tree is grown one level at a time. Histograms are built in parallel over nodes and features,
+/// only for the smaller child of a split. The histogram of the larger child is the difference of
+/// the parent and its sibling. The split search runs in parallel over nodes and features as well.
+class TreeBuilder{
+public:
+	std::size_t m_max_depth; ///< maximum depth of the tree
+	std::size_t m_min_samples_leaf; ///< minimum number of points in a leaf
+	double m_min_child_weight; ///< minimum sum of Hessians in a leaf
+	double m_lambda; ///< L2 regularization of the leaf values
+	double m_learning_rate; ///< shrinkage applied to the leaf values
+
+	/// \brief Grows a tree on the points in rows using only the features marked in useFeature.
+	///
+	/// The rows are reordered such that the points of every node are stored contiguously.
+	/// splitBins returns for every internal node the bin of its split, which allows to route points by their bins.
+	CARTree<RealVector> buildTree(
+		BinnedData const& data,
+		RealMatrix const& gradients, RealMatrix const& hessians,
+		std::vector<unsigned int>& rows,
+		std::vector<char> const& useFeature,
+		std::vector<unsigned int>& splitBins
+	) const{
+		SHARK_PROFILE_REGION("GBT::buildTree");
+		std::size_t outputs = gradients.size2();
+		std::size_t stride = 2 * outputs + 1;
+		CARTree<RealVector> tree(data.dim);
+		tree.createRoot();
+		splitBins.assign(1, 0);
+
+		std::vector<Node> level(1);
+		Node& root = level[0];
+		root.nodeId = 0;
+		root.start = 0;
+		root.end = rows.size();
+		root.depth = 0;
+		root.sums = RealVector(stride, 0.0);
+		root.sums(0) = rows.size();
+		for(auto i: rows){
+			noalias(subrange(root.sums, 1, 1 + outputs)) += row(gradients, i);
+			noalias(subrange(root.sums, 1 + outputs, stride)) += row(hessians, i);
+		}
+		if(!canSplit(root)){
+			makeLeaf(tree, root, outputs);
+			return tree;
+		}
+		root.histogram.resize(data.offsets.back() * stride);
+		buildHistograms(data, gradients, hessians, rows, useFeature, std::vector<Node*>(1, &root));
+
+		//sums left and right of the split candidate, one buffer per thread
+		std::vector<std::vector<double> > workspaces(SHARK_NUM_THREADS, std::vector<double>(2 * stride));
+		while(!level.empty()){
+			//search the best split of every node and feature
+			std::vector<Split> candidates(level.size() * data.dim);
+			SHARK_PARALLEL_FOR(int task = 0; task < (int)candidates.size(); ++task){
+				std::size_t f = task % data.dim;
+				if(useFeature[f])
+					candidates[task] = findSplit(data, level[task / data.dim], f, outputs, workspaces[SHARK_THREAD_NUM].data());
+			}
+
+			std::vector<Node> nextLevel;
+			std::vector<Node*> toBuild;
+			std::vector<std::pair<Node*, Node*> > toSubtract;
+			nextLevel.reserve(2 * level.size());
+			for(std::size_t n = 0; n != level.size(); ++n){
+				Node& node = level[n];
+				Split best;
+				for(std::size_t f = 0; f != data.dim; ++f){
+					if(candidates[n * data.dim + f].gain > best.gain)
+						best = candidates[n * data.dim + f];
+				}
+				if(best.gain <= 0){
+					makeLeaf(tree, node, outputs);
+					continue;
+				}
+				auto const& treeNode = tree.transformInternalNode(node.nodeId, best.feature, data.cuts[best.feature][best.bin]);
+				std::size_t leftId = treeNode.leftId;
+				std::size_t rightId = treeNode.rightIdOrIndex;
+				splitBins.resize(tree.numberOfNodes(), 0);
+				splitBins[node.nodeId] = best.bin;
+				auto mid = std::partition(rows.begin() + node.start, rows.begin() + node.end, [&](unsigned int i){
+					return data.bin(i, best.feature) <= best.bin;
+				});
+
+				Node left, right;
+				left.nodeId = leftId;
+				left.start = node.start;
+				left.end = mid - rows.begin();
+				left.depth = node.depth + 1;
+				left.sums = RealVector(stride, 0.0);
+				double const* histogram = node.histogram.data() + data.offsets[best.feature] * stride;
+				for(std::size_t b = 0; b <= best.bin; ++b){
+					for(std::size_t j = 0; j != stride; ++j)
+						left.sums(j) += histogram[b * stride + j];
+				}
+				right.nodeId = rightId;
+				right.start = left.end;
+				right.end = node.end;
+				right.depth = node.depth + 1;
+				right.sums = node.sums - left.sums;
+
+				bool splitLeft = canSplit(left);
+				bool splitRight = canSplit(right);
+				if(!splitLeft)
+					makeLeaf(tree, left, outputs);
+				if(!splitRight)
+					makeLeaf(tree, right, outputs);
+				if(!splitLeft && !splitRight)
+					continue;
+				//the smaller child gets its own histogram, the larger is computed by subtraction
+				bool leftSmaller = left.end - left.start <= right.end - right.start;
+				Node* small = &left;
+				Node* large = &right;
+				if(!leftSmaller)
+					std::swap(small, large);
+				small->histogram.resize(node.histogram.size());
+				large->histogram = std::move(node.histogram);
+				nextLevel.push_back(std::move(*small));
+				nextLevel.push_back(std::move(*large));
+				nextLevel[nextLevel.size() - 2].searched = leftSmaller? splitLeft: splitRight;
+				nextLevel.back().searched = leftSmaller? splitRight: splitLeft;
+			}
+			for(std::size_t n = 0; n < nextLevel.size(); n += 2){
+				toBuild.push_back(&nextLevel[n]);
+				toSubtract.push_back(std::make_pair(&nextLevel[n + 1], &nextLevel[n]));
+			}
+			buildHistograms(data, gradients, hessians, rows, useFeature, toBuild);
+			SHARK_PARALLEL_FOR(int n = 0; n < (int)toSubtract.size(); ++n){
+				std::vector<double>& large = toSubtract[n].first->histogram;
+				std::vector<double> const& small = toSubtract[n].second->histogram;
+				for(std::size_t j = 0; j != large.size(); ++j)
+					large[j] -= small[j];
+			}
+			//nodes which were only needed for the histogram of their sibling are done
+			level.clear();
+			for(auto& node: nextLevel){
+				if(node.searched)
+					level.push_back(std::move(node));
+			}
+		}
+		return tree;
+	}
+
+	/// \brief Returns the leaf of the tree the ith point of data is routed to.
+	static std::size_t findLeaf(
+		CARTree<RealVector> const& tree, std::vector<unsigned int> const& splitBins,
+		BinnedData const& data, std::size_t i
+	){
+		std::size_t nodeId = 0;
+		while(tree.getNode(nodeId).leftId != 0){
+			auto const& node = tree.getNode(nodeId);
+			nodeId = data.bin(i, node.attributeIndex) <= splitBins[nodeId]? node.leftId: node.rightIdOrIndex;
+		}
+		return nodeId;
+	}
+private:
+	struct Node{
+		std::size_t nodeId;
+		std::size_t start;
+		std::size_t end;
+		std::size_t depth;
+		RealVector sums; ///< number of points, sum of gradients and sum of hessians
+		std::vector<double> histogram; ///< sums per bin of every feature, in the same layout as sums
+		bool searched = true; ///< whether the node is split further
+	};
+
+	struct Split{
+		double gain = 0;
+		std::size_t feature = 0;
+		unsigned int bin = 0;
+	};
+
+	bool canSplit(Node const& node)const{
+		return node.depth < m_max_depth && node.end - node.start >= 2 * m_min_samples_leaf;
+	}
+
+	void makeLeaf(CARTree<RealVector>& tree, Node const& node, std::size_t outputs)const{
+		RealVector label(outputs);
+		for(std::size_t k = 0; k != outputs; ++k)
+			label(k) = -m_learning_rate * node.sums(1 + k) / (node.sums(1 + outputs + k) + m_lambda);
+		tree.transformLeafNode(node.nodeId, label);
+	}
+
+	double score(double const* sums, std::size_t outputs)const{
+		double result = 0;
+		for(std::size_t k = 0; k != outputs; ++k)
+			result += sqr(sums[1 + k]) / (sums[1 + outputs + k] + m_lambda);
+		return result;
+	}
+
+	//histograms of the nodes, every task fills the bins of one feature of one node
+	void buildHistograms(
+		BinnedData const& data,
+		RealMatrix const& gradients, RealMatrix const& hessians,
+		std::vector<unsigned int> const& rows,
+		std::vector<char> const& useFeature,
+		std::vector<Node*> const& nodes
+	)const{
+		std::size_t outputs = gradients.size2();
+		std::size_t stride = 2 * outputs + 1;
+		SHARK_PARALLEL_FOR(int task = 0; task < (int)(nodes.size() * data.dim); ++task){
+			Node& node = *nodes[task / data.dim];
+			std::size_t f = task % data.dim;
+			double* histogram = node.histogram.data() + data.offsets[f] * stride;
+			std::fill(histogram, histogram + (data.offsets[f + 1] - data.offsets[f]) * stride, 0.0);
+			if(!useFeature[f])
+				continue;
+			unsigned char const* bins = data.bins.data() + f * data.size;
+			for(std::size_t p = node.start; p != node.end; ++p){
+				unsigned int i = rows[p];
+				double* entry = histogram + bins[i] * stride;
+				entry[0] += 1;
+				for(std::size_t k = 0; k != outputs; ++k){
+					entry[1 + k] += gradients(i, k);
+					entry[1 + outputs + k] += hessians(i, k);
+				}
+			}
+		}
+		SHARK_PROFILE_COUNTER("histograms", nodes.size());
+	}
+
+	/// \brief Finds the best split of the node on feature f. workspace holds 2 * (2 * outputs + 1) values.
+	Split findSplit(BinnedData const& data, Node const& node, std::size_t f, std::size_t outputs, double* workspace)const{
+		std::size_t stride = 2 * outputs + 1;
+		std::size_t numBins = data.offsets[f + 1] - data.offsets[f];
+		double const* histogram = node.histogram.data() + data.offsets[f] * stride;
+		double const* sums = &node.sums(0);
+		double parentScore = score(sums, outputs);
+		Split best;
+		best.feature = f;
+		double* left = workspace;
+		double* right = workspace + stride;
+		std::fill(left, left + stride, 0.0);
+		for(std::size_t b = 0; b + 1 < numBins; ++b){
+			double hessianLeft = 0;
+			double hessianRight = 0;
+			for(std::size_t j = 0; j != stride; ++j){
+				left[j] += histogram[b * stride + j];
+				right[j] = sums[j] - left[j];
+				if(j > outputs){
+					hessianLeft += left[j];
+					hessianRight += right[j];
+				}
+			}
+			if(left[0] < m_min_samples_leaf || right[0] < m_min_samples_leaf)
+				continue;
+			if(hessianLeft < m_min_child_weight || hessianRight < m_min_child_weight)
+				continue;
+			double gain = 0.5 * (score(left, outputs) + score(right, outputs) - parentScore);
+			if(gain > best.gain){
+				best.gain = gain;
+				best.bin = b;
+			}
+		}
+		return best;
+	}
+};
+
+}}
+#endif
@@ -38,7 +38,11 @@
 
 #include <shark/Models/LinearModel.h>
 #include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Core/OpenMP.h>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <vector>
 
 
 namespace shark {
@@ -64,6 +68,12 @@ namespace shark {
  *  resulting weight vector w is represented by a LinearModel
  *  object. Currently model outputs and labels are restricted to a
  *  single dimension.
+ *
+ *  The problem is solved by coordinate descent on a column-wise copy
+ *  of the data. Screening of features which are zero at the optimum
+ *  can be enabled with setScreening and shotgun-style parallel updates
+ *  with setParallelUpdates. trainPath computes the solutions
+ *  for a decreasing sequence of values of lambda using warm starts.
  */
 template <class InputVectorType = RealVector>
 class LassoRegression : public AbstractTrainer<LinearModel<InputVectorType> >, public IParameterizable<>
@@ -79,6 +89,8 @@ public:
 	LassoRegression(double lambda, double accuracy = 0.01)
 	: m_lambda(lambda)
 	, m_accuracy(accuracy)
+	, m_parallelUpdates(1)
+	, m_screening(false)
 	{
 		RANGE_CHECK(m_lambda >= 0.0);
 		RANGE_CHECK(m_accuracy > 0.0);
@@ -135,46 +147,248 @@ public:
 		return 1;
 	}
 
+	/// \brief Return the number of coordinates which are updated simultaneously.
+	std::size_t parallelUpdates() const
+	{
+		return m_parallelUpdates;
+	}
+
+	/// \brief Set the number of coordinates which are updated simultaneously.
+	///
+	/// With a value of 1 (the default) the coordinates are updated one after another.
+	/// Larger values enable shotgun-style updates: the gradients of that many consecutive
+	/// coordinates of the schedule are computed in parallel from the same residual and
+	/// the steps are then applied together. This converges as long as the features are not too
+	/// strongly correlated, for example for sparse high dimensional data, and the
+	/// number of simultaneous updates is small compared to the number of features.
+	void setParallelUpdates(std::size_t parallelUpdates)
+	{
+		RANGE_CHECK(parallelUpdates > 0);
+		m_parallelUpdates = parallelUpdates;
+	}
+
+	/// \brief Return whether features are screened.
+	bool screening() const
+	{
+		return m_screening;
+	}
+
+	/// \brief Enable or disable feature screening (disabled by default).
+	///
+	/// With screening, the solver starts on the features which pass the sequential strong rule,
+	/// and the KKT conditions of all other features are checked when the solver stops. Violating
+	/// features are added and the solver continues. During the solve, gap safe screening
+	/// periodically removes features which are provably zero at the optimum.
+	/// The solution does not change, only the number of features visited per sweep.
+	void setScreening(bool screening)
+	{
+		m_screening = screening;
+	}
+
+	/// \brief Smallest value of lambda for which the solution is zero.
+	double maxLambda(DataType const& dataset) const
+	{
+		Snapshot snapshot(dataset);
+		RealVector correlation = snapshot.correlation(-snapshot.label);
+		return max(abs(correlation));
+	}
+
 	/// \brief Train a linear model with LASSO regression.
 	void train(ModelType& model, DataType const& dataset){
+		Snapshot snapshot(dataset);
+		RealVector w(snapshot.dim, 0.0);
+		RealVector difference = -snapshot.label;
+		// the solution at the largest lambda is zero, which serves as previous point of the strong rule
+		double previousLambda = max(abs(snapshot.correlation(difference)));
+		solve(snapshot, m_lambda, std::max(previousLambda, m_lambda), w, difference);
+
+		// write the weight vector into the model
+		RealMatrix mat(1, w.size());
+		row(mat, 0) = w;
+		model.setStructure(mat);
+	}
+
+	/// \brief Solution of LASSO regression for one value of lambda.
+	struct PathPoint{
+		double lambda;              ///< regularization parameter of the solution
+		RealVector w;               ///< weight vector
+		std::size_t activeFeatures; ///< number of features the solver worked on at the end
+	};
+
+	/// \brief Train LASSO regression for a decreasing sequence of values of lambda.
+	///
+	/// The data is copied into the column-wise layout only once and every solution is the
+	/// starting point for the next value of lambda. With screening, the previous solution also
+	/// predicts the active features of the next value through the sequential strong rule.
+	/// The regularization parameter of the trainer is not changed.
+	std::vector<PathPoint> trainPath(DataType const& dataset, std::vector<double> const& lambdas){
+		SHARK_RUNTIME_CHECK(!lambdas.empty() && lambdas[0] >= 0, "The values of lambda must be non-negative");
+		for(std::size_t k = 1; k < lambdas.size(); ++k)
+			SHARK_RUNTIME_CHECK(lambdas[k] <= lambdas[k-1], "The values of lambda must be sorted in decreasing order");
+
+		Snapshot snapshot(dataset);
+		RealVector w(snapshot.dim, 0.0);
+		RealVector difference = -snapshot.label;
+		double previousLambda = std::max(max(abs(snapshot.correlation(difference))), lambdas[0]);
+		std::vector<PathPoint> path;
+		for(double lambda: lambdas){
+			PathPoint point;
+			point.lambda = lambda;
+			point.activeFeatures = solve(snapshot, lambda, previousLambda, w, difference);
+			point.w = w;
+			path.push_back(point);
+			previousLambda = lambda;
+		}
+		return path;
+	}
+
+private:
+	/// \brief Column-wise copy of the data.
+	///
+	/// The inputs are stored transposed, such that row i holds feature i of all points. For
+	/// sparse inputs this is a compressed sparse column representation of the design matrix.
+	struct Snapshot{
+		typename Batch<InputVectorType>::type data;
+		RealVector label;
+		RealVector diag;  ///< squared norms of the features
+		std::size_t dim;
+
+		Snapshot(DataType const& dataset)
+		: label(column(createBatch(dataset.labels().elements()),0))
+		, dim(inputDimension(dataset)){
+			transposeInputs(dataset.inputs(), data);
+			diag.resize(dim);
+			for (std::size_t i=0; i<dim; i++){
+				diag[i] = norm_sqr(row(data,i));
+			}
+		}
+
+		void transposeInputs(Data<RealVector> const& inputs, RealMatrix& columns){
+			columns.resize(dim, inputs.numberOfElements());
+			std::size_t start = 0;
+			for (auto const& batch: inputs.batches()){
+				noalias(blas::columns(columns, start, start + batch.size1())) = trans(batch);
+				start += batch.size1();
+			}
+		}
+
+		// fills the compressed rows directly, each feature's entries are stored contiguously
+		void transposeInputs(Data<CompressedRealVector> const& inputs, CompressedRealMatrix& columns){
+			std::vector<std::size_t> start(dim + 1, 0);
+			for (auto const& batch: inputs.batches()){
+				for (std::size_t i=0; i<batch.size1(); i++){
+					auto x = row(batch,i);
+					for (auto pos = x.begin(); pos != x.end(); ++pos) ++start[pos.index() + 1];
+				}
+			}
+			std::partial_sum(start.begin(), start.end(), start.begin());
+			columns = CompressedRealMatrix(dim, inputs.numberOfElements(), start[dim]);
+			auto storage = columns.raw_storage();
+			for (std::size_t j=0; j<=dim; j++) storage.outer_indices_begin[j] = start[j];
+			for (std::size_t j=0; j<dim; j++) storage.outer_indices_end[j] = start[j];
+			std::size_t index = 0;
+			for (auto const& batch: inputs.batches()){
+				for (std::size_t i=0; i<batch.size1(); i++, index++){
+					auto x = row(batch,i);
+					for (auto pos = x.begin(); pos != x.end(); ++pos){
+						std::size_t k = storage.outer_indices_end[pos.index()]++;
+						storage.values[k] = *pos;
+						storage.indices[k] = index;
+					}
+				}
+			}
+			columns.set_filled(start[dim]);
+		}
+
+		/// \brief Computes X^T r for all features, in parallel.
+		RealVector correlation(RealVector const& r) const{
+			RealVector result(dim);
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)dim; ++i){
+				result(i) = inner_prod(r, row(data,i));
+			}
+			return result;
+		}
+	};
+
+	/// \brief Solves the problem for one lambda starting from w.
+	///
+	/// difference holds Xw - y and is kept up to date. Returns the number of
+	/// features the coordinate descent worked on at the end.
+	std::size_t solve(Snapshot const& snapshot, double lambda, double previousLambda, RealVector& w, RealVector& difference){
+		std::size_t dim = snapshot.dim;
+		if(!m_screening){
+			std::vector<std::size_t> active(dim);
+			std::iota(active.begin(), active.end(), 0);
+			descent(snapshot, lambda, active, w, difference);
+			return active.size();
+		}
+
+		// sequential strong rule: drop features with |x_i^T r| < 2 lambda - previousLambda
+		RealVector correlation = snapshot.correlation(difference);
+		std::vector<char> isActive(dim, 0);
+		std::vector<std::size_t> active;
+		for (std::size_t i=0; i<dim; i++){
+			if (w[i] != 0.0 || std::abs(correlation[i]) >= 2 * lambda - previousLambda){
+				isActive[i] = 1;
+				active.push_back(i);
+			}
+		}
+		while (true)
+		{
+			descent(snapshot, lambda, active, w, difference);
+
+			// check the KKT conditions of the features the solver did not work on
+			std::size_t activeFeatures = active.size();
+			std::fill(isActive.begin(), isActive.end(), 0);
+			for (std::size_t i: active) isActive[i] = 1;
+			correlation = snapshot.correlation(difference);
+			for (std::size_t i=0; i<dim; i++){
+				if (!isActive[i] && std::abs(correlation[i]) - lambda > m_accuracy){
+					isActive[i] = 1;
+					active.push_back(i);
+				}
+			}
+			if (active.size() == activeFeatures)
+				return activeFeatures;
+		}
+	}
+
+	/// \brief Coordinate descent on the features in active.
+	///
+	/// Features shown to be zero at the optimum by the gap safe rule are removed from active.
+	void descent(Snapshot const& snapshot, double lambda, std::vector<std::size_t>& active, RealVector& w, RealVector& difference){
 
 		// strategy constants
 		const double CHANGE_RATE = 0.2;
 		const double PREF_MIN = 0.05;
 		const double PREF_MAX = 20.0;
+		const std::size_t SCREENING_INTERVAL = 10;
 
 		// console output
 		const bool verbose = false;
 
-		std::size_t dim = inputDimension(dataset);
-		RealVector w(dim, 0.0);
-
-		// transpose the dataset and push it inside a single matrix
-		typename Batch<InputVectorType>::type data = trans(createBatch(dataset.inputs().elements()));
-		RealVector label = column(createBatch(dataset.labels().elements()),0);
-
-		RealVector diag(dim);
-		RealVector difference = -label;
-		UIntVector index(dim);
-
-		// pre-calculate diagonal matrix entries (feature-wise squared norms)
-		for (size_t i=0; i<dim; i++){
-			diag[i] = norm_sqr(row(data,i));
-		}
+		auto const& data = snapshot.data;
+		RealVector const& diag = snapshot.diag;
+		std::size_t dim = active.size();
+		if (dim == 0) return;
+		std::vector<std::size_t> index(dim);
 
 		// prepare preferences for scheduling
-		RealVector pref(dim, 1.0);
+		RealVector pref(snapshot.dim, 1.0);
 		double prefsum = (double)dim;
 
 		// prepare performance monitoring for self-adaptation
 		const double gain_learning_rate = 1.0 / dim;
 		double average_gain = 0.0;
 		bool canstop = true;
-		const double lambda = m_lambda;
+
+		// buffers for simultaneous updates
+		std::size_t parallelUpdates = m_parallelUpdates;
+		RealVector gradients(parallelUpdates);
+		std::vector<std::size_t> updated;
 
 		// main optimization loop
 		std::size_t iter = 0;
-		std::size_t steps = 0;
 		while (true)
 		{
 			double maxvio = 0.0;
@@ -182,10 +396,10 @@ public:
 			// define schedule
 			double psum = prefsum;
 			prefsum = 0.0;
-			int pos = 0;
-
-			for (std::size_t i=0; i<dim; i++)
+			std::size_t pos = 0;
+			for (std::size_t k=0; k<dim; k++)
 			{
+				std::size_t i = active[k];
 				double p = pref[i];
 				double n;
 				if (psum >= 1e-6 && p < psum)
@@ -198,7 +412,7 @@ public:
 				if ((double)rand() / (double)RAND_MAX < prob) m++;
 				for (std::size_t  j=0; j<m; j++)
 				{
-					index[pos] = (unsigned int)i;
+					index[pos] = i;
 					pos++;
 				}
 				psum -= p;
@@ -210,73 +424,15 @@ public:
 				std::swap(index[r], index[i]);
 			}
 
-			steps += dim;
-			for (size_t s=0; s<dim; s++)
-			{
-				std::size_t i = index[s];
+			// coordinate step on feature i with gradient grad, updating the gain-based preferences
+			auto updateCoordinate = [&](std::size_t i, double grad){
 				double a = w[i];
 				double d = diag[i];
 
-				// compute gradient
-				double grad = inner_prod(difference, row(data,i));
-
 				// compute optimal coordinate descent step and corresponding gain
 				double vio = 0.0;
 				double gain = 0.0;
-				double delta = 0.0;
-				if (a == 0.0)
-				{
-					if (grad > lambda)
-					{
-						vio = grad - lambda;
-						delta = -vio / d;
-						gain = 0.5 * d * delta * delta;
-					}
-					else if (grad < -lambda)
-					{
-						vio = -grad - lambda;
-						delta = vio / d;
-						gain = 0.5 * d * delta * delta;
-					}
-				}
-				else if (a > 0.0)
-				{
-					grad += lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta < -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d - 2.0 * lambda;
-						if (g0 > 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
-				}
-				else
-				{
-					grad -= lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta > -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d + 2.0 * lambda;
-						if (g0 < 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
-				}
+				double delta = coordinateStep(a, grad, d, lambda, vio, gain);
 
 				// update state
 				if (vio > maxvio) maxvio = vio;
@@ -300,6 +456,47 @@ public:
 						average_gain = (1.0 - gain_learning_rate) * average_gain + gain_learning_rate * gain;
 					}
 				}
+				return delta;
+			};
+
+			if (parallelUpdates == 1)
+			{
+				for (std::size_t k=0; k<dim; k++)
+				{
+					std::size_t i = index[k];
+					updateCoordinate(i, inner_prod(difference, row(data,i)));
+				}
+			}
+			else
+			{
+				// one parallel region per sweep: all threads compute the gradients of a block,
+				// which share the same residual, then one thread applies the updates
+				SHARK_PARALLEL_REGION
+				{
+					std::size_t thread = SHARK_THREAD_NUM;
+					std::size_t numThreads = SHARK_NUM_THREADS;
+					for (std::size_t blockStart=0; blockStart<dim; blockStart += parallelUpdates)
+					{
+						std::size_t blockSize = std::min(parallelUpdates, dim - blockStart);
+						for (std::size_t q=thread; q<blockSize; q += numThreads)
+							gradients(q) = inner_prod(difference, row(data,index[blockStart + q]));
+						SHARK_BARRIER
+						SHARK_SINGLE_REGION
+						{
+							updated.clear();
+							for (std::size_t q=0; q<blockSize; q++)
+							{
+								// a coordinate scheduled twice in a block needs the current value
+								std::size_t i = index[blockStart + q];
+								double grad = gradients(q);
+								if (std::find(updated.begin(), updated.end(), i) != updated.end())
+									grad = inner_prod(difference, row(data,i));
+								if (updateCoordinate(i, grad) != 0.0)
+									updated.push_back(i);
+							}
+						}
+					}
+				}
 			}
 			iter++;
 
@@ -311,7 +508,7 @@ public:
 				{
 					// prepare full sweep for a reliable check of the stopping criterion
 					canstop = true;
-					noalias(pref) = blas::repeat(1.0, dim);
+					for (std::size_t i: active) pref[i] = 1.0;
 					prefsum = (double)dim;
 					if (verbose) std::cout << "*" << std::flush;
 				}
@@ -321,17 +518,120 @@ public:
 				canstop = false;
 				if (verbose) std::cout << "." << std::flush;
 			}
+
+			if (m_screening && iter % SCREENING_INTERVAL == 0 && gapSafeScreening(snapshot, lambda, active, w, difference))
+			{
+				// restart the schedule on the remaining features
+				dim = active.size();
+				if (dim == 0) return;
+				index.resize(dim);
+				prefsum = 0.0;
+				for (std::size_t i: active) prefsum += pref[i];
+			}
 		}
+	}
 
-		// write the weight vector into the model
-		RealMatrix mat(1, w.size());
-		row(mat, 0) = w;
-		model.setStructure(mat);
+	/// \brief Removes features from active which are zero at the optimum.
+	///
+	/// With residual r = y - Xw, the point theta = r / max(lambda, max_i |x_i^T r|) is dual
+	/// feasible. If the duality gap is G, all dual optima lie in a ball of radius sqrt(2G)/lambda around
+	/// theta, and every feature with |x_i^T theta| + sqrt(2G)/lambda ||x_i|| < 1 is zero at the optimum.
+	/// The test only involves active features, which is sufficient as the others are zero
+	/// in the problem solved by descent. Returns whether features were removed.
+	bool gapSafeScreening(Snapshot const& snapshot, double lambda, std::vector<std::size_t>& active, RealVector& w, RealVector& difference) const{
+		if (lambda <= 0.0) return false;
+		std::size_t dim = active.size();
+		RealVector correlation(dim);
+		SHARK_PARALLEL_FOR(int k = 0; k < (int)dim; ++k){
+			correlation(k) = -inner_prod(difference, row(snapshot.data,active[k]));
+		}
+		double scale = std::max(lambda, max(abs(correlation)));
+		double l1 = 0.0;
+		for (std::size_t i: active) l1 += std::abs(w[i]);
+		double primal = 0.5 * norm_sqr(difference) + lambda * l1;
+		// y - lambda theta = y + lambda / scale * difference
+		double dual = 0.5 * norm_sqr(snapshot.label) - 0.5 * norm_sqr(snapshot.label + (lambda / scale) * difference);
+		double radius = std::sqrt(2.0 * std::max(primal - dual, 0.0)) / lambda;
+
+		std::size_t kept = 0;
+		for (std::size_t k=0; k<dim; k++){
+			std::size_t i = active[k];
+			if (std::abs(correlation(k)) / scale + radius * std::sqrt(snapshot.diag[i]) < 1.0){
+				if (w[i] != 0.0){
+					noalias(difference) -= w[i] * row(snapshot.data,i);
+					w[i] = 0.0;
+				}
+			}
+			else active[kept++] = i;
+		}
+		active.resize(kept);
+		return kept != dim;
+	}
+
+	/// \brief Computes the optimal step of coordinate a with gradient grad of the smooth part and curvature d.
+	static double coordinateStep(double a, double grad, double d, double lambda, double& vio, double& gain){
+		double delta = 0.0;
+		if (a == 0.0)
+		{
+			if (grad > lambda)
+			{
+				vio = grad - lambda;
+				delta = -vio / d;
+				gain = 0.5 * d * delta * delta;
+			}
+			else if (grad < -lambda)
+			{
+				vio = -grad - lambda;
+				delta = vio / d;
+				gain = 0.5 * d * delta * delta;
+			}
+		}
+		else if (a > 0.0)
+		{
+			grad += lambda;
+			vio = std::fabs(grad);
+			delta = -grad / d;
+			if (delta < -a)
+			{
+				delta = -a;
+				gain = delta * (grad - 0.5 * d * delta);
+				double g0 = grad - a * d - 2.0 * lambda;
+				if (g0 > 0.0)
+				{
+					double dd = -g0 / d;
+					gain = dd * (grad - 0.5 * d * dd);
+					delta += dd;
+				}
+			}
+			else gain = 0.5 * d * delta * delta;
+		}
+		else
+		{
+			grad -= lambda;
+			vio = std::fabs(grad);
+			delta = -grad / d;
+			if (delta > -a)
+			{
+				delta = -a;
+				gain = delta * (grad - 0.5 * d * delta);
+				double g0 = grad - a * d + 2.0 * lambda;
+				if (g0 < 0.0)
+				{
+					double dd = -g0 / d;
+					gain = dd * (grad - 0.5 * d * dd);
+					delta += dd;
+				}
+			}
+			else gain = 0.5 * d * delta * delta;
+		}
+		return delta;
 	}
 
 protected:
 	double m_lambda;             ///< regularization parameter
 	double m_accuracy;           ///< gradient accuracy
+	std::size_t m_parallelUpdates; ///< number of coordinates updated simultaneously
+	bool m_screening;            ///< whether features are screened
 };
 
 
@@ -39,9 +39,8 @@
 #include <shark/Models/LinearModel.h>
 #include <shark/Algorithms/Trainers/AbstractWeightedTrainer.h>
 #include <shark/Algorithms/GradientDescent/LBFGS.h>
-#include <shark/ObjectiveFunctions/ErrorFunction.h>
-#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
-#include <shark/ObjectiveFunctions/Regularizer.h>
+#include <shark/Algorithms/GradientDescent/TrustRegionNewton.h>
+#include <shark/ObjectiveFunctions/LogisticRegressionError.h>
 #include <shark/ObjectiveFunctions/BoxConstraintHandler.h>
 #include <cmath>
 
@@ -59,7 +58,12 @@ namespace shark {
 /// The solver is based on LBFGS for the case where no l1-regularization is used. Otherwise
 /// the problem is transformed into a constrained problem and the constrined-LBFGS algorithm
 /// is used. This is one of the most efficient solvers for logistic regression as long as the
-/// number of data points is not too large.
+/// number of data points is not too large. Without l1-regularization, a Hessian-free
+/// TrustRegionNewton can be chosen instead using setSolver, which often needs fewer passes over
+/// the data for ill-conditioned problems.
+///
+/// The objective is the LogisticRegressionError, which caches the margins of the points so that
+/// the trials of a line search do not require products with the data.
 template <class InputVectorType = RealVector>
 class LogisticRegression : public AbstractWeightedTrainer<LinearClassifier<InputVectorType> >, public IParameterizable<>
 {
@@ -70,6 +74,12 @@ public:
 	typedef typename base_type::DatasetType DatasetType;
 	typedef typename base_type::WeightedDatasetType WeightedDatasetType;
 
+	/// \brief Solvers for the problem without l1-regularization.
+	enum Solver{
+		LBFGSSolver,
+		TrustRegionNewtonSolver
+	};
+
 	/// \brief Constructor.
 	///
 	/// \param  lambda1    value of the 1-norm regularization parameter (see class description)
@@ -77,7 +87,7 @@ public:
 	/// \param  lbias          whether to train with bias or not
 	/// \param  accuracy  stopping criterion for the iterative solver, maximal gradient component of the objective function (see class description)
 	LogisticRegression(double lambda1 = 0, double lambda2 = 0, bool bias = true, double accuracy = 1.e-8)
-	: m_bias(bias){
+	: m_bias(bias), m_solver(LBFGSSolver){
 		setLambda1(lambda1);
 		setLambda2(lambda2);
 		setAccuracy(accuracy);
@@ -120,6 +130,16 @@ public:
 		m_accuracy = accuracy;
 	}
 
+	/// \brief Return the solver used when lambda1 is zero.
+	Solver solver() const{
+		return m_solver;
+	}
+
+	/// \brief Set the solver used when lambda1 is zero. With l1-regularization, LBFGS is always used.
+	void setSolver(Solver solver){
+		m_solver = solver;
+	}
+
 	/// \brief Get the regularization parameters lambda1 and lambda2 through the IParameterizable interface.
 	RealVector parameterVector() const{
 		return {m_lambda1,m_lambda2};
@@ -157,25 +177,33 @@ private:
 		auto& innerModel = model.decisionFunction();
 		innerModel.setStructure(inputDimension(dataset),numOutputs, m_bias);
 		std::size_t dim = innerModel.numberOfParameters();
-		innerModel.setParameterVector(RealVector(dim,0.0));
 		
-		//setup error function
-		CrossEntropy loss;
-		ErrorFunction error(dataset, &innerModel, &loss);//note: chooses a different implementation depending on the dataset type
+		//setup error function, which includes the two-norm regularization of all weights but the bias
+		LogisticRegressionError<InputVectorType> error(dataset, m_bias, m_lambda2);
 		
-		//handle two-norm regularization
-		TwoNormRegularizer regularizer;
-		if(m_lambda2 > 0.0){
-			//set mask to skip bias weights
-			if(m_bias){
-				RealVector mask(dim,1.0);
-				subrange(mask,dim - numOutputs, dim).clear();
-				regularizer.setMask(mask);
+		//no l1-regularization needed -> simple case
+		if(m_lambda1 == 0 && m_solver == TrustRegionNewtonSolver){
+			TrustRegionNewton optimizer;
+			error.init();
+			optimizer.init(error);
+			//a rejected step only shrinks the trust region. We stop at a rejected step if the last accepted
+			//step did not decrease the gradient anymore, otherwise once no improvement can be measured.
+			RealVector lastPoint = optimizer.solution().point;
+			double lastAcceptedNorm = std::numeric_limits<double>::infinity();
+			while(norm_inf(optimizer.derivative()) > m_accuracy){
+				double gradientNorm = norm_inf(optimizer.derivative());
+				optimizer.step(error);
+				if(optimizer.converged()) break;
+				if(norm_sqr(optimizer.solution().point - lastPoint) == 0){
+					if(gradientNorm >= lastAcceptedNorm) break;
+				}else{
+					lastAcceptedNorm = gradientNorm;
+					noalias(lastPoint) = optimizer.solution().point;
+				}
 			}
-			error.setRegularizer(m_lambda2, &regularizer);
+			model.setParameterVector(lastPoint);
+			return;
 		}
-		
-		//no l1-regularization needed -> simple case
 		if(m_lambda1 == 0){
 			LBFGS optimizer;
 			error.init();
@@ -234,13 +262,14 @@ private:
 
 private:
 	bool m_bias; ///< whether to train with the bias parameter or not
+	Solver m_solver;              ///< solver used without l1-regularization
 	double m_lambda1;             ///< l1-regularization parameter
 	double m_lambda2;             ///< l2-regularization parameter
 	double m_accuracy;           ///< gradient accuracy
 
 	class L1Reformulation: public SingleObjectiveFunction{
 	public:
-		L1Reformulation(ErrorFunction* error, double lambda1, std::size_t regularizedParams)
+		L1Reformulation(SingleObjectiveFunction* error, double lambda1, std::size_t regularizedParams)
 		: mep_error(error), m_lambda1(lambda1), m_regularizedParams(regularizedParams){
 			m_features |= CAN_PROPOSE_STARTING_POINT;
 			m_features |= HAS_FIRST_DERIVATIVE;
@@ -282,7 +311,7 @@ private:
 		}
 		
 	private:
-		ErrorFunction* mep_error;
+		SingleObjectiveFunction* mep_error;
 		double m_lambda1;
 		BoxConstraintHandler<RealVector> m_handler;
 		std::size_t m_regularizedParams;
@@ -0,0 +1,461 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Epoch based minibatch training with SGD, Adam and AdamW
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_TRAINERS_MINIBATCHTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_MINIBATCHTRAINER_H
+
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Algorithms/GradientDescent/Adam.h>
+#include <shark/Algorithms/GradientDescent/SteepestDescent.h>
+#include <shark/ObjectiveFunctions/Loss/AbstractLoss.h>
+#include <shark/Data/DataView.h>
+#include <shark/Core/Random.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+namespace shark{
+
+/// \brief Update rules of the MinibatchTrainer.
+enum class MinibatchUpdate{
+	SGD, ///< steepest descent with momentum
+	Adam, ///< Adam, the weight decay is added to the gradient as a two-norm penalty
+	AdamW ///< Adam with decoupled weight decay
+};
+
+/// \brief Trains a model by stochastic gradient descent on minibatches.
+///
+/// Every epoch visits all training points once in a new random order. For every minibatch
+/// the gradient of the mean loss is computed and a step of the chosen update rule is performed:
+/// steepest descent with momentum, Adam or AdamW. The update of the moment estimates and the
+/// parameters is done in a single pass over the parameter vector.
+///
+/// If the minibatch size is 0, the batches of the dataset are used as minibatches and only their order
+/// is shuffled. Otherwise the elements are shuffled and minibatches of the given size are assembled from them.
+/// In this case the next minibatch is assembled in a background thread while the
+/// gradient of the current minibatch is computed, unless prefetching is disabled. A single thread
+/// is used for the whole training, it stays one minibatch ahead of the updates.
+///
+/// The weight decay lambda shrinks the parameters by a factor of 1-eta*lambda in every step for SGD and AdamW
+/// (for AdamW eta is the learning rate without bias correction). For Adam, the gradient of lambda/2 ||w||^2
+/// is added to the gradient of the loss instead.
+///
+/// In contrast to an OptimizationTrainer with the Adam optimizer and an ErrorFunction using
+/// minibatches, this trainer samples without replacement and does not evaluate the error of the whole
+/// dataset. The mean loss over the minibatches of the last epoch is available as trainingError().
+///
+/// The parameters are updated in the precision of the parameter vector of the model, e.g. in single
+/// precision for models with FloatVector parameters.
+template <class Model, class LabelTypeT = typename Model::OutputType>
+class MinibatchTrainer : public AbstractTrainer<Model,LabelTypeT>
+{
+	typedef AbstractTrainer<Model,LabelTypeT> base_type;
+public:
+	typedef typename base_type::InputType InputType;
+	typedef typename base_type::LabelType LabelType;
+	typedef typename base_type::ModelType ModelType;
+	typedef typename base_type::DatasetType DatasetType;
+	typedef AbstractLoss<LabelType, typename ModelType::OutputType> LossType;
+	typedef typename ModelType::ParameterVectorType ParameterVectorType;
+
+	/// \brief Constructor.
+	///
+	/// \param loss   differentiable loss function
+	/// \param update the update rule
+	MinibatchTrainer(LossType* loss, MinibatchUpdate update = MinibatchUpdate::Adam)
+	: mep_loss(loss)
+	, m_update(update)
+	, m_learningRate(update == MinibatchUpdate::SGD ? 0.1 : 0.001)
+	, m_momentum(0.9)
+	, m_beta1(0.9)
+	, m_beta2(0.999)
+	, m_epsilon(1.e-8)
+	, m_weightDecay(0.0)
+	, m_epochs(10)
+	, m_batchSize(0)
+	, m_prefetch(true)
+	, m_trainingError(0.0){
+		SHARK_RUNTIME_CHECK(loss != nullptr, "Loss function must not be NULL");
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "MinibatchTrainer"; }
+
+	/// \brief Returns the update rule.
+	MinibatchUpdate update()const{
+		return m_update;
+	}
+	/// \brief Sets the update rule.
+	void setUpdate(MinibatchUpdate update){
+		m_update = update;
+	}
+
+	/// \brief Returns the learning rate eta.
+	double learningRate()const{
+		return m_learningRate;
+	}
+	/// \brief Sets the learning rate eta. The default is 0.1 for SGD and 0.001 for Adam and AdamW.
+	void setLearningRate(double learningRate){
+		SHARK_RUNTIME_CHECK(learningRate > 0, "learning rate must be positive.");
+		m_learningRate = learningRate;
+	}
+
+	/// \brief Returns the momentum of SGD.
+	double momentum()const{
+		return m_momentum;
+	}
+	/// \brief Sets the momentum of SGD.
+	void setMomentum(double momentum){
+		SHARK_RUNTIME_CHECK(momentum >= 0 && momentum < 1, "momentum must be in [0,1).");
+		m_momentum = momentum;
+	}
+
+	/// \brief Returns the gradient averaging parameter beta1 of Adam and AdamW.
+	double beta1()const{
+		return m_beta1;
+	}
+	/// \brief Sets the gradient averaging parameter beta1 of Adam and AdamW.
+	void setBeta1(double beta1){
+		SHARK_RUNTIME_CHECK(beta1 > 0, "beta1 must be positive.");
+		m_beta1 = beta1;
+	}
+
+	/// \brief Returns the gradient averaging parameter beta2 of Adam and AdamW.
+	double beta2()const{
+		return m_beta2;
+	}
+	/// \brief Sets the gradient averaging parameter beta2 of Adam and AdamW.
+	void setBeta2(double beta2){
+		SHARK_RUNTIME_CHECK(beta2 > 0, "beta2 must be positive.");
+		m_beta2 = beta2;
+	}
+
+	/// \brief Returns the minimum noise estimate epsilon of Adam and AdamW.
+	double epsilon()const{
+		return m_epsilon;
+	}
+	/// \brief Sets the minimum noise estimate epsilon of Adam and AdamW.
+	void setEpsilon(double epsilon){
+		SHARK_RUNTIME_CHECK(epsilon > 0, "epsilon must be positive.");
+		m_epsilon = epsilon;
+	}
+
+	/// \brief Returns the weight decay lambda.
+	double weightDecay()const{
+		return m_weightDecay;
+	}
+	/// \brief Sets the weight decay lambda.
+	void setWeightDecay(double weightDecay){
+		SHARK_RUNTIME_CHECK(weightDecay >= 0, "weight decay must not be negative.");
+		m_weightDecay = weightDecay;
+	}
+
+	/// \brief Returns the number of epochs.
+	std::size_t epochs()const{
+		return m_epochs;
+	}
+	/// \brief Sets the number of epochs.
+	void setEpochs(std::size_t epochs){
+		m_epochs = epochs;
+	}
+
+	/// \brief Returns the minibatch size. 0 means that the batches of the dataset are used.
+	std::size_t batchSize()const{
+		return m_batchSize;
+	}
+	/// \brief Sets the minibatch size. 0 means that the batches of the dataset are used.
+	void setBatchSize(std::size_t batchSize){
+		m_batchSize = batchSize;
+	}
+
+	/// \brief Returns whether minibatches are assembled in a background thread.
+	bool prefetch()const{
+		return m_prefetch;
+	}
+	/// \brief Sets whether minibatches are assembled in a background thread.
+	void setPrefetch(bool prefetch){
+		m_prefetch = prefetch;
+	}
+
+	/// \brief Returns the mean loss over the minibatches of the last epoch.
+	///
+	/// As the parameters change during the epoch, this is only an estimate of the training error.
+	double trainingError()const{
+		return m_trainingError;
+	}
+
+	void train(ModelType& model, DatasetType const& dataset){
+		SHARK_RUNTIME_CHECK(model.hasFirstParameterDerivative(), "The model must be differentiable with respect to its parameters");
+		SHARK_RUNTIME_CHECK(mep_loss->hasFirstDerivative(), "The loss must be differentiable");
+		SHARK_RUNTIME_CHECK(dataset.numberOfElements() > 0, "The dataset must not be empty");
+
+		std::size_t numParameters = model.numberOfParameters();
+		m_point = model.parameterVector();
+		m_firstMoment.resize(numParameters);
+		m_firstMoment.clear();
+		if(m_update != MinibatchUpdate::SGD){
+			m_secondMoment.resize(numParameters);
+			m_secondMoment.clear();
+		}
+		m_state = model.createState();
+		std::size_t counter = 0;
+
+		if(m_batchSize == 0){
+			std::vector<std::size_t> order(dataset.numberOfBatches());
+			std::iota(order.begin(),order.end(),0);
+			for(std::size_t epoch = 0; epoch != m_epochs; ++epoch){
+				shark::shuffle(order.begin(),order.end(), random::globalRng);
+				double epochError = 0;
+				for(std::size_t b: order){
+					epochError += step(model, dataset.batch(b), ++counter);
+				}
+				m_trainingError = epochError / dataset.numberOfElements();
+			}
+		}else{
+			typedef DataView<DatasetType const> ViewType;
+			typedef typename ViewType::batch_type BatchType;
+			ViewType view(dataset);
+			std::size_t numElements = view.size();
+			std::size_t numBatches = (numElements + m_batchSize - 1) / m_batchSize;
+			std::vector<std::size_t> indices(numElements);
+			std::iota(indices.begin(),indices.end(),0);
+			std::size_t batchSize = m_batchSize;
+			auto assemble = [&view, &indices, batchSize, numElements](std::size_t b){
+				std::size_t start = b * batchSize;
+				std::size_t end = std::min(start + batchSize, numElements);
+				return subBatch(view, boost::make_iterator_range(indices.begin() + start, indices.begin() + end));
+			};
+			if(!m_prefetch){
+				for(std::size_t epoch = 0; epoch != m_epochs; ++epoch){
+					shark::shuffle(indices.begin(),indices.end(), random::globalRng);
+					double epochError = 0;
+					for(std::size_t b = 0; b != numBatches; ++b){
+						epochError += step(model, assemble(b), ++counter);
+					}
+					m_trainingError = epochError / numElements;
+				}
+			}else{
+				BatchPrefetcher<BatchType> prefetcher(assemble);
+				for(std::size_t epoch = 0; epoch != m_epochs; ++epoch){
+					//the prefetcher does not access the indices between two epochs
+					shark::shuffle(indices.begin(),indices.end(), random::globalRng);
+					prefetcher.startEpoch(numBatches);
+					double epochError = 0;
+					for(std::size_t b = 0; b != numBatches; ++b){
+						epochError += step(model, prefetcher.next(), ++counter);
+					}
+					m_trainingError = epochError / numElements;
+				}
+			}
+		}
+		model.setParameterVector(m_point);
+		m_state.reset();
+	}
+
+	/// \brief From ISerializable. Reads the update rule and its settings, the loss is not stored.
+	void read( InArchive & archive ){
+		int update = 0;
+		archive >> update;
+		m_update = static_cast<MinibatchUpdate>(update);
+		archive >> m_learningRate;
+		archive >> m_momentum;
+		archive >> m_beta1;
+		archive >> m_beta2;
+		archive >> m_epsilon;
+		archive >> m_weightDecay;
+		archive >> m_epochs;
+		archive >> m_batchSize;
+		archive >> m_prefetch;
+	}
+
+	/// \brief From ISerializable. Writes the update rule and its settings, the loss is not stored.
+	void write( OutArchive & archive ) const{
+		int update = static_cast<int>(m_update);
+		archive << update;
+		archive << m_learningRate;
+		archive << m_momentum;
+		archive << m_beta1;
+		archive << m_beta2;
+		archive << m_epsilon;
+		archive << m_weightDecay;
+		archive << m_epochs;
+		archive << m_batchSize;
+		archive << m_prefetch;
+	}
+
+private:
+	/// \brief Assembles the minibatches of an epoch in a background thread, one minibatch ahead of the consumer.
+	///
+	/// The thread lives as long as the object. The minibatch is handed over through a single slot,
+	/// so assembling the next minibatch overlaps with the update of the current one.
+	template<class BatchType>
+	class BatchPrefetcher{
+	public:
+		BatchPrefetcher(std::function<BatchType(std::size_t)> assemble)
+		: m_assemble(assemble), m_numBatches(0), m_nextBatch(0), m_stop(false){
+			m_thread = std::thread([this]{produce();});
+		}
+
+		~BatchPrefetcher(){
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_changed.notify_all();
+			m_thread.join();
+		}
+
+		/// \brief Starts assembling the given number of minibatches. All minibatches of the last epoch must have been consumed.
+		void startEpoch(std::size_t numBatches){
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_numBatches = numBatches;
+			m_nextBatch = 0;
+			m_changed.notify_all();
+		}
+
+		/// \brief Waits for the next minibatch and returns it. Exceptions of the background thread are rethrown.
+		BatchType next(){
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_changed.wait(lock, [this]{return m_slot || m_error;});
+			if(m_error)
+				std::rethrow_exception(m_error);
+			BatchType batch = std::move(*m_slot);
+			m_slot.reset();
+			m_changed.notify_all();
+			return batch;
+		}
+	private:
+		void produce(){
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for(;;){
+				m_changed.wait(lock, [this]{return m_stop || (!m_slot && m_nextBatch != m_numBatches);});
+				if(m_stop) return;
+				std::size_t b = m_nextBatch++;
+				lock.unlock();
+				try{
+					std::unique_ptr<BatchType> batch(new BatchType(m_assemble(b)));
+					lock.lock();
+					m_slot = std::move(batch);
+				}catch(...){
+					lock.lock();
+					m_error = std::current_exception();
+					m_changed.notify_all();
+					return;
+				}
+				m_changed.notify_all();
+			}
+		}
+
+		std::function<BatchType(std::size_t)> m_assemble;
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_changed;
+		std::size_t m_numBatches;
+		std::size_t m_nextBatch;///< index of the next minibatch to assemble
+		std::unique_ptr<BatchType> m_slot;///< the assembled minibatch, empty if it was consumed
+		bool m_stop;
+		std::exception_ptr m_error;
+	};
+
+	/// \brief Computes the gradient of the minibatch and updates the parameters. Returns the summed loss of the batch.
+	template<class BatchType>
+	double step(ModelType& model, BatchType const& batch, std::size_t counter){
+		model.eval(batch.input, m_predictions, *m_state);
+		double error = mep_loss->evalDerivative(batch.label, m_predictions, m_errorDerivative);
+		model.weightedParameterDerivative(batch.input, m_predictions, m_errorDerivative, *m_state, m_gradient);
+		double gradientScale = 1.0 / shark::batchSize(batch);
+
+		switch(m_update){
+		case MinibatchUpdate::SGD:
+			detail::momentumUpdate(
+				m_point, m_firstMoment, m_gradient, gradientScale,
+				m_learningRate, m_momentum, m_learningRate * m_weightDecay
+			);
+		break;
+		case MinibatchUpdate::Adam:{
+			//add the gradient of the two-norm penalty, it is rescaled with the gradient
+			if(m_weightDecay > 0)
+				noalias(m_gradient) += (m_weightDecay / gradientScale) * m_point;
+			double bias1 = 1 - std::pow(m_beta1, counter);
+			double bias2 = 1 - std::pow(m_beta2, counter);
+			detail::adamUpdate(
+				m_point, m_firstMoment, m_secondMoment, m_gradient, gradientScale,
+				m_beta1, m_beta2, m_epsilon, m_learningRate / bias1, bias2, 0.0
+			);
+		}
+		break;
+		case MinibatchUpdate::AdamW:{
+			double bias1 = 1 - std::pow(m_beta1, counter);
+			double bias2 = 1 - std::pow(m_beta2, counter);
+			detail::adamUpdate(
+				m_point, m_firstMoment, m_secondMoment, m_gradient, gradientScale,
+				m_beta1, m_beta2, m_epsilon, m_learningRate / bias1, bias2, m_learningRate * m_weightDecay
+			);
+		}
+		break;
+		}
+		model.setParameterVector(m_point);
+		return error;
+	}
+
+	LossType* mep_loss;
+	MinibatchUpdate m_update;
+	double m_learningRate;
+	double m_momentum;
+	double m_beta1;
+	double m_beta2;
+	double m_epsilon;
+	double m_weightDecay;
+	std::size_t m_epochs;
+	std::size_t m_batchSize;
+	bool m_prefetch;
+	double m_trainingError;
+
+	//workspace of train()
+	ParameterVectorType m_point;
+	ParameterVectorType m_firstMoment;///< momentum path for SGD, first moment estimate for Adam and AdamW
+	ParameterVectorType m_secondMoment;
+	ParameterVectorType m_gradient;
+	typename Batch<typename ModelType::OutputType>::type m_predictions;
+	typename Batch<typename ModelType::OutputType>::type m_errorDerivative;
+	boost::shared_ptr<State> m_state;
+};
+
+}
+#endif
@@ -87,6 +87,7 @@ public:
 		m_min_impurity_split = 1e-10; 
 		m_epsilon = 1e-10;
 		m_max_features = 0;
+		m_presort = false;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -117,6 +118,13 @@ public:
 	/// The minimum dtsnace of features to be considered different (detault 1.e-10)
 	void epsilon(double distance) {m_epsilon = distance;}
 	
+	/// Presort the features once per tree and split all nodes of a level in parallel (default false)
+	///
+	/// If the forest has fewer trees than threads, the trees are grown one after another,
+	/// each using all threads. Presorting costs a sort of every feature per tree, thus it
+	/// pays off for large trees or when few trees are grown on many cores.
+	void setPresort(bool presort) {m_presort = presort;}
+	
 	/// Return the parameter vector.
 	RealVector parameterVector() const{return RealVector();}
 
@@ -140,6 +148,7 @@ public:
 		builder.m_min_impurity_split = m_min_impurity_split;
 		builder.m_epsilon = m_epsilon;
 		builder.m_max_features = m_max_features? m_max_features: std::sqrt(inputDimension(dataset));
+		builder.m_presort = m_presort;
 		
 		//copy data into single batch for easier lookup
 		blas::matrix<double, blas::column_major> data_train = createBatch<RealVector>(dataset.inputs().elements().begin(),dataset.inputs().elements().end());
@@ -155,7 +164,7 @@ public:
 		std::vector<std::vector<std::size_t> > complements;
 
 		//Generate trees
-		SHARK_PARALLEL_FOR(int t = 0; t < m_numTrees; ++t){
+		auto buildTree = [&](int t){
 			random::rng_type rng(seeds[t]);
 			
 			//Setup data for this tree
@@ -166,6 +175,14 @@ public:
 				model.addModel(tree);
 				complements.push_back(std::move(bootstrap.complement));
 			}
+		};
+		if(m_presort && m_numTrees < (long)SHARK_NUM_THREADS){
+			for(int t = 0; t < m_numTrees; ++t)
+				buildTree(t);
+		}else{
+			SHARK_PARALLEL_FOR(int t = 0; t < m_numTrees; ++t){
+				buildTree(t);
+			}
 		}
 		
 		if(m_computeOOBerror)
@@ -179,6 +196,7 @@ public:
 private:
 	bool m_computeFeatureImportances;///< set true if the feature importances should be computed
 	bool m_computeOOBerror;///< set true if OOB error should be computed
+	bool m_presort;///< set true if the trees are grown on presorted features
 
 	long m_numTrees; ///< number of trees in the forest
 	std::size_t m_max_features;///< number of attributes to randomly test at each inner node
@@ -206,6 +224,7 @@ public:
 		m_min_impurity_split = 1e-10; 
 		m_epsilon = 1e-10;
 		m_max_features = 0;
+		m_presort = false;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -236,6 +255,13 @@ public:
 	/// The minimum dtsnace of features to be considered different (detault 1.e-10)
 	void epsilon(double distance) {m_epsilon = distance;}
 	
+	/// Presort the features once per tree and split all nodes of a level in parallel (default false)
+	///
+	/// If the forest has fewer trees than threads, the trees are grown one after another,
+	/// each using all threads. Presorting costs a sort of every feature per tree, thus it
+	/// pays off for large trees or when few trees are grown on many cores.
+	void setPresort(bool presort) {m_presort = presort;}
+	
 	/// Return the parameter vector.
 	RealVector parameterVector() const{ return RealVector();}
 
@@ -245,7 +271,8 @@ public:
 	}
 	
 	
-	/// Train a random forest for classification.
+	/// Train a random forest for regression.
+	using AbstractWeightedTrainer<RFClassifier<RealVector> >::train;
 	void train(RFClassifier<LabelType>& model, WeightedLabeledData<RealVector,LabelType> const& dataset){
 		model.clearModels();
 		model.setOutputSize(labelDimension(dataset));
@@ -257,6 +284,7 @@ public:
 		builder.m_min_impurity_split = m_min_impurity_split;
 		builder.m_epsilon = m_epsilon;
 		builder.m_max_features = m_max_features? m_max_features: inputDimension(dataset)/3;
+		builder.m_presort = m_presort;
 		//copy data into single batch for easier lookup
 		blas::matrix<double, blas::column_major> data_train = createBatch<RealVector>(dataset.inputs().elements().begin(),dataset.inputs().elements().end());
 		auto labels_train = createBatch<LabelType>(dataset.labels().elements().begin(),dataset.labels().elements().end());
@@ -271,7 +299,7 @@ public:
 		std::vector<std::vector<std::size_t> > complements;
 
 		//Generate trees
-		SHARK_PARALLEL_FOR(int t = 0; t < m_numTrees; ++t){
+		auto buildTree = [&](int t){
 			random::rng_type rng{seeds[t]};
 			
 			//Setup data for this tree
@@ -282,6 +310,14 @@ public:
 				model.addModel(tree);
 				complements.push_back(std::move(bootstrap.complement));
 			}
+		};
+		if(m_presort && m_numTrees < (long)SHARK_NUM_THREADS){
+			for(int t = 0; t < m_numTrees; ++t)
+				buildTree(t);
+		}else{
+			SHARK_PARALLEL_FOR(int t = 0; t < m_numTrees; ++t){
+				buildTree(t);
+			}
 		}
 		
 		if(m_computeOOBerror)
@@ -295,6 +331,7 @@ public:
 private:
 	bool m_computeFeatureImportances;///< set true if the feature importances should be computed
 	bool m_computeOOBerror;///< set true if OOB error should be computed
+	bool m_presort;///< set true if the trees are grown on presorted features
 
 	long m_numTrees; ///< number of trees in the forest
 	std::size_t m_max_features;///< number of attributes to randomly test at each inner node
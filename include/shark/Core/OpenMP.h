@@ -45,12 +45,25 @@ for
 
 #define SHARK_CRITICAL_REGION __pragma(omp critical)
 
+//MSVC only supports OpenMP 2.0, tasks are executed directly
+#define SHARK_PARALLEL_REGION __pragma(omp parallel)
+#define SHARK_SINGLE_REGION __pragma(omp single)
+#define SHARK_BARRIER __pragma(omp barrier)
+#define SHARK_TASK
+#define SHARK_TASKWAIT
+
 #else
 #define SHARK_PARALLEL_FOR \
 _Pragma ( "omp parallel for" )\
 for
 
 #define SHARK_CRITICAL_REGION _Pragma("omp critical (globalSharkLock)")
+
+#define SHARK_PARALLEL_REGION _Pragma("omp parallel")
+#define SHARK_SINGLE_REGION _Pragma("omp single")
+#define SHARK_BARRIER _Pragma("omp barrier")
+#define SHARK_TASK _Pragma("omp task")
+#define SHARK_TASKWAIT _Pragma("omp taskwait")
 #endif
 
 #define SHARK_NUM_THREADS (std::size_t)(omp_in_parallel()?omp_get_num_threads():omp_get_max_threads())
@@ -59,6 +72,11 @@ for
 #else
 #define SHARK_PARALLEL_FOR for
 #define SHARK_CRITICAL_REGION
+#define SHARK_PARALLEL_REGION
+#define SHARK_SINGLE_REGION
+#define SHARK_BARRIER
+#define SHARK_TASK
+#define SHARK_TASKWAIT
 #define SHARK_NUM_THREADS (std::size_t)1
 #define SHARK_THREAD_NUM (std::size_t)0
 #endif
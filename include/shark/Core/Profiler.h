@@ -0,0 +1,350 @@
+/*!
+ *
+ *
+ * \brief       Hierarchical scoped-region profiler with user counters
+ *
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_CORE_PROFILER_H
+#define SHARK_CORE_PROFILER_H
+
+#include <shark/Core/Shark.h>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace shark{
+namespace profiling{
+
+/// \brief Writes name as JSON string, escaping quotes, backslashes and control characters.
+inline void writeJSONString(std::ostream& stream, char const* name){
+	static char const hex[] = "0123456789abcdef";
+	stream<<'"';
+	for(; *name; ++name){
+		unsigned char c = static_cast<unsigned char>(*name);
+		if(c == '"' || c == '\\')
+			stream<<'\\'<<*name;
+		else if(c < 0x20)
+			stream<<"\\u00"<<hex[c >> 4]<<hex[c & 15];
+		else
+			stream<<*name;
+	}
+	stream<<'"';
+}
+
+/// \brief Node in the tree of profiled regions.
+///
+/// Every node stores how often the region was entered, the total wall time spent inside it
+/// (including its children) and the user counters which were added while the region was
+/// the innermost active region.
+struct ProfileNode{
+	explicit ProfileNode(std::string const& name = "root"):name(name), calls(0), seconds(0.0){}
+
+	std::string name;
+	std::size_t calls;
+	double seconds;
+	std::vector<std::pair<std::string,double> > counters;
+	std::vector<std::unique_ptr<ProfileNode> > children;
+
+	/// \brief Returns the child with the given name, creating it if it does not exist.
+	ProfileNode& child(char const* childName){
+		for(auto& c: children){
+			if(std::strcmp(c->name.c_str(), childName) == 0)
+				return *c;
+		}
+		children.emplace_back(new ProfileNode(childName));
+		return *children.back();
+	}
+
+	/// \brief Returns the child with the given name or nullptr.
+	ProfileNode const* findChild(std::string const& childName)const{
+		for(auto const& c: children){
+			if(c->name == childName)
+				return c.get();
+		}
+		return nullptr;
+	}
+
+	/// \brief Returns the value of a counter, 0 if it was never set.
+	double counter(std::string const& counterName)const{
+		for(auto const& c: counters){
+			if(c.first == counterName)
+				return c.second;
+		}
+		return 0.0;
+	}
+
+	void addCounter(char const* counterName, double value){
+		for(auto& c: counters){
+			if(std::strcmp(c.first.c_str(), counterName) == 0){
+				c.second += value;
+				return;
+			}
+		}
+		counters.emplace_back(counterName, value);
+	}
+
+	/// \brief Adds calls, times and counters of another tree to this one.
+	void merge(ProfileNode const& other){
+		calls += other.calls;
+		seconds += other.seconds;
+		for(auto const& c: other.counters)
+			addCounter(c.first.c_str(), c.second);
+		for(auto const& c: other.children)
+			child(c->name.c_str()).merge(*c);
+	}
+};
+
+/// \brief Profiling data of a single thread.
+///
+/// Only the owning thread modifies the tree, therefore no locking is needed while profiling.
+/// Tracing can be switched on and off from other threads and is therefore an atomic flag.
+class ThreadProfile{
+public:
+	ThreadProfile(std::size_t id):m_id(id), m_current(&m_root){}
+
+	std::size_t id()const{
+		return m_id;
+	}
+	ProfileNode const& root()const{
+		return m_root;
+	}
+
+	ProfileNode* enter(char const* name){
+		ProfileNode* parent = m_current;
+		m_current = &parent->child(name);
+		return parent;
+	}
+	void leave(ProfileNode* parent, char const* name, double start, double end){
+		m_current->calls += 1;
+		m_current->seconds += end - start;
+		m_current = parent;
+		if(m_recordTrace.load(std::memory_order_relaxed))
+			m_events.push_back(TraceEvent{name, start, end - start});
+	}
+	void addCounter(char const* name, double value){
+		m_current->addCounter(name, value);
+	}
+
+	void setRecordTrace(bool recordTrace){
+		m_recordTrace.store(recordTrace, std::memory_order_relaxed);
+	}
+
+	/// \brief Writes the recorded regions as complete events of the chrome trace event format.
+	void writeTraceEvents(std::ostream& stream, bool& first)const{
+		for(auto const& event: m_events){
+			if(!first) stream<<",\n";
+			first = false;
+			stream<<"{\"name\":";
+			writeJSONString(stream, event.name);
+			stream<<",\"ph\":\"X\",\"pid\":0,\"tid\":"<<m_id
+				<<",\"ts\":"<<static_cast<long long>(event.start * 1.e6)
+				<<",\"dur\":"<<static_cast<long long>(event.duration * 1.e6)<<"}";
+		}
+	}
+
+	void reset(){
+		m_root = ProfileNode();
+		m_current = &m_root;
+		m_events.clear();
+	}
+private:
+	struct TraceEvent{
+		char const* name;
+		double start;
+		double duration;
+	};
+	std::size_t m_id;
+	ProfileNode m_root;
+	ProfileNode* m_current;
+	std::atomic<bool> m_recordTrace{false};
+	std::vector<TraceEvent> m_events;
+};
+
+/// \brief Collects the profiles of all threads.
+///
+/// Regions are entered and left using ScopedRegion, usually through the macro SHARK_PROFILE_REGION.
+/// Counters are added to the innermost active region of the calling thread, using addCounter or
+/// SHARK_PROFILE_COUNTER. Both macros expand to nothing unless Shark was configured with
+/// ENABLE_PROFILING, thus instrumentation has no cost in normal builds.
+/// In profiling builds the matrix-matrix products of the linear algebra library add their
+/// number of floating point operations to the counter "GEMM flops".
+///
+/// Region and counter names must be string literals or otherwise outlive the profiler, as
+/// trace events only store the pointer. reset(), summary() and the writers should not be called
+/// while another thread is inside a profiled region.
+class Profiler{
+public:
+	static Profiler& instance(){
+		static Profiler profiler;
+		return profiler;
+	}
+
+	/// \brief Returns the profile of the calling thread.
+	ThreadProfile& threadProfile(){
+		thread_local ThreadProfile* profile = nullptr;
+		if(!profile){
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_threads.emplace_back(new ThreadProfile(m_threads.size()));
+			m_threads.back()->setRecordTrace(m_recordTrace);
+			profile = m_threads.back().get();
+		}
+		return *profile;
+	}
+
+	/// \brief Seconds since the creation of the profiler.
+	double now()const{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+	}
+
+	/// \brief Enables recording of every single region for writeChromeTrace.
+	///
+	/// This is off by default as the memory needed grows with the number of entered regions.
+	void setRecordTrace(bool recordTrace){
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_recordTrace = recordTrace;
+		for(auto& thread: m_threads)
+			thread->setRecordTrace(recordTrace);
+	}
+
+	/// \brief Removes all recorded data.
+	void reset(){
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for(auto& thread: m_threads)
+			thread->reset();
+	}
+
+	/// \brief Returns the region tree with the data of all threads merged.
+	ProfileNode summary()const{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ProfileNode root;
+		for(auto const& thread: m_threads)
+			root.merge(thread->root());
+		return root;
+	}
+
+	/// \brief Writes the region trees of all threads as JSON.
+	void writeJSON(std::ostream& stream)const{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		stream<<"{\"threads\":[";
+		for(std::size_t i = 0; i != m_threads.size(); ++i){
+			if(i != 0) stream<<",";
+			stream<<"\n{\"thread\":"<<m_threads[i]->id()<<",\"regions\":";
+			writeChildren(stream, m_threads[i]->root());
+			stream<<"}";
+		}
+		stream<<"\n]}\n";
+	}
+
+	/// \brief Writes the recorded regions in the chrome trace event format.
+	///
+	/// The result can be loaded in chrome://tracing. Requires setRecordTrace(true).
+	void writeChromeTrace(std::ostream& stream)const{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		stream<<"{\"traceEvents\":[\n";
+		bool first = true;
+		for(auto const& thread: m_threads)
+			thread->writeTraceEvents(stream, first);
+		stream<<"\n]}\n";
+	}
+private:
+	Profiler():m_start(std::chrono::steady_clock::now()){}
+
+	static void writeChildren(std::ostream& stream, ProfileNode const& node){
+		stream<<"[";
+		for(std::size_t i = 0; i != node.children.size(); ++i){
+			ProfileNode const& child = *node.children[i];
+			if(i != 0) stream<<",";
+			stream<<"{\"name\":";
+			writeJSONString(stream, child.name.c_str());
+			stream<<",\"calls\":"<<child.calls<<",\"seconds\":"<<child.seconds;
+			stream<<",\"counters\":{";
+			for(std::size_t j = 0; j != child.counters.size(); ++j){
+				if(j != 0) stream<<",";
+				writeJSONString(stream, child.counters[j].first.c_str());
+				stream<<":"<<child.counters[j].second;
+			}
+			stream<<"},\"children\":";
+			writeChildren(stream, child);
+			stream<<"}";
+		}
+		stream<<"]";
+	}
+
+	std::chrono::steady_clock::time_point m_start;
+	mutable std::mutex m_mutex;
+	std::vector<std::unique_ptr<ThreadProfile> > m_threads;
+	bool m_recordTrace = false;
+};
+
+/// \brief Measures the region between construction and destruction.
+class ScopedRegion{
+public:
+	explicit ScopedRegion(char const* name)
+	: m_name(name)
+	, m_profile(Profiler::instance().threadProfile()){
+		m_parent = m_profile.enter(name);
+		m_start = Profiler::instance().now();
+	}
+	~ScopedRegion(){
+		m_profile.leave(m_parent, m_name, m_start, Profiler::instance().now());
+	}
+	ScopedRegion(ScopedRegion const&) = delete;
+	ScopedRegion& operator=(ScopedRegion const&) = delete;
+private:
+	char const* m_name;
+	ThreadProfile& m_profile;
+	ProfileNode* m_parent;
+	double m_start;
+};
+
+/// \brief Adds value to the counter of the innermost active region of the calling thread.
+inline void addCounter(char const* name, double value){
+	Profiler::instance().threadProfile().addCounter(name, value);
+}
+
+}}
+
+#ifdef SHARK_USE_PROFILING
+#define SHARK_PROFILE_REGION(name) shark::profiling::ScopedRegion BOOST_PP_CAT(sharkProfileRegion, __LINE__)(name)
+#define SHARK_PROFILE_COUNTER(name, value) shark::profiling::addCounter(name, value)
+#else
+#define SHARK_PROFILE_REGION(name)
+#define SHARK_PROFILE_COUNTER(name, value)
+#endif
+
+#endif
@@ -66,14 +66,22 @@ public:
 	static double now(bool measureWallclockTime = true) {
 #ifdef _WIN32
 		if(measureWallclockTime){
-			return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
-		}
-		else{
 			LARGE_INTEGER tick, tps;
 			QueryPerformanceFrequency(&tps);
 			QueryPerformanceCounter(&tick);
 			return( static_cast<double>( tick.QuadPart ) / static_cast<double>( tps.QuadPart ) );
 		}
+		else{
+			//kernel and user time of the process in units of 100ns
+			FILETIME creation, exit, kernel, user;
+			GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+			ULARGE_INTEGER kernelTime, userTime;
+			kernelTime.LowPart = kernel.dwLowDateTime;
+			kernelTime.HighPart = kernel.dwHighDateTime;
+			userTime.LowPart = user.dwLowDateTime;
+			userTime.HighPart = user.dwHighDateTime;
+			return 1e-7 * static_cast<double>(kernelTime.QuadPart + userTime.QuadPart);
+		}
 #else
 		if(measureWallclockTime){
 			timeval time;
@@ -108,6 +108,32 @@ SHARK_EXPORT_SYMBOL void importSparseData(
 	std::size_t batchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize
 );
 
+/// \brief Import classification data in single precision from a sparse data (libSVM) file.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  stream        stream to be read from
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+SHARK_EXPORT_SYMBOL void importSparseData(
+	LabeledData<FloatVector, unsigned int>& dataset,
+	std::istream& stream,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<FloatVector, unsigned int>::DefaultBatchSize
+);
+
+/// \brief Import regression data in single precision from a sparse data (libSVM) file.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  stream        stream to be read from
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+SHARK_EXPORT_SYMBOL void importSparseData(
+	LabeledData<FloatVector, FloatVector>& dataset,
+	std::istream& stream,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<FloatVector, FloatVector>::DefaultBatchSize
+);
+
 /// \brief Import classification data from a sparse data (libSVM) file.
 ///
 /// \param  dataset       container storing the loaded data
@@ -160,6 +186,32 @@ SHARK_EXPORT_SYMBOL void importSparseData(
 	std::size_t batchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize
 );
 
+/// \brief Import classification data in single precision from a sparse data (libSVM) file.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  fn            the file to be read from
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+SHARK_EXPORT_SYMBOL void importSparseData(
+	LabeledData<FloatVector, unsigned int>& dataset,
+	std::string fn,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<FloatVector, unsigned int>::DefaultBatchSize
+);
+
+/// \brief Import regression data in single precision from a sparse data (libSVM) file.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  fn            the file to be read from
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+SHARK_EXPORT_SYMBOL void importSparseData(
+	LabeledData<FloatVector, FloatVector>& dataset,
+	std::string fn,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<FloatVector, FloatVector>::DefaultBatchSize
+);
+
 
 /// \brief Export classification data to sparse data (libSVM) format.
 ///
@@ -40,6 +40,11 @@
 
 #include "../detail/matrix_proxy_classes.hpp"
 
+//hook for counting operations, e.g. defined by shark/Core/Shark.h when profiling is enabled
+#ifndef REMORA_PROFILE_COUNTER
+#define REMORA_PROFILE_COUNTER(name, value)
+#endif
+
 namespace remora{
 
 namespace bindings{
@@ -94,6 +99,7 @@ void gemm(
 	REMORA_SIZE_CHECK(m().size1() == e1().size1());
 	REMORA_SIZE_CHECK(m().size2() == e2().size2());
 	REMORA_SIZE_CHECK(e1().size2() == e2().size1());
+	REMORA_PROFILE_COUNTER("GEMM flops", 2.0 * m().size1() * m().size2() * e1().size2());
 
 	typedef typename M::orientation ResultOrientation;
 	typedef typename E1::orientation E1Orientation;
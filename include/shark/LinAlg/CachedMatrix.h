@@ -39,6 +39,8 @@
 #ifndef SHARK_LINALG_CACHEDMATRIX_H
 #define SHARK_LINALG_CACHEDMATRIX_H
 
+#include <shark/Core/OpenMP.h>
+#include <shark/Core/Profiler.h>
 #include <shark/Data/Dataset.h>
 #include <shark/LinAlg/Base.h>
 #include <shark/LinAlg/LRUCache.h>
@@ -182,6 +184,8 @@ public:
             std::copy(line + start, line+cached, storage);
         }
         //evaluate the remaining entries
+        SHARK_PROFILE_COUNTER(end > cached? "cache misses" : "cache hits", 1);
+        SHARK_PROFILE_COUNTER("kernel evaluations", end > cached? end - cached : 0);
         mep_baseMatrix->row(k,cached,end,storage+(cached-start));
     }
 
@@ -200,11 +204,49 @@ public:
         std::size_t cached= m_cache.lineLength(k);
         //create or extend cache line
         QpFloatType* line = m_cache.getCacheLine(k,end);
-        if (end > cached)//compute entries not already cached
+        SHARK_PROFILE_COUNTER(end > cached? "cache misses" : "cache hits", 1);
+        if (end > cached){//compute entries not already cached
+            SHARK_PROFILE_COUNTER("kernel evaluations", end - cached);
             mep_baseMatrix->row(k,cached,end,line+cached);
+        }
         return line;
     }
 
+    /// \brief Copies the range [start,end) of the k-th row of the matrix in external storage and caches the row
+    ///
+    /// In contrast to the other methods, this method can be called by several threads at the same time.
+    /// Only the access to the cache is serialized, missing entries are computed outside of the critical region.
+    /// \param k the index of the row
+    /// \param start the index of the first element in the range
+    /// \param end the index of the last element in the range
+    /// \param storage the external storage. must be big enough capable to hold the range
+    void sharedRow(std::size_t k, std::size_t start, std::size_t end, QpFloatType* storage){
+        SIZE_CHECK(start <= end);
+        SIZE_CHECK(end <= size());
+        std::size_t cached = start;
+        SHARK_CRITICAL_REGION{
+            std::size_t length = m_cache.lineLength(k);
+            if (start < length){
+                cached = std::min(length, end);
+                QpFloatType const* line = m_cache.getCacheLine(k, cached);
+                std::copy(line + start, line + cached, storage);
+            }
+        }
+        SHARK_PROFILE_COUNTER(cached == end? "cache hits" : "cache misses", 1);
+        if (cached == end) return;
+        SHARK_PROFILE_COUNTER("kernel evaluations", end - cached);
+        mep_baseMatrix->row(k, cached, end, storage + (cached - start));
+        //cache lines always start at the first column
+        if (start != 0) return;
+        SHARK_CRITICAL_REGION{
+            std::size_t length = m_cache.lineLength(k);
+            if (length < end){
+                QpFloatType* line = m_cache.getCacheLine(k, end);
+                std::copy(storage + length, storage + end, line + length);
+            }
+        }
+    }
+
     /// return a single matrix entry
     QpFloatType operator () (std::size_t i, std::size_t j) const{ 
         return entry(i, j);
@@ -293,5 +335,71 @@ protected:
     LRUCache<QpFloatType> m_cache; ///< cache of the matrix lines
 };
 
+///
+/// \brief Access of one thread to a CachedMatrix which is shared between threads
+///
+/// \par
+/// Every thread uses its own SharedCachedMatrix, all of which refer to the same
+/// CachedMatrix. The rows are copied out of the shared cache into storage owned by
+/// the SharedCachedMatrix, thus they can not be evicted by other threads while in use.
+/// The last two rows returned by row() stay valid, which are the two rows of a working set.
+///
+/// \par
+/// Flipping rows and columns is not supported, as it would change the matrix of all threads.
+///
+template <class Matrix>
+class SharedCachedMatrix
+{
+public:
+    typedef typename Matrix::QpFloatType QpFloatType;
+
+    /// Constructor
+    /// \param cache  Cached matrix shared by all threads
+    SharedCachedMatrix(CachedMatrix<Matrix>* cache)
+    : mep_cache(cache), m_next(0){
+        m_rows[0].resize(cache->size());
+        m_rows[1].resize(cache->size());
+    }
+
+    /// \brief Copies the range [start,end) of the k-th row of the matrix in external storage
+    void row(std::size_t k, std::size_t start,std::size_t end, QpFloatType* storage) const{
+        mep_cache->sharedRow(k, start, end, storage);
+    }
+
+    /// \brief Return a subset of a matrix row
+    ///
+    /// The array holds at least the entries in the interval [begin, end[.
+    /// It is valid until row() is called twice more.
+    QpFloatType* row(std::size_t k, std::size_t start, std::size_t end){
+        QpFloatType* line = m_rows[m_next].data();
+        m_next = 1 - m_next;
+        mep_cache->sharedRow(k, start, end, line + start);
+        return line;
+    }
+
+    /// return a single matrix entry
+    QpFloatType operator () (std::size_t i, std::size_t j) const{
+        return entry(i, j);
+    }
+
+    /// return a single matrix entry
+    QpFloatType entry(std::size_t i, std::size_t j) const{
+        return mep_cache->entry(i, j);
+    }
+
+    /// return the size of the quadratic matrix
+    std::size_t size() const
+    { return mep_cache->size(); }
+
+    /// return the size of the kernel cache (in "number of QpFloatType-s")
+    std::size_t getMaxCacheSize() const
+    { return mep_cache->getMaxCacheSize(); }
+
+private:
+    CachedMatrix<Matrix>* mep_cache; ///< matrix shared with the other threads
+    std::vector<QpFloatType> m_rows[2]; ///< the last two rows returned by row()
+    std::size_t m_next; ///< index of the storage used for the next row
+};
+
 }
 #endif
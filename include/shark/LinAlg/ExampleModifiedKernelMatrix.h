@@ -43,6 +43,7 @@
 #include <shark/LinAlg/Base.h>
 
 #include <vector>
+#include <atomic>
 #include <cmath>
 #include <algorithm>
 
@@ -148,8 +149,8 @@ protected:
     typedef typename Data<InputType>::const_element_range::const_iterator PointerType;
     /// Array of data pointers for kernel evaluations
     std::vector<PointerType> x;
-    /// counter for the kernel accesses
-    mutable unsigned long long m_accessCounter;
+    /// counter for the kernel accesses, atomic as rows may be computed concurrently
+    mutable std::atomic<unsigned long long> m_accessCounter;
 
 private:
 
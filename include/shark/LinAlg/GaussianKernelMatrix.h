@@ -43,6 +43,7 @@
 #include <shark/LinAlg/Base.h>
 
 #include <vector>
+#include <atomic>
 #include <cmath>
 
 
@@ -145,8 +146,8 @@ protected:
 
     double m_gamma;
 
-    /// counter for the kernel accesses
-    mutable unsigned long long m_accessCounter;
+    /// counter for the kernel accesses, atomic as rows may be computed concurrently
+    mutable std::atomic<unsigned long long> m_accessCounter;
 };
 
 }
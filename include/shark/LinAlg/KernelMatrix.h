@@ -45,6 +45,7 @@
 #include <shark/Models/Kernels/KernelHelpers.h>
 
 #include <vector>
+#include <atomic>
 #include <cmath>
 
 
@@ -151,8 +152,8 @@ protected:
     /// Array of data pointers for kernel evaluations
     std::vector<PointerType> x;
 
-    /// counter for the kernel accesses
-    mutable unsigned long long m_accessCounter;
+    /// counter for the kernel accesses, atomic as rows may be computed concurrently
+    mutable std::atomic<unsigned long long> m_accessCounter;
 };
 
 }
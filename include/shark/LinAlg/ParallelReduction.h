@@ -0,0 +1,148 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Reusable per-thread buffers for the parallel summation of vectors
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_LINALG_PARALLELREDUCTION_H
+#define SHARK_LINALG_PARALLELREDUCTION_H
+
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
+#include <vector>
+
+namespace shark{
+
+/// \brief Per-thread buffers for summing vectors and scalars computed in parallel.
+///
+/// Objective functions typically split the data into one range per thread, compute a partial
+/// gradient for every range and sum the partial gradients. Adding the partial results to the
+/// shared result inside a critical region serializes the summation and allocating a
+/// gradient-sized vector in every thread and call is costly for models with many parameters.
+///
+/// This class keeps one buffer per thread which is reused as long as the number of threads and the size
+/// do not change. Every thread writes only to its own buffer, thus no synchronization is needed.
+/// Afterwards sum() adds the buffers in parallel: the result is split into blocks and every block
+/// is summed over all buffers by one thread. As the buffers are always added in the same order, the
+/// result does not depend on the scheduling of the threads.
+///
+/// Copies do not share and do not copy the buffers.
+///
+/// \tparam VectorType type of the summed vectors, for example RealVector or FloatVector
+template<class VectorType = RealVector>
+class ParallelVectorReduction{
+public:
+	/// \brief Constructor.
+	///
+	/// \param blockSize number of elements of the result summed by a thread at once in sum()
+	ParallelVectorReduction(std::size_t blockSize = 4096):m_blockSize(blockSize){
+		SHARK_RUNTIME_CHECK(blockSize > 0, "Block size must be positive");
+	}
+	ParallelVectorReduction(ParallelVectorReduction const& other):m_blockSize(other.m_blockSize){}
+	ParallelVectorReduction& operator=(ParallelVectorReduction const& other){
+		m_blockSize = other.m_blockSize;
+		return *this;
+	}
+
+	/// \brief Prepares numBuffers buffers of the given size and sets all buffers and values to zero.
+	///
+	/// Memory is only allocated when the number or the size of the buffers changes.
+	void init(std::size_t numBuffers, std::size_t size){
+		SHARK_RUNTIME_CHECK(numBuffers > 0, "At least one buffer is needed");
+		m_buffers.resize(numBuffers);
+		m_values.assign(numBuffers, 0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBuffers; ++i){
+			if(m_buffers[i].size() != size)
+				m_buffers[i].resize(size);
+			m_buffers[i].clear();
+		}
+	}
+
+	/// \brief Number of buffers prepared by the last call to init().
+	std::size_t numberOfBuffers()const{
+		return m_buffers.size();
+	}
+
+	/// \brief Size of the buffers prepared by the last call to init().
+	std::size_t size()const{
+		return m_buffers.empty()? 0: m_buffers[0].size();
+	}
+
+	/// \brief Returns the i-th vector buffer.
+	VectorType& buffer(std::size_t i){
+		SIZE_CHECK(i < m_buffers.size());
+		return m_buffers[i];
+	}
+
+	/// \brief Returns the i-th scalar buffer, for example to sum up the error.
+	double& value(std::size_t i){
+		SIZE_CHECK(i < m_values.size());
+		return m_values[i];
+	}
+
+	/// \brief Returns the sum of all scalar buffers.
+	double sumOfValues()const{
+		double result = 0;
+		for(double value: m_values)
+			result += value;
+		return result;
+	}
+
+	/// \brief Stores the sum of all vector buffers in result.
+	void sum(VectorType& result)const{
+		SIZE_CHECK(!m_buffers.empty());
+		std::size_t n = size();
+		result.resize(n);
+		std::size_t numBlocks = (n + m_blockSize - 1) / m_blockSize;
+		if(numBlocks <= 1){
+			sumBlock(result, 0, n);
+			return;
+		}
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+			std::size_t start = b * m_blockSize;
+			sumBlock(result, start, std::min(start + m_blockSize, n));
+		}
+	}
+private:
+	void sumBlock(VectorType& result, std::size_t start, std::size_t end)const{
+		auto resultBlock = subrange(result, start, end);
+		noalias(resultBlock) = subrange(m_buffers[0], start, end);
+		for(std::size_t i = 1; i != m_buffers.size(); ++i){
+			noalias(resultBlock) += subrange(m_buffers[i], start, end);
+		}
+	}
+
+	std::size_t m_blockSize;
+	std::vector<VectorType> m_buffers;
+	std::vector<double> m_values;
+};
+
+}
+#endif
@@ -222,7 +222,7 @@ public:
 		BatchOutputType const& outputs,
 		BatchOutputType const & coefficients,
 		State const& state,
-		RealVector& derivative
+		ParameterType& derivative
 	)const{
 		SHARK_FEATURE_EXCEPTION(HAS_FIRST_PARAMETER_DERIVATIVE);
 	}
@@ -259,7 +259,7 @@ public:
 		BatchOutputType const& outputs,
 		BatchOutputType const & coefficients,
 		State const& state,
-		RealVector& parameterDerivative,
+		ParameterType& parameterDerivative,
 		BatchInputType& inputDerivative
 	)const{
 		weightedParameterDerivative(patterns, outputs, coefficients,state,parameterDerivative);
@@ -278,9 +278,9 @@ public:
 ///
 /// \param model: model to be initialized
 /// \param s: variance of mean-free normal distribution
-template <class InputType, class OutputType>
-void initRandomNormal(AbstractModel<InputType, OutputType>& model, double s){
-	RealVector weights(model.numberOfParameters());
+template <class InputType, class OutputType, class ParameterType>
+void initRandomNormal(AbstractModel<InputType, OutputType, ParameterType>& model, double s){
+	ParameterType weights(model.numberOfParameters());
 	std::generate(weights.begin(), weights.end(), [&](){return random::gauss(random::globalRng,0,s);});
 	model.setParameterVector(weights);
 }
@@ -291,9 +291,9 @@ void initRandomNormal(AbstractModel<InputType, OutputType>& model, double s){
 /// \param model model to be initialized
 /// \param lower lower bound of initialization interval
 /// \param upper upper bound of initialization interval
-template <class InputType, class OutputType>
-void initRandomUniform(AbstractModel<InputType, OutputType>& model, double lower, double upper){
-	RealVector weights(model.numberOfParameters());
+template <class InputType, class OutputType, class ParameterType>
+void initRandomUniform(AbstractModel<InputType, OutputType, ParameterType>& model, double lower, double upper){
+	ParameterType weights(model.numberOfParameters());
 	std::generate(weights.begin(), weights.end(), [&](){return random::uni(random::globalRng,lower,upper);});
 	model.setParameterVector(weights);
 }
@@ -52,6 +52,9 @@ namespace shark {
 ///of model2 must match. Another way of construction is calling the constructor of ConcatenatedModel using the constructor:
 /// ConcatenatedModel<InputType,OutputType> model (&modell,&model2);
 ///warning: model1 and model2 must outlive model. When they are destroyed first, behavior is undefined.
+///
+///VectorType is the input, output and parameter type of all layers, e.g. FloatVector for a network
+///trained in single precision.
 template<class VectorType>
 class ConcatenatedModel: public AbstractModel<VectorType, VectorType, VectorType> {
 private:
@@ -76,7 +79,7 @@ public:
 	}
 
 
-	void add(AbstractModel<VectorType, VectorType>* layer, bool optimize){
+	void add(AbstractModel<VectorType, VectorType, VectorType>* layer, bool optimize){
 		m_layers.push_back({layer,optimize});
 		enableModelOptimization(m_layers.size()-1, optimize);//recompute capabilities
 	}
@@ -187,7 +190,7 @@ public:
 		BatchOutputType const & outputs,
 		BatchOutputType const& coefficients,
 		State const& state,
-		RealVector& gradient
+		ParameterVectorType& gradient
 	)const{
 		InternalState const& s = state.toState<InternalState>();
 		BatchOutputType inputDerivativeLast;
@@ -206,7 +209,7 @@ public:
 				if(i != 0) //check, if we are done, the input layer does not need to compute anything
 					m_layers[i].model->weightedInputDerivative(*pInput,s.intermediates[i], inputDerivativeLast, *s.state[i], inputDerivative);
 			}else{
-				RealVector paramDerivative;
+				ParameterVectorType paramDerivative;
 				if(i != 0){//if we are in an intermediates layer, compute chain rule
 					m_layers[i].model->weightedDerivatives(*pInput,s.intermediates[i], inputDerivativeLast, *s.state[i], paramDerivative,inputDerivative);					
 				}
@@ -246,7 +249,7 @@ public:
 		BatchOutputType const & outputs,
 		BatchOutputType const & coefficients,
 		State const& state,
-		RealVector& gradient,
+		ParameterVectorType& gradient,
 		BatchInputType& inputDerivative
 	)const{
 		InternalState const& s = state.toState<InternalState>();
@@ -265,7 +268,7 @@ public:
 			if(!m_layers[i].optimize || m_layers[i].model->numberOfParameters() == 0){
 				m_layers[i].model->weightedInputDerivative(*pInput,s.intermediates[i], inputDerivativeLast, *s.state[i], inputDerivative);
 			}else{
-				RealVector paramDerivative;
+				ParameterVectorType paramDerivative;
 				m_layers[i].model->weightedDerivatives(*pInput,s.intermediates[i], inputDerivativeLast, *s.state[i], paramDerivative,inputDerivative);
 				noalias(subrange(gradient,paramEnd - paramDerivative.size(),paramEnd)) = paramDerivative;
 				paramEnd -= paramDerivative.size();
@@ -290,7 +293,7 @@ public:
 	}
 private:
 	struct Layer{
-		AbstractModel<VectorType, VectorType>* model;
+		AbstractModel<VectorType, VectorType, VectorType>* model;
 		bool optimize;
 	};
 	std::vector<Layer> m_layers;
@@ -35,6 +35,7 @@
 #include <shark/Models/AbstractModel.h>
 #include <shark/Models/NeuronLayers.h>
 #include <shark/LinAlg/BLAS/kernels/conv2d.hpp>
+#include <shark/Core/OpenMP.h>
 namespace shark {
 
 
@@ -172,15 +173,14 @@ public:
 		std::size_t outputsForFilter = outputShape().numElements()/m_numFilters;
 		std::size_t paddingHeight = (m_type != Convolution::Valid) ? m_filterHeight - 1: 0;
 		std::size_t paddingWidth = (m_type != Convolution::Valid) ? m_filterWidth - 1: 0;
+		convolveBatch(inputs, m_filters, outputs,
+			m_numChannels, m_numFilters,
+			m_imageHeight, m_imageWidth,
+			paddingHeight, paddingWidth
+		);
+		//apply offset
 		for(std::size_t i = 0; i != inputs.size1(); ++i){
 			auto output = row(outputs,i);
-			blas::kernels::conv2d(row(inputs,i), m_filters, output,
-				m_numChannels, m_numFilters, 
-				m_imageHeight, m_imageWidth,
-				m_filterHeight, m_filterWidth,
-				paddingHeight, paddingWidth
-			);
-			//apply offset
 			noalias(to_matrix(output, m_numFilters, outputsForFilter) ) += trans(blas::repeat(m_offset,outputsForFilter));
 		}
 		m_activation.evalInPlace(outputs, state.toState<typename ActivationFunction::State>());
@@ -205,30 +205,27 @@ public:
 		auto weightGradient = to_matrix(subrange(gradient,0,m_filters.size()), m_numFilters, m_filters.size()/m_numFilters);
 		auto offsetGradient = subrange(gradient, m_filters.size(),gradient.size());
 		
-		BatchInputType patches(outputShape().numElements()/m_numFilters, m_filters.size()/m_numFilters);
-		for(std::size_t i = 0; i != inputs.size1(); ++i){
-			if(m_type == Convolution::Valid){
-				blas::bindings::im2mat(//todo must get public interface in remora
-					row(inputs,i),patches,
-					m_numChannels, 
-					m_imageHeight, m_imageWidth,
-					m_filterHeight, m_filterWidth
-				);
-			}else{
-				blas::bindings::im2mat_pad(//todo must get public interface in remora
-					row(inputs,i),patches,
-					m_numChannels, 
-					m_imageHeight, m_imageWidth,
-					m_filterHeight, m_filterWidth,
-					m_filterHeight - 1, m_filterWidth - 1
-				);
+		std::size_t paddingHeight = (m_type != Convolution::Valid) ? m_filterHeight - 1: 0;
+		std::size_t paddingWidth = (m_type != Convolution::Valid) ? m_filterWidth - 1: 0;
+		std::size_t outputsForFilter = outputShape().numElements()/m_numFilters;
+		std::size_t chunkSize = std::min(inputs.size1(), imagesPerChunk(outputsForFilter, m_numChannels));
+		Workspace& workspace = threadWorkspace();
+		WorkspaceMatrix patches = workspaceMatrix(workspace.patches, chunkSize * outputsForFilter, m_filters.size()/m_numFilters);
+		WorkspaceMatrix deltaStacked = workspaceMatrix(workspace.stacked, m_numFilters, chunkSize * outputsForFilter);
+		for(std::size_t start = 0; start < inputs.size1(); start += chunkSize){
+			std::size_t size = std::min(chunkSize, inputs.size1() - start);
+			extractPatches(inputs, start, size, patches, m_numChannels, m_imageHeight, m_imageWidth, paddingHeight, paddingWidth);
+			//stack the deltas of the images side by side, such that each row belongs to one filter
+			SHARK_PARALLEL_FOR(int k = 0; k < int(size * m_numFilters); ++k){
+				std::size_t i = k / m_numFilters;
+				std::size_t f = k % m_numFilters;
+				noalias(subrange(row(deltaStacked, f), i * outputsForFilter, (i+1) * outputsForFilter))
+				= subrange(row(delta, start + i), f * outputsForFilter, (f+1) * outputsForFilter);
 			}
-			auto delta_mat = to_matrix(row(delta,i), m_numFilters, patches.size1());
-			noalias(weightGradient) += delta_mat % patches;
-			noalias(offsetGradient) += sum_columns(delta_mat);
+			auto deltaBlock = columns(deltaStacked, 0, size * outputsForFilter);
+			noalias(weightGradient) += deltaBlock % rows(patches, 0, size * outputsForFilter);
+			noalias(offsetGradient) += sum_columns(deltaBlock);
 		}
-		//derivative of offset
-		
 	}
 	///\brief Calculates the first derivative w.r.t the inputs and summs them up over all inputs of the last computed batch
 	void weightedInputDerivative(
@@ -251,16 +248,11 @@ public:
 			paddingWidth *=2;
 		}
 		derivatives.resize(inputs.size1(),inputShape().numElements());
-		derivatives.clear();
-		for(std::size_t i = 0; i != inputs.size1(); ++i){
-			auto derivative = row(derivatives,i);
-			blas::kernels::conv2d(row(delta,i), m_backpropFilters, derivative,
-				m_numFilters, m_numChannels, 
-				shape[0], shape[1],
-				m_filterHeight, m_filterWidth,
-				paddingHeight, paddingWidth
-			);
-		}
+		convolveBatch(delta, m_backpropFilters, derivatives,
+			m_numFilters, m_numChannels, 
+			shape[0], shape[1],
+			paddingHeight, paddingWidth
+		);
 	}
 
 	/// From ISerializable
@@ -290,6 +282,115 @@ public:
 	}
 	
 private:
+	typedef blas::dense_matrix_adaptor<typename VectorType::value_type, blas::row_major> WorkspaceMatrix;
+
+	///\brief Buffers for the stacked patches and the stacked responses or deltas of the batched convolution.
+	///
+	/// Every thread has its own buffers, which grow to the largest chunk seen and are reused by all later calls.
+	struct Workspace{
+		VectorType patches;
+		VectorType stacked;
+	};
+	static Workspace& threadWorkspace(){
+		static thread_local Workspace workspace;
+		return workspace;
+	}
+	///\brief Returns the first size1 * size2 elements of buffer as row-major matrix, enlarging the buffer if needed.
+	static WorkspaceMatrix workspaceMatrix(VectorType& buffer, std::size_t size1, std::size_t size2){
+		if(buffer.size() < size1 * size2)
+			buffer.resize(size1 * size2);
+		return WorkspaceMatrix(buffer.raw_storage().values, size1, size2);
+	}
+
+	///\brief Returns how many images are processed at once by the batched convolution.
+	///
+	/// The stacked patch matrix of all images of a chunk is kept at about 64K elements so that it stays in cache.
+	std::size_t imagesPerChunk(std::size_t outputsForFilter, std::size_t numChannels)const{
+		std::size_t patchMatrixSize = outputsForFilter * m_filterHeight * m_filterWidth * numChannels;
+		return std::max<std::size_t>(1, (std::size_t(1) << 16) / patchMatrixSize);
+	}
+	
+	///\brief Stores the patches of the images start,...,start+size-1 of the batch on top of each other in patches.
+	///
+	/// The patches of image i occupy the rows i*P,...,(i+1)*P-1 where P is the number of outputs per filter.
+	/// Each row of patches is written sequentially, copying contiguous rows of the filter area from the image.
+	/// Pixels outside of the image are set to zero.
+	void extractPatches(
+		BatchInputType const& images, std::size_t start, std::size_t size, WorkspaceMatrix const& patches,
+		std::size_t numChannels, std::size_t imageHeight, std::size_t imageWidth,
+		std::size_t paddingHeight, std::size_t paddingWidth
+	)const{
+		typedef typename VectorType::value_type value_type;
+		std::size_t outputHeight = imageHeight - m_filterHeight + 1 + paddingHeight;
+		std::size_t outputWidth = imageWidth - m_filterWidth + 1 + paddingWidth;
+		std::size_t outputsForFilter = outputHeight * outputWidth;
+		//offset of the upper left corner of the image in the padded image
+		std::ptrdiff_t top = paddingHeight / 2;
+		std::ptrdiff_t left = paddingWidth / 2;
+		SHARK_PARALLEL_FOR(int i = 0; i < int(size); ++i){
+			value_type const* image = images.raw_storage().values + (start + i) * images.raw_storage().leading_dimension;
+			for(std::size_t p = 0; p != outputsForFilter; ++p){
+				value_type* patch = patches.raw_storage().values + (i * outputsForFilter + p) * patches.raw_storage().leading_dimension;
+				std::ptrdiff_t row0 = std::ptrdiff_t(p / outputWidth) - top;
+				std::ptrdiff_t col0 = std::ptrdiff_t(p % outputWidth) - left;
+				bool inside = col0 >= 0 && col0 + std::ptrdiff_t(m_filterWidth) <= std::ptrdiff_t(imageWidth);
+				for(std::size_t c = 0; c != numChannels; ++c){
+					value_type const* channel = image + c * imageHeight * imageWidth;
+					for(std::size_t i1 = 0; i1 != m_filterHeight; ++i1, patch += m_filterWidth){
+						std::ptrdiff_t r = row0 + i1;
+						if(r < 0 || r >= std::ptrdiff_t(imageHeight)){
+							std::fill(patch, patch + m_filterWidth, value_type(0));
+						}else if(inside){
+							std::copy(channel + r * imageWidth + col0, channel + r * imageWidth + col0 + m_filterWidth, patch);
+						}else{
+							for(std::size_t j1 = 0; j1 != m_filterWidth; ++j1){
+								std::ptrdiff_t col = col0 + j1;
+								patch[j1] = (col < 0 || col >= std::ptrdiff_t(imageWidth))? value_type(0): channel[r * imageWidth + col];
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	
+	///\brief Computes the convolution of all images in the batch with the given filters.
+	///
+	/// Instead of one small matrix-matrix product per image, the patches of a chunk of images are stacked
+	/// and the responses of all filters are computed by a single large product. The workspaces are
+	/// taken from the buffers of the calling thread and reused for all chunks. Patch extraction and the scattering
+	/// of the responses into the outputs run in parallel over images and filters.
+	template<class Filters>
+	void convolveBatch(
+		BatchInputType const& images, Filters const& filters, BatchOutputType& outputs,
+		std::size_t numChannels, std::size_t numFilters,
+		std::size_t imageHeight, std::size_t imageWidth,
+		std::size_t paddingHeight, std::size_t paddingWidth
+	)const{
+		std::size_t outputsForFilter = (imageHeight - m_filterHeight + 1 + paddingHeight) * (imageWidth - m_filterWidth + 1 + paddingWidth);
+		std::size_t filterSize = m_filterHeight * m_filterWidth * numChannels;
+		SIZE_CHECK(outputs.size1() == images.size1());
+		SIZE_CHECK(outputs.size2() == outputsForFilter * numFilters);
+		
+		std::size_t chunkSize = std::min(images.size1(), imagesPerChunk(outputsForFilter, numChannels));
+		Workspace& workspace = threadWorkspace();
+		WorkspaceMatrix patches = workspaceMatrix(workspace.patches, chunkSize * outputsForFilter, filterSize);
+		WorkspaceMatrix responses = workspaceMatrix(workspace.stacked, numFilters, chunkSize * outputsForFilter);
+		auto filterMatrix = to_matrix(filters, numFilters, filterSize);
+		for(std::size_t start = 0; start < images.size1(); start += chunkSize){
+			std::size_t size = std::min(chunkSize, images.size1() - start);
+			extractPatches(images, start, size, patches, numChannels, imageHeight, imageWidth, paddingHeight, paddingWidth);
+			auto responseBlock = columns(responses, 0, size * outputsForFilter);
+			noalias(responseBlock) = filterMatrix % trans(rows(patches, 0, size * outputsForFilter));
+			//the responses of image i are stored in the columns i*P,...,(i+1)*P-1
+			SHARK_PARALLEL_FOR(int k = 0; k < int(size * numFilters); ++k){
+				std::size_t i = k / numFilters;
+				std::size_t f = k % numFilters;
+				noalias(subrange(row(outputs, start + i), f * outputsForFilter, (f+1) * outputsForFilter))
+				= subrange(row(responses, f), i * outputsForFilter, (i+1) * outputsForFilter);
+			}
+		}
+	}
 	
 	///\brief Converts the filters into the backprop filters
 	///
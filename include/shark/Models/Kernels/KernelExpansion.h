@@ -43,8 +43,12 @@
 
 #include <shark/Models/Classifier.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
+
+#include <type_traits>
 
 namespace shark {
 
@@ -95,6 +99,7 @@ public:
 		m_basis = basis;
 		m_alpha.resize(basis.numberOfElements(), outputs);
 		m_alpha.clear();
+		clearCompactBasis();
 	}
 
 	/// \brief From INameable: return the class name.
@@ -131,18 +136,23 @@ public:
 	bool hasOffset() const{
 		return m_b.size() != 0;
 	}
+	/// \brief Mutable access to the coefficients. Removes the tiles created by compactBasis.
 	RealMatrix& alpha(){
+		clearCompactBasis();
 		return m_alpha;
 	}
 	RealMatrix const& alpha() const{
 		return m_alpha;
 	}
+	/// \brief Mutable access to a coefficient. Removes the tiles created by compactBasis.
 	double& alpha(std::size_t example, std::size_t cls){
+		clearCompactBasis();
 		return m_alpha(example, cls);
 	}
 	double const& alpha(std::size_t example, std::size_t cls) const{
 		return m_alpha(example, cls);
 	}
+	/// \brief Mutable access to the offset. eval() always reads the current offset, also after compactBasis.
 	RealVector& offset(){
 		SHARK_RUNTIME_CHECK(hasOffset(), "[KernelExpansion::offset] invalid call for object without offset term");
 		return m_b;
@@ -169,9 +179,11 @@ public:
 		return m_basis;
 	}
 
+	/// \brief Mutable access to the basis. Removes the tiles created by compactBasis.
 	Data<InputType>& basis() {
-        return m_basis;
-    }
+		clearCompactBasis();
+		return m_basis;
+	}
     
     /// The sparsify method removes non-support-vectors from
 	/// its set of basis vectors and the coefficient matrix.
@@ -192,6 +204,60 @@ public:
 			noalias(row(a,i)) = row(m_alpha,svIndices[i]); 
 		}
 		swap(m_alpha,a);
+		clearCompactBasis();
+	}
+
+	/// \brief Prepares the expansion for fast repeated evaluation.
+	///
+	/// Basis vectors with all coefficients zero are dropped and the remaining ones are copied
+	/// in tiles of tileSize elements together with their coefficients. eval() computes the tiles
+	/// in parallel and reuses per-thread buffers for the kernel values, thus after the first call
+	/// no kernel matrix sized memory is allocated.
+	///
+	/// If the kernel is a GaussianRbfKernel on dense vectors, the squared norms of the basis vectors are
+	/// precomputed and the exponential is applied in place before the product with the coefficients.
+	/// In this case singlePrecision stores basis and coefficients as float and computes the kernel values
+	/// in single precision, which halves the memory traffic at the cost of accuracy.
+	///
+	/// The tiles are a copy of basis and coefficients. They are removed by setStructure, setParameterVector,
+	/// sparsify, read and the mutable versions of alpha() and basis(), afterwards eval() uses the
+	/// uncompacted expansion until compactBasis() is called again. Changing the offset or the kernel
+	/// parameters does not require a new call.
+	void compactBasis(bool singlePrecision = false, std::size_t tileSize = 256){
+		SHARK_RUNTIME_CHECK(tileSize > 0, "[KernelExpansion::compactBasis] tile size must be positive");
+		clearCompactBasis();
+		DataView<Data<InputType> const> view(m_basis);
+		std::vector<std::size_t> indices;
+		for (std::size_t i=0; i != view.size(); ++i){
+			if (blas::norm_1(row(m_alpha, i)) > 0.0)
+				indices.push_back(i);
+		}
+		m_singlePrecision = singlePrecision;
+		for(std::size_t start = 0; start < indices.size(); start += tileSize){
+			std::size_t end = std::min(start + tileSize, indices.size());
+			std::vector<InputType> elements;
+			BasisTile tile;
+			tile.alpha.resize(end - start, m_alpha.size2());
+			for(std::size_t i = start; i != end; ++i){
+				elements.push_back(view[indices[i]]);
+				noalias(row(tile.alpha, i - start)) = row(m_alpha, indices[i]);
+			}
+			tile.basis = createBatch<InputType>(elements);
+			prepareTile(tile, std::is_same<InputType, RealVector>());
+			m_tiles.push_back(std::move(tile));
+		}
+		m_compact = true;
+	}
+
+	/// \brief Removes the tiles created by compactBasis.
+	void clearCompactBasis(){
+		m_tiles.clear();
+		m_compact = false;
+	}
+
+	/// \brief Returns whether eval uses the tiles created by compactBasis.
+	bool hasCompactBasis()const{
+		return m_compact;
 	}
 
 	// //////////////////////////////////////////////////////////
@@ -213,6 +279,7 @@ public:
 		noalias(to_vector(m_alpha)) = subrange(newParameters, 0, numParams);
 		if (hasOffset())
 			noalias(m_b) = subrange(newParameters, numParams, numParams + m_b.size());
+		clearCompactBasis();
 	}
 
 	std::size_t numberOfParameters() const{
@@ -240,6 +307,11 @@ public:
 			output = repeat(m_b,numPatterns);
 		else
 			output.clear();
+		
+		if(m_compact){
+			evalCompact(patterns, output);
+			return;
+		}
 
 		std::size_t batchStart = 0;
 		for (std::size_t i=0; i != m_basis.numberOfBatches(); i++){
@@ -272,6 +344,7 @@ public:
 		archive >> m_b;
 		archive >> m_basis;
 		archive >> (*mep_kernel);
+		clearCompactBasis();
 	}
 
 	/// From ISerializable, writes a model to an archive
@@ -284,6 +357,131 @@ public:
 		archive << const_cast<KernelType const&>(*mep_kernel);//prevent compilation warning
 	}
 
+private:
+	/// \brief Part of the compacted basis with its coefficients.
+	struct BasisTile{
+		BatchInputType basis;
+		RealMatrix alpha;
+		RealVector norms;///< squared norms of the basis vectors, only for dense inputs
+		FloatMatrix basisFloat;///< single precision copies, only if requested
+		FloatMatrix alphaFloat;
+		FloatVector normsFloat;
+	};
+
+	void prepareTile(BasisTile& tile, std::true_type)const{
+		tile.norms = sum_columns(sqr(tile.basis));
+		if(m_singlePrecision){
+			tile.basisFloat = tile.basis;
+			tile.alphaFloat = tile.alpha;
+			tile.normsFloat = tile.norms;
+		}
+	}
+	void prepareTile(BasisTile&, std::false_type)const{}
+
+	/// \brief Quantities of the patterns shared by all tiles of the Gaussian kernel, computed once per eval.
+	struct PatternData{
+		RealVector norms;///< squared norms of the patterns
+		FloatMatrix patternsFloat;///< single precision copy, only if requested
+		FloatVector normsFloat;
+	};
+
+	void preparePatterns(BatchInputType const& patterns, PatternData& data, std::true_type)const{
+		data.norms.resize(patterns.size1());
+		noalias(data.norms) = sum_columns(sqr(patterns));
+		if(m_singlePrecision){
+			data.patternsFloat.resize(patterns.size1(), patterns.size2());
+			noalias(data.patternsFloat) = patterns;
+			data.normsFloat.resize(patterns.size1());
+			noalias(data.normsFloat) = data.norms;
+		}
+	}
+	void preparePatterns(BatchInputType const&, PatternData&, std::false_type)const{}
+
+	/// \brief Evaluates the tiles in parallel, thread t sums its range of tiles in its own buffer.
+	void evalCompact(BatchInputType const& patterns, BatchOutputType& output)const{
+		GaussianRbfKernel<InputType> const* gaussian = dynamic_cast<GaussianRbfKernel<InputType> const*>(mep_kernel);
+		std::size_t numTiles = m_tiles.size();
+		if(numTiles == 0) return;
+		std::size_t numThreads = std::min(SHARK_NUM_THREADS, numTiles);
+		std::size_t tilesPerThread = numTiles / numThreads;
+		std::size_t leftOver = numTiles - tilesPerThread * numThreads;
+
+		//buffers of the calling thread, bound to references as the thread_local names
+		//would refer to the buffers of the worker threads inside the parallel region
+		static thread_local std::vector<RealMatrix> threadOutputBuffers;
+		static thread_local PatternData patternBuffer;
+		std::vector<RealMatrix>& threadOutputs = threadOutputBuffers;
+		PatternData& patternData = patternBuffer;
+		threadOutputs.resize(numThreads - 1);
+		if(gaussian)
+			preparePatterns(patterns, patternData, std::is_same<InputType, RealVector>());
+		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){
+			std::size_t t = ti;
+			std::size_t start = t * tilesPerThread + std::min(t, leftOver);
+			std::size_t end = (t + 1) * tilesPerThread + std::min(t + 1, leftOver);
+			RealMatrix& target = t == 0? output : threadOutputs[t - 1];
+			if(t != 0){
+				target.resize(output.size1(), output.size2());
+				target.clear();
+			}
+			for(std::size_t i = start; i != end; ++i){
+				if(gaussian)
+					evalGaussianTile(m_tiles[i], patterns, patternData, gaussian->gamma(), target, std::is_same<InputType, RealVector>());
+				else
+					evalTile(m_tiles[i], patterns, target);
+			}
+		}
+		for(auto const& threadOutput: threadOutputs)
+			noalias(output) += threadOutput;
+	}
+
+	void evalTile(BasisTile const& tile, BatchInputType const& patterns, RealMatrix& target)const{
+		static thread_local RealMatrix kernelValues;
+		mep_kernel->eval(tile.basis, patterns, kernelValues);
+		noalias(target) += prod(trans(kernelValues), tile.alpha);
+	}
+
+	/// \brief Computes exp(-gamma(|x|^2 + |y|^2 - 2 x^Ty)) in place in the thread's buffer.
+	void evalGaussianTile(
+		BasisTile const& tile, BatchInputType const& patterns, PatternData const& patternData,
+		double gamma, RealMatrix& target, std::true_type
+	)const{
+		std::size_t tileSize = tile.basis.size1();
+		std::size_t numPatterns = patterns.size1();
+		if(m_singlePrecision){
+			static thread_local FloatMatrix kernelValues;
+			static thread_local FloatMatrix outputFloat;
+			FloatVector const& patternNorms = patternData.normsFloat;
+			kernelValues.resize(tileSize, numPatterns);
+			outputFloat.resize(numPatterns, target.size2());
+			noalias(kernelValues) = prod(tile.basisFloat, trans(patternData.patternsFloat));
+			for(std::size_t i = 0; i != tileSize; ++i){
+				for(std::size_t j = 0; j != numPatterns; ++j)
+					kernelValues(i,j) = std::exp(float(-gamma) * (tile.normsFloat(i) + patternNorms(j) - 2.0f * kernelValues(i,j)));
+			}
+			noalias(outputFloat) = prod(trans(kernelValues), tile.alphaFloat);
+			noalias(target) += outputFloat;
+		}else{
+			static thread_local RealMatrix kernelValues;
+			RealVector const& patternNorms = patternData.norms;
+			kernelValues.resize(tileSize, numPatterns);
+			noalias(kernelValues) = prod(tile.basis, trans(patterns));
+			for(std::size_t i = 0; i != tileSize; ++i){
+				for(std::size_t j = 0; j != numPatterns; ++j)
+					kernelValues(i,j) = std::exp(-gamma * (tile.norms(i) + patternNorms(j) - 2.0 * kernelValues(i,j)));
+			}
+			noalias(target) += prod(trans(kernelValues), tile.alpha);
+		}
+	}
+	void evalGaussianTile(BasisTile const& tile, BatchInputType const& patterns, PatternData const&, double, RealMatrix& target, std::false_type)const{
+		evalTile(tile, patterns, target);
+	}
+
+	/// tiles of the compacted basis, see compactBasis
+	std::vector<BasisTile> m_tiles;
+	bool m_compact = false;
+	bool m_singlePrecision = false;
+
 // //////////////////////////////////////////////////////////
 // ////////              MEMBERS               //////////////
 // //////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Nystrom feature map approximating arbitrary kernels
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_KERNELS_NYSTROMFEATURES_H
+#define SHARK_MODELS_KERNELS_NYSTROMFEATURES_H
+
+#include <shark/Models/AbstractModel.h>
+#include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/Data/Dataset.h>
+
+namespace shark {
+
+///
+/// \brief Nystrom feature map of a kernel given a set of landmarks.
+///
+/// Given landmarks \f$ z_1,\dots,z_m \f$ with kernel matrix \f$ K = Q D Q^T \f$ the model maps an input x to
+/// \f[ \phi(x) = D^{-1/2} Q^T k_x, \quad k_x = (k(z_1,x),\dots,k(z_m,x))^T \f]
+/// Thus \f$ \langle \phi(x), \phi(y) \rangle = k_x^T K^{-1} k_y \f$ which is exact if x or y is a landmark and
+/// in general the kernel of the projection onto the span of the landmarks in feature space.
+/// Eigenvalues smaller than tolerance times the largest eigenvalue are dropped, thus the output
+/// dimension can be smaller than the number of landmarks.
+///
+/// In contrast to RandomFourierFeatures this works for every kernel, including the LinearKernel and kernels on
+/// sparse inputs, and the output is always dense. Landmarks are usually a random subset of the training inputs,
+/// for example toDataset(randomSubset(elements(inputs), m)), or the centers found by k-means.
+/// Evaluation costs m kernel evaluations and O(m^2) operations per input.
+///
+/// Like the KernelExpansion, the model stores a pointer to the kernel. The kernel parameters
+/// must not change after setStructure.
+template<class InputType = RealVector>
+class NystromFeatures : public AbstractModel<InputType, RealVector>
+{
+private:
+	typedef AbstractModel<InputType, RealVector> base_type;
+public:
+	typedef AbstractKernelFunction<InputType> KernelType;
+	typedef typename base_type::BatchInputType BatchInputType;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+
+	NystromFeatures():mep_kernel(NULL){}
+
+	NystromFeatures(KernelType* kernel, Data<InputType> const& landmarks, double tolerance = 1.e-10){
+		setStructure(kernel, landmarks, tolerance);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "NystromFeatures"; }
+
+	Shape inputShape() const{
+		return dataDimension(m_landmarks);
+	}
+	Shape outputShape() const{
+		return m_projection.size2();
+	}
+
+	KernelType const* kernel() const{
+		return mep_kernel;
+	}
+	Data<InputType> const& landmarks() const{
+		return m_landmarks;
+	}
+	/// \brief Returns the matrix \f$ Q D^{-1/2} \f$ with one column per feature.
+	RealMatrix const& projection() const{
+		return m_projection;
+	}
+
+	/// \brief Computes the feature map for the given kernel and landmarks.
+	void setStructure(KernelType* kernel, Data<InputType> const& landmarks, double tolerance = 1.e-10){
+		SHARK_RUNTIME_CHECK(kernel != NULL, "[NystromFeatures::setStructure] kernel must not be NULL");
+		SHARK_RUNTIME_CHECK(landmarks.numberOfElements() > 0, "[NystromFeatures::setStructure] no landmarks given");
+		mep_kernel = kernel;
+		m_landmarks = landmarks;
+
+		blas::symm_eigenvalue_decomposition<RealMatrix> eigen(calculateRegularizedKernelMatrix(*kernel, landmarks));
+		RealMatrix const& Q = eigen.Q();
+		RealVector const& D = eigen.D();
+		double threshold = tolerance * max(D);
+		std::size_t numFeatures = 0;
+		for(std::size_t i = 0; i != D.size(); ++i){
+			if(D(i) > threshold)
+				++numFeatures;
+		}
+		SHARK_RUNTIME_CHECK(numFeatures > 0, "[NystromFeatures::setStructure] kernel matrix of the landmarks is zero");
+		m_projection.resize(D.size(), numFeatures);
+		std::size_t feature = 0;
+		for(std::size_t i = 0; i != D.size(); ++i){
+			if(D(i) > threshold){
+				noalias(column(m_projection, feature)) = column(Q, i) / std::sqrt(D(i));
+				++feature;
+			}
+		}
+	}
+
+	using base_type::eval;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State&) const{
+		SHARK_ASSERT(mep_kernel != NULL);
+		std::size_t numPatterns = batchSize(patterns);
+		outputs.resize(numPatterns, m_projection.size2());
+		outputs.clear();
+		std::size_t batchStart = 0;
+		for(std::size_t i = 0; i != m_landmarks.numberOfBatches(); ++i){
+			std::size_t batchEnd = batchStart + batchSize(m_landmarks.batch(i));
+			RealMatrix kernelEvaluations = (*mep_kernel)(m_landmarks.batch(i), patterns);
+			auto batchProjection = rows(m_projection, batchStart, batchEnd);
+			noalias(outputs) += prod(trans(kernelEvaluations), batchProjection);
+			batchStart = batchEnd;
+		}
+	}
+
+	/// From ISerializable, reads a model from an archive
+	void read(InArchive& archive){
+		SHARK_ASSERT(mep_kernel != NULL);
+		archive >> m_projection;
+		archive >> m_landmarks;
+		archive >> (*mep_kernel);
+	}
+
+	/// From ISerializable, writes a model to an archive
+	void write(OutArchive& archive) const{
+		SHARK_ASSERT(mep_kernel != NULL);
+		archive << m_projection;
+		archive << m_landmarks;
+		archive << const_cast<KernelType const&>(*mep_kernel);//prevent compilation warning
+	}
+
+private:
+	KernelType* mep_kernel;
+	Data<InputType> m_landmarks;
+	RealMatrix m_projection;///< Q D^{-1/2}, one row per landmark
+};
+
+}
+#endif
@@ -0,0 +1,161 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Random Fourier feature map approximating Gaussian kernels
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_KERNELS_RANDOMFOURIERFEATURES_H
+#define SHARK_MODELS_KERNELS_RANDOMFOURIERFEATURES_H
+
+#include <shark/Models/AbstractModel.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/ArdKernel.h>
+#include <shark/Core/Random.h>
+#include <shark/LinAlg/Base.h>
+
+#include <boost/math/constants/constants.hpp>
+
+namespace shark {
+
+///
+/// \brief Random Fourier feature map of a Gaussian kernel.
+///
+/// The model maps an input x to the D dimensional vector
+/// \f[ z(x) = \sqrt{2/D} \cos(W x + b) \f]
+/// where the rows of W are drawn from the Fourier transform of the kernel and b is
+/// uniformly distributed in \f$ [0, 2\pi] \f$. For a kernel
+/// \f$ k(x, y) = \exp(-\sum_i \gamma_i (x_i - y_i)^2) \f$ the entries \f$ W_{ji} \f$ are normally
+/// distributed with variance \f$ 2\gamma_i \f$ and \f$ \langle z(x), z(y) \rangle \f$ is an unbiased
+/// estimate of k(x,y) with error of order \f$ 1/\sqrt{D} \f$ (Rahimi and Recht, 2007).
+///
+/// The features are dense, thus linear trainers like LinearCSvmTrainer, LogisticRegression or
+/// LinearSAGTrainer can be used on the transformed inputs to train a model whose costs grow only
+/// linearly with the number of samples. The trained linear model can be appended
+/// using operator>> to obtain the model on the original inputs.
+///
+/// The map can be created for the GaussianRbfKernel and the ARDKernelUnconstrained. The LinearKernel is not shift
+/// invariant and has no random Fourier features, use NystromFeatures or the inputs directly instead.
+/// The model has no parameters, W and b are chosen by setStructure.
+class RandomFourierFeatures : public AbstractModel<RealVector, RealVector>
+{
+private:
+	typedef AbstractModel<RealVector, RealVector> base_type;
+public:
+	typedef base_type::BatchInputType BatchInputType;
+	typedef base_type::BatchOutputType BatchOutputType;
+
+	RandomFourierFeatures(){}
+
+	/// \brief Creates numFeatures random features approximating the Gaussian kernel on inputDim dimensional inputs.
+	template<class Rng>
+	RandomFourierFeatures(GaussianRbfKernel<RealVector> const& kernel, std::size_t inputDim, std::size_t numFeatures, Rng& rng){
+		setStructure(kernel, inputDim, numFeatures, rng);
+	}
+
+	/// \brief Creates numFeatures random features approximating the ARD kernel.
+	template<class Rng>
+	RandomFourierFeatures(ARDKernelUnconstrained<RealVector> const& kernel, std::size_t numFeatures, Rng& rng){
+		setStructure(kernel, numFeatures, rng);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "RandomFourierFeatures"; }
+
+	Shape inputShape() const{
+		return m_W.size2();
+	}
+	Shape outputShape() const{
+		return m_W.size1();
+	}
+
+	/// \brief Returns the matrix W of frequencies, one row per feature.
+	RealMatrix const& frequencies() const{
+		return m_W;
+	}
+	/// \brief Returns the phase offsets b.
+	RealVector const& phases() const{
+		return m_b;
+	}
+
+	template<class Rng>
+	void setStructure(GaussianRbfKernel<RealVector> const& kernel, std::size_t inputDim, std::size_t numFeatures, Rng& rng){
+		setStructure(RealVector(inputDim, kernel.gamma()), numFeatures, rng);
+	}
+
+	template<class Rng>
+	void setStructure(ARDKernelUnconstrained<RealVector> const& kernel, std::size_t numFeatures, Rng& rng){
+		setStructure(kernel.gammaVector(), numFeatures, rng);
+	}
+
+	/// \brief Draws the features for the kernel \f$ k(x, y) = \exp(-\sum_i \gamma_i (x_i - y_i)^2) \f$.
+	template<class Rng>
+	void setStructure(RealVector const& gammas, std::size_t numFeatures, Rng& rng){
+		SHARK_RUNTIME_CHECK(numFeatures > 0, "[RandomFourierFeatures::setStructure] number of features must be positive");
+		m_W.resize(numFeatures, gammas.size());
+		m_b.resize(numFeatures);
+		for(std::size_t j = 0; j != numFeatures; ++j){
+			for(std::size_t i = 0; i != gammas.size(); ++i){
+				SHARK_RUNTIME_CHECK(gammas(i) > 0, "[RandomFourierFeatures::setStructure] gamma must be positive");
+				m_W(j,i) = random::gauss(rng, 0.0, 2 * gammas(i));
+			}
+			m_b(j) = random::uni(rng, 0.0, boost::math::constants::two_pi<double>());
+		}
+	}
+
+	using base_type::eval;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State&) const{
+		SIZE_CHECK(patterns.size2() == m_W.size2());
+		outputs.resize(patterns.size1(), m_W.size1());
+		noalias(outputs) = prod(patterns, trans(m_W));
+		noalias(outputs) += repeat(m_b, patterns.size1());
+		outputs = std::sqrt(2.0 / m_W.size1()) * cos(outputs);
+	}
+
+	/// from ISerializable
+	void read(InArchive& archive){
+		archive & m_W;
+		archive & m_b;
+	}
+
+	/// from ISerializable
+	void write(OutArchive& archive) const{
+		archive & m_W;
+		archive & m_b;
+	}
+
+private:
+	RealMatrix m_W;///< frequencies, one row per feature
+	RealVector m_b;///< phase offsets
+};
+
+}
+#endif
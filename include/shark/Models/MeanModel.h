@@ -35,8 +35,13 @@
 #ifndef SHARK_MODELS_MEANMODEL_H
 #define SHARK_MODELS_MEANMODEL_H
 
+#include <shark/Core/OpenMP.h>
+
 namespace shark {
 /// \brief Calculates the weighted mean of a set of models
+///
+/// The models are evaluated in parallel. Their responses are summed up in a
+/// fixed order afterwards, thus the result does not depend on the number of threads.
 template<class ModelType>
 class MeanModel : public AbstractModel<typename ModelType::InputType, RealVector, typename ModelType::ParameterVectorType>
 {
@@ -45,18 +50,26 @@ private:
 
 	template<class InputBatch>
 	void doEval(InputBatch const& patterns, RealMatrix& outputs, tag<RealVector>)const{
+		std::vector<RealMatrix> responses(m_models.size());
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_models.size(); ++i){
+			responses[i] = m_models[i](patterns);
+		}
 		for(std::size_t i = 0; i != m_models.size(); i++) 
-			noalias(outputs) += m_weight[i] * m_models[i](patterns);
+			noalias(outputs) += m_weight[i] * responses[i];
 		outputs /= m_weightSum;
 	}
 	template<class InputBatch>
 	void doEval(InputBatch const& patterns, RealMatrix& outputs, tag<unsigned int>)const{
-		blas::vector<unsigned int> responses;
+		blas::matrix<unsigned int> responses(m_models.size(), patterns.size1());
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_models.size(); ++i){
+			blas::vector<unsigned int> response;
+			m_models[i].eval(patterns, response);
+			noalias(row(responses, i)) = response;
+		}
 		for(std::size_t i = 0; i != m_models.size(); ++i){
-			m_models[i].eval(patterns, responses);
 			for(std::size_t p = 0; p != patterns.size1(); ++p){
-				SIZE_CHECK(responses(p) < m_outputDim);
-				outputs(p,responses(p)) += m_weight[i];
+				SIZE_CHECK(responses(i, p) < m_outputDim);
+				outputs(p,responses(i, p)) += m_weight[i];
 			}
 		}
 		outputs /= m_weightSum;
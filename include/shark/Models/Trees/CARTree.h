@@ -87,14 +87,13 @@ public:
 	/// \brief Evaluate the Tree on a batch of patterns
 	void eval(BatchInputType const& patterns, BatchOutputType & outputs) const{
 		std::size_t numPatterns = patterns.size1();
-		//evaluate the first pattern alone and create the batch output from that
-		LabelType const& firstResult = evalPattern(row(patterns,0));
+		std::vector<std::size_t> leaves;
+		evalLeaves(patterns, leaves);
+		//create the batch output from the first result
+		LabelType const& firstResult = m_labels[m_tree[leaves[0]].rightIdOrIndex];
 		outputs = Batch<LabelType>::createBatch(firstResult,numPatterns);
-		getBatchElement(outputs,0) = firstResult;
-		
-		//evaluate the rest
 		for(std::size_t i = 0; i != numPatterns; ++i){
-			getBatchElement(outputs,i) = evalPattern(row(patterns,i));
+			getBatchElement(outputs,i) = m_labels[m_tree[leaves[i]].rightIdOrIndex];
 		}
 	}
 	
@@ -106,6 +105,30 @@ public:
 		output = evalPattern(pattern);		
 	}
 
+	/// \brief Computes the id of the leaf reached by every pattern of the batch.
+	///
+	/// All patterns descend the tree together, one level at a time, reading the
+	/// split attributes directly from the batch.
+	void evalLeaves(BatchInputType const& patterns, std::vector<std::size_t>& leaves) const{
+		std::size_t numPatterns = patterns.size1();
+		leaves.assign(numPatterns, 0);
+		std::vector<std::size_t> active(numPatterns);
+		for(std::size_t i = 0; i != numPatterns; ++i)
+			active[i] = i;
+		while(!active.empty()){
+			std::size_t remaining = 0;
+			for(std::size_t k = 0; k != active.size(); ++k){
+				std::size_t i = active[k];
+				Node const& node = m_tree[leaves[i]];
+				if(node.leftId == 0) continue;
+				leaves[i] = patterns(i, node.attributeIndex) <= node.attributeValue? node.leftId : node.rightIdOrIndex;
+				active[remaining] = i;
+				++remaining;
+			}
+			active.resize(remaining);
+		}
+	}
+
 	/// \brief The model does not have any parameters.
 	std::size_t numberOfParameters() const{
 		return 0;
@@ -0,0 +1,206 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Binary tree of the top levels of a cluster hierarchy.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_CLUSTERTREE_H
+#define SHARK_MODELS_TREES_CLUSTERTREE_H
+
+
+#include <shark/Models/Trees/BinaryTree.h>
+#include <shark/Data/Dataset.h>
+#include <shark/LinAlg/Base.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace shark {
+
+
+/// \brief One merge step of an agglomerative clustering.
+///
+/// For n points the clusters 0,...,n-1 are the single points and the
+/// i-th merge creates the cluster n+i. Merges are sorted by distance,
+/// thus the last merge creates the root of the hierarchy.
+struct ClusterMerge{
+	std::size_t left;   ///< first merged cluster
+	std::size_t right;  ///< second merged cluster
+	double distance;    ///< linkage distance of the two clusters
+	std::size_t size;   ///< number of points in the merged cluster
+};
+
+
+///
+/// \brief Binary tree representing the top levels of a cluster hierarchy.
+///
+/// \par
+/// The tree is built from the merges of an agglomerative clustering,
+/// see agglomerativeClustering. It consists of the last numClusters-1
+/// merges, thus its leaves are the numClusters clusters obtained by
+/// cutting the hierarchy. The points of every node are its members in
+/// the hierarchy and the leaves are numbered from left to right in the
+/// same order as by cutDendrogram.
+///
+/// \par
+/// New points are routed to the child with the closer centroid, that is,
+/// every node splits space by the hyperplane bisecting the centroids of its
+/// children. Thus the tree can be used with HierarchicalClustering and
+/// HardClusteringModel. Note that clusters of single or average linkage are in
+/// general not linearly separable, so a training point may be routed into a different
+/// cluster than the one it belongs to in the hierarchy.
+///
+/// \par
+/// The lower bound on the distance of a point to the members of a node is computed from
+/// the ball around the centroid of the node containing all its members. The bisecting
+/// planes can not be used for this, as merged clusters are in general not separated by them.
+///
+class ClusterTree : public BinaryTree<RealVector>
+{
+	typedef BinaryTree<RealVector> base_type;
+public:
+	/// \brief Builds the tree of the numClusters clusters from the merges of the hierarchy on the dataset.
+	ClusterTree(Data<RealVector> const& dataset, std::vector<ClusterMerge> const& merges, std::size_t numClusters)
+	: base_type(dataset.numberOfElements())
+	, m_height(0.0)
+	, m_radius(0.0){
+		std::size_t n = m_size;
+		SHARK_RUNTIME_CHECK(merges.size() + 1 == n, "[ClusterTree] number of merges does not match the dataset size");
+		SHARK_RUNTIME_CHECK(numClusters > 0 && numClusters <= n, "[ClusterTree] invalid number of clusters");
+
+		//position of every cluster in the left-to-right order of the points
+		std::vector<std::size_t> offsets(2 * n - 1, 0);
+		for(std::size_t i = merges.size(); i != 0; --i){
+			ClusterMerge const& merge = merges[i - 1];
+			offsets[merge.left] = offsets[n + i - 1];
+			offsets[merge.right] = offsets[n + i - 1] + clusterSize(merge.left, merges);
+		}
+		for(std::size_t p = 0; p != n; ++p)
+			mp_indexList[offsets[p]] = p;
+
+		RealMatrix points(n, dataDimension(dataset));
+		std::size_t start = 0;
+		for(auto const& batch: dataset.batches()){
+			noalias(rows(points, start, start + batch.size1())) = batch;
+			start += batch.size1();
+		}
+		buildTree(2 * n - 2, n - numClusters, merges, points);
+	}
+
+	/// \brief Linkage distance of the merge creating this node, 0 for single points.
+	double height() const{
+		return m_height;
+	}
+
+	/// \brief Compute a lower bound on the squared distance of the reference point to the members of the node.
+	double squaredDistanceLowerBound(RealVector const& reference) const{
+		double dist = norm_2(reference - m_center) - m_radius;
+		return dist > 0 ? dist * dist : 0.0;
+	}
+
+protected:
+	using base_type::mp_left;
+	using base_type::mp_right;
+	using base_type::mp_indexList;
+	using base_type::m_size;
+	using base_type::m_nodes;
+	using base_type::m_threshold;
+
+	/// (internal) construction of a non-root node
+	ClusterTree(ClusterTree* parent, std::size_t* list, std::size_t size)
+	: base_type(parent, list, size)
+	, m_height(0.0)
+	, m_radius(0.0){}
+
+	static std::size_t clusterSize(std::size_t cluster, std::vector<ClusterMerge> const& merges){
+		std::size_t n = merges.size() + 1;
+		return cluster < n ? 1 : merges[cluster - n].size;
+	}
+
+	/// (internal) construction method: expands the merges creating clusters above firstMerge
+	void buildTree(std::size_t cluster, std::size_t firstMerge, std::vector<ClusterMerge> const& merges, RealMatrix const& points){
+		std::size_t n = merges.size() + 1;
+		//smallest ball around the centroid containing all members
+		m_center = centroid(0, m_size, points);
+		for(std::size_t i = 0; i != m_size; ++i)
+			m_radius = std::max(m_radius, norm_2(row(points, mp_indexList[i]) - m_center));
+		if(cluster < n + firstMerge){
+			m_nodes = 1;
+			return;
+		}
+		ClusterMerge const& merge = merges[cluster - n];
+		m_height = merge.distance;
+		std::size_t leftSize = clusterSize(merge.left, merges);
+		mp_left = new ClusterTree(this, mp_indexList, leftSize);
+		mp_right = new ClusterTree(this, mp_indexList + leftSize, m_size - leftSize);
+
+		//split by the plane bisecting the centroids of the children
+		RealVector leftCentroid = centroid(0, leftSize, points);
+		RealVector rightCentroid = centroid(leftSize, m_size, points);
+		m_normal = rightCentroid - leftCentroid;
+		double norm = norm_2(m_normal);
+		if(norm > 0)
+			m_normal /= norm;
+		m_threshold = 0.5 * inner_prod(m_normal, leftCentroid + rightCentroid);
+
+		static_cast<ClusterTree*>(mp_left)->buildTree(merge.left, firstMerge, merges, points);
+		static_cast<ClusterTree*>(mp_right)->buildTree(merge.right, firstMerge, merges, points);
+		m_nodes = 1 + mp_left->nodes() + mp_right->nodes();
+	}
+
+	RealVector centroid(std::size_t begin, std::size_t end, RealMatrix const& points) const{
+		RealVector c(points.size2(), 0.0);
+		for(std::size_t i = begin; i != end; ++i)
+			noalias(c) += row(points, mp_indexList[i]);
+		return c / double(end - begin);
+	}
+
+	/// function describing the separating hyperplane
+	double funct(RealVector const& reference) const{
+		return inner_prod(m_normal, reference);
+	}
+
+	/// normal of the plane bisecting the centroids of the children, empty for leaves
+	RealVector m_normal;
+
+	/// linkage distance of the merge creating this node
+	double m_height;
+
+	/// centroid of the members of the node
+	RealVector m_center;
+
+	/// largest distance of a member to the centroid
+	double m_radius;
+};
+
+
+}
+#endif
@@ -0,0 +1,382 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Pointer-free space-partitioning tree for nearest neighbor search.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_COMPACTTREE_H
+#define SHARK_MODELS_TREES_COMPACTTREE_H
+
+
+#include <shark/Models/Trees/BinaryTree.h>
+#include <shark/Data/Dataset.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Core/Math.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace shark {
+
+
+///
+/// \brief Binary space-partitioning tree stored in contiguous arrays.
+///
+/// \par
+/// The tree offers the same splits as the KDTree and the LCTree for dense
+/// real-valued inputs. Instead of allocating every node on the heap, the
+/// tree is complete and stored breadth-first: the children of node i are
+/// the nodes 2i+1 and 2i+2, the parent is (i-1)/2 and the root is node 0.
+/// Every node stores its split (dimension or row of the normal matrix and
+/// threshold) and its range of points inline. The points are copied and
+/// reordered such that the points of every node, and in particular
+/// every leaf bucket, are stored in contiguous rows of a matrix.
+///
+/// \par
+/// Nodes are split at the median position, thus all leaves have the same
+/// depth and hold at most maxBucketSize points. The depth is the smallest
+/// depth satisfying the bucket size, bounded by maxDepth.
+/// Once the top levels provide enough subtrees, these are built in parallel.
+///
+/// \par
+/// Queries are answered by a depth-first branch-and-bound search which returns
+/// exactly the same neighbors as IterativeNNQuery on a KDTree or LCTree, up to the
+/// order of points with equal distance. A bucket size larger than one is
+/// recommended as the leaves are scanned linearly in memory.
+class CompactTree
+{
+public:
+	/// \brief Splitting rule of the inner nodes.
+	enum SplitRule{
+		KDSplit,        ///< axis-aligned median cut of the widest dimension, as in the KDTree
+		LinearCutSplit  ///< median cut along the widest sampled direction, as in the LCTree
+	};
+	typedef KeyValuePair<double, std::size_t> DistancePair;
+
+	/// \brief Builds the tree from the data.
+	///
+	/// The points are copied, thus the dataset does not need to outlive the tree.
+	CompactTree(
+		Data<RealVector> const& dataset,
+		SplitRule rule = KDSplit,
+		TreeConstruction tc = TreeConstruction(0, 16)
+	): m_rule(rule){
+		SHARK_RUNTIME_CHECK(dataset.numberOfElements() > 0, "[CompactTree] dataset is empty");
+		std::size_t size = dataset.numberOfElements();
+		std::size_t dim = dataDimension(dataset);
+		RealMatrix points(size, dim);
+		std::size_t start = 0;
+		for(auto const& batch: dataset.batches()){
+			noalias(rows(points, start, start + batch.size1())) = batch;
+			start += batch.size1();
+		}
+
+		m_depth = 0;
+		while(m_depth < tc.maxDepth() && ((size - 1) >> m_depth) + 1 > tc.maxBucketSize())
+			++m_depth;
+		m_nodes.resize((std::size_t(2) << m_depth) - 1);
+		if(m_rule == LinearCutSplit)
+			m_normals.resize(numberOfInnerNodes(), dim);
+
+		m_indices.resize(size);
+		for(std::size_t i = 0; i != size; ++i)
+			m_indices[i] = i;
+		m_nodes[0].begin = 0;
+		m_nodes[0].end = size;
+
+		//split the top levels one at a time until there is a subtree for every thread
+		std::size_t level = 0;
+		for(; level != m_depth && (std::size_t(1) << level) < 4 * SHARK_NUM_THREADS; ++level){
+			std::size_t first = (std::size_t(1) << level) - 1;
+			for(std::size_t node = first; node != 2 * first + 1; ++node)
+				split(node, points);
+		}
+		std::size_t first = (std::size_t(1) << level) - 1;
+		SHARK_PARALLEL_FOR(int node = (int)first; node < (int)(2 * first + 1); ++node){
+			buildSubtree(node, points);
+		}
+
+		//store the points in the order of the leaves
+		m_points.resize(size, dim);
+		for(std::size_t i = 0; i != size; ++i)
+			noalias(row(m_points, i)) = row(points, m_indices[i]);
+	}
+
+	/// \brief Number of points stored in the tree.
+	std::size_t size() const{
+		return m_points.size1();
+	}
+	/// \brief Total number of nodes, including the leaves.
+	std::size_t nodes() const{
+		return m_nodes.size();
+	}
+	/// \brief Depth of the leaves, the root has depth 0.
+	std::size_t depth() const{
+		return m_depth;
+	}
+	SplitRule splitRule() const{
+		return m_rule;
+	}
+
+	/// \brief The points, reordered such that the points of every node are contiguous.
+	RealMatrix const& points() const{
+		return m_points;
+	}
+	/// \brief Index in the dataset of the point stored in the given row of points().
+	std::size_t index(std::size_t row) const{
+		return m_indices[row];
+	}
+
+	bool isLeaf(std::size_t node) const{
+		return node >= numberOfInnerNodes();
+	}
+	std::size_t left(std::size_t node) const{
+		return 2 * node + 1;
+	}
+	std::size_t right(std::size_t node) const{
+		return 2 * node + 2;
+	}
+	std::size_t parent(std::size_t node) const{
+		return (node - 1) / 2;
+	}
+	/// \brief First row of points() belonging to the node.
+	std::size_t begin(std::size_t node) const{
+		return m_nodes[node].begin;
+	}
+	/// \brief One past the last row of points() belonging to the node.
+	std::size_t end(std::size_t node) const{
+		return m_nodes[node].end;
+	}
+	/// \brief Signed distance of the point to the separating hyperplane of an inner node.
+	///
+	/// Points with negative distance belong to the left child.
+	template<class VectorT>
+	double distanceFromPlane(std::size_t node, VectorT const& point) const{
+		SIZE_CHECK(!isLeaf(node));
+		if(m_rule == KDSplit)
+			return point(m_nodes[node].dimension) - m_nodes[node].threshold;
+		return inner_prod(row(m_normals, node), point) - m_nodes[node].threshold;
+	}
+
+	/// \brief Returns the k nearest neighbors of the point, sorted by distance.
+	///
+	/// The keys are Euclidean distances, the values indices into the dataset.
+	template<class VectorT>
+	std::vector<DistancePair> nearestNeighbors(VectorT const& point, std::size_t k) const{
+		SHARK_RUNTIME_CHECK(k <= size(), "[CompactTree::nearestNeighbors] not enough points in the tree");
+		SIZE_CHECK(point.size() == m_points.size2());
+		std::vector<DistancePair> heap;
+		if(k == 0) return heap;
+		heap.reserve(k);
+		RealVector offsets(point.size(), 0.0);
+		search(0, point, 0.0, offsets, k, heap);
+		std::sort_heap(heap.begin(), heap.end());
+		for(auto& neighbor: heap)
+			neighbor.key = std::sqrt(neighbor.key);
+		return heap;
+	}
+
+	/// \brief Returns the k nearest neighbors of every row of the matrix, computed in parallel.
+	///
+	/// The neighbors of the i-th point are stored at positions [i*k, (i+1)*k).
+	std::vector<DistancePair> nearestNeighbors(RealMatrix const& points, std::size_t k) const{
+		SHARK_RUNTIME_CHECK(k <= size(), "[CompactTree::nearestNeighbors] not enough points in the tree");
+		std::vector<DistancePair> results(points.size1() * k);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)points.size1(); ++i){
+			std::vector<DistancePair> neighbors = nearestNeighbors(row(points, i), k);
+			std::copy(neighbors.begin(), neighbors.end(), results.begin() + i * k);
+		}
+		return results;
+	}
+
+private:
+	struct Node{
+		double threshold;      ///< split value
+		std::size_t dimension; ///< split dimension for KDSplit
+		std::size_t begin;     ///< first row of the points of the node
+		std::size_t end;       ///< one past the last row of the points of the node
+	};
+
+	std::size_t numberOfInnerNodes() const{
+		return (std::size_t(1) << m_depth) - 1;
+	}
+
+	void buildSubtree(std::size_t node, RealMatrix const& points){
+		if(isLeaf(node)) return;
+		split(node, points);
+		buildSubtree(left(node), points);
+		buildSubtree(right(node), points);
+	}
+
+	/// \brief Splits the points of an inner node at the median and initializes the children.
+	void split(std::size_t node, RealMatrix const& points){
+		Node& n = m_nodes[node];
+		std::size_t mid = n.begin + (n.end - n.begin) / 2;
+		m_nodes[left(node)].begin = n.begin;
+		m_nodes[left(node)].end = mid;
+		m_nodes[right(node)].begin = mid;
+		m_nodes[right(node)].end = n.end;
+		n.dimension = 0;
+		n.threshold = 0;
+		if(n.end - n.begin < 2){
+			//nothing to split, the left child stays empty
+			if(n.end != n.begin && m_rule == KDSplit)
+				n.threshold = points(m_indices[n.begin], 0);
+			return;
+		}
+
+		//compute the value of every point along the splitting direction
+		std::vector<KeyValuePair<double, std::size_t> > values(n.end - n.begin);
+		if(m_rule == KDSplit){
+			n.dimension = widestDimension(n.begin, n.end, points);
+			for(std::size_t i = n.begin; i != n.end; ++i)
+				values[i - n.begin] = makeKeyValuePair(points(m_indices[i], n.dimension), m_indices[i]);
+		}else{
+			auto normal = row(m_normals, node);
+			calculateNormal(n.begin, n.end, points, normal);
+			for(std::size_t i = n.begin; i != n.end; ++i)
+				values[i - n.begin] = makeKeyValuePair(inner_prod(normal, row(points, m_indices[i])), m_indices[i]);
+		}
+
+		//partition at the median position and place the threshold between both halves
+		auto median = values.begin() + (mid - n.begin);
+		std::nth_element(values.begin(), median, values.end());
+		double maximum = std::max_element(values.begin(), median)->key;
+		n.threshold = 0.5 * (maximum + median->key);
+		for(std::size_t i = n.begin; i != n.end; ++i)
+			m_indices[i] = values[i - n.begin].value;
+	}
+
+	std::size_t widestDimension(std::size_t begin, std::size_t end, RealMatrix const& points) const{
+		std::size_t dim = points.size2();
+		RealVector L = row(points, m_indices[begin]);
+		RealVector U = L;
+		for(std::size_t i = begin + 1; i != end; ++i){
+			auto point = row(points, m_indices[i]);
+			for(std::size_t d = 0; d != dim; ++d){
+				L(d) = std::min(L(d), point(d));
+				U(d) = std::max(U(d), point(d));
+			}
+		}
+		std::size_t cutDim = 0;
+		double extent = U(0) - L(0);
+		for(std::size_t d = 1; d != dim; ++d){
+			if(U(d) - L(d) > extent){
+				extent = U(d) - L(d);
+				cutDim = d;
+			}
+		}
+		return cutDim;
+	}
+
+	/// \brief Direction of the longest distance between evenly spaced samples of the points, as in the LCTree.
+	template<class Normal>
+	void calculateNormal(std::size_t begin, std::size_t end, RealMatrix const& points, Normal& normal) const{
+		std::size_t const CuttingAccuracy = 25;
+		std::size_t size = end - begin;
+		std::vector<std::size_t> samples;
+		if(size <= CuttingAccuracy){
+			samples.assign(m_indices.begin() + begin, m_indices.begin() + end);
+		}else{
+			for(std::size_t i = 0; i != CuttingAccuracy; ++i)
+				samples.push_back(m_indices[begin + size * (2 * i + 1) / (2 * CuttingAccuracy)]);
+		}
+		std::size_t besti = 0;
+		std::size_t bestj = 0;
+		double bestDist2 = -1.0;
+		for(std::size_t i = 1; i != samples.size(); ++i){
+			for(std::size_t j = 0; j != i; ++j){
+				double dist2 = distanceSqr(row(points, samples[i]), row(points, samples[j]));
+				if(dist2 > bestDist2){
+					bestDist2 = dist2;
+					besti = i;
+					bestj = j;
+				}
+			}
+		}
+		double factor = bestDist2 > 0 ? 1.0 / std::sqrt(bestDist2) : 1.0;
+		noalias(normal) = factor * (row(points, samples[besti]) - row(points, samples[bestj]));
+	}
+
+	/// \brief Depth-first search for the k nearest neighbors.
+	///
+	/// bound is a lower bound on the squared distance of the point to the cell of the node.
+	/// For the KDSplit it is the exact distance to the cell, with offsets storing the
+	/// per-dimension distances. For the LinearCutSplit it is the maximum squared distance
+	/// to the planes separating the point from the cell.
+	template<class VectorT>
+	void search(
+		std::size_t node, VectorT const& point, double bound, RealVector& offsets,
+		std::size_t k, std::vector<DistancePair>& heap
+	) const{
+		if(heap.size() == k && bound >= heap.front().key) return;
+		if(isLeaf(node)){
+			for(std::size_t i = m_nodes[node].begin; i != m_nodes[node].end; ++i){
+				double dist2 = distanceSqr(row(m_points, i), point);
+				if(heap.size() < k){
+					heap.push_back(makeKeyValuePair(dist2, m_indices[i]));
+					std::push_heap(heap.begin(), heap.end());
+				}else if(dist2 < heap.front().key){
+					std::pop_heap(heap.begin(), heap.end());
+					heap.back() = makeKeyValuePair(dist2, m_indices[i]);
+					std::push_heap(heap.begin(), heap.end());
+				}
+			}
+			return;
+		}
+		double diff = distanceFromPlane(node, point);
+		std::size_t nearChild = diff < 0 ? left(node) : right(node);
+		std::size_t farChild = diff < 0 ? right(node) : left(node);
+		search(nearChild, point, bound, offsets, k, heap);
+		if(m_rule == KDSplit){
+			std::size_t d = m_nodes[node].dimension;
+			double oldOffset = offsets(d);
+			offsets(d) = diff;
+			search(farChild, point, bound - sqr(oldOffset) + sqr(diff), offsets, k, heap);
+			offsets(d) = oldOffset;
+		}else{
+			search(farChild, point, std::max(bound, sqr(diff)), offsets, k, heap);
+		}
+	}
+
+	SplitRule m_rule;                     ///< splitting rule of the inner nodes
+	std::size_t m_depth;                  ///< depth of the leaves
+	std::vector<Node> m_nodes;            ///< all nodes in breadth-first order
+	RealMatrix m_normals;                 ///< normals of the inner nodes for the LinearCutSplit, one row per node
+	RealMatrix m_points;                  ///< points ordered by the leaves
+	std::vector<std::size_t> m_indices;   ///< dataset index of every row of m_points
+};
+
+
+}
+#endif
@@ -0,0 +1,176 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Additive ensemble of regression trees
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_GRADIENTBOOSTEDTREES_H
+#define SHARK_MODELS_TREES_GRADIENTBOOSTEDTREES_H
+
+#include <shark/Models/Trees/CARTree.h>
+#include <shark/Core/OpenMP.h>
+
+namespace shark {
+
+///
+/// \brief Additive ensemble of regression trees.
+///
+/// \par
+/// The model computes \f$ f(x) = c + \sum_t T_t(x) \f$ where c is a constant offset
+/// and the \f$ T_t \f$ are CARTrees with vector valued leaves, as trained by gradient boosting,
+/// see GradientBoostingTrainer. The outputs are unnormalized scores, a Classifier turns
+/// them into class labels.
+///
+/// \par
+/// A batch is split into blocks of rows which are evaluated in parallel. Every block is passed
+/// through all trees in order, thus the result does not depend on the number of threads.
+///
+class GradientBoostedTrees : public AbstractModel<RealVector, RealVector>
+{
+private:
+	typedef AbstractModel<RealVector, RealVector> base_type;
+public:
+	typedef base_type::BatchInputType BatchInputType;
+	typedef base_type::BatchOutputType BatchOutputType;
+
+	GradientBoostedTrees():m_inputDimension(0){}
+
+	/// \brief Creates an ensemble without trees predicting the offset for every input.
+	GradientBoostedTrees(std::size_t inputDimension, RealVector const& offset)
+	: m_offset(offset), m_inputDimension(inputDimension){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "GradientBoostedTrees"; }
+
+	boost::shared_ptr<State> createState() const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	Shape inputShape() const{
+		return m_inputDimension;
+	}
+	Shape outputShape() const{
+		return m_offset.size();
+	}
+
+	/// \brief The model does not have any parameters.
+	std::size_t numberOfParameters() const{
+		return 0;
+	}
+
+	/// \brief The model does not have any parameters.
+	RealVector parameterVector() const{
+		return RealVector();
+	}
+
+	/// \brief The model does not have any parameters.
+	void setParameterVector(RealVector const& param){
+		SHARK_ASSERT(param.size() == 0);
+	}
+
+	/// \brief Returns the constant added to the output of the trees.
+	RealVector const& offset() const{
+		return m_offset;
+	}
+
+	/// \brief Returns the number of trees.
+	std::size_t numberOfTrees() const{
+		return m_trees.size();
+	}
+
+	/// \brief Returns the tree with the given index.
+	CARTree<RealVector> const& tree(std::size_t index) const{
+		SIZE_CHECK(index < m_trees.size());
+		return m_trees[index];
+	}
+
+	/// \brief Appends a tree to the ensemble.
+	void addTree(CARTree<RealVector> const& tree){
+		m_trees.push_back(tree);
+	}
+
+	/// \brief Removes all but the first numberOfTrees trees.
+	void truncate(std::size_t numberOfTrees){
+		if(numberOfTrees < m_trees.size())
+			m_trees.resize(numberOfTrees);
+	}
+
+	using base_type::eval;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+		std::size_t numPatterns = patterns.size1();
+		outputs.resize(numPatterns, m_offset.size());
+		for(std::size_t i = 0; i != numPatterns; ++i)
+			noalias(row(outputs, i)) = m_offset;
+		if(m_trees.empty())
+			return;
+
+		std::size_t const blockSize = 256;
+		std::size_t numBlocks = (numPatterns + blockSize - 1) / blockSize;
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+			std::size_t start = b * blockSize;
+			std::size_t end = std::min(numPatterns, start + blockSize);
+			RealMatrix block = rows(patterns, start, end);
+			std::vector<std::size_t> leaves;
+			for(auto const& tree: m_trees){
+				tree.evalLeaves(block, leaves);
+				for(std::size_t i = 0; i != leaves.size(); ++i)
+					noalias(row(outputs, start + i)) += tree.getLabel(leaves[i]);
+			}
+		}
+	}
+
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns, outputs);
+	}
+
+	/// from ISerializable, reads a model from an archive
+	void read(InArchive& archive){
+		archive >> m_trees;
+		archive >> m_offset;
+		archive >> m_inputDimension;
+	}
+
+	/// from ISerializable, writes a model to an archive
+	void write(OutArchive& archive) const{
+		archive << m_trees;
+		archive << m_offset;
+		archive << m_inputDimension;
+	}
+
+private:
+	std::vector<CARTree<RealVector> > m_trees; ///< trees of the ensemble
+	RealVector m_offset; ///< constant added to the sum of the trees
+	std::size_t m_inputDimension; ///< dimensionality of the inputs
+};
+
+}
+#endif
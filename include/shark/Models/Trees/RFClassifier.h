@@ -41,6 +41,7 @@
 #include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>        
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark {
 
@@ -50,29 +51,35 @@ template<class LabelType>
 class RFClassifierBase : public MeanModel<CARTree<LabelType> >{
 protected:
 	double doComputeOOBerror(
-		UIntMatrix const& oobPoints, LabeledData<RealVector, RealVector> const& data
+		std::vector<std::vector<std::size_t> > const& oobIndices, LabeledData<RealVector, RealVector> const& data
 	){
+		std::size_t elements = data.numberOfElements();
+		std::size_t labelDim = labelDimension(data);
+		DataView<LabeledData<RealVector, RealVector> const > view(data);
+		//every thread sums up the predictions of its trees, the last column counts the trees
+		std::vector<RealMatrix> sums(SHARK_NUM_THREADS, RealMatrix(elements, labelDim + 1, 0.0));
+		SHARK_PARALLEL_FOR(int m = 0; m < (int)this->numberOfModels(); ++m){
+			if(oobIndices[m].empty()) continue;
+			RealMatrix& sum = sums[SHARK_THREAD_NUM];
+			auto batch = subBatch(view, oobIndices[m]);
+			RealMatrix predictions = this->getModel(m)(batch.input);
+			for(std::size_t i = 0; i != oobIndices[m].size(); ++i){
+				std::size_t elem = oobIndices[m][i];
+				noalias(subrange(row(sum, elem), 0, labelDim)) += row(predictions, i);
+				sum(elem, labelDim) += 1;
+			}
+		}
+		for(std::size_t t = 1; t != sums.size(); ++t)
+			noalias(sums[0]) += sums[t];
+		
 		double OOBerror = 0;
-		//aquire votes for every element
-		RealVector mean(labelDimension(data));
-		RealVector input(inputDimension(data));
 		std::size_t elem = 0;
 		for(auto const& point: data.elements()){
-			noalias(input) = point.input;
-			mean.clear();
-			std::size_t oobModels = 0;
-			for(std::size_t m = 0; m != this->numberOfModels();++m){
-				if(oobPoints(m,elem)){
-					++oobModels;
-					auto const& model = this->getModel(m);
-					noalias(mean) += model(input);
-				}
-			}
-			mean /= oobModels;
+			RealVector mean = subrange(row(sums[0], elem), 0, labelDim) / sums[0](elem, labelDim);
 			OOBerror += 0.5 * norm_sqr(point.label - mean);
 			++elem;
 		}
-		OOBerror /= data.numberOfElements();
+		OOBerror /= elements;
 		return OOBerror;
 	}
 	
@@ -112,27 +119,31 @@ protected:
 	}
 	
 	double doComputeOOBerror(
-		UIntMatrix const& oobPoints, LabeledData<RealVector, unsigned int> const& data
+		std::vector<std::vector<std::size_t> > const& oobIndices, LabeledData<RealVector, unsigned int> const& data
 	){
+		std::size_t elements = data.numberOfElements();
+		DataView<LabeledData<RealVector, unsigned int> const > view(data);
+		//every thread collects the votes of its trees
+		std::vector<RealMatrix> votes(SHARK_NUM_THREADS, RealMatrix(elements, numberOfClasses(data), 0.0));
+		SHARK_PARALLEL_FOR(int m = 0; m < (int)numberOfModels(); ++m){
+			if(oobIndices[m].empty()) continue;
+			RealMatrix& threadVotes = votes[SHARK_THREAD_NUM];
+			auto batch = subBatch(view, oobIndices[m]);
+			UIntVector predictions = getModel(m)(batch.input);
+			for(std::size_t i = 0; i != oobIndices[m].size(); ++i){
+				threadVotes(oobIndices[m][i], predictions(i)) += 1;
+			}
+		}
+		for(std::size_t t = 1; t != votes.size(); ++t)
+			noalias(votes[0]) += votes[t];
+		
 		double OOBerror = 0;
-		//aquire votes for every element
-		RealVector votes(numberOfClasses(data));
-		RealVector input(inputDimension(data));
 		std::size_t elem = 0;
 		for(auto const& point: data.elements()){
-			noalias(input) = point.input;
-			votes.clear();
-			for(std::size_t m = 0; m != numberOfModels();++m){
-				if(oobPoints(m,elem)){
-					auto const& model = getModel(m);
-					unsigned int label = model(input);
-					votes(label) += 1;
-				}
-			}
-			OOBerror += (arg_max(votes) != point.label);
+			OOBerror += (arg_max(row(votes[0], elem)) != point.label);
 			++elem;
 		}
-		OOBerror /= data.numberOfElements();
+		OOBerror /= elements;
 		return OOBerror;
 	}
 };
@@ -181,39 +192,61 @@ public:
 	}
 	
 	/// Compute oob error, given an oob dataset (Classification)
+	///
+	/// The trees are evaluated in parallel, each on the batch of its out-of-bag samples.
 	void computeOOBerror(std::vector<std::vector<std::size_t> > const& oobIndices, LabeledData<RealVector, LabelType> const& data){
-		UIntMatrix oobMatrix(oobIndices.size(), data.numberOfElements(),0);
-		for(std::size_t i = 0; i != oobMatrix.size1(); ++i){
-			for(auto index: oobIndices[i])
-				oobMatrix(i,index) = 1;
-		}
-		m_OOBerror = this->doComputeOOBerror(oobMatrix,data);
+		SIZE_CHECK(oobIndices.size() == this->numberOfModels());
+		m_OOBerror = this->doComputeOOBerror(oobIndices,data);
 	}
 
 	/// Compute feature importances, given an oob dataset
 	///
 	/// For each tree, extracts the out-of-bag-samples indicated by oobIndices. The feature importance is defined
 	/// as the average change of loss (Squared loss or accuracy depending on label type) when the feature is permuted across the oob samples of a tree.
+	///
+	/// The work is split into tasks of one tree and a block of features which are processed in parallel.
+	/// Every feature of every tree is permuted by its own random number generator seeded from rng,
+	/// thus the result does not depend on the number of threads.
 	void computeFeatureImportances(std::vector<std::vector<std::size_t> > const& oobIndices, LabeledData<RealVector, LabelType> const& data, random::rng_type& rng){
+		SIZE_CHECK(oobIndices.size() == this->numberOfModels());
 		std::size_t inputs = inputDimension(data);
-		m_featureImportances.resize(inputs);
+		std::size_t models = this->numberOfModels();
 		DataView<LabeledData<RealVector, LabelType> const > view(data);
 		
-		for(std::size_t m = 0; m != this->numberOfModels();++m){
+		//split the features of every tree into blocks such that there are enough tasks for all threads
+		std::size_t threads = SHARK_NUM_THREADS;
+		std::size_t blocksPerModel = std::max<std::size_t>(1, std::min(inputs, (4 * threads + models - 1) / models));
+		std::size_t blockSize = (inputs + blocksPerModel - 1) / blocksPerModel;
+		blocksPerModel = (inputs + blockSize - 1) / blockSize;
+		std::size_t numTasks = models * blocksPerModel;
+		//one seed per tree and feature
+		std::vector<unsigned int> seeds(models * inputs);
+		for(auto& seed: seeds)
+			seed = (unsigned int) rng();
+		
+		//every task writes the importances of its tree and features into its own part of the matrix
+		RealMatrix importances(models, inputs, 0.0);
+		SHARK_PARALLEL_FOR(int task = 0; task < (int)numTasks; ++task){
+			std::size_t m = task / blocksPerModel;
+			if(oobIndices[m].empty()) continue;
+			std::size_t start = (task % blocksPerModel) * blockSize;
+			std::size_t end = std::min(inputs, start + blockSize);
+			auto const& model = this->getModel(m);
 			auto batch = subBatch(view, oobIndices[m]);
-			double errorBefore = this->loss(batch.label,this->getModel(m)(batch.input));
+			double errorBefore = this->loss(batch.label,model(batch.input));
 			
-			for(std::size_t i=0; i!=inputs;++i) {
+			for(std::size_t i = start; i != end; ++i) {
 				RealVector vOld= column(batch.input,i);
 				RealVector v = vOld;
-				std::shuffle(v.begin(), v.end(), rng);
+				random::rng_type featureRng(seeds[m * inputs + i]);
+				std::shuffle(v.begin(), v.end(), featureRng);
 				noalias(column(batch.input,i)) = v;
-				double errorAfter = this->loss(batch.label,this->getModel(m)(batch.input));
+				double errorAfter = this->loss(batch.label,model(batch.input));
 				noalias(column(batch.input,i)) = vOld;
-				m_featureImportances(i) += (errorAfter - errorBefore) / batch.size();
+				importances(m,i) = (errorAfter - errorBefore) / batch.size();
 			}
 		}
-		m_featureImportances /= this->numberOfModels();
+		m_featureImportances = sum_rows(importances) / models;
 	}
 
 private:
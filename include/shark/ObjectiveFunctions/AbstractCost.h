@@ -89,10 +89,10 @@ public:
 	bool hasFirstDerivative() const{ 
 		return m_features & HAS_FIRST_DERIVATIVE; 
 	}
-	//~ /// returns true when the second parameter derivative is implemented
-	//~ bool hasSecondDerivative() const{ 
-		//~ return m_features & HAS_SECOND_DERIVATIVE; 
-	//~ }
+	/// returns true when the second parameter derivative is implemented
+	bool hasSecondDerivative() const{ 
+		return m_features & HAS_SECOND_DERIVATIVE; 
+	}
 	
 	/// returns true when the cost function is in fact a loss function
 	bool isLossFunction() const{ 
@@ -37,9 +37,13 @@
 #include <shark/Core/INameable.h>
 #include <shark/Core/Exception.h>
 #include <shark/Core/Flags.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/LinAlg/Base.h>
+#include <shark/Data/BatchInterface.h>
 #include <shark/ObjectiveFunctions/AbstractConstraintHandler.h>
 
+#include <atomic>
+
 namespace shark {
 
 /// \brief Super class of all objective functions for optimization and learning.
@@ -64,6 +68,7 @@ namespace shark {
 /// HAS_FIRST_DERIVATIVE: evalDerivative can be called for the FirstOrderDerivative.
 /// The Derivative is defined and as exact as possible;
 /// HAS_SECOND_DERIVATIVE: evalDerivative can be called for the second derivative.
+/// HAS_HESSIAN_VECTOR_PRODUCT: hessianVectorProduct can be called, which does not require to form the Hessian.
 /// IS_CONSTRAINED_FEATURE: The function has constraints and isFeasible might return false;
 /// CAN_PROPOSE_STARTING_POINT: the function can return a possibly randomized starting point;
 /// CAN_PROVIDE_CLOSEST_FEASIBLE: if the function is constrained, closest feasible can be
@@ -74,6 +79,9 @@ namespace shark {
 /// Moreoever, derivatives in the single objective case are RealVectors, while they are 
 /// RealMatrix in the multi-objective case (i.e. the jacobian of the function).
 ///
+/// Populations of points can be evaluated at once using evalBatch. The points of a batch
+/// are evaluated in parallel if the function announces IS_THREAD_SAFE.
+///
 /// Calling the derivatives, proposeStartingPoint or closestFeasible when the flags are not set
 /// will throw an exception.
 /// The features can be queried using the method features() as in
@@ -86,6 +94,10 @@ class AbstractObjectiveFunction :  public INameable{
 public:
 	typedef PointType SearchPointType;
 	typedef ResultT ResultType;
+	/// \brief Type of a set of points, e.g. a RealMatrix storing one point per row.
+	typedef typename Batch<SearchPointType>::type SearchPointBatch;
+	/// \brief Type of the function values of a set of points, e.g. a RealVector in the single objective case.
+	typedef typename Batch<ResultType>::type ResultBatch;
 
 	//if the result type is not an arithmetic type, we assume it is a vector-type->multi objective optimization
 	typedef typename boost::mpl::if_<
@@ -109,7 +121,8 @@ public:
 		HAS_CONSTRAINT_HANDLER           =  32, ///< The constraints are governed by a constraint handler which can be queried by getConstraintHandler()
 		CAN_PROVIDE_CLOSEST_FEASIBLE     = 64,	///< If the function is constrained, the method closestFeasible is implemented and returns a "repaired" solution.
 		IS_THREAD_SAFE     = 128,	///< can eval or evalDerivative be called in parallel?
-		IS_NOISY     = 256	///< The function value is perturbed by some kind of noise
+		IS_NOISY     = 256,	///< The function value is perturbed by some kind of noise
+		HAS_HESSIAN_VECTOR_PRODUCT = 512 ///< The method hessianVectorProduct is implemented.
 	};
 
 	/// This statement declares the member m_features. See Core/Flags.h for details.
@@ -160,10 +173,30 @@ public:
 		return m_features & IS_NOISY;
 	}
 
+	/// \brief Returns whether this function can multiply vectors with its Hessian.
+	bool hasHessianVectorProduct()const{
+		return m_features & HAS_HESSIAN_VECTOR_PRODUCT;
+	}
+
 	/// \brief Default ctor.
-	AbstractObjectiveFunction():m_evaluationCounter(0), mep_rng(&random::globalRng){
+	AbstractObjectiveFunction():m_evaluationCounter(0), m_constraintHandler(nullptr), mep_rng(&random::globalRng){
 	    m_features |=HAS_VALUE;
 	}
+	/// \brief Copy ctor, the evaluation counter is atomic and thus has to be copied explicitly.
+	AbstractObjectiveFunction(AbstractObjectiveFunction const& other)
+	: m_evaluationCounter(other.m_evaluationCounter.load())
+	, m_constraintHandler(other.m_constraintHandler)
+	, mep_rng(other.mep_rng){
+		m_features = other.m_features;
+	}
+	/// \brief Copy assignment, see the copy ctor.
+	AbstractObjectiveFunction& operator=(AbstractObjectiveFunction const& other){
+		m_features = other.m_features;
+		m_evaluationCounter = other.m_evaluationCounter.load();
+		m_constraintHandler = other.m_constraintHandler;
+		mep_rng = other.mep_rng;
+		return *this;
+	}
 	/// \brief Virtual destructor
 	virtual ~AbstractObjectiveFunction() {}
 
@@ -269,6 +302,32 @@ public:
 		SHARK_FEATURE_EXCEPTION(HAS_VALUE);
 	}
 
+	/// \brief Evaluates the objective function for a batch of points.
+	///
+	/// Afterwards the i-th element of results stores the function value of the i-th point of inputs.
+	/// The default implementation calls eval for every point. If the function is thread safe,
+	/// the points are evaluated in parallel.
+	/// \param [in] inputs The points for which the function shall be evaluated.
+	/// \param [out] results The function values of the points.
+	virtual void evalBatch( SearchPointBatch const& inputs, ResultBatch& results )const {
+		std::size_t n = batchSize(inputs);
+		SHARK_RUNTIME_CHECK(n > 0, "Batch of points is empty");
+		//the first evaluation determines the structure of the results
+		ResultType firstResult = eval(getBatchElement(inputs,0));
+		results = Batch<ResultType>::createBatch(firstResult, n);
+		getBatchElement(results,0) = firstResult;
+		if(!isThreadSafe()){
+			for(std::size_t i = 1; i != n; ++i){
+				getBatchElement(results,i) = eval(getBatchElement(inputs,i));
+			}
+			return;
+		}
+		SHARK_PARALLEL_FOR(int i = 1; i < (int)n; ++i){
+			ResultType result = eval(getBatchElement(inputs,i));
+			getBatchElement(results,i) = result;
+		}
+	}
+
 	/// \brief Evaluates the function. Useful together with STL-Algorithms like std::transform.
 	ResultType operator()( SearchPointType const& input ) const {
 		return eval(input);
@@ -294,8 +353,22 @@ public:
 		SHARK_FEATURE_EXCEPTION(HAS_SECOND_DERIVATIVE);
 	}
 
+	/// \brief Computes the product of the Hessian at input with a vector.
+	///
+	/// Second order methods can use this instead of the full Hessian when the number of variables is large.
+	/// Implementations may reuse intermediate results of the last call to evalDerivative, thus
+	/// input should be the point of that call.
+	/// \param [in] input The point at which the Hessian is taken.
+	/// \param [in] v The vector to multiply with the Hessian.
+	/// \param [out] result The product is placed here.
+	/// \throws FeatureNotAvailableException in the default implementation
+	/// and if a function does not support this feature.
+	virtual void hessianVectorProduct( SearchPointType const& input, SearchPointType const& v, SearchPointType& result )const {
+		SHARK_FEATURE_EXCEPTION(HAS_HESSIAN_VECTOR_PRODUCT);
+	}
+
 protected:
-	mutable std::size_t m_evaluationCounter; ///< Evaluation counter, default value: 0.
+	mutable std::atomic<std::size_t> m_evaluationCounter; ///< Evaluation counter, default value: 0. Atomic as thread safe functions may be evaluated concurrently.
 	AbstractConstraintHandler<SearchPointType> const* m_constraintHandler;
 	random::rng_type* mep_rng;
 	
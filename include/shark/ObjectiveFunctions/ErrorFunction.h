@@ -64,29 +64,38 @@ namespace shark{
 /// It automatically infers the input und label type from the given dataset and the output type
 /// of the model in the constructor and ensures that Model and loss match. Thus the user does
 /// not need to provide the types as template parameters. 
-class ErrorFunction : public SingleObjectiveFunction
+///
+/// The template parameter is the type of the parameter vector of the model, e.g. FloatVector
+/// for models with single precision parameters. ErrorFunction is the version for RealVector.
+template<class SearchPointType>
+class ErrorFunctionT : public AbstractObjectiveFunction<SearchPointType,double>
 {
+private:
+	typedef AbstractObjectiveFunction<SearchPointType,double> base_type;
 public:
+	typedef typename base_type::ResultType ResultType;
+	typedef typename base_type::FirstOrderDerivative FirstOrderDerivative;
+
 	template<class InputType, class LabelType, class OutputType>
-	ErrorFunction(
+	ErrorFunctionT(
 		LabeledData<InputType, LabelType> const& dataset,
-		AbstractModel<InputType,OutputType>* model, 
+		AbstractModel<InputType,OutputType,SearchPointType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss,
 		bool useMiniBatches = false
 	);
 	template<class InputType, class LabelType, class OutputType>
-	ErrorFunction(
+	ErrorFunctionT(
 		WeightedLabeledData<InputType, LabelType> const& dataset,
-		AbstractModel<InputType,OutputType>* model, 
+		AbstractModel<InputType,OutputType,SearchPointType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss
 	);
-	ErrorFunction(const ErrorFunction& op);
-	ErrorFunction& operator=(const ErrorFunction& op);
+	ErrorFunctionT(const ErrorFunctionT& op);
+	ErrorFunctionT& operator=(const ErrorFunctionT& op);
 
 	std::string name() const
 	{ return "ErrorFunction"; }
 	
-	void setRegularizer(double factor, SingleObjectiveFunction* regularizer){
+	void setRegularizer(double factor, AbstractObjectiveFunction<SearchPointType,double>* regularizer){
 		m_regularizer = regularizer;
 		m_regularizationStrength = factor;
 	}
@@ -103,17 +112,24 @@ public:
 		mp_wrapper-> init();
 	}
 
-	double eval(RealVector const& input) const;
-	ResultType evalDerivative( const SearchPointType & input, FirstOrderDerivative & derivative ) const;
+	double eval(SearchPointType const& input) const;
+	ResultType evalDerivative( SearchPointType const& input, FirstOrderDerivative & derivative ) const;
 	
-	friend void swap(ErrorFunction& op1, ErrorFunction& op2);
+	friend void swap(ErrorFunctionT& op1, ErrorFunctionT& op2){
+		using std::swap;
+		swap(op1.mp_wrapper,op2.mp_wrapper);
+		swap(op1.m_features,op2.m_features);
+	}
 
 private:
-	boost::scoped_ptr<detail::FunctionWrapperBase > mp_wrapper;
-	SingleObjectiveFunction* m_regularizer;
+	boost::scoped_ptr<detail::FunctionWrapperBase<SearchPointType> > mp_wrapper;
+	AbstractObjectiveFunction<SearchPointType,double>* m_regularizer;
 	double m_regularizationStrength;
 };
 
+/// \brief Error function for models with RealVector parameters.
+typedef ErrorFunctionT<RealVector> ErrorFunction;
+
 }
 #include "Impl/ErrorFunction.inl"
 #endif
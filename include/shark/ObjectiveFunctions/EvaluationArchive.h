@@ -71,6 +71,8 @@ public:
 	typedef AbstractObjectiveFunction<PointType, ResultT> base_type;
 	typedef typename base_type::SearchPointType SearchPointType;
 	typedef typename base_type::ResultType ResultType;
+	typedef typename base_type::SearchPointBatch SearchPointBatch;
+	typedef typename base_type::ResultBatch ResultBatch;
 
 	typedef typename base_type::FirstOrderDerivative FirstOrderDerivative;
 	typedef typename base_type::SecondOrderDerivative SecondOrderDerivative;
@@ -184,6 +186,20 @@ public:
 		return r;
 	}
 
+	/// \brief Wrapper function storing all points and results.
+	///
+	/// The batch is evaluated by the wrapped function, possibly in parallel.
+	/// The archive is updated afterwards in a single thread.
+	void evalBatch(SearchPointBatch const& inputs, ResultBatch& results) const
+	{
+		mep_objective->evalBatch(inputs, results);
+		std::size_t n = batchSize(inputs);
+		base_type::m_evaluationCounter += n;
+		for(std::size_t i = 0; i != n; ++i){
+			m_archive.insert(PointResultPairType(getBatchElement(inputs,i), getBatchElement(results,i)));
+		}
+	}
+
 	// TG: Could someone enlighten me: why do I have to copy this
 	// from the super class to make the compiler find the f**king
 	// operator??
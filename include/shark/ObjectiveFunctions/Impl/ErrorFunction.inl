@@ -29,18 +29,22 @@
 #define SHARK_OBJECTIVEFUNCTIONS_IMPL_ERRORFUNCTION_INL
 
 #include <shark/Core/OpenMP.h>
+#include <shark/Core/Profiler.h>
+#include <shark/LinAlg/ParallelReduction.h>
 
 namespace shark{
 namespace detail{
 
 ///\brief Implementation of the ErrorFunction using AbstractLoss for parallelizable computations
-template<class InputType, class LabelType,class OutputType>
-class ErrorFunctionImpl:public FunctionWrapperBase{
+template<class InputType, class LabelType,class OutputType, class SearchPointType>
+class ErrorFunctionImpl:public FunctionWrapperBase<SearchPointType>{
 public:
+	typedef typename FunctionWrapperBase<SearchPointType>::ResultType ResultType;
+	typedef typename FunctionWrapperBase<SearchPointType>::FirstOrderDerivative FirstOrderDerivative;
 
 	ErrorFunctionImpl(
 		LabeledData<InputType,LabelType> const& dataset,
-		AbstractModel<InputType,OutputType>* model, 
+		AbstractModel<InputType,OutputType,SearchPointType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss,
 		bool useMiniBatches
 	):mep_model(model),mep_loss(loss),m_dataset(dataset), m_useMiniBatches(useMiniBatches){
@@ -48,8 +52,8 @@ public:
 		SHARK_ASSERT(loss!=NULL);
 
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
-			m_features|=HAS_FIRST_DERIVATIVE;
-		m_features|=CAN_PROPOSE_STARTING_POINT;
+			this->m_features|=FunctionWrapperBase<SearchPointType>::HAS_FIRST_DERIVATIVE;
+		this->m_features|=FunctionWrapperBase<SearchPointType>::CAN_PROPOSE_STARTING_POINT;
 	}
 
 	std::string name() const
@@ -63,15 +67,15 @@ public:
 		return mep_model->numberOfParameters();
 	}
 
-	FunctionWrapperBase* clone()const{
-		return new ErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
+	FunctionWrapperBase<SearchPointType>* clone()const{
+		return new ErrorFunctionImpl<InputType,LabelType,OutputType,SearchPointType>(*this);
 	}
 
-	double eval(RealVector const& point) const {
+	double eval(SearchPointType const& point) const {
 		mep_model->setParameterVector(point);
 		//minibatch case
 		if(m_useMiniBatches){
-			std::size_t batchIndex = random::discrete(*mep_rng, std::size_t(0),m_dataset.numberOfBatches()-1);
+			std::size_t batchIndex = random::discrete(*this->mep_rng, std::size_t(0),m_dataset.numberOfBatches()-1);
 			double error = eval(batchIndex,batchIndex+1);
 			return error / shark::batchSize(m_dataset.batch(batchIndex));
 		}
@@ -82,31 +86,30 @@ public:
 		//calculate optimal partitioning
 		std::size_t batchesPerThread = numBatches/numThreads;
 		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
+		std::vector<double> threadErrors(numThreads,0.0);
 		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in parallel loops
 			//get start and end index of batch-range
 			std::size_t t = ti;
 			std::size_t start = t*batchesPerThread+std::min(t,leftOver);
 			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
 			
-			//compute derivative of the range
-			double threadError = eval(start, end);
-			
-			SHARK_CRITICAL_REGION{
-				error +=  threadError;
-			}
+			//compute error of the range
+			threadErrors[t] = eval(start, end);
 		}
+		double error = 0;
+		for(double threadError: threadErrors)
+			error += threadError;
 		return error /  m_dataset.numberOfElements();
 	}
 
 	ResultType evalDerivative(SearchPointType const& point, FirstOrderDerivative & derivative ) const {
 		mep_model->setParameterVector(point);
-		derivative.resize(mep_model->numberOfParameters());
-		derivative.clear();
 		
 		//minibatch case
 		if(m_useMiniBatches){
-			std::size_t batchIndex = random::discrete(*mep_rng, std::size_t(0),m_dataset.numberOfBatches()-1);
+			derivative.resize(mep_model->numberOfParameters());
+			derivative.clear();
+			std::size_t batchIndex = random::discrete(*this->mep_rng, std::size_t(0),m_dataset.numberOfBatches()-1);
 			double error = evalDerivative(batchIndex,batchIndex+1, derivative);
 			
 			auto const& batch = m_dataset.batch(batchIndex);
@@ -121,7 +124,8 @@ public:
 		//calculate optimal partitioning
 		std::size_t batchesPerThread = numBatches/numThreads;
 		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
+		//every thread accumulates into its own buffer, the buffers are summed afterwards
+		m_reduction.init(numThreads, mep_model->numberOfParameters());
 		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in parallel loops
 			//get start and end index of batch-range
 			std::size_t t = ti;
@@ -129,29 +133,25 @@ public:
 			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
 			
 			//compute derivative of the range
-			FirstOrderDerivative threadDerivative(mep_model->numberOfParameters(),0.0);
-			double threadError = evalDerivative(start, end, threadDerivative);
-			
-			SHARK_CRITICAL_REGION{
-				error +=  threadError;
-				noalias(derivative) += threadDerivative;
-			}
+			m_reduction.value(t) = evalDerivative(start, end, m_reduction.buffer(t));
 		}
+		m_reduction.sum(derivative);
 		derivative /= numElements;
-		return error / numElements;
+		return m_reduction.sumOfValues() / numElements;
 	}
 
 protected:
-	AbstractModel<InputType, OutputType>* mep_model;
+	AbstractModel<InputType, OutputType, SearchPointType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
 	LabeledData<InputType, LabelType> m_dataset;
 	bool m_useMiniBatches;
+	mutable ParallelVectorReduction<SearchPointType> m_reduction;///< per-thread gradient buffers reused between calls
 
 	ResultType evalDerivative( std::size_t start, std::size_t end,FirstOrderDerivative& derivative) const {
 		boost::shared_ptr<State> state = mep_model->createState();
 		typename Batch<OutputType>::type predictions;
 		typename Batch<OutputType>::type errorDerivative;
-		RealVector parameterDerivative;
+		SearchPointType parameterDerivative;
 		double errorSum = 0;
 		for(std::size_t i = start; i != end; ++i){
 			auto const& batch = m_dataset.batch(i);
@@ -183,20 +183,22 @@ protected:
 
 
 ///\brief Implementation of the ErrorFunction using AbstractLoss.
-template<class InputType, class LabelType,class OutputType>
-class WeightedErrorFunctionImpl:public FunctionWrapperBase{
+template<class InputType, class LabelType,class OutputType, class SearchPointType>
+class WeightedErrorFunctionImpl:public FunctionWrapperBase<SearchPointType>{
 public:
+	typedef typename FunctionWrapperBase<SearchPointType>::ResultType ResultType;
+	typedef typename FunctionWrapperBase<SearchPointType>::FirstOrderDerivative FirstOrderDerivative;
 	WeightedErrorFunctionImpl(
 		WeightedLabeledData<InputType, LabelType> const& dataset,
-		AbstractModel<InputType,OutputType>* model, 
+		AbstractModel<InputType,OutputType,SearchPointType>* model, 
 		AbstractLoss<LabelType, OutputType>* loss
 	):mep_model(model),mep_loss(loss),m_dataset(dataset){
 		SHARK_ASSERT(model!=NULL);
 		SHARK_ASSERT(loss!=NULL);
 
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
-			m_features|=HAS_FIRST_DERIVATIVE;
-		m_features|=CAN_PROPOSE_STARTING_POINT;
+			this->m_features|=FunctionWrapperBase<SearchPointType>::HAS_FIRST_DERIVATIVE;
+		this->m_features|=FunctionWrapperBase<SearchPointType>::CAN_PROPOSE_STARTING_POINT;
 	}
 
 	std::string name() const
@@ -210,16 +212,17 @@ public:
 		return mep_model->numberOfParameters();
 	}
 
-	FunctionWrapperBase* clone()const{
-		return new WeightedErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
+	FunctionWrapperBase<SearchPointType>* clone()const{
+		return new WeightedErrorFunctionImpl<InputType,LabelType,OutputType,SearchPointType>(*this);
 	}
 
-	double eval(RealVector const& input) const {
+	double eval(SearchPointType const& input) const {
 		mep_model->setParameterVector(input);
 
 		double sumWeights = sumOfWeights(m_dataset);
-		double error = 0.0;
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_dataset.numberOfBatches(); ++i){
+		std::size_t numBatches = m_dataset.numberOfBatches();
+		std::vector<double> batchErrors(numBatches,0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
 			auto const& weights = m_dataset.batch(i).weight;
 			auto const& data = m_dataset.batch(i).data;
 			
@@ -231,112 +234,127 @@ public:
 			for(std::size_t j = 0; j != data.size(); ++j){
 				batchError += weights(j) * mep_loss->eval(getBatchElement(data.label,j), getBatchElement(prediction,j));
 			}
-			SHARK_CRITICAL_REGION{
-				error+= batchError;
-			}
+			batchErrors[i] = batchError;
 		}
+		double error = 0.0;
+		for(double batchError: batchErrors)
+			error += batchError;
 		return error/sumWeights;
 	}
 
 	ResultType evalDerivative( SearchPointType const& point, FirstOrderDerivative& derivative ) const {
 		mep_model->setParameterVector(point);
 		double sumWeights = sumOfWeights(m_dataset);
-		derivative.resize(mep_model->numberOfParameters());
-		derivative.clear();
 		
-		
-		double error = 0.0;
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_dataset.numberOfBatches(); ++i){
-			auto const& weights = m_dataset.batch(i).weight;
-			auto const& data = m_dataset.batch(i).data;
+		std::size_t numBatches = m_dataset.numberOfBatches();
+		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+		//calculate optimal partitioning
+		std::size_t batchesPerThread = numBatches/numThreads;
+		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
+		//every thread accumulates into its own buffer, the buffers are summed afterwards
+		m_reduction.init(numThreads, mep_model->numberOfParameters());
+		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in parallel loops
+			//get start and end index of batch-range
+			std::size_t t = ti;
+			std::size_t start = t*batchesPerThread+std::min(t,leftOver);
+			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
 			
-			// calculate model output for the batch as well as the derivative
+			SearchPointType& threadDerivative = m_reduction.buffer(t);
 			typename Batch<OutputType>::type prediction;
-			boost::shared_ptr<State> state = mep_model->createState();
-			mep_model->eval(data.input, prediction,*state);
-			
-			//compute  weighted loss and its derivative for every element in its batch
-			typename Batch<OutputType>::type errorDerivative(prediction.size1(),prediction.size2());
+			typename Batch<OutputType>::type errorDerivative;
 			OutputType singleDerivative;
-			double batchError = 0.0;
-			for(std::size_t j = 0; j != data.size(); ++j){
-				batchError += weights(j) * mep_loss->evalDerivative(getBatchElement(data.label,j), getBatchElement(prediction,j), singleDerivative);
-				noalias(row(errorDerivative,j) ) = weights(j) * singleDerivative;
-			}
-			
-			//calculate the gradient using the chain rule
-			RealVector dataGradient(mep_model->numberOfParameters());
-			mep_model->weightedParameterDerivative(data.input, prediction, errorDerivative,*state,dataGradient);
-			SHARK_CRITICAL_REGION{
-				derivative += dataGradient;
-				error += batchError;
+			SearchPointType dataGradient;
+			boost::shared_ptr<State> state = mep_model->createState();
+			double threadError = 0.0;
+			for(std::size_t i = start; i != end; ++i){
+				auto const& weights = m_dataset.batch(i).weight;
+				auto const& data = m_dataset.batch(i).data;
+				
+				// calculate model output for the batch as well as the derivative
+				mep_model->eval(data.input, prediction,*state);
+				
+				//compute  weighted loss and its derivative for every element in its batch
+				errorDerivative.resize(prediction.size1(),prediction.size2());
+				for(std::size_t j = 0; j != data.size(); ++j){
+					threadError += weights(j) * mep_loss->evalDerivative(getBatchElement(data.label,j), getBatchElement(prediction,j), singleDerivative);
+					noalias(row(errorDerivative,j) ) = weights(j) * singleDerivative;
+				}
+				
+				//calculate the gradient using the chain rule
+				mep_model->weightedParameterDerivative(data.input, prediction, errorDerivative,*state,dataGradient);
+				noalias(threadDerivative) += dataGradient;
 			}
+			m_reduction.value(t) = threadError;
 		}
-		error /= sumWeights;
+		m_reduction.sum(derivative);
 		derivative /= sumWeights;
-		return error;
+		return m_reduction.sumOfValues() / sumWeights;
 	}
 
 private:
-	AbstractModel<InputType, OutputType>* mep_model;
+	AbstractModel<InputType, OutputType, SearchPointType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
 	WeightedLabeledData<InputType, LabelType> m_dataset;
+	mutable ParallelVectorReduction<SearchPointType> m_reduction;///< per-thread gradient buffers reused between calls
 };
 
 } // namespace detail
 
-
-inline void swap(ErrorFunction& op1, ErrorFunction& op2){
-	using std::swap;
-	swap(op1.mp_wrapper,op2.mp_wrapper);
-	swap(op1.m_features,op2.m_features);
-}
-
+template<class SearchPointType>
 template<class InputType,class LabelType, class OutputType>
-inline ErrorFunction::ErrorFunction(
+inline ErrorFunctionT<SearchPointType>::ErrorFunctionT(
 	LabeledData<InputType, LabelType> const& dataset,
-	AbstractModel<InputType,OutputType>* model, 
+	AbstractModel<InputType,OutputType,SearchPointType>* model, 
 	AbstractLoss<LabelType, OutputType>* loss,
 	bool useMiniBatches
 ){
 	m_regularizer = 0;
-	mp_wrapper.reset(new detail::ErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss, useMiniBatches));
+	mp_wrapper.reset(new detail::ErrorFunctionImpl<InputType,LabelType,OutputType,SearchPointType>(dataset,model,loss, useMiniBatches));
 
 	this -> m_features = mp_wrapper -> features();
 }
 
+template<class SearchPointType>
 template<class InputType,class LabelType, class OutputType>
-inline ErrorFunction::ErrorFunction(
+inline ErrorFunctionT<SearchPointType>::ErrorFunctionT(
 	WeightedLabeledData<InputType, LabelType> const& dataset,
-	AbstractModel<InputType,OutputType>* model, 
+	AbstractModel<InputType,OutputType,SearchPointType>* model, 
 	AbstractLoss<LabelType, OutputType>* loss
 ){
 	m_regularizer = 0;
-	mp_wrapper.reset(new detail::WeightedErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss));
+	mp_wrapper.reset(new detail::WeightedErrorFunctionImpl<InputType,LabelType,OutputType,SearchPointType>(dataset,model,loss));
 	this -> m_features = mp_wrapper -> features();
 }
 
-inline ErrorFunction::ErrorFunction(const ErrorFunction& op)
-:mp_wrapper(op.mp_wrapper->clone()){
+template<class SearchPointType>
+inline ErrorFunctionT<SearchPointType>::ErrorFunctionT(const ErrorFunctionT& op)
+:mp_wrapper(op.mp_wrapper->clone())
+,m_regularizer(op.m_regularizer)
+,m_regularizationStrength(op.m_regularizationStrength){
 	this -> m_features = mp_wrapper -> features();
 }
 
-inline ErrorFunction& ErrorFunction::operator = (const ErrorFunction& op){
-	ErrorFunction copy(op);
+template<class SearchPointType>
+inline ErrorFunctionT<SearchPointType>& ErrorFunctionT<SearchPointType>::operator = (const ErrorFunctionT& op){
+	ErrorFunctionT copy(op);
 	swap(copy.mp_wrapper,mp_wrapper);
 	return *this;
 }
 
-inline double ErrorFunction::eval(RealVector const& input) const{
-	++m_evaluationCounter;
+template<class SearchPointType>
+inline double ErrorFunctionT<SearchPointType>::eval(SearchPointType const& input) const{
+	SHARK_PROFILE_REGION("ErrorFunction::eval");
+	++this->m_evaluationCounter;
 	double value = mp_wrapper -> eval(input);
 	if(m_regularizer)
 		value += m_regularizationStrength * m_regularizer->eval(input);
 	return value;
 }
 
-inline ErrorFunction::ResultType ErrorFunction::evalDerivative( const SearchPointType & input, FirstOrderDerivative & derivative ) const{
-	++m_evaluationCounter;
+template<class SearchPointType>
+inline typename ErrorFunctionT<SearchPointType>::ResultType ErrorFunctionT<SearchPointType>::evalDerivative( SearchPointType const& input, FirstOrderDerivative & derivative ) const{
+	SHARK_PROFILE_REGION("ErrorFunction::evalDerivative");
+	++this->m_evaluationCounter;
 	double value = mp_wrapper -> evalDerivative(input,derivative);
 	if(m_regularizer){
 		FirstOrderDerivative regularizerDerivative;
@@ -36,6 +36,7 @@
 #include <shark/Data/Dataset.h>
 #include <shark/Data/Statistics.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/LinAlg/ParallelReduction.h>
 
 
 namespace shark{
@@ -179,34 +180,36 @@ public:
 		KernelMatrixResults results = evaluateKernelMatrix();
 
 		std::size_t parameters = mep_kernel->numberOfParameters();
-		derivative.resize(parameters);
-		derivative.clear();
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
-			std::size_t startX = 0;
-			for(int j = 0; j != i; ++j){
-				startX+= batchSize(m_data.batch(j));
-			}
-			RealVector threadDerivative(parameters,0.0);
+		//the batches are distributed cyclically as the work of batch i grows with i.
+		//every thread accumulates into its own buffer, the buffers are summed afterwards
+		std::size_t numBatches = m_data.numberOfBatches();
+		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+		m_derivativeReduction.init(numThreads, parameters);
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numThreads; ++t){
+			RealVector& threadDerivative = m_derivativeReduction.buffer(t);
 			RealVector blockDerivative;
 			boost::shared_ptr<State> state = mep_kernel->createState();
 			RealMatrix blockK;//block of the KernelMatrix
-			RealMatrix blockW;//block of the WeightMatrix
-			std::size_t startY = 0;
-			for(int j = 0; j <= i; ++j){
-				mep_kernel->eval(m_data.batch(i).input,m_data.batch(j).input,blockK,*state);
-				mep_kernel->weightedParameterDerivative(
-					m_data.batch(i).input,m_data.batch(j).input,
-					generateDerivativeWeightBlock(i,j,startX,startY,blockK,results),//takes symmetry into account
-					*state,
-					blockDerivative
-				);
-				noalias(threadDerivative) += blockDerivative;
-				startY += batchSize(m_data.batch(j));
-			}
-			SHARK_CRITICAL_REGION{
-				noalias(derivative) += threadDerivative;
+			for(std::size_t i = t; i < numBatches; i += numThreads){
+				std::size_t startX = 0;
+				for(std::size_t j = 0; j != i; ++j){
+					startX+= batchSize(m_data.batch(j));
+				}
+				std::size_t startY = 0;
+				for(std::size_t j = 0; j <= i; ++j){
+					mep_kernel->eval(m_data.batch(i).input,m_data.batch(j).input,blockK,*state);
+					mep_kernel->weightedParameterDerivative(
+						m_data.batch(i).input,m_data.batch(j).input,
+						generateDerivativeWeightBlock(i,j,startX,startY,blockK,results),//takes symmetry into account
+						*state,
+						blockDerivative
+					);
+					noalias(threadDerivative) += blockDerivative;
+					startY += batchSize(m_data.batch(j));
+				}
 			}
 		}
+		m_derivativeReduction.sum(derivative);
 		derivative *= -1;
 		derivative /= m_elements;
 		return -results.error;
@@ -220,6 +223,8 @@ private:
 	std::size_t m_numberOfClasses;                  ///< number of classes
 	std::size_t m_elements;                          ///< number of data points
 	bool m_centering;
+	mutable ParallelVectorReduction<> m_derivativeReduction;///< per-thread gradient buffers reused between calls
+	mutable ParallelVectorReduction<> m_meanReduction;///< per-thread buffers for the row sums of the kernel matrix
 
 	struct KernelMatrixResults{
 		RealVector k;
@@ -359,41 +364,49 @@ private:
 		// where k is the row mean over K and y the row mean over y, mk, my the total means of K and Y
 		// and n the number of elements
 
-		double KK = 0; //stores \langle K,K \rangle
-		double YK = 0; //stores \langle Y,K^c \rangle
-		RealVector k(m_elements,0.0);//stores the row/column means of K
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
-			std::size_t startRow = 0;
-			for(int j = 0; j != i; ++j){
-				startRow+= batchSize(m_data.batch(j));
-			}
-			std::size_t rowSize = batchSize(m_data.batch(i));
+		//every thread accumulates \langle K,K \rangle and the row sums of K in its own buffer,
+		//the batches are distributed cyclically as the work of batch i grows with i.
+		std::size_t numBatches = m_data.numberOfBatches();
+		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+		m_meanReduction.init(numThreads, m_elements);
+		std::vector<double> threadYKs(numThreads,0.0);
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numThreads; ++t){
+			RealVector& threadk = m_meanReduction.buffer(t);
 			double threadKK = 0;
 			double threadYK = 0;
-			RealVector threadk(m_elements,0.0);
-			std::size_t startColumn = 0; //starting column of the current block
-			for(int j = 0; j <= i; ++j){
-				std::size_t columnSize = batchSize(m_data.batch(j));
-				RealMatrix blockK = (*mep_kernel)(m_data.batch(i).input,m_data.batch(j).input);
-				if(i == j){
-					threadKK += frobenius_prod(blockK,blockK);
-					subrange(threadk,startColumn,startColumn+columnSize)+=sum_rows(blockK);//update sum_rows(K)
-					threadYK += updateYK(m_data.batch(i).label,m_data.batch(j).label,blockK);
+			for(std::size_t i = t; i < numBatches; i += numThreads){
+				std::size_t startRow = 0;
+				for(std::size_t j = 0; j != i; ++j){
+					startRow+= batchSize(m_data.batch(j));
 				}
-				else{//use symmetry ok K
-					threadKK += 2.0 * frobenius_prod(blockK,blockK);
-					subrange(threadk,startColumn,startColumn+columnSize)+=sum_rows(blockK);
-					subrange(threadk,startRow,startRow+rowSize)+=sum_columns(blockK);//symmetry: block(j,i)
-					threadYK += 2.0 * updateYK(m_data.batch(i).label,m_data.batch(j).label,blockK);
+				std::size_t rowSize = batchSize(m_data.batch(i));
+				std::size_t startColumn = 0; //starting column of the current block
+				for(std::size_t j = 0; j <= i; ++j){
+					std::size_t columnSize = batchSize(m_data.batch(j));
+					RealMatrix blockK = (*mep_kernel)(m_data.batch(i).input,m_data.batch(j).input);
+					if(i == j){
+						threadKK += frobenius_prod(blockK,blockK);
+						subrange(threadk,startColumn,startColumn+columnSize)+=sum_rows(blockK);//update sum_rows(K)
+						threadYK += updateYK(m_data.batch(i).label,m_data.batch(j).label,blockK);
+					}
+					else{//use symmetry ok K
+						threadKK += 2.0 * frobenius_prod(blockK,blockK);
+						subrange(threadk,startColumn,startColumn+columnSize)+=sum_rows(blockK);
+						subrange(threadk,startRow,startRow+rowSize)+=sum_columns(blockK);//symmetry: block(j,i)
+						threadYK += 2.0 * updateYK(m_data.batch(i).label,m_data.batch(j).label,blockK);
+					}
+					startColumn+=columnSize;
 				}
-				startColumn+=columnSize;
-			}
-			SHARK_CRITICAL_REGION{
-				KK += threadKK;
-				YK +=threadYK;
-				noalias(k) +=threadk;
 			}
+			m_meanReduction.value(t) = threadKK;
+			threadYKs[t] = threadYK;
 		}
+		double KK = m_meanReduction.sumOfValues(); //stores \langle K,K \rangle
+		double YK = 0; //stores \langle Y,K^c \rangle
+		for(double threadYK: threadYKs)
+			YK += threadYK;
+		RealVector k;//stores the row/column means of K
+		m_meanReduction.sum(k);
 		//calculate the error
 		double n = (double)m_elements;
 		k /= n;//means
@@ -0,0 +1,355 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Cross-entropy error of a linear model with cached margins
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_OBJECTIVEFUNCTIONS_LOGISTICREGRESSIONERROR_H
+#define SHARK_OBJECTIVEFUNCTIONS_LOGISTICREGRESSIONERROR_H
+
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/Data/WeightedDataset.h>
+#include <shark/LinAlg/ParallelReduction.h>
+#include <shark/Core/OpenMP.h>
+
+#include <cmath>
+#include <vector>
+
+namespace shark{
+
+/// \brief Regularized cross-entropy error of a linear model, specialized for logistic regression.
+///
+/// For K classes the function computes
+/// \f[ E(W,b) = \frac{1}{\sum_i u_i} \sum_i u_i l(y_i, W x_i + b) + \frac{\lambda_2}{2} \|W\|^2 \f]
+/// where l is the CrossEntropy loss and \f$ u_i \f$ are the weights of the points (1 without weights).
+/// For two classes, a single output is used. The search point has the layout of the parameter vector
+/// of the LinearModel, that is the rows of W followed by b, thus this is the same function as an ErrorFunction
+/// of a LinearModel with the CrossEntropy loss and a TwoNormRegularizer masking the offset.
+///
+/// In contrast to the ErrorFunction, the margins \f$ W x_i + b \f$ are cached. When the function is evaluated at
+/// a point \f$ w + t d \f$ of the line through the last point w of evalDerivative and the last
+/// evaluated point, the margins are updated as \f$ X(w + t d) = Xw + t Xd \f$. Thus all trials of a line search, after
+/// the first one, and the evaluation of the derivative at the accepted point only cost O(nK) instead of
+/// a product with the data. The Hessian is never formed, hessianVectorProduct reuses the probabilities
+/// of the last call to evalDerivative, which makes the function suitable for the Hessian-free TrustRegionNewton.
+///
+/// Products with the data are computed in parallel over the batches of the dataset. Because of the cache, the
+/// function must not be evaluated from several threads at the same time.
+template<class InputVectorType = RealVector>
+class LogisticRegressionError : public SingleObjectiveFunction{
+public:
+	typedef typename Batch<InputVectorType>::type BatchInputType;
+
+	/// \brief Constructor.
+	///
+	/// \param dataset the training data
+	/// \param bias whether the linear model has an offset
+	/// \param lambda2 strength of the two-norm regularization of W
+	LogisticRegressionError(LabeledData<InputVectorType, unsigned int> const& dataset, bool bias = true, double lambda2 = 0.0)
+	: m_inputs(dataset.inputs()), m_labels(dataset.labels()), m_sumOfWeights(dataset.numberOfElements()){
+		for(std::size_t i = 0; i != m_labels.numberOfBatches(); ++i)
+			m_weights.push_back(RealVector(m_labels.batch(i).size(), 1.0));
+		setup(numberOfClasses(dataset), bias, lambda2);
+	}
+
+	/// \brief Constructor for weighted data.
+	///
+	/// \param dataset the training data
+	/// \param bias whether the linear model has an offset
+	/// \param lambda2 strength of the two-norm regularization of W
+	LogisticRegressionError(WeightedLabeledData<InputVectorType, unsigned int> const& dataset, bool bias = true, double lambda2 = 0.0)
+	: m_inputs(dataset.inputs()), m_labels(dataset.labels()), m_sumOfWeights(sumOfWeights(dataset)){
+		for(std::size_t i = 0; i != m_labels.numberOfBatches(); ++i)
+			m_weights.push_back(dataset.weights().batch(i));
+		setup(numberOfClasses(dataset), bias, lambda2);
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "LogisticRegressionError"; }
+
+	std::size_t numberOfVariables()const{
+		return m_numOutputs * m_inputDim + (m_bias? m_numOutputs: 0);
+	}
+
+	/// \brief Number of outputs of the linear model, 1 for binary problems.
+	std::size_t numberOfOutputs()const{
+		return m_numOutputs;
+	}
+
+	SearchPointType proposeStartingPoint()const{
+		return SearchPointType(numberOfVariables(), 0.0);
+	}
+
+	double eval(SearchPointType const& point)const{
+		SIZE_CHECK(point.size() == numberOfVariables());
+		++m_evaluationCounter;
+		std::vector<RealMatrix> const& margins = marginsAt(point);
+		std::size_t numBatches = margins.size();
+		std::vector<double> batchErrors(numBatches, 0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
+			batchErrors[i] = batchError(i, margins[i], nullptr);
+		}
+		double error = 0.0;
+		for(double e: batchErrors)
+			error += e;
+		return error / m_sumOfWeights + regularization(point);
+	}
+
+	double evalDerivative(SearchPointType const& point, FirstOrderDerivative& derivative)const{
+		SIZE_CHECK(point.size() == numberOfVariables());
+		++m_evaluationCounter;
+		std::vector<RealMatrix> const& margins = marginsAt(point);
+		moveAnchor(point, margins);
+
+		//gradient of the loss w.r.t. the margins and the curvature for hessianVectorProduct
+		std::size_t numBatches = m_margins.size();
+		m_curvature.resize(numBatches);
+		std::vector<RealMatrix> coefficients(numBatches);
+		std::vector<double> batchErrors(numBatches, 0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
+			batchErrors[i] = batchError(i, m_margins[i], &coefficients[i]);
+		}
+		m_curvaturePoint = point;
+
+		transposedProduct(coefficients, derivative);
+		derivative /= m_sumOfWeights;
+		std::size_t matrixParams = m_numOutputs * m_inputDim;
+		noalias(subrange(derivative, 0, matrixParams)) += m_lambda2 * subrange(point, 0, matrixParams);
+
+		double error = 0.0;
+		for(double e: batchErrors)
+			error += e;
+		return error / m_sumOfWeights + regularization(point);
+	}
+
+	/// \brief Computes the product of the Hessian at point with v.
+	///
+	/// Costs two products with the data. The curvature is taken from the last call to evalDerivative,
+	/// which is repeated if it was made at another point.
+	void hessianVectorProduct(SearchPointType const& point, SearchPointType const& v, SearchPointType& result)const{
+		SIZE_CHECK(point.size() == numberOfVariables());
+		SIZE_CHECK(v.size() == numberOfVariables());
+		if(m_curvaturePoint.size() != point.size() || norm_inf(m_curvaturePoint - point) != 0){
+			FirstOrderDerivative derivative;
+			evalDerivative(point, derivative);
+		}
+		std::size_t numBatches = m_curvature.size();
+		std::vector<RealMatrix> products(numBatches);
+		computeMargins(v, products);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
+			RealMatrix& A = products[i];
+			RealMatrix const& curvature = m_curvature[i];
+			for(std::size_t j = 0; j != A.size1(); ++j){
+				if(m_numOutputs == 1){
+					A(j, 0) *= curvature(j, 0);
+				}else{
+					//(diag(p) - pp^T) a, scaled by the weight
+					double pa = inner_prod(row(curvature, j), row(A, j));
+					for(std::size_t k = 0; k != m_numOutputs; ++k)
+						A(j, k) = m_weights[i](j) * curvature(j, k) * (A(j, k) - pa);
+				}
+			}
+		}
+		transposedProduct(products, result);
+		result /= m_sumOfWeights;
+		std::size_t matrixParams = m_numOutputs * m_inputDim;
+		noalias(subrange(result, 0, matrixParams)) += m_lambda2 * subrange(v, 0, matrixParams);
+	}
+
+private:
+	void setup(std::size_t numClasses, bool bias, double lambda2){
+		SHARK_RUNTIME_CHECK(numClasses >= 2, "[LogisticRegressionError] At least two classes are needed");
+		SHARK_RUNTIME_CHECK(lambda2 >= 0, "[LogisticRegressionError] lambda2 must be non-negative");
+		m_numOutputs = numClasses == 2? 1: numClasses;
+		m_inputDim = dataDimension(m_inputs);
+		m_bias = bias;
+		m_lambda2 = lambda2;
+		m_features |= HAS_FIRST_DERIVATIVE;
+		m_features |= HAS_HESSIAN_VECTOR_PRODUCT;
+		m_features |= CAN_PROPOSE_STARTING_POINT;
+	}
+
+	double regularization(SearchPointType const& point)const{
+		return 0.5 * m_lambda2 * norm_sqr(subrange(point, 0, m_numOutputs * m_inputDim));
+	}
+
+	/// \brief Computes XW^T + b for all batches, where W and b are stored in point.
+	void computeMargins(SearchPointType const& point, std::vector<RealMatrix>& margins)const{
+		std::size_t matrixParams = m_numOutputs * m_inputDim;
+		auto W = blas::to_matrix(subrange(point, 0, matrixParams), m_numOutputs, m_inputDim);
+		std::size_t numBatches = m_inputs.numberOfBatches();
+		margins.resize(numBatches);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
+			BatchInputType const& X = m_inputs.batch(i);
+			margins[i].resize(X.size1(), m_numOutputs);
+			noalias(margins[i]) = X % trans(W);
+			if(m_bias)
+				noalias(margins[i]) += repeat(subrange(point, matrixParams, matrixParams + m_numOutputs), X.size1());
+		}
+	}
+
+	/// \brief Computes sum_i c_i x_i^T and the sums of c_i for the offset, in parallel.
+	void transposedProduct(std::vector<RealMatrix> const& coefficients, RealVector& result)const{
+		std::size_t numBatches = coefficients.size();
+		std::size_t numThreads = std::min<std::size_t>(SHARK_NUM_THREADS, numBatches);
+		std::size_t batchesPerThread = numBatches / numThreads;
+		std::size_t leftOver = numBatches - batchesPerThread * numThreads;
+		std::size_t matrixParams = m_numOutputs * m_inputDim;
+		m_reduction.init(numThreads, numberOfVariables());
+		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){
+			std::size_t t = ti;
+			std::size_t start = t * batchesPerThread + std::min(t, leftOver);
+			std::size_t end = (t + 1) * batchesPerThread + std::min(t + 1, leftOver);
+			RealVector& buffer = m_reduction.buffer(t);
+			auto weightGradient = blas::to_matrix(subrange(buffer, 0, matrixParams), m_numOutputs, m_inputDim);
+			for(std::size_t i = start; i != end; ++i){
+				noalias(weightGradient) += trans(coefficients[i]) % m_inputs.batch(i);
+				if(m_bias)
+					noalias(subrange(buffer, matrixParams, matrixParams + m_numOutputs)) += sum_rows(coefficients[i]);
+			}
+		}
+		m_reduction.sum(result);
+	}
+
+	/// \brief Weighted error of batch i. If coefficients is given, stores the weighted derivative w.r.t. the margins and the curvature.
+	double batchError(std::size_t i, RealMatrix const& margins, RealMatrix* coefficients)const{
+		UIntVector const& labels = m_labels.batch(i);
+		RealVector const& weights = m_weights[i];
+		std::size_t n = margins.size1();
+		if(coefficients){
+			coefficients->resize(n, m_numOutputs);
+			m_curvature[i].resize(n, m_numOutputs);
+		}
+		double error = 0.0;
+		for(std::size_t j = 0; j != n; ++j){
+			if(m_numOutputs == 1){
+				double label = 2.0 * labels(j) - 1.0;
+				double z = -label * margins(j, 0);
+				//log(1+exp(z)) in a numerically stable way
+				error += weights(j) * (z > 0? z + std::log1p(std::exp(-z)): std::log1p(std::exp(z)));
+				if(coefficients){
+					double sigmoid = 1.0 / (1.0 + std::exp(-margins(j, 0)));
+					(*coefficients)(j, 0) = weights(j) * (sigmoid - labels(j));
+					m_curvature[i](j, 0) = weights(j) * sigmoid * (1.0 - sigmoid);
+				}
+			}else{
+				auto f = row(margins, j);
+				double maximum = max(f);
+				double logNorm = std::log(sum(exp(f - maximum))) + maximum;
+				error += weights(j) * (logNorm - f(labels(j)));
+				if(coefficients){
+					auto p = row(m_curvature[i], j);
+					noalias(p) = exp(f - logNorm);
+					auto c = row(*coefficients, j);
+					noalias(c) = weights(j) * p;
+					c(labels(j)) -= weights(j);
+				}
+			}
+		}
+		return error;
+	}
+
+	/// \brief Returns the margins of point, using the cached line if possible.
+	std::vector<RealMatrix> const& marginsAt(SearchPointType const& point)const{
+		if(m_anchor.size() != point.size()){
+			m_anchor = point;
+			computeMargins(point, m_margins);
+			m_hasDirection = false;
+			m_anchorMoves = 0;
+			return m_margins;
+		}
+		RealVector difference = point - m_anchor;
+		double differenceNorm = norm_inf(difference);
+		if(differenceNorm == 0)
+			return m_margins;
+
+		//is the point on the line through the anchor along the cached direction?
+		double t = 1.0;
+		bool onLine = false;
+		if(m_hasDirection){
+			t = inner_prod(difference, m_direction) / norm_sqr(m_direction);
+			double tolerance = 1.e-12 * std::max(differenceNorm, norm_inf(m_anchor));
+			onLine = norm_inf(difference - t * m_direction) <= tolerance;
+		}
+		if(!onLine){
+			m_direction = difference;
+			computeMargins(difference, m_directionMargins);
+			m_hasDirection = true;
+			t = 1.0;
+		}
+		std::size_t numBatches = m_margins.size();
+		m_trialMargins.resize(numBatches);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; ++i){
+			m_trialMargins[i].resize(m_margins[i].size1(), m_margins[i].size2());
+			noalias(m_trialMargins[i]) = m_margins[i] + t * m_directionMargins[i];
+		}
+		return m_trialMargins;
+	}
+
+	/// \brief Makes point the new anchor of the cache.
+	///
+	/// The cached direction stays valid as the margins are linear in the point. To avoid
+	/// accumulating rounding errors, the margins are recomputed from scratch from time to time.
+	void moveAnchor(SearchPointType const& point, std::vector<RealMatrix> const& margins)const{
+		if(&margins == &m_margins) return;
+		noalias(m_anchor) = point;
+		++m_anchorMoves;
+		if(m_anchorMoves % 50 == 0)
+			computeMargins(point, m_margins);
+		else
+			swap(m_margins, m_trialMargins);
+	}
+
+	UnlabeledData<InputVectorType> m_inputs;
+	Data<unsigned int> m_labels;
+	std::vector<RealVector> m_weights;
+	double m_sumOfWeights;
+	std::size_t m_numOutputs;
+	std::size_t m_inputDim;
+	bool m_bias;
+	double m_lambda2;
+
+	//cache of the margins, see marginsAt
+	mutable RealVector m_anchor;                      ///< point of the cached margins
+	mutable std::vector<RealMatrix> m_margins;        ///< margins of the anchor, one matrix per batch
+	mutable bool m_hasDirection = false;
+	mutable RealVector m_direction;                   ///< direction of the cached line
+	mutable std::vector<RealMatrix> m_directionMargins;///< product of the data with the direction
+	mutable std::vector<RealMatrix> m_trialMargins;   ///< margins of the last point on the line
+	mutable std::size_t m_anchorMoves = 0;
+
+	mutable RealVector m_curvaturePoint;              ///< point of the last call to evalDerivative
+	mutable std::vector<RealMatrix> m_curvature;      ///< sigmoid derivative (binary) or probabilities (multi-class)
+	mutable ParallelVectorReduction<> m_reduction;    ///< per-thread gradient buffers reused between calls
+};
+
+}
+#endif
@@ -39,7 +39,7 @@
 #include <shark/Algorithms/QP/SvmProblems.h>
 #include <shark/LinAlg/CachedMatrix.h>
 #include <shark/LinAlg/KernelMatrix.h>
-#include <shark/Models/Kernels/KernelExpansion.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark {
 
@@ -89,101 +89,94 @@ public:
 
 		double C = params.back();
 		mep_kernel->setParameterVector(subrange(params,0,params.size() - 1));
-		
-		ZeroOneLoss<unsigned int, RealVector> loss;
 
 		// prepare the quadratic program
-		typedef KernelMatrix<InputType, QpFloatType> KernelMatrixType;
-		typedef CachedMatrix< KernelMatrixType > CachedMatrixType;
-		typedef CSVMProblem<CachedMatrixType> SVMProblemType;
 		KernelMatrixType km(*mep_kernel, mep_dataset->inputs());
 		CachedMatrixType matrix(&km);
-		SVMProblemType svmProblem(matrix,mep_dataset->labels(),C);
-		std::size_t ell = km.size();
-		
-		//QpStoppingCondition stop;
 
 		if (m_withOffset)
+			return looError<SvmProblem>(matrix, C, stop);//with equality constraint
+		else
+			return looError<BoxConstrainedProblem>(matrix, C, stop);
+	}
+
+private:
+	typedef KernelMatrix<InputType, QpFloatType> KernelMatrixType;
+	typedef CachedMatrix< KernelMatrixType > CachedMatrixType;
+	typedef SharedCachedMatrix< KernelMatrixType > SharedMatrixType;
+
+	/// \brief Computes the leave-one-out error using quadratic programs of type Problem.
+	///
+	/// The full problem is solved first. Then each support vector is removed in turn,
+	/// always starting from the full solution, thus the result does not depend on the
+	/// order in which the support vectors are processed. The support vectors are split
+	/// between threads, each solving its own copy of the problem, while all share the kernel cache.
+	/// The prediction for the removed example is read off the gradient, which holds the
+	/// kernel expansion evaluated at all training examples.
+	template<template<class> class Problem>
+	double looError(CachedMatrixType& matrix, double C, QpStoppingCondition const& stop){
+		std::size_t ell = matrix.size();
+
+		// solve the full problem
+		RealVector alphaFull;
+		RealVector gradientFull(ell);
 		{
-			// solve the full problem with equality constraint and activated shrinking
-			typedef SvmProblem<SVMProblemType> ProblemType;
+			typedef CSVMProblem<CachedMatrixType> SVMProblemType;
+			typedef Problem<SVMProblemType> ProblemType;
+			SVMProblemType svmProblem(matrix,mep_dataset->labels(),C);
 			ProblemType problem(svmProblem);
 			QpSolver< ProblemType > solver(problem);
-			solver.solve(stop);
-			RealVector alphaFull(problem.dimensions());
-			for(std::size_t i = 0; i != problem.dimensions(); ++i){
-				alphaFull(i) = problem.alpha(i);
+			QpStoppingCondition fullStop = stop;
+			solver.solve(fullStop);
+			alphaFull = problem.getUnpermutedAlpha();
+			for(std::size_t i = 0; i != ell; ++i){
+				gradientFull(problem.permutation(i)) = problem.gradient(i);
 			}
-			KernelExpansion<InputType> svm(mep_kernel,mep_dataset->inputs(),true);
+		}
 
-			// leave-one-out
-			//problem.setShrinking(false);
-			double mistakes = 0;
-			for (std::size_t i=0; i<ell; i++)
-			{
-				// use sparseness of the solution:
-				if (alphaFull(i) == 0.0) continue;
-				problem.deactivateVariable(i);
-				
-				// solve the reduced problem
-				solver.solve(stop);
-
-				// predict using the previously removed example.
-				// we need to take into account that the initial problem is solved
-				// with shrinking and we thus need to get the initial permutation 
-				// for the element index and the unpermuted alpha for the svm
-				column(svm.alpha(),0)= problem.getUnpermutedAlpha();
-				svm.offset(0) = computeBias(problem);
-				std::size_t elementIndex = i;//svmProblem.permutation[i];
-				unsigned int target = mep_dataset->element(elementIndex).label;
-				mistakes += loss(target, svm(mep_dataset->element(elementIndex).input));
-				
-				problem.activateVariable(i);
-			}
-			return mistakes / (double)ell;
+		// use sparseness of the solution: only support vectors can be mispredicted
+		std::vector<std::size_t> supportVectors;
+		for (std::size_t i=0; i<ell; i++){
+			if (alphaFull(i) != 0.0)
+				supportVectors.push_back(i);
 		}
-		else
-		{
-			// solve the full problem without equality constraint and activated shrinking
-			typedef BoxConstrainedProblem<SVMProblemType> ProblemType;
+
+		// leave-one-out
+		std::size_t numThreads = std::min(SHARK_NUM_THREADS, supportVectors.size());
+		std::vector<std::size_t> mistakes(numThreads, 0);
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numThreads; ++t){
+			typedef CSVMProblem<SharedMatrixType> SVMProblemType;
+			typedef Problem<SVMProblemType> ProblemType;
+			SharedMatrixType threadMatrix(&matrix);
+			SVMProblemType svmProblem(threadMatrix,mep_dataset->labels(),C);
 			ProblemType problem(svmProblem);
 			QpSolver< ProblemType > solver(problem);
-			solver.solve(stop);
-			RealVector alphaFull(problem.dimensions());
-			for(std::size_t i = 0; i != problem.dimensions(); ++i){
-				alphaFull(i) = problem.alpha(i);
-			}
-			KernelExpansion<InputType> svm(mep_kernel,mep_dataset->inputs(),false);
-			
-			// leave-one-out
-			//problem.setShrinking(false);
-			double mistakes = 0;
-			for (std::size_t i=0; i<ell; i++)
-			{
-				// use sparseness of the solution:
-				if (alphaFull(i) == 0.0) continue;
+			QpStoppingCondition threadStop = stop;
+			for (std::size_t k = t; k < supportVectors.size(); k += numThreads){
+				std::size_t i = supportVectors[k];
+				problem.setInitialSolution(alphaFull, gradientFull);
 				problem.deactivateVariable(i);
-				
 
 				// solve the reduced problem
-				solver.solve(stop);
+				solver.solve(threadStop);
 
-				// predict using the previously removed example.
-				// we need to take into account that the initial problem is solved
-				// with shrinking and we thus need to get the initial permutation 
-				// for the element index and the unpermuted alpha for the svm
-				column(svm.alpha(),0)= problem.getUnpermutedAlpha();
-				std::size_t elementIndex = i;//svmProblem.permutation[i];
-				unsigned int target = mep_dataset->element(elementIndex).label;
-				mistakes += loss(target, svm(mep_dataset->element(elementIndex).input));
+				// predict the removed example. Its alpha is zero, thus
+				// linear(i) - gradient(i) is the kernel expansion without offset.
+				double prediction = problem.linear(i) - problem.gradient(i);
+				if (m_withOffset)
+					prediction += computeBias(problem);
+				if ((prediction > 0.0) != (problem.linear(i) > 0.0))
+					mistakes[t]++;
 
 				problem.activateVariable(i);
 			}
-			return mistakes / (double)ell;
 		}
+		std::size_t totalMistakes = 0;
+		for (std::size_t t = 0; t != numThreads; ++t)
+			totalMistakes += mistakes[t];
+		return totalMistakes / (double)ell;
 	}
 
-private:
 	/// Compute the SVM offset term (b).
 	template<class Problem>
 	double computeBias(Problem const& problem){
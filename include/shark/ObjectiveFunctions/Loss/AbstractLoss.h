@@ -139,6 +139,27 @@ public:
 		return 0.0;  // dead code, prevent warning
 	}
 
+	/// \brief evaluate the loss, the derivative and the diagonal of the hessian w.r.t. the prediction
+	///
+	/// \par
+	/// The i-th row of hessianDiagonal holds the second derivatives of the loss of the i-th point
+	/// w.r.t. the components of its prediction.
+	/// The default implementations throws an exception.
+	/// If you overwrite this method and the one for a single point, don't forget to set
+	/// the flag HAS_SECOND_DERIVATIVE.
+	/// \param  target      target values
+	/// \param  prediction  predictions, typically made by a model
+	/// \param  gradient    the gradient of the loss function with respect to the predictions
+	/// \param  hessianDiagonal the diagonal of the hessian of the loss function with respect to the predictions
+	virtual double evalDerivative(
+		BatchLabelType const& target, BatchOutputType const& prediction,
+		BatchOutputType& gradient, BatchOutputType& hessianDiagonal
+	) const
+	{
+		SHARK_FEATURE_EXCEPTION_DERIVED(HAS_SECOND_DERIVATIVE);
+		return 0.0;  // dead code, prevent warning
+	}
+
 	//~ /// \brief evaluate the loss and fist and second derivative w.r.t. the prediction
 	//~ ///
 	//~ /// \par
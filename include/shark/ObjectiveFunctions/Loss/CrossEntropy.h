@@ -63,10 +63,15 @@ namespace shark{
  * The class labels must be integers starting from 0. Also for theoretical reasons, the output neurons of a neural
  *  Network must be linear.
  */
-class CrossEntropy : public AbstractLoss<unsigned int,RealVector>
+template<class VectorType>
+class CrossEntropyT : public AbstractLoss<unsigned int,VectorType>
 {
 private:
-	typedef AbstractLoss<unsigned int,RealVector> base_type;
+	typedef AbstractLoss<unsigned int,VectorType> base_type;
+	typedef typename base_type::ConstLabelReference ConstLabelReference;
+	typedef typename base_type::ConstOutputReference ConstOutputReference;
+	typedef typename base_type::BatchOutputType BatchOutputType;
+	typedef typename base_type::MatrixType MatrixType;
 
 	//uses different formula to compute the binary case for 1 output.
 	//should be numerically more stable
@@ -81,10 +86,10 @@ private:
 		return std::log(1+exponential);
 	}
 public:
-	CrossEntropy()
+	CrossEntropyT()
 	{
-		m_features |= HAS_FIRST_DERIVATIVE;
-		//~ m_features |= HAS_SECOND_DERIVATIVE;
+		this->m_features |= base_type::HAS_FIRST_DERIVATIVE;
+		this->m_features |= base_type::HAS_SECOND_DERIVATIVE;
 	}
 
 
@@ -95,7 +100,7 @@ public:
 	// annoyingness of C++ templates
 	using base_type::eval;
 
-	double eval(UIntVector const& target, RealMatrix const& prediction) const {
+	double eval(UIntVector const& target, BatchOutputType const& prediction) const {
 		double error = 0;
 		for(std::size_t i = 0; i != prediction.size1(); ++i){
 			error += eval(target(i), row(prediction,i));
@@ -123,7 +128,7 @@ public:
 		}
 	}
 
-	double evalDerivative(UIntVector const& target, RealMatrix const& prediction, RealMatrix& gradient) const {
+	double evalDerivative(UIntVector const& target, BatchOutputType const& prediction, BatchOutputType& gradient) const {
 		gradient.resize(prediction.size1(),prediction.size2());
 		if ( prediction.size2() == 1 )
 		{
@@ -158,7 +163,27 @@ public:
 			return error;
 		}
 	}
-	double evalDerivative(ConstLabelReference target, ConstOutputReference prediction, OutputType& gradient) const {
+	/// \brief Computes the derivative and the diagonal of the hessian for a batch of points.
+	///
+	/// In the binary case the second derivative is sigmoid(yx)(1-sigmoid(yx)), otherwise
+	/// the diagonal is p_k(1-p_k) where p are the softmax probabilities.
+	double evalDerivative(
+		UIntVector const& target, BatchOutputType const& prediction,
+		BatchOutputType& gradient, BatchOutputType& hessianDiagonal
+	) const {
+		double error = evalDerivative(target, prediction, gradient);
+		hessianDiagonal.resize(prediction.size1(),prediction.size2());
+		for(std::size_t i = 0; i != prediction.size1(); ++i){
+			for(std::size_t k = 0; k != prediction.size2(); ++k){
+				//recover the probabilities from the gradient, for one output |gradient| = 1-sigmoid(yx)
+				double p = prediction.size2() == 1? std::abs(gradient(i,0)) : gradient(i,k) + (k == target(i));
+				hessianDiagonal(i,k) = p * (1 - p);
+			}
+		}
+		return error;
+	}
+
+	double evalDerivative(ConstLabelReference target, ConstOutputReference prediction, VectorType& gradient) const {
 		gradient.resize(prediction.size());
 		if ( prediction.size() == 1 )
 		{
@@ -187,7 +212,7 @@ public:
 
 	double evalDerivative(
 		ConstLabelReference target, ConstOutputReference prediction,
-		OutputType& gradient,MatrixType & hessian
+		VectorType& gradient,MatrixType & hessian
 	) const {
 		gradient.resize(prediction.size());
 		hessian.resize(prediction.size(),prediction.size());
@@ -218,11 +243,13 @@ public:
 			noalias(diag(hessian)) += gradient;
 			gradient(target) -= 1;
 
-			return std::log(norm) - prediction(target) - maximum;
+			return std::log(norm) - prediction(target) + maximum;
 		}
 	}
 };
 
+/// \brief Cross entropy loss for RealVector outputs.
+typedef CrossEntropyT<RealVector> CrossEntropy;
 
 }
 #endif
@@ -51,11 +51,15 @@ public:
 	typedef AbstractLoss<LabelType,OutputType> base_type;
 	typedef typename base_type::BatchOutputType BatchOutputType;
 	typedef typename base_type::BatchLabelType BatchLabelType;
+	typedef typename base_type::ConstLabelReference ConstLabelReference;
+	typedef typename base_type::ConstOutputReference ConstOutputReference;
+	typedef typename base_type::MatrixType MatrixType;
 
 	/// Constructor.
 	SquaredLoss()
 	{
 		this->m_features|=base_type::HAS_FIRST_DERIVATIVE;
+		this->m_features|=base_type::HAS_SECOND_DERIVATIVE;
 	}
 
 
@@ -84,6 +88,29 @@ public:
 		noalias(gradient) = (prediction - label);
 		return SquaredLoss::eval(label,prediction);
 	}
+
+	/// Evaluate the squared loss, its derivative and the diagonal of its hessian, which is one.
+	double evalDerivative(
+		BatchLabelType const& label, BatchOutputType const& prediction,
+		BatchOutputType& gradient, BatchOutputType& hessianDiagonal
+	) const {
+		hessianDiagonal.resize(prediction.size1(),prediction.size2());
+		noalias(hessianDiagonal) = blas::repeat(1.0, prediction.size1(), prediction.size2());
+		return evalDerivative(label, prediction, gradient);
+	}
+
+	/// Evaluate the squared loss, its derivative and its hessian, the identity, for a single point.
+	double evalDerivative(
+		ConstLabelReference label, ConstOutputReference prediction,
+		OutputType& gradient, MatrixType& hessian
+	) const {
+		gradient.resize(prediction.size());
+		noalias(gradient) = prediction - label;
+		hessian.resize(prediction.size(), prediction.size());
+		hessian.clear();
+		noalias(diag(hessian)) = blas::repeat(1.0, prediction.size());
+		return 0.5 * distanceSqr(prediction,label);
+	}
 };
 
 //specialisation for classification case.
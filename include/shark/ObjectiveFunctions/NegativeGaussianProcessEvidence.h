@@ -114,17 +114,18 @@ public:
 		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
 		RealVector t = column(createBatch<RealVector>(m_dataset.labels().elements()),0);
 
-		blas::cholesky_decomposition<RealMatrix> cholesky(M);
+		//replace M by its lower cholesky factor M=AA^T
+		choleskyFactor(M);
 		
 		//compute the determinant of M using the cholesky factorization M=AA^T:
 		//ln det(M) = 2 trace(ln A)
-		double logDet = 2* trace(log(cholesky.lower_factor()));
+		double logDet = 2* trace(log(M));
 		
 		//we need to compute t^T M^-1 t 
 		//= t^T (AA^T)^-1 t= t^T (A^-T A^-1)=||A^-1 t||^2
 		//so we will first solve the triangular System Az=t
 		//and then compute ||z||^2
-		RealVector z = solve(cholesky.lower_factor(),t,blas::lower(), blas::left());
+		RealVector z = solve(M,t,blas::lower(), blas::left());
 
 		// equation (6.69) on page 311 in the book C.M. Bishop, Pattern Recognition and Machine Learning, Springer, 2006
 		// e = 1/2 \cdot [ -log(det(M)) - t^T M^{-1} t - N log(2 \pi) ]
@@ -158,13 +159,18 @@ public:
 		mep_kernel->setParameterVector(subrange(parameters,0,kp));
 		
 		//generate kernel matrix and label vector
-		RealMatrix M = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
+		//all following computations are done in the memory of W
+		RealMatrix W = calculateRegularizedKernelMatrix(*mep_kernel,m_dataset.inputs(),betaInv);
 		RealVector t = column(createBatch<RealVector>(m_dataset.labels().elements()),0);
 
-		//compute cholesky decomposition of M
-		blas::cholesky_decomposition<RealMatrix> cholesky(M);
-		//we dont need M anymore, so save a lot of memory by freeing the memory of M
-		M=RealMatrix();
+		//compute cholesky decomposition M=AA^T and the determinant of M (see eval for why this works)
+		choleskyFactor(W);
+		double logDetM = 2* trace(log(W));
+		
+		//calculate z = M^-1 t
+		RealVector z = t;
+		z = solve(W,z,blas::lower(), blas::left());
+		z = solve(trans(W),z,blas::upper(), blas::left());
 		
 		// compute derivative w.r.t. kernel parameters
 		//the derivative is defined as:
@@ -177,14 +183,10 @@ public:
 		// dE/da = sum_i sum_j W dM_ij/da
 		//this can be calculated as blockwise derivative.
 		
-		//compute inverse matrix from the cholesky decomposition 
-		RealMatrix W= blas::identity_matrix<double>(N);
-		cholesky.solve(W,blas::left());
-
-		//calculate z = Wt=M^-1 t
-		RealVector z = prod(W,t);
+		//compute inverse matrix from the cholesky factor
+		choleskyInverse(W);
 		
-		// W is already initialized as the inverse of M, so we only need 
+		// W is now the inverse of M, so we only need 
 		// to change the sign and add z. to calculate W fully
 		W*=-1;
 		noalias(W) += outer_prod(z,z);
@@ -208,8 +210,6 @@ public:
 			if(std::abs(derivative(i)) < m_derivativeThresholds(i)) derivative(i) = 0;
 
 		// compute the evidence
-		//compute determinant of M (see eval for why this works)
-		double logDetM = 2* trace(log(cholesky.lower_factor()));
 		double e = 0.5 * (-logDetM - inner_prod(t, z) - N * std::log(2.0 * M_PI));
 		return -e;
 	}
@@ -227,6 +227,55 @@ public:
 		
 
 private:
+	/// \brief Replaces the symmetric positive definite matrix M by its lower cholesky factor.
+	///
+	/// The factorization is computed in place by the blocked cholesky decomposition of the
+	/// linear algebra library. The upper triangle is set to zero.
+	static void choleskyFactor(RealMatrix& M){
+		std::size_t n = M.size1();
+		blas::kernels::potrf<blas::lower>(M);
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = i+1; j != n; ++j)
+				M(i,j) = 0.0;
+		}
+	}
+
+	/// \brief Replaces the lower cholesky factor A of M by the inverse of M.
+	///
+	/// This is done in place in blocks of rows, first A is inverted and then
+	/// the inverse of M = AA^T is computed as A^-T A^-1. Most of the work
+	/// is spent in matrix-matrix products, which run in parallel. This needs
+	/// a third of the operations of solving the system for the identity.
+	static void choleskyInverse(RealMatrix& A){
+		std::size_t n = A.size1();
+		std::size_t const blockSize = 64;
+		
+		//A^-1: the rows of block b are given by -A_bb^-1 A_b,<b (A^-1)_<b and A_bb^-1,
+		//where (A^-1)_<b is the part of A^-1 computed so far.
+		for(std::size_t start = 0; start < n; start += blockSize){
+			std::size_t end = std::min(start + blockSize, n);
+			RealMatrix blockInverse = inv(subrange(A,start,end,start,end), blas::lower());
+			if(start != 0){
+				//both inverses are lower triangular, the first product is computed transposed
+				RealMatrix rowBlockT = blas::triangular_prod<blas::upper>(trans(subrange(A,0,start,0,start)),trans(subrange(A,start,end,0,start)));
+				noalias(subrange(A,start,end,0,start)) = -blas::triangular_prod<blas::lower>(blockInverse,trans(rowBlockT));
+			}
+			noalias(subrange(A,start,end,start,end)) = blockInverse;
+		}
+		
+		//A^-T A^-1: the lower triangle of the rows of block b only depends on the rows of A^-1
+		//starting from b, thus the result can be stored in the rows that are not needed anymore.
+		for(std::size_t start = 0; start < n; start += blockSize){
+			std::size_t end = std::min(start + blockSize, n);
+			RealMatrix rowBlock = prod(trans(subrange(A,start,n,start,end)),subrange(A,start,n,0,end));
+			noalias(subrange(A,start,end,0,end)) = rowBlock;
+		}
+		for(std::size_t i = 0; i != n; ++i){
+			for(std::size_t j = 0; j != i; ++j)
+				A(j,i) = A(i,j);
+		}
+	}
+
 	/// pointer to external data set
 	DatasetType m_dataset;
 
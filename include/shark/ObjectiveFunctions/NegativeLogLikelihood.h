@@ -35,6 +35,7 @@
 #include <shark/Models/AbstractModel.h>
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 #include <shark/Core/Random.h>
+#include <shark/LinAlg/ParallelReduction.h>
 
 #include <boost/range/algorithm_ext/iota.hpp>
 #include <boost/range/algorithm/random_shuffle.hpp>
@@ -83,16 +84,16 @@ public:
 		m_evaluationCounter++;
 		mep_model->setParameterVector(input);
 		
-		double error = 0;
 		double minProb = 1e-100;//numerical stability is only guaranteed for lower bounded probabilities
+		std::vector<double> batchErrors(m_data.numberOfBatches(),0.0);
 		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
 			RealMatrix predictions = (*mep_model)(m_data.batch(i));
 			SIZE_CHECK(predictions.size2() == 1);
-			double logLikelihoodOfSamples = sum(log(max(predictions,minProb)));
-			SHARK_CRITICAL_REGION{
-				error += logLikelihoodOfSamples;
-			}
+			batchErrors[i] = sum(log(max(predictions,minProb)));
 		}
+		double error = 0;
+		for(double batchError: batchErrors)
+			error += batchError;
 		error/=m_data.numberOfElements();//compute mean
 		return -error;//negative log likelihood
 	}
@@ -103,8 +104,6 @@ public:
 		SIZE_CHECK(input.size() == numberOfVariables());
 		m_evaluationCounter++;
 		mep_model->setParameterVector(input);
-		derivative.resize(input.size());
-		derivative.clear();
 		
 		//compute partitioning on threads
 		std::size_t numBatches = m_data.numberOfBatches();
@@ -113,8 +112,9 @@ public:
 		//calculate optimal partitioning
 		std::size_t batchesPerThread = numBatches/numThreads;
 		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
 		double minProb = 1e-100;//numerical stability is only guaranteed for lower bounded probabilities
+		//every thread accumulates into its own buffer, the buffers are summed afterwards
+		m_reduction.init(numThreads, input.size());
 		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
 			std::size_t t = ti;
 			//~ //get start and end index of batch-range
@@ -122,7 +122,7 @@ public:
 			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
 			
 			//calculate error and derivative of the current thread
-			FirstOrderDerivative threadDerivative(input.size(),0.0);
+			RealVector& threadDerivative = m_reduction.buffer(t);
 			double threadError = 0;
 			boost::shared_ptr<State> state = mep_model->createState();
 			RealVector batchDerivative;
@@ -143,17 +143,14 @@ public:
 				mep_model->weightedParameterDerivative(
 					m_data.batch(i),predictions, coeffs,*state,batchDerivative
 				);
-				threadDerivative += batchDerivative;
-			}
-			
-			//sum over all threads
-			SHARK_CRITICAL_REGION{
-				error += threadError;
-				noalias(derivative) += threadDerivative;
+				noalias(threadDerivative) += batchDerivative;
 			}
+			m_reduction.value(t) = threadError;
 		}
 		
-		error /= numElements;
+		//sum over all threads
+		m_reduction.sum(derivative);
+		double error = m_reduction.sumOfValues() / numElements;
 		derivative /= numElements;
 		derivative *= -1;
 		return -error;//negative log likelihood
@@ -162,6 +159,7 @@ public:
 private:
 	AbstractModel<RealVector,RealVector>* mep_model;
 	UnlabeledData<RealVector> m_data;
+	mutable ParallelVectorReduction<> m_reduction;///< per-thread gradient buffers reused between calls
 };
 
 }
@@ -0,0 +1,290 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Evidence of a Gaussian process with inducing points for model selection on large datasets.
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_OBJECTIVEFUNCTIONS_NEGATIVESPARSEGAUSSIANPROCESSEVIDENCE_H
+#define SHARK_OBJECTIVEFUNCTIONS_NEGATIVESPARSEGAUSSIANPROCESSEVIDENCE_H
+
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/Models/Kernels/AbstractKernelFunction.h>
+
+#include <shark/LinAlg/Base.h>
+namespace shark {
+
+
+///
+/// \brief Evidence of a Gaussian process with inducing points.
+///
+/// The full Gaussian process evidence (see NegativeGaussianProcessEvidence)
+/// needs time \f$ O(N^3) \f$ and memory \f$ O(N^2) \f$. Given \f$ m \f$ inducing points \f$ Z \f$,
+/// the kernel matrix is replaced by the Nyström approximation
+/// \f[ Q = K_{NZ} K_{ZZ}^{-1} K_{ZN} \f]
+/// and the covariance matrix by \f$ M = Q + \Lambda \f$ with diagonal \f$ \Lambda \f$.
+/// For the FITC approximation (fully independent training conditional) the diagonal
+/// of M is exact, \f$ \Lambda = \mathop{diag}(K - Q) + \beta^{-1} I \f$. Otherwise
+/// \f$ \Lambda = \beta^{-1} I \f$, which is the deterministic training conditional (DTC).
+/// The evidence and its derivative are computed in time \f$ O(N m^2) \f$ and memory
+/// \f$ O(N m) \f$. The inducing points are fixed, good choices are random subsets of the
+/// training data or k-means centers.
+///
+/// For details, please see:
+///
+/// J. Quiñonero-Candela & C.E. Rasmussen, A Unifying View of Sparse Approximate
+/// Gaussian Process Regression, JMLR 6, 2005
+///
+/// E. Snelson & Z. Ghahramani, Sparse Gaussian Processes using Pseudo-inputs, NIPS 18, 2006
+///
+/// The parameters are the kernel parameters followed by the regularization parameter
+/// \f$ \beta^{-1} \f$, encoded as in NegativeGaussianProcessEvidence.
+template<class InputType = RealVector, class OutputType = RealVector, class LabelType = RealVector>
+class NegativeSparseGaussianProcessEvidence : public SingleObjectiveFunction
+{
+public:
+	typedef LabeledData<InputType,LabelType> DatasetType;
+	typedef AbstractKernelFunction<InputType> KernelType;
+
+	/// \param dataset: training data for the Gaussian process
+	/// \param inducingPoints: inputs defining the Nyström approximation of the kernel matrix
+	/// \param kernel: pointer to external kernel function
+	/// \param unconstrained: exponential encoding of regularization parameter for unconstraint optimization
+	/// \param fitc: whether the diagonal of the kernel matrix is corrected (FITC) or not (DTC)
+	NegativeSparseGaussianProcessEvidence(
+		DatasetType const& dataset,
+		Data<InputType> const& inducingPoints,
+		KernelType* kernel,
+		bool unconstrained = false,
+		bool fitc = true
+	): m_dataset(dataset)
+	, m_inducingPoints(createBatch<InputType>(inducingPoints.elements()))
+	, mep_kernel(kernel)
+	, m_unconstrained(unconstrained)
+	, m_fitc(fitc)
+	{
+		if (kernel->hasFirstParameterDerivative()) m_features |= HAS_FIRST_DERIVATIVE;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "NegativeSparseGaussianProcessEvidence"; }
+
+	std::size_t numberOfVariables()const{
+		return 1+ mep_kernel->numberOfParameters();
+	}
+
+	/// Evaluates the negative evidence \f$ 1/2 \cdot [ \log(\det(M)) + t^T M^{-1} t + N \log(2 \pi) ] \f$
+	double eval(const RealVector& parameters) const {
+		m_evaluationCounter++;
+		return evalEvidence(parameters, nullptr);
+	}
+
+	/// Evaluates the negative evidence and its derivative.
+	///
+	/// As for the full Gaussian process, the derivative w.r.t. a kernel parameter p is
+	/// \f$ dE/dp = 1/2 \cdot tr(W dM/dp) \f$ with \f$ W = M^{-1} t t^T M^{-1} - M^{-1} \f$.
+	/// W is never formed. Instead the weights of the derivatives of \f$ K_{ZZ} \f$, \f$ K_{NZ} \f$
+	/// and of the diagonal of K are computed using the matrix inversion lemma.
+	double evalDerivative(const RealVector& parameters, FirstOrderDerivative& derivative) const {
+		m_evaluationCounter++;
+		return evalEvidence(parameters, &derivative);
+	}
+
+private:
+	double evalEvidence(RealVector const& parameters, RealVector* derivative)const{
+		std::size_t N  = m_dataset.numberOfElements();
+		std::size_t m  = batchSize(m_inducingPoints);
+		std::size_t kp = mep_kernel->numberOfParameters();
+		SHARK_ASSERT(1 + kp == parameters.size());
+
+		//set parameters
+		double betaInv = parameters.back();
+		if(m_unconstrained)
+			betaInv = std::exp(betaInv); // for unconstraint optimization
+		mep_kernel->setParameterVector(subrange(parameters,0,kp));
+
+		Data<InputType> const& inputs = m_dataset.inputs();
+		RealVector t = column(createBatch<RealVector>(m_dataset.labels().elements()),0);
+
+		//cholesky factor of K_ZZ. A small jitter keeps it positive definite for close inducing points
+		RealMatrix Kmm = (*mep_kernel)(m_inducingPoints,m_inducingPoints);
+		for(std::size_t i = 0; i != m; ++i)
+			Kmm(i,i) += 1.e-8;
+		blas::cholesky_decomposition<RealMatrix> Lmm(Kmm);
+
+		//V = Lmm^-1 K_ZN, thus Q = V^T V. lambda is the diagonal of Lambda
+		RealMatrix V(m,N);
+		RealVector lambda(N,betaInv);
+		std::size_t start = 0;
+		for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+			std::size_t end = start + batchSize(inputs.batch(b));
+			noalias(columns(V,start,end)) = (*mep_kernel)(m_inducingPoints,inputs.batch(b));
+			if(m_fitc){
+				for(std::size_t i = 0; i != end - start; ++i){
+					auto x = getBatchElement(inputs.batch(b),i);
+					lambda(start + i) += mep_kernel->eval(x,x);
+				}
+			}
+			start = end;
+		}
+		blas::kernels::trsm<blas::lower,blas::left>(Lmm.lower_factor(),V);
+		//lambda is clamped at betaInv against rounding errors, clamped entries do not depend on the kernel
+		std::vector<char> clamped(N,false);
+		if(m_fitc){
+			for(std::size_t i = 0; i != N; ++i){
+				double q = norm_sqr(column(V,i));
+				if(lambda(i) - q > betaInv){
+					lambda(i) -= q;
+				}else{
+					lambda(i) = betaInv;
+					clamped[i] = true;
+				}
+			}
+		}
+
+		//A = I + V Lambda^-1 V^T, then log det(M) = log det(Lambda) + log det(A)
+		RealMatrix A = blas::identity_matrix<double>(m);
+		noalias(A) += prod(V,trans(V / blas::repeat(lambda,m)));
+		blas::cholesky_decomposition<RealMatrix> La(A);
+		double logDetM = sum(log(lambda)) + 2 * trace(log(La.lower_factor()));
+
+		//alpha = M^-1 t = Lambda^-1 (t - V^T A^-1 V Lambda^-1 t)
+		RealVector s = prod(V,t / lambda);
+		La.solve(s,blas::left());
+		RealVector alpha = (t - prod(trans(V),s)) / lambda;
+
+		double e = 0.5 * (-logDetM - inner_prod(t, alpha) - N * std::log(2.0 * M_PI));
+		if(!derivative)
+			return -e;
+
+		// compute derivative. With B = K_ZZ^-1 K_ZN = Lmm^-T V the derivative of M is
+		// dM = dK_NZ B + B^T dK_ZN - B^T dK_ZZ B + dLambda,
+		// where for FITC dLambda = diag(dK - dQ). Let w be the diagonal of W and Wt = W - diag(w) for FITC
+		// and Wt = W otherwise. Then tr(W dM) is the sum of
+		// 2 Wt B^T weighting dK_NZ, -B Wt B^T weighting dK_ZZ and w weighting the diagonal of dK.
+		// For clamped entries of Lambda, dLambda is 0 and their w is neither removed from Wt nor weights dK.
+		// Using M^-1 B^T = Lambda^-1 V^T P with P = A^-1 Lmm^-1 all terms are computed blockwise.
+		RealMatrix LmmInv = inv(Lmm.lower_factor(),blas::lower());
+		RealMatrix P = LmmInv;
+		La.solve(P,blas::left());
+		RealVector Balpha = prod(trans(LmmInv),prod(V,alpha));
+
+		RealVector kernelGradient(kp,0.0);
+		RealVector blockGradient(kp);
+		RealMatrix BwB(m,m,0.0);//B diag(w) B^T restricted to Wt
+		double traceW = 0.0;
+		boost::shared_ptr<State> state = mep_kernel->createState();
+		RealMatrix block;
+		start = 0;
+		for(std::size_t b = 0; b != inputs.numberOfBatches(); ++b){
+			std::size_t end = start + batchSize(inputs.batch(b));
+			auto Vb = columns(V,start,end);
+			auto alphab = subrange(alpha,start,end);
+			auto lambdab = subrange(lambda,start,end);
+
+			//w = alpha^2 - diag(M^-1) with diag(M^-1)= 1/lambda - |La^-1 v_i|^2/lambda^2
+			RealMatrix R = Vb;
+			blas::kernels::trsm<blas::lower,blas::left>(La.lower_factor(),R);
+			RealVector w = sqr(alphab) + (sum_rows(sqr(R)) / lambdab - 1.0) / lambdab;
+			traceW += sum(w);
+			RealVector wt = m_fitc? w : RealVector(end - start, 0.0);
+			for(std::size_t i = 0; i != end - start; ++i){
+				if(clamped[start + i])
+					wt(i) = 0.0;
+			}
+
+			//weights of dK_ZN: 2 (B alpha alpha^T - P^T V Lambda^-1 - B diag(wt))
+			RealMatrix Bb = Vb;
+			blas::kernels::trsm<blas::upper,blas::left>(trans(Lmm.lower_factor()),Bb);
+			RealMatrix G = 2 * outer_prod(Balpha,alphab);
+			noalias(G) -= 2 * prod(trans(P),Vb) / blas::repeat(lambdab,m);
+			noalias(G) -= 2 * Bb * blas::repeat(wt,m);
+			noalias(BwB) += prod(Bb * blas::repeat(wt,m),trans(Bb));
+
+			mep_kernel->eval(m_inducingPoints,inputs.batch(b),block,*state);
+			mep_kernel->weightedParameterDerivative(m_inducingPoints,inputs.batch(b),G,*state,blockGradient);
+			noalias(kernelGradient) += blockGradient;
+
+			if(m_fitc){
+				//only the diagonal of dK is needed, thus the points are handled one by one
+				typename Batch<InputType>::type point = Batch<InputType>::createBatch(getBatchElement(inputs.batch(b),0),1);
+				RealMatrix pointWeight(1,1);
+				for(std::size_t i = 0; i != end - start; ++i){
+					if(clamped[start + i])
+						continue;
+					getBatchElement(point,0) = getBatchElement(inputs.batch(b),i);
+					pointWeight(0,0) = w(i);
+					mep_kernel->eval(point,point,block,*state);
+					mep_kernel->weightedParameterDerivative(point,point,pointWeight,*state,blockGradient);
+					noalias(kernelGradient) += blockGradient;
+				}
+			}
+			start = end;
+		}
+		//weights of dK_ZZ: -(B alpha alpha^T B^T - Lmm^-T (I-A^-1) Lmm^-1 - B diag(wt) B^T)
+		RealMatrix Gmm = prod(trans(LmmInv),LmmInv - P);
+		noalias(Gmm) -= outer_prod(Balpha,Balpha);
+		noalias(Gmm) += BwB;
+		mep_kernel->eval(m_inducingPoints,m_inducingPoints,block,*state);
+		mep_kernel->weightedParameterDerivative(m_inducingPoints,m_inducingPoints,Gmm,*state,blockGradient);
+		noalias(kernelGradient) += blockGradient;
+
+		double betaInvDerivative = 0.5 * traceW;
+		if(m_unconstrained)
+			betaInvDerivative *= betaInv;
+
+		//merge both derivatives and since we return the negative evidence, multiply with -1
+		derivative->resize(1 + kp);
+		noalias(*derivative) = - (0.5 * kernelGradient | betaInvDerivative);
+		return -e;
+	}
+
+	/// training data
+	DatasetType m_dataset;
+
+	/// inducing points in one batch
+	typename Batch<InputType>::type m_inducingPoints;
+
+	/// pointer to external kernel function
+	KernelType* mep_kernel;
+
+	/// Indicates whether log() of the regularization parameter is
+	/// considered. This is useful for unconstraint
+	/// optimization. The default value is false.
+	bool m_unconstrained;
+
+	/// Whether the FITC or the DTC approximation is used.
+	bool m_fitc;
+};
+
+
+}
+#endif
@@ -45,6 +45,9 @@ public:
 	/// second element is the original standard-normally distributed vector drawn
 	/// for sampling purposes.
 	typedef std::pair<RealVector,RealVector> result_type;
+	
+	/// \brief Type of the eigenvalue decomposition used for sampling.
+	typedef blas::symm_eigenvalue_decomposition<RealMatrix> DecompositionType;
 
 	/// \brief Constructor
 	/// \param [in] Sigma covariance matrix
@@ -63,6 +66,8 @@ public:
 	void serialize( Archive & ar, const std::size_t version ) {
 		ar & BOOST_SERIALIZATION_NVP( m_covarianceMatrix );
 		ar & BOOST_SERIALIZATION_NVP( m_decomposition );
+		if(Archive::is_loading::value)
+			updateTransformation();
 	}
 
 	/// \brief Resizes the distribution. Updates both eigenvectors and eigenvalues.
@@ -91,6 +96,20 @@ public:
 		update();
 	}
 
+	/// \brief Accesses the eigenvalue decomposition used for sampling.
+	DecompositionType const& decomposition() const {
+		return m_decomposition;
+	}
+	
+	/// \brief Replaces the eigenvalue decomposition used for sampling without touching the covariance matrix.
+	///
+	/// This allows to compute the decomposition elsewhere, e.g. in a background thread or
+	/// from an older covariance matrix.
+	void setDecomposition(DecompositionType const& decomposition){
+		m_decomposition = decomposition;
+		updateTransformation();
+	}
+
 	/// \brief Accesses an immutable reference to the eigenvectors of the covariance matrix.
 	RealMatrix const& eigenVectors() const {
 		return m_decomposition.Q();
@@ -101,6 +120,11 @@ public:
 		return m_decomposition.D();
 	}
 
+	/// \brief Accesses the matrix \f$ A = Q D^{1/2} \f$ which maps standard normal samples onto samples of the distribution.
+	RealMatrix const& transformation() const {
+		return m_transformation;
+	}
+
 	/// \brief Samples the distribution.
 	template<class randomType>
 	result_type operator()(randomType& rng) const {
@@ -110,18 +134,44 @@ public:
 			z( i ) = random::gauss(rng, 0., 1. );
 		}
 		
-		RealVector result = m_decomposition.Q() % to_diagonal(sqrt(max(eigenValues(),0))) % z;
+		RealVector result = m_transformation % z;
 		return std::make_pair( result, z );
-	}	    
+	}
+
+	/// \brief Draws a batch of samples.
+	///
+	/// The rows of z are filled with standard normally distributed numbers
+	/// and the rows of y are the corresponding samples of the distribution, \f$ y_i = A z_i \f$.
+	/// All samples are transformed with a single matrix-matrix product, which is much faster than
+	/// drawing them one by one for populations of search points.
+	template<class randomType, class Matrix1, class Matrix2>
+	void generate(randomType& rng, Matrix1& y, Matrix2& z, std::size_t samples) const {
+		std::size_t n = m_covarianceMatrix.size1();
+		z.resize(samples, n);
+		y.resize(samples, n);
+		for( std::size_t i = 0; i != samples; i++ ) {
+			for( std::size_t j = 0; j != n; j++ ) {
+				z( i, j ) = random::gauss(rng, 0., 1. );
+			}
+		}
+		noalias(y) = z % trans(m_transformation);
+	}
 
 	/// \brief Calculates the evd of the current covariance matrix.
 	void update() {
 		m_decomposition.decompose(m_covarianceMatrix);
+		updateTransformation();
 	}
 
 private:
+	/// \brief Computes the sampling matrix from the eigenvalue decomposition. Negative eigenvalues are clipped at 0.
+	void updateTransformation(){
+		m_transformation = m_decomposition.Q() % to_diagonal(sqrt(max(eigenValues(),0)));
+	}
+
 	RealMatrix m_covarianceMatrix; ///< Covariance matrix of the mutation distribution.
-	blas::symm_eigenvalue_decomposition<RealMatrix> m_decomposition; /// < Eigenvalue decomposition of the covarianceMatrix
+	DecompositionType m_decomposition; /// < Eigenvalue decomposition of the covarianceMatrix
+	RealMatrix m_transformation; ///< Q D^{1/2}, computed once per decomposition
 };
 
 /// \brief Multivariate normal distribution with zero mean using a cholesky decomposition
@@ -188,6 +238,24 @@ public:
 		noalias(y) = blas::triangular_prod<blas::lower>(m_cholesky.lower_factor(),z);
 	}
 
+	/// \brief Draws a batch of samples.
+	///
+	/// The rows of z are filled with standard normally distributed numbers
+	/// and the rows of y are the corresponding samples of the distribution, \f$ y_i = L z_i \f$.
+	/// All samples are transformed with a single triangular matrix-matrix product.
+	template<class randomType, class Matrix1, class Matrix2>
+	void generate(randomType& rng, Matrix1& y, Matrix2& z, std::size_t samples)const{
+		z.resize(samples, size());
+		y.resize(samples, size());
+		for( std::size_t i = 0; i != samples; i++ ) {
+			for( std::size_t j = 0; j != size(); j++ ) {
+				z( i, j ) = random::gauss(rng, 0, 1 );
+			}
+		}
+		auto yTrans = trans(y);
+		noalias(yTrans) = blas::triangular_prod<blas::lower>(m_cholesky.lower_factor(),trans(z));
+	}
+
 	/// \brief Samples the distribution.
 	///
 	/// Returns a vector pair (y,z) where  y=Lz and, L is the lower cholesky factor and z is a vector
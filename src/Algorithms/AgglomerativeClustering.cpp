@@ -0,0 +1,460 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Agglomerative hierarchical clustering
+ *
+ *
+ *
+ * \author      Shark Development Team
+ * \date        2026
+ *
+ *
+ * \par Copyright 1995-2026 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#define SHARK_COMPILE_DLL
+#include <shark/Algorithms/AgglomerativeClustering.h>
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using namespace shark;
+
+namespace{
+
+/// number of rows and columns of the tiles of the distance matrix
+std::size_t const TileSize = 256;
+
+/// disjoint sets of points
+class UnionFind{
+public:
+	UnionFind(std::size_t n):m_parent(n){
+		std::iota(m_parent.begin(), m_parent.end(), 0);
+	}
+	std::size_t find(std::size_t i){
+		while(m_parent[i] != i){
+			m_parent[i] = m_parent[m_parent[i]];
+			i = m_parent[i];
+		}
+		return i;
+	}
+	/// joins the sets of both roots and returns the new root
+	std::size_t join(std::size_t root1, std::size_t root2){
+		m_parent[root2] = root1;
+		return root1;
+	}
+private:
+	std::vector<std::size_t> m_parent;
+};
+
+/// merge of the clusters containing the points a and b
+struct PointMerge{
+	std::size_t a;
+	std::size_t b;
+	double distance;
+};
+
+RealMatrix dataMatrix(Data<RealVector> const& data){
+	RealMatrix points(data.numberOfElements(), dataDimension(data));
+	std::size_t start = 0;
+	for(auto const& batch: data.batches()){
+		noalias(rows(points, start, start + batch.size1())) = batch;
+		start += batch.size1();
+	}
+	return points;
+}
+
+/// \brief Sorts the merges by distance and numbers the clusters.
+std::vector<ClusterMerge> buildDendrogram(std::size_t n, std::vector<PointMerge> merges){
+	std::stable_sort(merges.begin(), merges.end(), [](PointMerge const& x, PointMerge const& y){
+		return x.distance < y.distance;
+	});
+	UnionFind sets(n);
+	std::vector<std::size_t> clusterId(n);
+	std::iota(clusterId.begin(), clusterId.end(), 0);
+	std::vector<std::size_t> sizes(n, 1);
+	std::vector<ClusterMerge> dendrogram;
+	dendrogram.reserve(merges.size());
+	for(PointMerge const& m: merges){
+		std::size_t rootA = sets.find(m.a);
+		std::size_t rootB = sets.find(m.b);
+		SHARK_ASSERT(rootA != rootB);
+		ClusterMerge merge;
+		merge.left = std::min(clusterId[rootA], clusterId[rootB]);
+		merge.right = std::max(clusterId[rootA], clusterId[rootB]);
+		merge.distance = m.distance;
+		merge.size = sizes[rootA] + sizes[rootB];
+		std::size_t root = sets.join(rootA, rootB);
+		clusterId[root] = n + dendrogram.size();
+		sizes[root] = merge.size;
+		dendrogram.push_back(merge);
+	}
+	return dendrogram;
+}
+
+/// \brief Returns distance and index of the closest active cluster, ties are broken by the smaller index.
+template<class Clusters>
+std::pair<double, std::size_t> nearestActive(Clusters const& clusters, std::vector<std::size_t> const& active, std::size_t a){
+	typedef std::pair<double, std::size_t> Candidate;
+	std::size_t numThreads = active.size() < 4096 ? 1 : std::min<std::size_t>(SHARK_NUM_THREADS, active.size() / 1024);
+	std::vector<Candidate> best(numThreads, Candidate(std::numeric_limits<double>::infinity(), active.size()));
+	SHARK_PARALLEL_FOR(int t = 0; t < (int)numThreads; ++t){
+		std::size_t start = active.size() * t / numThreads;
+		std::size_t end = active.size() * (t + 1) / numThreads;
+		for(std::size_t i = start; i != end; ++i){
+			std::size_t k = active[i];
+			if(k == a) continue;
+			Candidate candidate(clusters.distance(a, k), k);
+			if(candidate < best[t])
+				best[t] = candidate;
+		}
+	}
+	return *std::min_element(best.begin(), best.end());
+}
+
+/// Ward linkage stored as centroids and cluster sizes.
+///
+/// The centroids of the active clusters are kept in consecutive rows, so the distances of a cluster
+/// to all others are computed block by block, with one product of the block of centroids per block.
+class WardClusters{
+public:
+	WardClusters(RealMatrix const& points)
+	: m_centroids(points), m_norms(points.size1()), m_sizes(points.size1(), 1.0)
+	, m_row(points.size1()), m_cluster(points.size1()), m_numRows(points.size1()){
+		std::iota(m_row.begin(), m_row.end(), 0);
+		std::iota(m_cluster.begin(), m_cluster.end(), 0);
+		for(std::size_t i = 0; i != points.size1(); ++i)
+			m_norms(i) = norm_sqr(row(points, i));
+	}
+
+	/// increase of the within-cluster sum of squares when merging both clusters
+	double distance(std::size_t i, std::size_t j)const{
+		return weight(i, j) * distanceSqr(row(m_centroids, m_row[i]), row(m_centroids, m_row[j]));
+	}
+	double height(double distance)const{
+		return std::sqrt(2 * distance);
+	}
+	void merge(std::size_t keep, std::size_t remove, std::vector<std::size_t> const&){
+		double size = m_sizes[keep] + m_sizes[remove];
+		auto centroid = row(m_centroids, m_row[keep]);
+		noalias(centroid) = (m_sizes[keep] / size) * centroid + (m_sizes[remove] / size) * row(m_centroids, m_row[remove]);
+		m_norms(m_row[keep]) = norm_sqr(centroid);
+		m_sizes[keep] = size;
+		//the last row takes the place of the removed cluster
+		std::size_t freed = m_row[remove];
+		std::size_t last = m_numRows - 1;
+		if(freed != last){
+			noalias(row(m_centroids, freed)) = row(m_centroids, last);
+			m_norms(freed) = m_norms(last);
+			m_cluster[freed] = m_cluster[last];
+			m_row[m_cluster[freed]] = freed;
+		}
+		--m_numRows;
+	}
+
+	/// \brief Returns distance and index of the closest other cluster, ties are broken by the smaller index.
+	///
+	/// The distances are first expanded as ||c_a||^2 + ||c_k||^2 - 2 <c_a,c_k> using one matrix-vector product
+	/// per block of centroids. All clusters whose expanded distance is within its rounding error of the smallest
+	/// distance are compared with the exact distance, so the result is the same as comparing all exact distances.
+	std::pair<double, std::size_t> nearest(std::size_t a)const{
+		typedef std::pair<double, std::size_t> Candidate;
+		std::size_t n = m_numRows;
+		std::size_t rowA = m_row[a];
+		RealVector centroid = row(m_centroids, rowA);
+		double normA = m_norms(rowA);
+		double relativeError = 4 * (m_centroids.size2() + 2) * std::numeric_limits<double>::epsilon();
+		std::vector<double>& expanded = m_expanded;
+		std::vector<double>& errors = m_errors;
+		expanded.resize(n);
+		errors.resize(n);
+		std::size_t numThreads = n < 4096 ? 1 : std::min<std::size_t>(SHARK_NUM_THREADS, n / 1024);
+		std::vector<double> upperBounds(numThreads, std::numeric_limits<double>::infinity());
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numThreads; ++t){
+			std::size_t end = n * (t + 1) / numThreads;
+			RealVector products;
+			for(std::size_t start = n * t / numThreads; start < end; start += TileSize){
+				std::size_t tileEnd = std::min(end, start + TileSize);
+				products = prod(rows(m_centroids, start, tileEnd), centroid);
+				for(std::size_t r = start; r != tileEnd; ++r){
+					if(r == rowA) continue;
+					double w = weight(a, m_cluster[r]);
+					expanded[r] = w * std::max(normA + m_norms(r) - 2 * products(r - start), 0.0);
+					errors[r] = w * relativeError * (normA + m_norms(r));
+					upperBounds[t] = std::min(upperBounds[t], expanded[r] + errors[r]);
+				}
+			}
+		}
+		double upperBound = *std::min_element(upperBounds.begin(), upperBounds.end());
+		Candidate best(std::numeric_limits<double>::infinity(), m_sizes.size());
+		for(std::size_t r = 0; r != n; ++r){
+			if(r == rowA || expanded[r] - errors[r] > upperBound) continue;
+			Candidate candidate(distance(a, m_cluster[r]), m_cluster[r]);
+			if(candidate < best)
+				best = candidate;
+		}
+		return best;
+	}
+private:
+	double weight(std::size_t i, std::size_t j)const{
+		return m_sizes[i] * m_sizes[j] / (m_sizes[i] + m_sizes[j]);
+	}
+
+	RealMatrix m_centroids;///< centroids of the active clusters in the rows 0,...,m_numRows-1
+	RealVector m_norms;///< squared norms of the centroids
+	std::vector<double> m_sizes;///< size of every cluster
+	std::vector<std::size_t> m_row;///< row of the centroid of every active cluster
+	std::vector<std::size_t> m_cluster;///< cluster of every row
+	std::size_t m_numRows;
+	mutable std::vector<double> m_expanded;///< workspace of nearest()
+	mutable std::vector<double> m_errors;///< workspace of nearest()
+};
+
+/// \brief Ward linkage computes the distances to all clusters blockwise.
+std::pair<double, std::size_t> nearestActive(WardClusters const& clusters, std::vector<std::size_t> const&, std::size_t a){
+	return clusters.nearest(a);
+}
+
+/// Average linkage stored as full matrix of the cluster distances.
+class AverageClusters{
+public:
+	AverageClusters(RealMatrix const& points):m_distances(points.size1(), points.size1()), m_sizes(points.size1(), 1.0){
+		std::size_t n = points.size1();
+		RealVector norms(n);
+		for(std::size_t i = 0; i != n; ++i)
+			norms(i) = norm_sqr(row(points, i));
+		//upper triangle, one block of rows at a time
+		std::size_t numTiles = (n + TileSize - 1) / TileSize;
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numTiles; ++t){
+			std::size_t start = t * TileSize;
+			std::size_t end = std::min(n, start + TileSize);
+			auto tile = subrange(m_distances, start, end, start, n);
+			noalias(tile) = prod(rows(points, start, end), trans(rows(points, start, n)));
+			for(std::size_t i = start; i != end; ++i){
+				for(std::size_t j = i; j != n; ++j){
+					double dist2 = norms(i) + norms(j) - 2 * tile(i - start, j - start);
+					tile(i - start, j - start) = std::sqrt(std::max(dist2, 0.0));
+				}
+				tile(i - start, i - start) = 0.0;
+			}
+		}
+		//the lower triangle is the mirror image, distances must be exactly symmetric
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)n; ++i){
+			for(std::size_t j = 0; j != (std::size_t)i; ++j)
+				m_distances(i, j) = m_distances(j, i);
+		}
+	}
+
+	double distance(std::size_t i, std::size_t j)const{
+		return m_distances(i, j);
+	}
+	double height(double distance)const{
+		return distance;
+	}
+	/// Lance-Williams update of the distances to the merged cluster
+	void merge(std::size_t keep, std::size_t remove, std::vector<std::size_t> const& active){
+		double size = m_sizes[keep] + m_sizes[remove];
+		double weightKeep = m_sizes[keep] / size;
+		double weightRemove = m_sizes[remove] / size;
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)active.size(); ++i){
+			std::size_t k = active[i];
+			if(k == keep) continue;
+			double d = weightKeep * m_distances(keep, k) + weightRemove * m_distances(remove, k);
+			m_distances(keep, k) = d;
+			m_distances(k, keep) = d;
+		}
+		m_sizes[keep] = size;
+	}
+private:
+	RealMatrix m_distances;
+	std::vector<double> m_sizes;
+};
+
+/// \brief Nearest-neighbor-chain algorithm for reducible linkages.
+///
+/// Follows nearest neighbors until two clusters are reciprocal nearest neighbors and merges them.
+/// The merged cluster is stored at the smaller index.
+template<class Clusters>
+std::vector<PointMerge> nearestNeighborChain(Clusters& clusters, std::size_t n){
+	std::vector<std::size_t> active(n);
+	std::vector<std::size_t> position(n);
+	std::iota(active.begin(), active.end(), 0);
+	std::iota(position.begin(), position.end(), 0);
+	std::vector<std::size_t> chain;
+	std::vector<PointMerge> merges;
+	merges.reserve(n - 1);
+	while(active.size() > 1){
+		if(chain.empty())
+			chain.push_back(active.front());
+		std::size_t a = chain.back();
+		std::pair<double, std::size_t> nearest = nearestActive(clusters, active, a);
+		//the predecessor is preferred on ties, which guarantees that the chain terminates
+		if(chain.size() > 1){
+			std::size_t previous = chain[chain.size() - 2];
+			double distance = clusters.distance(a, previous);
+			if(distance <= nearest.first){
+				chain.pop_back();
+				chain.pop_back();
+				std::size_t keep = std::min(a, previous);
+				std::size_t remove = std::max(a, previous);
+				PointMerge merge = {keep, remove, clusters.height(distance)};
+				merges.push_back(merge);
+				std::size_t pos = position[remove];
+				active[pos] = active.back();
+				position[active[pos]] = pos;
+				active.pop_back();
+				clusters.merge(keep, remove, active);
+				continue;
+			}
+		}
+		chain.push_back(nearest.second);
+	}
+	return merges;
+}
+
+/// \brief Boruvka's algorithm for the Euclidean minimum spanning tree.
+///
+/// Edges are ordered by (distance, smaller point index, larger point index), which makes
+/// the minimum spanning tree unique.
+std::vector<PointMerge> minimumSpanningTree(RealMatrix const& points){
+	std::size_t n = points.size1();
+	RealVector norms(n);
+	for(std::size_t i = 0; i != n; ++i)
+		norms(i) = norm_sqr(row(points, i));
+	std::size_t numTiles = (n + TileSize - 1) / TileSize;
+
+	UnionFind sets(n);
+	std::vector<std::size_t> component(n);
+	std::iota(component.begin(), component.end(), 0);
+	std::vector<PointMerge> edges;
+	edges.reserve(n - 1);
+	std::vector<double> bestDistance(n);
+	std::vector<std::size_t> bestPoint(n);
+	while(edges.size() + 1 < n){
+		//closest point of another component for every point
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)numTiles; ++t){
+			std::size_t start = t * TileSize;
+			std::size_t end = std::min(n, start + TileSize);
+			for(std::size_t i = start; i != end; ++i){
+				bestDistance[i] = std::numeric_limits<double>::infinity();
+				bestPoint[i] = n;
+			}
+			RealMatrix products(end - start, TileSize);
+			for(std::size_t columnStart = 0; columnStart < n; columnStart += TileSize){
+				std::size_t columnEnd = std::min(n, columnStart + TileSize);
+				auto tile = columns(products, 0, columnEnd - columnStart);
+				noalias(tile) = prod(rows(points, start, end), trans(rows(points, columnStart, columnEnd)));
+				for(std::size_t i = start; i != end; ++i){
+					for(std::size_t j = columnStart; j != columnEnd; ++j){
+						if(component[i] == component[j]) continue;
+						double dist2 = std::max(norms(i) + norms(j) - 2 * tile(i - start, j - columnStart), 0.0);
+						if(dist2 < bestDistance[i]){
+							bestDistance[i] = dist2;
+							bestPoint[i] = j;
+						}
+					}
+				}
+			}
+		}
+
+		//cheapest outgoing edge of every component
+		auto edgeLess = [&](std::size_t i, std::size_t k){
+			if(bestDistance[i] != bestDistance[k])
+				return bestDistance[i] < bestDistance[k];
+			std::size_t minI = std::min(i, bestPoint[i]);
+			std::size_t minK = std::min(k, bestPoint[k]);
+			if(minI != minK)
+				return minI < minK;
+			return std::max(i, bestPoint[i]) < std::max(k, bestPoint[k]);
+		};
+		std::vector<std::size_t> cheapest(n, n);
+		for(std::size_t i = 0; i != n; ++i){
+			std::size_t& current = cheapest[component[i]];
+			if(current == n || edgeLess(i, current))
+				current = i;
+		}
+		for(std::size_t c = 0; c != n; ++c){
+			if(cheapest[c] == n) continue;
+			std::size_t i = cheapest[c];
+			std::size_t j = bestPoint[i];
+			std::size_t rootI = sets.find(i);
+			std::size_t rootJ = sets.find(j);
+			if(rootI == rootJ) continue;//the same edge was chosen by both components
+			sets.join(rootI, rootJ);
+			PointMerge edge = {i, j, norm_2(row(points, i) - row(points, j))};
+			edges.push_back(edge);
+		}
+		for(std::size_t i = 0; i != n; ++i)
+			component[i] = sets.find(i);
+	}
+	return edges;
+}
+
+}
+
+std::vector<ClusterMerge> shark::agglomerativeClustering(Data<RealVector> const& data, Linkage linkage){
+	SHARK_RUNTIME_CHECK(data.numberOfElements() > 0, "[agglomerativeClustering] dataset is empty");
+	RealMatrix points = dataMatrix(data);
+	std::size_t n = points.size1();
+	std::vector<PointMerge> merges;
+	if(linkage == WardLinkage){
+		WardClusters clusters(points);
+		merges = nearestNeighborChain(clusters, n);
+	}else if(linkage == AverageLinkage){
+		AverageClusters clusters(points);
+		merges = nearestNeighborChain(clusters, n);
+	}else{
+		merges = minimumSpanningTree(points);
+	}
+	return buildDendrogram(n, merges);
+}
+
+std::vector<unsigned int> shark::cutDendrogram(std::vector<ClusterMerge> const& merges, std::size_t numClusters){
+	std::size_t n = merges.size() + 1;
+	SHARK_RUNTIME_CHECK(numClusters > 0 && numClusters <= n, "[cutDendrogram] invalid number of clusters");
+	//the clusters of the cut are numbered from left to right, as the leaves of the ClusterTree.
+	//we walk down from the root, passing the labels of the undone merges to their children
+	std::vector<unsigned int> labels(2 * n - 1, 0);
+	std::vector<unsigned int> leavesLeft(2 * n - 1, 0);//number of clusters of the cut left of a cluster
+	std::size_t firstMerge = n - numClusters;
+	//count the clusters of the cut contained in every cluster of the top levels
+	std::vector<unsigned int> numLeaves(2 * n - 1, 1);
+	for(std::size_t i = firstMerge; i != merges.size(); ++i)
+		numLeaves[n + i] = numLeaves[merges[i].left] + numLeaves[merges[i].right];
+	for(std::size_t i = merges.size(); i != 0; --i){
+		ClusterMerge const& merge = merges[i - 1];
+		std::size_t cluster = n + i - 1;
+		if(i - 1 >= firstMerge){
+			leavesLeft[merge.left] = leavesLeft[cluster];
+			leavesLeft[merge.right] = leavesLeft[cluster] + numLeaves[merge.left];
+			labels[merge.left] = leavesLeft[merge.left];
+			labels[merge.right] = leavesLeft[merge.right];
+		}else{
+			labels[merge.left] = labels[cluster];
+			labels[merge.right] = labels[cluster];
+		}
+	}
+	return std::vector<unsigned int>(labels.begin(), labels.begin() + n);
+}
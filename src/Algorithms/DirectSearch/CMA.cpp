@@ -38,6 +38,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
 #include <shark/Core/utility/KeyValuePair.h>
+#include <shark/Core/Profiler.h>
 #include <algorithm>
 using namespace shark;
 
@@ -93,6 +94,9 @@ CMA::CMA(random::rng_type& rng)
 , m_muEff( 0 )
 , m_lowerBound( 1E-40)
 , m_counter( 0 )
+, m_lazyDecomposition( false )
+, m_backgroundDecomposition( false )
+, m_lastDecomposition( 0 )
 , mpe_rng(&rng){
 	m_features |= REQUIRES_VALUE;
 }
@@ -127,6 +131,9 @@ void CMA::read( InArchive & archive ) {
 	archive >> m_numEvalIncreaseFactor;
 	archive >> m_rLambda;
 	archive >> m_rankChangeQuantile;
+	
+	m_pendingDecomposition = std::shared_future<MultiVariateNormalDistribution::DecompositionType>();
+	m_lastDecomposition = m_counter;
 }
 
 void CMA::write( OutArchive & archive ) const {
@@ -271,14 +278,18 @@ void CMA::doInit(
 	m_best.value = initialValues[pos];
 	m_lowerBound = 1E-40;
 	m_counter = 0;
+	m_lastDecomposition = 0;
+	m_pendingDecomposition = std::shared_future<MultiVariateNormalDistribution::DecompositionType>();
 }
 
 std::vector<CMA::IndividualType> CMA::generateOffspring( ) const{
 	std::vector< IndividualType > offspring( m_lambda );
+	RealMatrix steps;
+	RealMatrix z;
+	m_mutationDistribution.generate(*mpe_rng, steps, z, m_lambda);
 	for( std::size_t i = 0; i < offspring.size(); i++ ) {
-		MultiVariateNormalDistribution::result_type sample = m_mutationDistribution(*mpe_rng);
-		offspring[i].chromosome() = sample.second;
-		offspring[i].searchPoint() = m_mean + m_sigma * sample.first;
+		offspring[i].chromosome() = row(z, i);
+		offspring[i].searchPoint() = m_mean + m_sigma * row(steps, i);
 	}
 	return offspring;
 }
@@ -323,7 +334,7 @@ void CMA::updatePopulation( std::vector<IndividualType> const& offspring ) {
 	m_sigma *= std::exp((m_cSigma / m_dSigma) * (norm_2(m_evolutionPathSigma) / expectedChi - 1.)); // eq. (39)
 
 	// update mutation distribution
-	m_mutationDistribution.update();
+	updateDecomposition();
 	
 	//mean update
 	m_mean = m;
@@ -338,7 +349,47 @@ void CMA::updatePopulation( std::vector<IndividualType> const& offspring ) {
 	m_best.value= selectedOffspring[ 0 ].unpenalizedFitness();
 
 }
+
+void CMA::rebaseOffspring( IndividualType& offspring ) const{
+	RealVector y = (offspring.searchPoint() - m_mean) / m_sigma;
+	//invert the sampling transformation y = Q D^{1/2} z
+	RealVector z = blas::prod( trans(m_mutationDistribution.eigenVectors()), y ) / sqrt(m_mutationDistribution.eigenValues());
+	double n = static_cast<double>(m_numberOfVariables);
+	double alpha = std::min(1.0, (std::sqrt(n) + 2 * n / (n + 2)) / norm_2(z));
+	offspring.chromosome() = alpha * z;
+	offspring.searchPoint() = m_mean + (alpha * m_sigma) * y;
+}
+
+void CMA::updateDecomposition(){
+	typedef MultiVariateNormalDistribution::DecompositionType DecompositionType;
+	//use the decomposition computed in the background during the last generation
+	if(m_pendingDecomposition.valid()){
+		m_mutationDistribution.setDecomposition(m_pendingDecomposition.get());
+		m_pendingDecomposition = std::shared_future<DecompositionType>();
+	}
+	
+	//the covariance matrix changes by a factor of about c1+cMu per generation. 
+	//Like the reference implementation we decompose every 1/(10n(c1+cMu)) generations
+	//which keeps the amortized cost per generation quadratic in n.
+	if(m_lazyDecomposition){
+		double interval = 1.0/(10 * m_numberOfVariables * (m_c1 + m_cMu));
+		if(m_counter - m_lastDecomposition < interval)
+			return;
+	}
+	m_lastDecomposition = m_counter;
+	
+	if(!m_backgroundDecomposition){
+		m_mutationDistribution.update();
+		return;
+	}
+	RealMatrix C = m_mutationDistribution.covarianceMatrix();
+	m_pendingDecomposition = std::async(std::launch::async, [C]{
+		return DecompositionType(C);
+	}).share();
+}
+
 void CMA::step(ObjectiveFunctionType const& function){
+	SHARK_PROFILE_REGION("CMA::step");
 	std::vector<IndividualType> offspring = generateOffspring();
 	PenalizingEvaluator penalizingEvaluator;
 	penalizingEvaluator.m_numEvaluations = m_numEvaluations;
@@ -39,6 +39,7 @@
 #include <shark/Algorithms/DirectSearch/CMSA.h>
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
+#include <shark/Core/Profiler.h>
 using namespace shark;
 
 void CMSA::init( ObjectiveFunctionType const& function, SearchPointType const& p) {
@@ -109,6 +110,7 @@ void CMSA::doInit(
 
 
 void CMSA::step(ObjectiveFunctionType const& function){
+	SHARK_PROFILE_REGION("CMSA::step");
 	std::vector<IndividualType> offspring = generateOffspring();
 	PenalizingEvaluator penalizingEvaluator;
 	penalizingEvaluator( function, offspring.begin(), offspring.end() );
@@ -117,11 +119,13 @@ void CMSA::step(ObjectiveFunctionType const& function){
 
 std::vector<CMSA::IndividualType> CMSA::generateOffspring( ) const{
 	std::vector< IndividualType > offspring( m_lambda );
-	for( std::size_t i = 0; i < offspring.size(); i++ ) {		    
-		MultiVariateNormalDistribution::result_type sample = m_mutationDistribution(*mpe_rng);
+	RealMatrix steps;
+	RealMatrix z;
+	m_mutationDistribution.generate(*mpe_rng, steps, z, m_lambda);
+	for( std::size_t i = 0; i < offspring.size(); i++ ) {
 		offspring[i].chromosome().sigma = m_sigma * std::exp( m_cSigma * random::gauss(*mpe_rng, 0, 1 ) );
-		offspring[i].chromosome().step = sample.first;
-		offspring[i].searchPoint() = m_mean + offspring[i].chromosome().sigma * sample.first;
+		offspring[i].chromosome().step = row(steps, i);
+		offspring[i].searchPoint() = m_mean + offspring[i].chromosome().sigma * row(steps, i);
 	}
 	return offspring;
 }
@@ -35,6 +35,7 @@
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/ElitistSelection.h>
 #include <shark/Algorithms/DirectSearch/CrossEntropyMethod.h>
+#include <shark/Core/Profiler.h>
 
 using namespace shark;
 
@@ -178,6 +179,7 @@ void CrossEntropyMethod::updateStrategyParameters( const std::vector<Individual<
 * \brief Executes one iteration of the algorithm.
 */
 void CrossEntropyMethod::step(ObjectiveFunctionType const& function){
+	SHARK_PROFILE_REGION("CrossEntropyMethod::step");
 	
 	std::vector< IndividualType > offspring( m_populationSize );
 
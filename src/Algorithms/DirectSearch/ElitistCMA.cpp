@@ -30,6 +30,7 @@
  */
  #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/DirectSearch/ElitistCMA.h>
+#include <shark/Core/Profiler.h>
 #include <algorithm>
 
 using namespace shark;
@@ -70,6 +71,7 @@ void ElitistCMA::init( ObjectiveFunctionType const& function, SearchPointType co
 }
 
 void ElitistCMA::step(ObjectiveFunctionType const& function) {
+	SHARK_PROFILE_REGION("ElitistCMA::step");
 	//create and evaluate offspring
 	m_individual.mutate(*mpe_rng);
 	m_evaluator( function, m_individual );
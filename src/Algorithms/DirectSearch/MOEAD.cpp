@@ -30,6 +30,7 @@
 #include <shark/Algorithms/DirectSearch/MOEAD.h>
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Scalarizers/Tchebycheff.h>
+#include <shark/Core/Profiler.h>
 using namespace shark;
 
 MOEAD::MOEAD(random::rng_type & rng) : mpe_rng(&rng){
@@ -74,6 +75,7 @@ void MOEAD::init(
 }
 
 void MOEAD::step(ObjectiveFunctionType const & function){
+	SHARK_PROFILE_REGION("MOEAD::step");
 	PenalizingEvaluator penalizingEvaluator;
 	// y in paper
 	std::vector<IndividualType> offspring = generateOffspring();
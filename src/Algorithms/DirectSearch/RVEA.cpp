@@ -33,6 +33,7 @@
 #include <shark/Algorithms/DirectSearch/RVEA.h>
 #include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Selection/TournamentSelection.h>
+#include <shark/Core/Profiler.h>
 
 using namespace shark;
 
@@ -90,6 +91,7 @@ void RVEA::init(
 }
 
 void RVEA::step(ObjectiveFunctionType const & function){
+	SHARK_PROFILE_REGION("RVEA::step");
 	PenalizingEvaluator penalizingEvaluator;
 	std::vector<IndividualType> offspring = generateOffspring();
 	penalizingEvaluator(function, offspring.begin(), offspring.end());
@@ -44,323 +44,364 @@
 //RPROP-MINUS>
 
 
-RpropMinus::RpropMinus(){
-	m_features |= REQUIRES_FIRST_DERIVATIVE;
-	m_features |= CAN_SOLVE_CONSTRAINED;
-
-	m_increaseFactor = 1.2;
-	m_decreaseFactor = 0.5;
-	m_maxDelta = 1e100;
-	m_minDelta = 0.0;
+template<class SearchPointType>
+RpropMinusT<SearchPointType>::RpropMinusT(){
+	this->m_features |= RpropMinusT<SearchPointType>::REQUIRES_FIRST_DERIVATIVE;
+	this->m_features |= RpropMinusT<SearchPointType>::CAN_SOLVE_CONSTRAINED;
+
+	this->m_increaseFactor = 1.2;
+	this->m_decreaseFactor = 0.5;
+	this->m_maxDelta = 1e100;
+	this->m_minDelta = 0.0;
 }
 
-void RpropMinus::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
+template<class SearchPointType>
+void RpropMinusT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
 	init(objectiveFunction,startingPoint,0.01);
 }
-void RpropMinus::init(
+template<class SearchPointType>
+void RpropMinusT<SearchPointType>::init(
 	ObjectiveFunctionType const& objectiveFunction, 
 	SearchPointType const& startingPoint, 
 	double initDelta
 ) {
-	checkFeatures(objectiveFunction);
+	this->checkFeatures(objectiveFunction);
 	
-	m_parameterSize = startingPoint.size();
-	m_delta.resize(m_parameterSize);
-	m_oldDerivative.resize(m_parameterSize);
+	this->m_parameterSize = startingPoint.size();
+	this->m_delta.resize(this->m_parameterSize);
+	this->m_oldDerivative.resize(this->m_parameterSize);
 
-	std::fill(m_delta.begin(),m_delta.end(),initDelta);
-	m_oldDerivative.clear();
-	m_best.point = startingPoint;
+	std::fill(this->m_delta.begin(),this->m_delta.end(),initDelta);
+	this->m_oldDerivative.clear();
+	this->m_best.point = startingPoint;
 	//evaluate initial point
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+	this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,this->m_derivative);
 }
 
-void RpropMinus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
+template<class SearchPointType>
+void RpropMinusT<SearchPointType>::step(ObjectiveFunctionType const& objectiveFunction) {
+	for (size_t i = 0; i < this->m_parameterSize; i++)
 	{
-		double p = m_best.point(i);
-		if (m_derivative(i) * m_oldDerivative(i) > 0)
+		double p = this->m_best.point(i);
+		if (this->m_derivative(i) * this->m_oldDerivative(i) > 0)
 		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			this->m_delta(i) = std::min(this->m_maxDelta, this->m_increaseFactor * this->m_delta(i));
 		}
-		else if (m_derivative(i) * m_oldDerivative(i) < 0)
+		else if (this->m_derivative(i) * this->m_oldDerivative(i) < 0)
 		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
 		}
-		m_best.point(i) -= m_delta(i) * boost::math::sign(m_derivative(i));
-		if (! objectiveFunction.isFeasible(m_best.point))
+		this->m_best.point(i) -= this->m_delta(i) * boost::math::sign(this->m_derivative(i));
+		if (! objectiveFunction.isFeasible(this->m_best.point))
 		{
-			m_best.point(i) = p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			this->m_best.point(i) = p;
+			this->m_delta(i) *= this->m_decreaseFactor;
+			this->m_oldDerivative(i) = 0.0;
 		}
 		else
 		{
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
 	}
 	//evaluate the new point
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+	this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,this->m_derivative);
 }
 
-void RpropMinus::read( InArchive & archive )
+template<class SearchPointType>
+void RpropMinusT<SearchPointType>::read( InArchive & archive )
 {
-	archive>>m_delta;
-	archive>>m_oldDerivative;
-	archive>>m_increaseFactor;
-	archive>>m_decreaseFactor;
-	archive>>m_maxDelta;
-	archive>>m_minDelta;
-	archive>>m_parameterSize;
-	archive>>m_best.point;
-	archive>>m_best.value;
+	archive>>this->m_delta;
+	archive>>this->m_oldDerivative;
+	archive>>this->m_increaseFactor;
+	archive>>this->m_decreaseFactor;
+	archive>>this->m_maxDelta;
+	archive>>this->m_minDelta;
+	archive>>this->m_parameterSize;
+	archive>>this->m_best.point;
+	archive>>this->m_best.value;
 }
 
-void RpropMinus::write( OutArchive & archive ) const
+template<class SearchPointType>
+void RpropMinusT<SearchPointType>::write( OutArchive & archive ) const
 {
-	archive<<m_delta;
-	archive<<m_oldDerivative;
-	archive<<m_increaseFactor;
-	archive<<m_decreaseFactor;
-	archive<<m_maxDelta;
-	archive<<m_minDelta;
-	archive<<m_parameterSize;
-	archive<<m_best.point;
-	archive<<m_best.value;
+	archive<<this->m_delta;
+	archive<<this->m_oldDerivative;
+	archive<<this->m_increaseFactor;
+	archive<<this->m_decreaseFactor;
+	archive<<this->m_maxDelta;
+	archive<<this->m_minDelta;
+	archive<<this->m_parameterSize;
+	archive<<this->m_best.point;
+	archive<<this->m_best.value;
 }
 
 
 //RPROP-PLUS
 
-RpropPlus::RpropPlus()
+template<class SearchPointType>
+RpropPlusT<SearchPointType>::RpropPlusT()
 {
 }
 
-void RpropPlus::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
+template<class SearchPointType>
+void RpropPlusT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
 	init(objectiveFunction,startingPoint,0.01);
 }
-void RpropPlus::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta)
+template<class SearchPointType>
+void RpropPlusT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta)
 {
-	RpropMinus::init(objectiveFunction,startingPoint,initDelta);
-	m_deltaw.resize(m_parameterSize);
-	m_deltaw.clear();
+	RpropMinusT<SearchPointType>::init(objectiveFunction,startingPoint,initDelta);
+	this->m_deltaw.resize(this->m_parameterSize);
+	this->m_deltaw.clear();
 }
-void RpropPlus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
+template<class SearchPointType>
+void RpropPlusT<SearchPointType>::step(ObjectiveFunctionType const& objectiveFunction) {
+	for (size_t i = 0; i < this->m_parameterSize; i++)
 	{
 		//save the current value to ensure, that it can be restored
-		double p = m_best.point(i);
-		if (m_derivative(i) * m_oldDerivative(i) > 0)
+		double p = this->m_best.point(i);
+		if (this->m_derivative(i) * this->m_oldDerivative(i) > 0)
 		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i)+=m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_delta(i) = std::min(this->m_maxDelta, this->m_increaseFactor * this->m_delta(i));
+			this->m_deltaw(i) = this->m_delta(i) * -boost::math::sign(this->m_derivative(i));
+			this->m_best.point(i)+=this->m_deltaw(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
-		else if (m_derivative(i) * m_oldDerivative(i) < 0)
+		else if (this->m_derivative(i) * this->m_oldDerivative(i) < 0)
 		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			m_best.point(i)-=m_deltaw(i);
-			m_oldDerivative(i) = 0;
+			this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
+			this->m_best.point(i)-=this->m_deltaw(i);
+			this->m_oldDerivative(i) = 0;
 		}
 		else
 		{
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i)+=m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_deltaw(i) = this->m_delta(i) * -boost::math::sign(this->m_derivative(i));
+			this->m_best.point(i)+=this->m_deltaw(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
-		if (! objectiveFunction.isFeasible(m_best.point))
+		if (! objectiveFunction.isFeasible(this->m_best.point))
 		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			this->m_best.point(i)=p;
+			this->m_delta(i) *= this->m_decreaseFactor;
+			this->m_oldDerivative(i) = 0.0;
 		}
 	}
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+	this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,this->m_derivative);
 }
-void RpropPlus::read( InArchive & archive )
+template<class SearchPointType>
+void RpropPlusT<SearchPointType>::read( InArchive & archive )
 {
-	archive>>boost::serialization::base_object<RpropMinus>(*this);
-	archive>>m_deltaw;
+	archive>>boost::serialization::base_object<RpropMinusT<SearchPointType> >(*this);
+	archive>>this->m_deltaw;
 }
 
-void RpropPlus::write( OutArchive & archive ) const
+template<class SearchPointType>
+void RpropPlusT<SearchPointType>::write( OutArchive & archive ) const
 {
-	archive<<boost::serialization::base_object<RpropMinus>(*this);
-	archive<<m_deltaw;
+	archive<<boost::serialization::base_object<RpropMinusT<SearchPointType> >(*this);
+	archive<<this->m_deltaw;
 }
 
 //IRpropPlus
 
 
-IRpropPlus::IRpropPlus()
+template<class SearchPointType>
+IRpropPlusT<SearchPointType>::IRpropPlusT()
 {
-	m_features |= REQUIRES_VALUE;
-	m_derivativeThreshold = 0.;
+	this->m_features |= RpropMinusT<SearchPointType>::REQUIRES_VALUE;
+	this->m_derivativeThreshold = 0.;
 }
 
-void IRpropPlus::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
 	init(objectiveFunction,startingPoint,0.01);
 }
-void IRpropPlus::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta) {
-	RpropPlus::init(objectiveFunction,startingPoint,initDelta);
-	m_oldError = std::numeric_limits<double>::max();
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta) {
+	RpropPlusT<SearchPointType>::init(objectiveFunction,startingPoint,initDelta);
+	this->m_oldError = std::numeric_limits<double>::max();
 }
 
-void IRpropPlus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::step(ObjectiveFunctionType const& objectiveFunction) {
+	for (size_t i = 0; i < this->m_parameterSize; i++)
 	{
-		if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
-		double p = m_best.point(i);
-		double direction = m_derivative(i) * m_oldDerivative(i);
+		if(std::abs(this->m_derivative(i)) < this->m_derivativeThreshold) this->m_derivative(i) = 0.;
+		double p = this->m_best.point(i);
+		double direction = this->m_derivative(i) * this->m_oldDerivative(i);
 		if ( direction > 0)
 		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i) += m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_delta(i) = std::min(this->m_maxDelta, this->m_increaseFactor * this->m_delta(i));
+			this->m_deltaw(i) = this->m_delta(i) * -boost::math::sign(this->m_derivative(i));
+			this->m_best.point(i) += this->m_deltaw(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
 		else if (direction < 0)
 		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			if (m_best.value > m_oldError)
+			this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
+			if (this->m_best.value > this->m_oldError)
 			{
-				m_best.point(i) -= m_deltaw(i);
+				this->m_best.point(i) -= this->m_deltaw(i);
 			}
-			m_oldDerivative(i) = 0;
+			this->m_oldDerivative(i) = 0;
 		}
 		else
 		{
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i) += m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_deltaw(i) = this->m_delta(i) * -boost::math::sign(this->m_derivative(i));
+			this->m_best.point(i) += this->m_deltaw(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
-		if (! objectiveFunction.isFeasible(m_best.point))
+		if (! objectiveFunction.isFeasible(this->m_best.point))
 		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			this->m_best.point(i)=p;
+			this->m_delta(i) *= this->m_decreaseFactor;
+			this->m_oldDerivative(i) = 0.0;
 		}
 	}
-	m_oldError = m_best.value;
-	m_best.value = objectiveFunction.evalDerivative( m_best.point, m_derivative );
+	this->m_oldError = this->m_best.value;
+	this->m_best.value = objectiveFunction.evalDerivative( this->m_best.point, this->m_derivative );
 }
 
-void IRpropPlus::read( InArchive & archive ) {
-	archive>>boost::serialization::base_object<RpropPlus>(*this);
-	archive>>m_oldError;
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::read( InArchive & archive ) {
+	archive>>boost::serialization::base_object<RpropPlusT<SearchPointType> >(*this);
+	archive>>this->m_oldError;
 }
-void IRpropPlus::write( OutArchive & archive ) const {
-	archive<<boost::serialization::base_object<RpropPlus>(*this);
-	archive<<m_oldError;
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::write( OutArchive & archive ) const {
+	archive<<boost::serialization::base_object<RpropPlusT<SearchPointType> >(*this);
+	archive<<this->m_oldError;
 }
 
-void IRpropPlus::setDerivativeThreshold(double derivativeThreshold)  {
-	m_derivativeThreshold = derivativeThreshold;		
+template<class SearchPointType>
+void IRpropPlusT<SearchPointType>::setDerivativeThreshold(double derivativeThreshold)  {
+	this->m_derivativeThreshold = derivativeThreshold;		
 }
 
 
-IRpropPlusFull::IRpropPlusFull()
+template<class SearchPointType>
+IRpropPlusFullT<SearchPointType>::IRpropPlusFullT()
 {
-	m_features |= REQUIRES_VALUE;
-	m_derivativeThreshold = 0.;
+	this->m_features |= RpropMinusT<SearchPointType>::REQUIRES_VALUE;
+	this->m_derivativeThreshold = 0.;
 }
 
-void IRpropPlusFull::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint) {
 	init(objectiveFunction,startingPoint,0.01);
 }
-void IRpropPlusFull::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta) {
-	RpropPlus::init(objectiveFunction,startingPoint,initDelta);
-	m_oldError = std::numeric_limits<double>::max();
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initDelta) {
+	RpropPlusT<SearchPointType>::init(objectiveFunction,startingPoint,initDelta);
+	this->m_oldError = std::numeric_limits<double>::max();
 }
 
-void IRpropPlusFull::step(ObjectiveFunctionType const& objectiveFunction) {
-	if ( m_best.value < m_oldError){//accept the point as the new current one if it is better
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::step(ObjectiveFunctionType const& objectiveFunction) {
+	if ( this->m_best.value < this->m_oldError){//accept the point as the new current one if it is better
 		//step size adaptation
-		for (size_t i = 0; i < m_parameterSize; i++)
+		for (size_t i = 0; i < this->m_parameterSize; i++)
 		{
-			if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
-			double direction = m_derivative(i) * m_oldDerivative(i);
+			if(std::abs(this->m_derivative(i)) < this->m_derivativeThreshold) this->m_derivative(i) = 0.;
+			double direction = this->m_derivative(i) * this->m_oldDerivative(i);
 			if(direction < 0){//decrease if we overstepped the optimum
-				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+				this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
 			}
 			if( direction > 0)//increase if we still go in the same direction
 			{
-				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+				this->m_delta(i) = std::min(this->m_maxDelta, this->m_increaseFactor * this->m_delta(i));
 			}
 		}
 		//accept the point as the new current one
-		m_oldDerivative = m_derivative;
-		m_oldError = m_best.value;
+		this->m_oldDerivative = this->m_derivative;
+		this->m_oldError = this->m_best.value;
 	}
 	else{
 		//do a full backtrack
-		noalias(m_best.point) -= m_deltaw;
-		for (size_t i = 0; i < m_parameterSize; i++)
+		noalias(this->m_best.point) -= this->m_deltaw;
+		for (size_t i = 0; i < this->m_parameterSize; i++)
 		{
-			if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
-			double direction = m_derivative(i) * m_oldDerivative(i);
+			if(std::abs(this->m_derivative(i)) < this->m_derivativeThreshold) this->m_derivative(i) = 0.;
+			double direction = this->m_derivative(i) * this->m_oldDerivative(i);
 			if(direction < 0){//this went too far...
-				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+				this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
 			}
 		}
 	}
 	
 	//propose new step with updated step sizes
-	for (size_t i = 0; i < m_parameterSize; i++)
+	for (size_t i = 0; i < this->m_parameterSize; i++)
 	{
-		m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-		m_best.point(i) += m_deltaw(i);
+		this->m_deltaw(i) = this->m_delta(i) * -boost::math::sign(this->m_derivative(i));
+		this->m_best.point(i) += this->m_deltaw(i);
 	}
-	m_best.value = objectiveFunction.evalDerivative( m_best.point, m_derivative );
+	this->m_best.value = objectiveFunction.evalDerivative( this->m_best.point, this->m_derivative );
 }
 
-void IRpropPlusFull::read( InArchive & archive ) {
-	archive>>boost::serialization::base_object<RpropPlus>(*this);
-	archive>>m_oldError;
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::read( InArchive & archive ) {
+	archive>>boost::serialization::base_object<RpropPlusT<SearchPointType> >(*this);
+	archive>>this->m_oldError;
 }
-void IRpropPlusFull::write( OutArchive & archive ) const {
-	archive<<boost::serialization::base_object<RpropPlus>(*this);
-	archive<<m_oldError;
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::write( OutArchive & archive ) const {
+	archive<<boost::serialization::base_object<RpropPlusT<SearchPointType> >(*this);
+	archive<<this->m_oldError;
 }
 
-void IRpropPlusFull::setDerivativeThreshold(double derivativeThreshold)  {
-	m_derivativeThreshold = derivativeThreshold;		
+template<class SearchPointType>
+void IRpropPlusFullT<SearchPointType>::setDerivativeThreshold(double derivativeThreshold)  {
+	this->m_derivativeThreshold = derivativeThreshold;		
 }
 
 
 //IRpropMinus
 
-IRpropMinus::IRpropMinus()
+template<class SearchPointType>
+IRpropMinusT<SearchPointType>::IRpropMinusT()
 {
 }
 
-void IRpropMinus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
+template<class SearchPointType>
+void IRpropMinusT<SearchPointType>::step(ObjectiveFunctionType const& objectiveFunction) {
+	for (size_t i = 0; i < this->m_parameterSize; i++)
 	{
-		double p = m_best.point(i);
-		double direction = m_derivative(i) * m_oldDerivative(i);
+		double p = this->m_best.point(i);
+		double direction = this->m_derivative(i) * this->m_oldDerivative(i);
 		if (direction > 0)
 		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_delta(i) = std::min(this->m_maxDelta, this->m_increaseFactor * this->m_delta(i));
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
 		else if (direction < 0)
 		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			m_oldDerivative(i) = 0;
+			this->m_delta(i) = std::max(this->m_minDelta, this->m_decreaseFactor * this->m_delta(i));
+			this->m_oldDerivative(i) = 0;
 		}
 		else
 		{
-			m_oldDerivative(i) = m_derivative(i);
+			this->m_oldDerivative(i) = this->m_derivative(i);
 		}
-		m_best.point(i)-=m_delta(i) * boost::math::sign(m_derivative(i));
-		if (! objectiveFunction.isFeasible(m_best.point))
+		this->m_best.point(i)-=this->m_delta(i) * boost::math::sign(this->m_derivative(i));
+		if (! objectiveFunction.isFeasible(this->m_best.point))
 		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			this->m_best.point(i)=p;
+			this->m_delta(i) *= this->m_decreaseFactor;
+			this->m_oldDerivative(i) = 0.0;
 		}
 	}
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+	this->m_best.value = objectiveFunction.evalDerivative(this->m_best.point,this->m_derivative);
+}
+
+namespace shark{
+template class RpropMinusT<RealVector>;
+template class RpropMinusT<FloatVector>;
+template class RpropPlusT<RealVector>;
+template class RpropPlusT<FloatVector>;
+template class IRpropPlusT<RealVector>;
+template class IRpropPlusT<FloatVector>;
+template class IRpropPlusFullT<RealVector>;
+template class IRpropPlusFullT<FloatVector>;
+template class IRpropMinusT<RealVector>;
+template class IRpropMinusT<FloatVector>;
 }
@@ -71,8 +71,11 @@ namespace{
 	/// Returns the improvement in function value and the solution as a pair.
 	///
 	/// Algorithm 7.2 in Wright, Nocedal: Numerical Optimization
+	///
+	/// hessianProduct(v, Hv) computes the product of the Hessian with v.
+	template<class HessianProduct>
 	std::pair<double,RealVector> trustRegionCG(
-		RealMatrix const& hessian,
+		HessianProduct const& hessianProduct,
 		RealVector gradient,
 		double tolerance,   // bound on the norm of the gradient
 		double delta        // trust region size (radius)
@@ -87,7 +90,8 @@ namespace{
 			return solution;
 
 		for(std::size_t iter = 0; iter != 10*gradient.size(); ++iter ){//numerical safeguard(should never be called)
-			RealVector Hdir=prod(hessian,direction);
+			RealVector Hdir;
+			hessianProduct(direction, Hdir);
 			double normH=inner_prod(direction, Hdir);
 			// if our Hessian is not positive definite then we just run to the boundary
 			if(normH <= 0){
@@ -133,13 +137,26 @@ TrustRegionNewton::TrustRegionNewton()
 }
 
 void TrustRegionNewton::init(ObjectiveFunctionType const& objectiveFunction, SearchPointType const& startingPoint, double initialDelta) {
-	checkFeatures(objectiveFunction);
+	m_hessianFree = objectiveFunction.hasHessianVectorProduct();
+	if(m_hessianFree){
+		SHARK_RUNTIME_CHECK(objectiveFunction.hasFirstDerivative(), name()+" Requires first derivative of objective function");
+		SHARK_RUNTIME_CHECK(!objectiveFunction.isConstrained(), name()+" Can not solve constrained problems");
+	}else{
+		checkFeatures(objectiveFunction);
+	}
 
 	m_delta = initialDelta;
 	m_minImprovementRatio = 0.1;
+	m_converged = false;
 	
 	m_best.point = startingPoint;
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+	m_best.value = evalDerivative(objectiveFunction);
+}
+
+double TrustRegionNewton::evalDerivative(ObjectiveFunctionType const& objectiveFunction){
+	if(m_hessianFree)
+		return objectiveFunction.evalDerivative(m_best.point,m_derivatives.gradient);
+	return objectiveFunction.evalDerivative(m_best.point,m_derivatives);
 }
 
 void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
@@ -158,8 +175,21 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//The initial guess of 0.5 might be too optimistic and we still spend a lot of time on finding the solution, but this is hugely problem dependent.
 	double gamma =std::min(0.5,std::sqrt(gradNorm_2));
 	double tolerance = gamma* gradNorm_2;
-	std::pair<double,RealVector> solution =  trustRegionCG(m_derivatives.hessian, m_derivatives.gradient, tolerance, m_delta);
-	if (solution.first == 0) return;//we are done
+	std::pair<double,RealVector> solution;
+	if(m_hessianFree){
+		auto hessianProduct = [&](RealVector const& v, RealVector& Hv){
+			objectiveFunction.hessianVectorProduct(m_best.point, v, Hv);
+		};
+		solution = trustRegionCG(hessianProduct, m_derivatives.gradient, tolerance, m_delta);
+	}else{
+		auto hessianProduct = [&](RealVector const& v, RealVector& Hv){
+			Hv = prod(m_derivatives.hessian, v);
+		};
+		solution = trustRegionCG(hessianProduct, m_derivatives.gradient, tolerance, m_delta);
+	}
+	//we are done if the model does not predict an improvement larger than the rounding error
+	m_converged = -solution.first <= std::numeric_limits<double>::epsilon() * std::abs(m_best.value);
+	if (m_converged) return;
 
 	//calculate the function value improvement of the point compared to the model prediction
 	double newValue = objectiveFunction(m_best.point + solution.second);
@@ -176,6 +206,6 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//accept the point only if the improvement is significant
 	if(rho >= m_minImprovementRatio){
 		noalias(m_best.point) +=solution.second;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+		m_best.value = evalDerivative(objectiveFunction);
 	}
 }
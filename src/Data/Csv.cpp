@@ -36,6 +36,7 @@
 #include <boost/spirit/include/qi.hpp>
 #include <boost/fusion/adapted/std_pair.hpp>
 #include <shark/Data/Csv.h>
+#include <shark/Core/Profiler.h>
 #include <vector>
 #include <ctype.h>
 
@@ -46,6 +47,8 @@ inline std::vector<T> importCSVReaderSingleValue(
 	std::string const& contents,
 	char comment = '#'
 ) {
+	SHARK_PROFILE_REGION("importCSV");
+	SHARK_PROFILE_COUNTER("bytes parsed", contents.size());
 	std::string::const_iterator first = contents.begin();
 	std::string::const_iterator last = contents.end();
 
@@ -67,6 +70,8 @@ inline std::vector<std::vector<double> > importCSVReaderSingleValues(
 	char separator,
 	char comment = '#'
 ) {
+	SHARK_PROFILE_REGION("importCSV");
+	SHARK_PROFILE_COUNTER("bytes parsed", contents.size());
 	std::string::const_iterator first = contents.begin();
 	std::string::const_iterator last = contents.end();
 
@@ -111,6 +116,8 @@ inline std::vector<CsvPoint> import_csv_reader_points(
 	char separator,
 	char comment = '#'
 ) {
+	SHARK_PROFILE_REGION("importCSV");
+	SHARK_PROFILE_COUNTER("bytes parsed", contents.size());
 	typedef std::string::const_iterator Iterator;
 	Iterator first = contents.begin();
 	Iterator last = contents.end();
@@ -36,6 +36,7 @@
 #include <boost/spirit/include/qi.hpp>
 #include <boost/fusion/adapted/std_pair.hpp>
 #include <shark/Data/SparseData.h>
+#include <shark/Core/Profiler.h>
 
 using namespace shark;
 
@@ -44,10 +45,12 @@ namespace {
 typedef std::pair<double, std::vector<std::pair<std::size_t, double> > > LibSVMPoint;
 inline std::vector<LibSVMPoint> 
 importSparseDataReader(std::istream& stream) {
+	SHARK_PROFILE_REGION("importSparseData");
 	std::vector<LibSVMPoint> fileContents;
 	while(stream) {
 		std::string line;
 		std::getline(stream, line);
+		SHARK_PROFILE_COUNTER("bytes parsed", line.size() + 1);
 		if (line.empty()) continue;
 
 		using namespace boost::spirit::qi;
@@ -183,8 +186,8 @@ shark::LabeledData<T, unsigned int> libsvm_importer_classification(
 	return data;
 }
 
-template<class T>//We assume T to be vectorial
-shark::LabeledData<T, RealVector> libsvm_importer_regression(
+template<class T, class L = RealVector>//We assume T and L to be vectorial
+shark::LabeledData<T, L> libsvm_importer_regression(
 	std::istream& stream,
 	unsigned int dimensions,
 	std::size_t batchSize
@@ -217,13 +220,13 @@ shark::LabeledData<T, RealVector> libsvm_importer_regression(
 	}
 
 	//copy contents into a new dataset
-	typename shark::LabeledData<T, RealVector>::element_type blueprint(T(maxIndex + (hasZero ? 1 : 0)), RealVector(1));
-	shark::LabeledData<T, RealVector> data(numPoints, blueprint, batchSize);//create dataset with the right structure
+	typename shark::LabeledData<T, L>::element_type blueprint(T(maxIndex + (hasZero ? 1 : 0)), L(1));
+	shark::LabeledData<T, L> data(numPoints, blueprint, batchSize);//create dataset with the right structure
 	copySparsePoints(data.inputs(),contents, hasZero);
 	{
 		std::size_t i = 0;
 		for(auto element: data.elements()) {
-			element.label = RealVector(1, contents[i].first);
+			element.label = L(1, contents[i].first);
 			++i;
 		}
 	}
@@ -270,6 +273,24 @@ void shark::importSparseData(
 	dataset =  libsvm_importer_regression<CompressedRealVector>(stream, highestIndex, batchSize);
 }
 
+void shark::importSparseData(
+	LabeledData<FloatVector, unsigned int>& dataset,
+	std::istream& stream,
+	unsigned int highestIndex,
+	std::size_t batchSize
+){
+	dataset =  libsvm_importer_classification<FloatVector>(stream, highestIndex, batchSize);
+}
+
+void shark::importSparseData(
+	LabeledData<FloatVector, FloatVector>& dataset,
+	std::istream& stream,
+	unsigned int highestIndex,
+	std::size_t batchSize
+){
+	dataset =  libsvm_importer_regression<FloatVector, FloatVector>(stream, highestIndex, batchSize);
+}
+
 void shark::importSparseData(
 	LabeledData<RealVector, unsigned int>& dataset,
 	std::string fn,
@@ -313,3 +334,25 @@ void shark::importSparseData(
 	SHARK_RUNTIME_CHECK(ifs, "failed to open file for input");
 	dataset =  libsvm_importer_regression<CompressedRealVector>(ifs, highestIndex, batchSize);
 }
+
+void shark::importSparseData(
+	LabeledData<FloatVector, unsigned int>& dataset,
+	std::string fn,
+	unsigned int highestIndex,
+	std::size_t batchSize
+){
+	std::ifstream ifs(fn.c_str());
+	SHARK_RUNTIME_CHECK(ifs, "failed to open file for input");
+	dataset =  libsvm_importer_classification<FloatVector>(ifs, highestIndex, batchSize);
+}
+
+void shark::importSparseData(
+	LabeledData<FloatVector, FloatVector>& dataset,
+	std::string fn,
+	unsigned int highestIndex,
+	std::size_t batchSize
+){
+	std::ifstream ifs(fn.c_str());
+	SHARK_RUNTIME_CHECK(ifs, "failed to open file for input");
+	dataset =  libsvm_importer_regression<FloatVector, FloatVector>(ifs, highestIndex, batchSize);
+}